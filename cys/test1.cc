@@ -28,6 +28,9 @@
 #include "ns3/flow-monitor-module.h"
 #include "ns3/point-to-point-net-device.h"
 #include "ns3/queue.h"
+#include "ns3/auto-topology-reader.h"
+#include "ns3/point-to-point-auto-topology.h"
+#include "ns3/columnar-writer.h"
 
 using namespace ns3;
 using namespace std;
@@ -252,6 +255,70 @@ struct SubSampleAccumulator {
 
 static SubSampleAccumulator g_subSampleAccum;
 
+// 列式二进制输出: 非空时写入 <prefix>-links.ncol / <prefix>-flows.ncol / <prefix>-flow-tuples.ncol
+static std::string g_columnarPrefix;
+// 进度旁路文件 (JSON Lines): 非空时由 ShowProgress 按墙钟间隔写入
+static std::string g_progressOut;
+// 交换节点只装转发栈 (ForwardingStackHelper)，否则所有节点装完整协议栈
+static bool g_forwardingStack = false;
+
+// 抓包: 前缀非空时对选中链路两端设备写 <prefix>-<node>-<dev>.pcap
+static std::string g_pcapPrefix;
+// 选中的链路 "u-v,..." (节点编号，不分方向)，为空则抓所有链路
+static std::string g_pcapLinks;
+// 只抓这些优先级 (IPv4 TOS 高 3 位，同 QbbNetDevice)，为空则不过滤
+static std::set<uint8_t> g_pcapPriorities;
+
+// 按 ',' 切分参数
+static std::vector<std::string> SplitList (const std::string& s)
+{
+  std::vector<std::string> out;
+  std::istringstream is (s);
+  std::string item;
+  while (std::getline (is, item, ','))
+    {
+      if (!item.empty ())
+        out.push_back (item);
+    }
+  return out;
+}
+
+static bool IsPcapLink (uint32_t a, uint32_t b)
+{
+  if (g_pcapLinks.empty ())
+    return true;
+  for (const std::string& link : SplitList (g_pcapLinks))
+    {
+      uint32_t u = 0, v = 0;
+      char dash = 0;
+      std::istringstream is (link);
+      if ((is >> u >> dash >> v) && dash == '-' && ((u == a && v == b) || (u == b && v == a)))
+        return true;
+    }
+  return false;
+}
+
+// PcapFileWrapper 的 Filter: 设备抓到的是带 PPP 头的帧
+static bool IsPcapPriority (Ptr<const Packet> p)
+{
+  Ptr<Packet> copy = p->Copy ();
+  PppHeader ppp;
+  copy->RemoveHeader (ppp);
+  if (ppp.GetProtocol () != 0x0021)
+    return false;
+  Ipv4Header ip;
+  copy->PeekHeader (ip);
+  return g_pcapPriorities.count ((ip.GetTos () >> 5) & 0x7) > 0;
+}
+
+struct LinkSeriesColumns
+{
+  uint32_t time, link, nodeA, nodeB, queueA, queueB, util;
+};
+
+static ColumnarWriter* g_linkSeries = nullptr;
+static LinkSeriesColumns g_linkSeriesColumns;
+
 void RecordAllQueuesAtSubPoint()
 {
     if (g_allLinksPtr == nullptr) return;
@@ -328,6 +395,19 @@ void RecordAllQueues()
         }
         link.utilSnapshots.push_back(utilStep);
 
+        if (g_linkSeries)
+        {
+            const LinkSeriesColumns& c = g_linkSeriesColumns;
+            g_linkSeries->Set(c.time, now);
+            g_linkSeries->Set(c.link, i);
+            g_linkSeries->Set(c.nodeA, link.nodeA);
+            g_linkSeries->Set(c.nodeB, link.nodeB);
+            g_linkSeries->Set(c.queueA, qA);
+            g_linkSeries->Set(c.queueB, qB);
+            g_linkSeries->Set(c.util, utilStep);
+            g_linkSeries->EndRow();
+        }
+
         link.lastSampleTime   = now;
         link.lastTxBytesTotal = currTxTotal;
     }
@@ -337,6 +417,30 @@ void RecordAllQueues()
     g_subSampleAccum.count = 0;
 }
 
+// 周期性调用一个函数, 共 count 次: 每个周期复用同一个事件
+struct PeriodicSampler
+{
+    PeriodicEvent event;
+    void (*function)() = nullptr;
+    uint32_t remaining = 0;
+
+    void Start(void (*fn)(), Time first, Time period, uint32_t count)
+    {
+        function = fn;
+        remaining = count;
+        if (remaining == 0) return;
+        event.SetFunction(&PeriodicSampler::Expire, this);
+        event.SetPeriod(period);
+        event.Start(first);
+    }
+
+    void Expire()
+    {
+        function();
+        if (--remaining == 0) event.Stop();
+    }
+};
+
 std::vector<double> GetStatus(
     uint32_t flows,
     const std::string& transport,
@@ -364,8 +468,53 @@ int main (int argc, char *argv[])
   cmd.AddValue ("load-rate", "TCP per-flow 速率均值系数", loadRate);
   cmd.AddValue ("link-ref-mbps", "参考链路带宽（Mbps）", linkRefMbps);
   cmd.AddValue ("appsStop", "应用程序停止时间（秒）", appsStop);
+  cmd.AddValue ("columnar-out", "列式二进制结果文件前缀（为空则只输出日志）", g_columnarPrefix);
+  cmd.AddValue ("progress-out", "运行进度 JSON Lines 旁路文件（为空则不输出）", g_progressOut);
+  cmd.AddValue ("forwarding-stack", "交换节点只装 IPv4 转发与全局路由（不装 ARP/ICMP/IPv6/TCP/UDP 和流量控制层）", g_forwardingStack);
+  bool headerCache = false;
+  cmd.AddValue ("header-cache", "缓存已解析的包头（路由/分类重复 PeekHeader 时不再反序列化）", headerCache);
+  bool deviceQueueOnly = false;
+  cmd.AddValue ("device-queue-only", "主机不装默认队列规程，IP 包直接交给设备队列（不分配 QueueDiscItem）", deviceQueueOnly);
+  bool noByteTags = false;
+  cmd.AddValue ("no-byte-tags", "关闭字节标签和包元数据（FlowMonitor 改用包标签，每跳少做标签偏移维护）", noByteTags);
+  cmd.AddValue ("pcap-prefix", "抓包文件前缀（为空则不抓包）", g_pcapPrefix);
+  cmd.AddValue ("pcap-links", "只抓这些链路 \"u-v,...\"（为空则所有链路）", g_pcapLinks);
+  string pcapPriorities;
+  cmd.AddValue ("pcap-priorities", "只抓这些优先级 \"3,5\"（为空则所有优先级）", pcapPriorities);
+  uint32_t pcapSample = 1;
+  cmd.AddValue ("pcap-sample", "每个设备每 N 个包抓 1 个", pcapSample);
+  uint32_t pcapSnaplen = PcapFile::SNAPLEN_DEFAULT;
+  cmd.AddValue ("pcap-snaplen", "每个包最多保存的字节数", pcapSnaplen);
+  uint32_t pcapBuffer = 4 << 20;
+  cmd.AddValue ("pcap-buffer", "后台写线程的双缓冲大小（字节，0 则在仿真线程同步写）", pcapBuffer);
   cmd.Parse (argc, argv);
 
+  Config::SetDefault ("ns3::PcapFileWrapper::SamplingPeriod", UintegerValue (pcapSample));
+  Config::SetDefault ("ns3::PcapFileWrapper::CaptureSize", UintegerValue (pcapSnaplen));
+  Config::SetDefault ("ns3::PcapFileWrapper::WriteBufferSize", UintegerValue (pcapBuffer));
+  for (const std::string& prio : SplitList (pcapPriorities))
+    {
+      g_pcapPriorities.insert (static_cast<uint8_t> (std::stoul (prio)));
+    }
+  if (!g_pcapPriorities.empty ())
+    {
+      Config::SetDefault ("ns3::PcapFileWrapper::Filter",
+                          CallbackValue (MakeCallback (&IsPcapPriority)));
+    }
+
+  if (headerCache)
+    {
+      Packet::EnableHeaderCache();
+    }
+  if (deviceQueueOnly)
+    {
+      Config::SetDefault("ns3::TrafficControlLayer::QueueDiscBypass", BooleanValue(true));
+    }
+  if (noByteTags)
+    {
+      Packet::DisableByteTags();
+    }
+
   int run_count = 0;
   while (run_count < 1)
   {
@@ -379,30 +528,11 @@ int main (int argc, char *argv[])
           std::cerr << "仿真 " << (run_count + 1) << " 发生错误" << std::endl;
       } else {
           std::vector<std::pair<uint32_t, uint32_t>> linkNodePairs;
-          std::ifstream topoFile("scratch/auto.txt");
-          if (topoFile.is_open()) {
-              std::string line;
-              int state = 0;
-              int numNodes = 0, numLinks = 0;
-
-              while (std::getline(topoFile, line)) {
-                  if (line.empty() || line[0] == '#') continue;
-                  if (line.find("TOPO_TYPE:") == 0) continue;
-                  if (line.find("EDGE_NODES:") == 0) continue;
-
-                  std::istringstream iss(line);
-                  if (state == 0) {
-                      if (iss >> numNodes) state = 1;
-                  } else if (state == 1) {
-                      if (iss >> numLinks) state = 2;
-                  } else if (state == 2) {
-                      int n1, n2;
-                      if (iss >> n1 >> n2) {
-                          linkNodePairs.push_back(std::make_pair((uint32_t)n1, (uint32_t)n2));
-                      }
-                  }
-              }
-              topoFile.close();
+          Ptr<AutoTopologyReader> topoReader = CreateObject<AutoTopologyReader>();
+          topoReader->SetFileName("scratch/auto.txt");
+          topoReader->Parse();
+          for (const auto& info : topoReader->GetLinkInfos()) {
+              linkNodePairs.push_back(std::make_pair(info.from, info.to));
           }
 
           uint32_t numLinks = (results.size() - 3) / 2;
@@ -501,71 +631,37 @@ std::vector<double> GetStatus(
       return {-6.0, -6.0, -6.0, -6.0};
     }
 
-  std::ifstream topoFile(input_topo_path.c_str());
-  if (!topoFile.is_open())
+  Ptr<AutoTopologyReader> topoReader = CreateObject<AutoTopologyReader>();
+  topoReader->SetFileName(input_topo_path);
+  NodeContainer nodes = topoReader->Read();
+  if (nodes.GetN() == 0)
     {
       return {-1.0, -1.0, -1.0, -1.0};
     }
-
-  int numNodes = 0;
-  int numLinks = 0;
-  std::string line;
-  int state = 0;
-  std::vector<uint32_t> edgeNodes;
-  std::map<uint32_t, std::vector<uint32_t> > nodeLinks;
-
-  std::string firstLinkLine;
-  bool hasFirstLink = false;
-
-  while (std::getline(topoFile, line))
+  if (topoReader->GetLinkInfos().empty())
     {
-      if (line.empty() || line[0] == '#') continue;
-      if (line.find("TOPO_TYPE:") == 0) continue; 
-      if (line.find("EDGE_NODES:") == 0)
-        {
-          std::istringstream iss(line.substr(11));
-          uint32_t node;
-          while (iss >> node) edgeNodes.push_back(node);
-          continue;
-        }
-
-      std::istringstream iss(line);
-
-      if (state == 0)
-        {
-          if (iss >> numNodes)
-            {
-              state = 1;
-              continue;
-            }
-        }
-      else if (state == 1)
-        {
-          if (iss >> numLinks)
-            {
-              state = 2;
-              if (numLinks == 0) break;
-              continue;
-            }
-        }
-      else if (state == 2)
-        {
-          firstLinkLine = line;
-          hasFirstLink = true;
-          break;
-        }
+      return {-2.0, -2.0, -2.0, -2.0};
     }
 
-  if (numNodes <= 0 || numLinks <= 0)
+  std::vector<uint32_t> edgeNodes = topoReader->GetEdgeNodes();
+
+  // 只有边缘节点跑应用；--forwarding-stack 时其余交换节点只装 IPv4 转发与
+  // 全局路由，不装 ARP/ICMP/IPv6/TCP/UDP 和流量控制层（也就没有队列规程）
+  NodeContainer hosts;
+  NodeContainer switches;
+  std::set<uint32_t> edgeSet(edgeNodes.begin(), edgeNodes.end());
+  for (uint32_t i = 0; i < nodes.GetN(); ++i)
     {
-      topoFile.close();
-      return {-2.0, -2.0, -2.0, -2.0};
+      if (!g_forwardingStack || edgeSet.empty() || edgeSet.count(i))
+        hosts.Add(nodes.Get(i));
+      else
+        switches.Add(nodes.Get(i));
     }
 
-  NodeContainer nodes;
-  nodes.Create(numNodes);
   InternetStackHelper stack;
-  stack.Install(nodes);
+  stack.Install(hosts);
+  ForwardingStackHelper forwarding;
+  forwarding.Install(switches);
 
   for (uint32_t i = 0; i < nodes.GetN(); ++i)
     {
@@ -578,46 +674,40 @@ std::vector<double> GetStatus(
   address.SetBase ("10.0.0.0", "255.255.255.252");
   p2p.SetQueue("ns3::DropTailQueue<Packet>", "MaxSize", StringValue("20p"));
 
-  std::set<uint32_t> connectedNodes;
-  std::vector<LinkStats> allLinks;
-
-  auto installLinkAndTrace = [&](const std::string& linkLine_arg) 
+  // 按权重批量配置链路: 时延 = weight*2/100 ms, 带宽 = 50/weight Mbps
+  auto configLink = [](PointToPointHelper& helper, uint32_t weight)
   {
-    if (linkLine_arg.empty() || linkLine_arg[0] == '#') return;
-    if (linkLine_arg.find("EDGE_NODES:") == 0) return;
-    if (linkLine_arg.find("TOPO_TYPE:") == 0) return; 
-
-    std::istringstream iss(linkLine_arg);
-    int node1, node2, weight;
-
-    if (!(iss >> node1 >> node2)) return;
-    if (!(iss >> weight)) weight = 100;
-
-    if (node1 < 0 || node1 >= numNodes || node2 < 0 || node2 >= numNodes)
-      {
-        return;
-      }
-
-    connectedNodes.insert((uint32_t)node1);
-    connectedNodes.insert((uint32_t)node2);
-
-    nodeLinks[(uint32_t)node1].push_back((uint32_t)node2);
-    nodeLinks[(uint32_t)node2].push_back((uint32_t)node1);
-
     std::ostringstream delayStr, bwStr;
-    double delay_ms = (weight * 2.0) / 100.0;
-    double bandwidth_mbps = (50.0) / weight; 
+    delayStr << (weight * 2.0) / 100.0 << "ms";
+    bwStr << 50.0 / weight << "Mbps";
+    helper.SetChannelAttribute ("Delay", StringValue (delayStr.str()));
+    helper.SetDeviceAttribute ("DataRate", StringValue (bwStr.str()));
+  };
+  PointToPointAutoTopologyHelper fabric (p2p, PointToPointAutoTopologyHelper::LinkConfigCallback (configLink));
+  std::vector<NetDeviceContainer> linkDevices = fabric.Install (topoReader, address);
 
-    delayStr << delay_ms << "ms";
-    bwStr << bandwidth_mbps << "Mbps";
+  if (!g_pcapPrefix.empty ())
+    {
+      // 只在选中链路上抓包，采样/截断/写线程由 PcapFileWrapper 的默认属性决定
+      for (uint32_t li = 0; li < linkDevices.size (); ++li)
+        {
+          const auto& info = topoReader->GetLinkInfos ()[li];
+          if (IsPcapLink (info.from, info.to))
+            p2p.EnablePcap (g_pcapPrefix, linkDevices[li]);
+        }
+    }
 
-    p2p.SetChannelAttribute ("Delay", StringValue (delayStr.str()));
-    p2p.SetDeviceAttribute ("DataRate", StringValue (bwStr.str()));
+  std::set<uint32_t> connectedNodes;
+  std::vector<LinkStats> allLinks;
 
-    NodeContainer nc = NodeContainer(nodes.Get((uint32_t)node1), nodes.Get((uint32_t)node2));
-    NetDeviceContainer ndc = p2p.Install(nc);
-    address.Assign(ndc);
-    address.NewNetwork();
+  for (uint32_t li = 0; li < linkDevices.size(); ++li)
+  {
+    const NetDeviceContainer& ndc = linkDevices[li];
+    uint32_t node1 = topoReader->GetLinkInfos()[li].from;
+    uint32_t node2 = topoReader->GetLinkInfos()[li].to;
+
+    connectedNodes.insert(node1);
+    connectedNodes.insert(node2);
 
     Ptr<PointToPointNetDevice> d0 = DynamicCast<PointToPointNetDevice>(ndc.Get(0));
     Ptr<PointToPointNetDevice> d1 = DynamicCast<PointToPointNetDevice>(ndc.Get(1));
@@ -627,8 +717,8 @@ std::vector<double> GetStatus(
         ls.sa = std::make_shared<DevStats>();
         ls.sb = std::make_shared<DevStats>();
 
-        ls.nodeA = (uint32_t)node1;
-        ls.nodeB = (uint32_t)node2;
+        ls.nodeA = node1;
+        ls.nodeB = node2;
 
         ls.sa->tag = std::string("A(") + std::to_string(node1) + "->" + std::to_string(node2) + ")";
         ls.sb->tag = std::string("B(") + std::to_string(node2) + "->" + std::to_string(node1) + ")";
@@ -669,15 +759,7 @@ std::vector<double> GetStatus(
 
         allLinks.push_back(ls);
       }
-  };
-
-  if (hasFirstLink) {
-      installLinkAndTrace(firstLinkLine);
   }
-  while (std::getline(topoFile, line)) { 
-      installLinkAndTrace(line);
-  }
-  topoFile.close();
 
   if (edgeNodes.empty())
     {
@@ -842,6 +924,21 @@ for (size_t i = 0; i < pairs.size(); ++i)
 
   g_allLinksPtr = &allLinks;
 
+  ColumnarWriter linkSeries;
+  if (!g_columnarPrefix.empty())
+    {
+      LinkSeriesColumns& c = g_linkSeriesColumns;
+      c.time = linkSeries.AddColumn("time", ColumnarWriter::DOUBLE);
+      c.link = linkSeries.AddColumn("link", ColumnarWriter::UINT32);
+      c.nodeA = linkSeries.AddColumn("nodeA", ColumnarWriter::UINT32);
+      c.nodeB = linkSeries.AddColumn("nodeB", ColumnarWriter::UINT32);
+      c.queueA = linkSeries.AddColumn("queueA", ColumnarWriter::DOUBLE);
+      c.queueB = linkSeries.AddColumn("queueB", ColumnarWriter::DOUBLE);
+      c.util = linkSeries.AddColumn("util", ColumnarWriter::DOUBLE);
+      linkSeries.Open(g_columnarPrefix + "-links.ncol");
+      g_linkSeries = &linkSeries;
+    }
+
   const double sampleStart = std::max(0.0, startMin);
   const double sampleEnd   = appsStop;
 
@@ -853,24 +950,45 @@ for (auto& link : allLinks)
 }
 
 
+  // 子采样与采样事件各自周期性重复, 不再预先为每个区间调度 SUB_SAMPLE_COUNT 个事件
+  uint32_t nSamples = 0;
   for (double t = sampleStart; t <= sampleEnd + 1e-12; t += sampleInterval)
   {
-      double subDt = sampleInterval / (double)SUB_SAMPLE_COUNT;
-      for (uint32_t sub = 0; sub < SUB_SAMPLE_COUNT; ++sub)
-      {
-          double subT = t + (sub + 0.5) * subDt;
-          Simulator::Schedule(Seconds(subT), &RecordAllQueuesAtSubPoint);
-      }
-
-      Simulator::Schedule(Seconds(t + sampleInterval), &RecordAllQueues);
+      nSamples++;
+  }
+  const Time subDt = Seconds(sampleInterval) / SUB_SAMPLE_COUNT;
+  PeriodicSampler subSampler;
+  PeriodicSampler sampler;
+  subSampler.Start(&RecordAllQueuesAtSubPoint, Seconds(sampleStart) + subDt / 2, subDt,
+                   nSamples * SUB_SAMPLE_COUNT);
+  sampler.Start(&RecordAllQueues, Seconds(sampleStart + sampleInterval), Seconds(sampleInterval),
+                nSamples);
+
+  // 长时间运行的进度监控: 事件速率、事件表大小、在途包数、内存
+  std::unique_ptr<ShowProgress> progress;
+  if (!g_progressOut.empty())
+  {
+      progress = std::make_unique<ShowProgress>(Seconds(10), std::cerr);
+      progress->SetSidecar(g_progressOut);
   }
 
   Simulator::Stop(Seconds(appsStop + 1.0));
   Simulator::Run();
+  progress.reset();
 
   monitor->CheckForLostPackets();
   const auto& stats = monitor->GetFlowStats();
 
+  if (g_linkSeries)
+    {
+      g_linkSeries->Close();
+      g_linkSeries = nullptr;
+      flowmonHelper.SerializeToColumnarFile(g_columnarPrefix + "-flows.ncol");
+      Ptr<Ipv4FlowClassifier> classifier =
+          DynamicCast<Ipv4FlowClassifier>(flowmonHelper.GetClassifier());
+      classifier->SerializeToColumnarFile(g_columnarPrefix + "-flow-tuples.ncol");
+    }
+
   double simTime = std::max(1e-9, Simulator::Now().GetSeconds());
 
   // 【修改】计算平均队列长度，支持小数
@@ -963,6 +1081,16 @@ for (auto& link : allLinks)
       NS_LOG_UNCOND("  平均队列: " << std::fixed << std::setprecision(2) 
                     << avgQueueLengths[i] << " 包");
 
+      // 时间序列已写入列式文件时不再打印
+      if (!g_columnarPrefix.empty())
+      {
+          NS_LOG_UNCOND("  利用率=" << std::fixed << std::setprecision(2)
+                        << linkUtilizations[i] << "% | 发送字节="
+                        << (L.sa->txBytes + L.sb->txBytes)
+                        << " | 丢包数=" << (L.sa->dropPackets + L.sb->dropPackets));
+          continue;
+      }
+
       // 【修改】只输出前10个时间戳，避免日志过长
       std::ostringstream ossT;
       ossT << "  采样时间戳序列(前10个): [";
@@ -166,12 +166,21 @@ macro(write_configtable)
   string(APPEND out "MPI Support                   : ")
   check_on_or_off("NS3_MPI" "MPI_FOUND")
 
+  string(APPEND out "Multithreaded Simulation      : ")
+  check_on_or_off("NS3_MTP" "NS3_MTP")
+
+  string(APPEND out "Replications as Threads       : ")
+  check_on_or_off("NS3_REPLICATIONS" "NS3_REPLICATIONS")
+
   string(APPEND out "ns-3 Click Integration        : ")
   check_on_or_off("ON" "NS3_CLICK")
 
   string(APPEND out "ns-3 OpenFlow Integration     : ")
   check_on_or_off("ON" "NS3_OPENFLOW")
 
+  string(APPEND out "Packet byte tags and metadata : ")
+  check_on_or_off("NS3_BYTE_TAGS" "NS3_BYTE_TAGS")
+
   string(APPEND out "Netmap emulation FdNetDevice  : ")
   check_on_or_off("ENABLE_EMU" "ENABLE_NETMAP_EMU")
 
@@ -379,6 +379,30 @@ macro(process_options)
     add_definitions(-DENABLE_DES_METRICS)
   endif()
 
+  if(${NS3_MTP})
+    # The shared reference counters and free lists must be thread-safe in
+    # every module, and in the programs which include their headers
+    add_definitions(-DNS3_MTP)
+  endif()
+
+  if(${NS3_REPLICATIONS})
+    if(${NS3_MTP})
+      message(
+        FATAL_ERROR
+          "NS3_REPLICATIONS and NS3_MTP can't be used together. Disable one of them."
+      )
+    endif()
+    # The simulator, the node and channel lists, the configuration and the
+    # random number seeds are thread-local, in every module
+    add_definitions(-DNS3_REPLICATIONS)
+  endif()
+
+  if(NOT ${NS3_BYTE_TAGS})
+    # The packets skip their byte-tag and metadata bookkeeping, in every
+    # module and in the programs which include packet.h
+    add_definitions(-DNS3_NO_BYTE_TAGS)
+  endif()
+
   if(${NS3_SANITIZE} AND ${NS3_SANITIZE_MEMORY})
     message(
       FATAL_ERROR
@@ -1188,6 +1212,10 @@ macro(process_options)
     list(REMOVE_ITEM libs_to_build mpi)
   endif()
 
+  if(NOT ${NS3_MTP})
+    list(REMOVE_ITEM libs_to_build mtp)
+  endif()
+
   if(NOT ${ENABLE_VISUALIZER})
     list(REMOVE_ITEM libs_to_build visualizer)
   endif()
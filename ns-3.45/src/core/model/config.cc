@@ -9,6 +9,7 @@
 
 #include "global-value.h"
 #include "log.h"
+#include "multithreading.h"
 #include "names.h"
 #include "object-ptr-container.h"
 #include "object.h"
@@ -631,6 +632,19 @@ Resolver::DoArrayResolve(std::string path, const ObjectPtrContainerValue& contai
 class ConfigImpl : public Singleton<ConfigImpl>
 {
   public:
+    /**
+     * Get the instance of the simulation: the roots belong to the
+     * simulation, e.g., the node list, and there is one instance per
+     * thread with the NS3_REPLICATIONS option.
+     *
+     * @return A pointer to the instance.
+     */
+    static ConfigImpl* Get()
+    {
+        static NS3_SIMULATION_LOCAL ConfigImpl object;
+        return &object;
+    }
+
     // Keep Set and SetFailSafe since their errors are triggered
     // by the underlying ObjectBase functions.
     /** @copydoc ns3::Config::Set() */
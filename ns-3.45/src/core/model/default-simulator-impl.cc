@@ -8,12 +8,19 @@
 
 #include "default-simulator-impl.h"
 
+#include "abort.h"
 #include "assert.h"
+#include "boolean.h"
+#include "event-profiler.h"
 #include "log.h"
 #include "scheduler.h"
 #include "simulator.h"
+#include "string.h"
+#include "uinteger.h"
 
 #include <cmath>
+#include <fstream>
+#include <iostream>
 
 /**
  * @file
@@ -34,10 +41,28 @@ NS_OBJECT_ENSURE_REGISTERED(DefaultSimulatorImpl);
 TypeId
 DefaultSimulatorImpl::GetTypeId()
 {
-    static TypeId tid = TypeId("ns3::DefaultSimulatorImpl")
-                            .SetParent<SimulatorImpl>()
-                            .SetGroupName("Core")
-                            .AddConstructor<DefaultSimulatorImpl>();
+    static TypeId tid =
+        TypeId("ns3::DefaultSimulatorImpl")
+            .SetParent<SimulatorImpl>()
+            .SetGroupName("Core")
+            .AddConstructor<DefaultSimulatorImpl>()
+            .AddAttribute("Profile",
+                          "Count the events, and measure their run time, by function and "
+                          "context, and print the profile at Simulator::Destroy().",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&DefaultSimulatorImpl::m_profile),
+                          MakeBooleanChecker())
+            .AddAttribute("ProfileSamplingPeriod",
+                          "When profiling, measure the run time of one event out of this "
+                          "many; all the events are counted.",
+                          UintegerValue(10),
+                          MakeUintegerAccessor(&DefaultSimulatorImpl::m_profileSamplingPeriod),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("ProfileFile",
+                          "The file to which the profile is written, std::clog if empty.",
+                          StringValue(""),
+                          MakeStringAccessor(&DefaultSimulatorImpl::m_profileFile),
+                          MakeStringChecker());
     return tid;
 }
 
@@ -51,8 +76,11 @@ DefaultSimulatorImpl::DefaultSimulatorImpl()
     m_currentContext = Simulator::NO_CONTEXT;
     m_unscheduledEvents = 0;
     m_eventCount = 0;
+    m_cancelledEventCount = 0;
     m_eventsWithContextEmpty = true;
     m_mainThreadId = std::this_thread::get_id();
+    m_profile = false;
+    m_profileSamplingPeriod = 10;
 }
 
 DefaultSimulatorImpl::~DefaultSimulatorImpl()
@@ -79,6 +107,20 @@ void
 DefaultSimulatorImpl::Destroy()
 {
     NS_LOG_FUNCTION(this);
+    if (m_profiler)
+    {
+        if (m_profileFile.empty())
+        {
+            m_profiler->Print(std::clog);
+        }
+        else
+        {
+            std::ofstream os(m_profileFile);
+            NS_ABORT_MSG_UNLESS(os, "Cannot open the profile file " << m_profileFile);
+            m_profiler->Print(os);
+        }
+        m_profiler.reset();
+    }
     while (!m_destroyEvents.empty())
     {
         Ptr<EventImpl> ev = m_destroyEvents.front().PeekEventImpl();
@@ -125,12 +167,23 @@ DefaultSimulatorImpl::ProcessOneEvent()
     NS_ASSERT(next.key.m_ts >= m_currentTs);
     m_unscheduledEvents--;
     m_eventCount++;
+    if (next.impl->IsCancelled())
+    {
+        m_cancelledEventCount++;
+    }
 
     NS_LOG_LOGIC("handle " << next.key.m_ts);
     m_currentTs = next.key.m_ts;
     m_currentContext = next.key.m_context;
     m_currentUid = next.key.m_uid;
-    next.impl->Invoke();
+    if (m_profiler)
+    {
+        m_profiler->Invoke(next.impl, next.key.m_context);
+    }
+    else
+    {
+        next.impl->Invoke();
+    }
     next.impl->Unref();
 
     ProcessEventsWithContext();
@@ -180,6 +233,10 @@ DefaultSimulatorImpl::Run()
     m_mainThreadId = std::this_thread::get_id();
     ProcessEventsWithContext();
     m_stop = false;
+    if (m_profile && !m_profiler)
+    {
+        m_profiler = std::make_unique<EventProfiler>(m_profileSamplingPeriod);
+    }
 
     while (!m_events->IsEmpty() && !m_stop)
     {
@@ -386,4 +443,16 @@ DefaultSimulatorImpl::GetEventCount() const
     return m_eventCount;
 }
 
+uint64_t
+DefaultSimulatorImpl::GetCancelledEventCount() const
+{
+    return m_cancelledEventCount;
+}
+
+uint64_t
+DefaultSimulatorImpl::GetPendingEventCount() const
+{
+    return m_unscheduledEvents;
+}
+
 } // namespace ns3
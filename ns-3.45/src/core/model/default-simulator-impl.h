@@ -12,7 +12,9 @@
 #include "simulator-impl.h"
 
 #include <list>
+#include <memory>
 #include <mutex>
+#include <string>
 #include <thread>
 
 /**
@@ -26,11 +28,17 @@ namespace ns3
 
 // Forward
 class Scheduler;
+class EventProfiler;
 
 /**
  * @ingroup simulator
  *
  * The default single process simulator implementation.
+ *
+ * When the Profile attribute is set, the events are counted, and their
+ * run time measured on a sample of them, by function and context, and the
+ * profile is written to std::clog, or to the ProfileFile, by
+ * Simulator::Destroy(); see EventProfiler.
  */
 class DefaultSimulatorImpl : public SimulatorImpl
 {
@@ -66,6 +74,8 @@ class DefaultSimulatorImpl : public SimulatorImpl
     uint32_t GetSystemId() const override;
     uint32_t GetContext() const override;
     uint64_t GetEventCount() const override;
+    uint64_t GetCancelledEventCount() const override;
+    uint64_t GetPendingEventCount() const override;
 
   private:
     void DoDispose() override;
@@ -117,6 +127,8 @@ class DefaultSimulatorImpl : public SimulatorImpl
     uint32_t m_currentContext;
     /** The event count. */
     uint64_t m_eventCount;
+    /** The count of the cancelled events removed from the event list. */
+    uint64_t m_cancelledEventCount;
     /**
      * Number of events that have been inserted but not yet scheduled,
      *  not counting the Destroy events; this is used for validation
@@ -125,6 +137,15 @@ class DefaultSimulatorImpl : public SimulatorImpl
 
     /** Main execution thread. */
     std::thread::id m_mainThreadId;
+
+    /** Whether to profile the events. */
+    bool m_profile;
+    /** Measure the run time of one event out of this many. */
+    uint32_t m_profileSamplingPeriod;
+    /** The file of the profile, std::clog if empty. */
+    std::string m_profileFile;
+    /** The profile of the events, if enabled. */
+    std::unique_ptr<EventProfiler> m_profiler;
 };
 
 } // namespace ns3
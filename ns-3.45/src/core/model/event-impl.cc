@@ -10,6 +10,8 @@
 
 #include "log.h"
 
+#include <new>
+
 /**
  * @file
  * @ingroup events
@@ -21,6 +23,147 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("EventImpl");
 
+namespace
+{
+
+/**
+ * @ingroup events
+ * Free lists of event blocks, by size class of 16 bytes.
+ *
+ * Each thread has its own pool, so that the events scheduled by other
+ * threads (e.g., by the file descriptor readers of the real time
+ * simulator, or by the logical processes of the multithreaded simulator)
+ * need no lock. The blocks are allocated from the global heap, so an
+ * event can be released to the pool of another thread.
+ */
+class EventPool
+{
+  public:
+    /** Destructor: release the free blocks to the heap. */
+    ~EventPool();
+
+    /**
+     * @param size the size of the event
+     * @returns the memory of the event
+     */
+    void* Allocate(std::size_t size);
+
+    /**
+     * @param p the memory of the event
+     * @param size the size of the event
+     */
+    void Deallocate(void* p, std::size_t size);
+
+    EventImpl::PoolStats m_stats{0, 0}; //!< Allocation counters
+
+  private:
+    /// A free block
+    struct Block
+    {
+        Block* next; //!< The next free block
+    };
+
+    static constexpr std::size_t GRANULARITY = 16; //!< Size step of the size classes
+    static constexpr std::size_t N_CLASSES = 16;   //!< Events up to 256 bytes are pooled
+    static constexpr uint32_t MAX_FREE = 65536;    //!< Maximum free blocks per class
+
+    /**
+     * @param size the size of an event
+     * @returns the size class of the event, N_CLASSES if it is not pooled
+     */
+    static std::size_t GetClass(std::size_t size)
+    {
+        std::size_t c = (size + GRANULARITY - 1) / GRANULARITY - 1;
+        return c < N_CLASSES ? c : N_CLASSES;
+    }
+
+    Block* m_free[N_CLASSES]{};    //!< The free blocks, by size class
+    uint32_t m_nFree[N_CLASSES]{}; //!< The number of free blocks, by size class
+};
+
+/// The event pool of the thread
+thread_local EventPool g_eventPool;
+/// The event pool of the thread was destroyed at the exit of the thread
+thread_local bool g_eventPoolDestroyed = false;
+
+EventPool::~EventPool()
+{
+    for (std::size_t c = 0; c < N_CLASSES; c++)
+    {
+        while (m_free[c])
+        {
+            Block* block = m_free[c];
+            m_free[c] = block->next;
+            ::operator delete(block);
+        }
+    }
+    g_eventPoolDestroyed = true;
+}
+
+void*
+EventPool::Allocate(std::size_t size)
+{
+    m_stats.allocations++;
+    std::size_t c = GetClass(size);
+    if (c < N_CLASSES && m_free[c])
+    {
+        Block* block = m_free[c];
+        m_free[c] = block->next;
+        m_nFree[c]--;
+        return block;
+    }
+    m_stats.heapAllocations++;
+    return ::operator new(c < N_CLASSES ? (c + 1) * GRANULARITY : size);
+}
+
+void
+EventPool::Deallocate(void* p, std::size_t size)
+{
+    std::size_t c = GetClass(size);
+    if (c == N_CLASSES || m_nFree[c] >= MAX_FREE)
+    {
+        ::operator delete(p);
+        return;
+    }
+    auto block = static_cast<Block*>(p);
+    block->next = m_free[c];
+    m_free[c] = block;
+    m_nFree[c]++;
+}
+
+} // namespace
+
+void*
+EventImpl::operator new(std::size_t size)
+{
+    if (g_eventPoolDestroyed)
+    {
+        return ::operator new(size);
+    }
+    return g_eventPool.Allocate(size);
+}
+
+void
+EventImpl::operator delete(void* p, std::size_t size)
+{
+    if (g_eventPoolDestroyed)
+    {
+        ::operator delete(p);
+        return;
+    }
+    g_eventPool.Deallocate(p, size);
+}
+
+EventImpl::PoolStats
+EventImpl::GetPoolStats()
+{
+    if (g_eventPoolDestroyed)
+    {
+        return PoolStats{0, 0};
+    }
+    return g_eventPool.m_stats;
+}
+
 EventImpl::~EventImpl()
 {
     NS_LOG_FUNCTION(this);
@@ -49,6 +192,13 @@ EventImpl::Cancel()
     m_cancel = true;
 }
 
+void
+EventImpl::Uncancel()
+{
+    NS_LOG_FUNCTION(this);
+    m_cancel = false;
+}
+
 bool
 EventImpl::IsCancelled()
 {
@@ -56,4 +206,10 @@ EventImpl::IsCancelled()
     return m_cancel;
 }
 
+const void*
+EventImpl::GetFunction() const
+{
+    return nullptr;
+}
+
 } // namespace ns3
@@ -10,6 +10,7 @@
 
 #include "simple-ref-count.h"
 
+#include <cstddef>
 #include <stdint.h>
 
 /**
@@ -49,6 +50,12 @@ class EventImpl : public SimpleRefCount<EventImpl>
      * before calling Invoke().
      */
     void Cancel();
+    /**
+     * Clears the 'canceled' mark of an event which is still in the event
+     * list, so that it runs after all, e.g., a ReschedulableTimer scheduled
+     * again after a cancellation.
+     */
+    void Uncancel();
     /**
      * @returns true if the event has been canceled.
      *
@@ -56,6 +63,54 @@ class EventImpl : public SimpleRefCount<EventImpl>
      */
     bool IsCancelled();
 
+    /**
+     * Get the address of the code run by this event, e.g., to profile the
+     * events.
+     *
+     * The events made by MakeEvent() return the function, the class
+     * method, or the call operator of the lambda; other events may return
+     * nullptr, in which case their type identifies them.
+     *
+     * @returns the address of the function, or nullptr if unknown
+     */
+    virtual const void* GetFunction() const;
+
+    /**
+     * @brief Allocation counters of the event pool of the calling thread.
+     *
+     * The event implementations are allocated from free lists, by size
+     * class, and recycled when their last reference is released; the
+     * counters tell how many allocations the pool could not serve.
+     */
+    struct PoolStats
+    {
+        uint64_t allocations;     //!< Number of events allocated
+        uint64_t heapAllocations; //!< Number of allocations served by the heap
+    };
+
+    /**
+     * @returns the allocation counters of the calling thread since its start
+     */
+    static PoolStats GetPoolStats();
+
+    /**
+     * Allocate an event from the pool of the calling thread.
+     * @param size the size of the event
+     * @returns the memory of the event
+     */
+    static void* operator new(std::size_t size);
+
+    /**
+     * Release an event to the pool of the calling thread.
+     *
+     * An event may be released by another thread than the one which
+     * allocated it; the pools hold blocks of the global heap.
+     *
+     * @param p the memory of the event
+     * @param size the size of the event
+     */
+    static void operator delete(void* p, std::size_t size);
+
   protected:
     /**
      * Implementation for Invoke().
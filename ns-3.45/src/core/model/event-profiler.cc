@@ -0,0 +1,229 @@
+//
+// SPDX-License-Identifier: GPL-2.0-only
+//
+
+#include "event-profiler.h"
+
+#include "assert.h"
+#include "demangle.h"
+#include "event-impl.h"
+#include "log.h"
+#include "simulator.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+#if __has_include(<dlfcn.h>)
+#include <dlfcn.h>
+#define NS3_EVENT_PROFILER_DLADDR
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/**
+ * @file
+ * @ingroup simulator
+ * ns3::EventProfiler implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("EventProfiler");
+
+EventProfiler::EventProfiler(uint32_t samplingPeriod)
+    : m_startCycles(ReadCycles()),
+      m_start(std::chrono::steady_clock::now()),
+      m_samplingPeriod(samplingPeriod)
+{
+    NS_LOG_FUNCTION(this << samplingPeriod);
+    NS_ASSERT_MSG(samplingPeriod > 0, "The sampling period must be at least 1");
+}
+
+uint64_t
+EventProfiler::ReadCycles()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return std::chrono::steady_clock::now().time_since_epoch().count();
+#endif
+}
+
+void
+EventProfiler::Invoke(EventImpl* event, uint32_t context)
+{
+    const void* function = event->GetFunction();
+    Site site{function ? function : &typeid(*event), context};
+    Counters& counters = m_sites[site];
+    if (counters.count == 0)
+    {
+        counters.type = &typeid(*event);
+        counters.known = function != nullptr;
+    }
+    counters.count++;
+
+    if (--counters.countdown > 0)
+    {
+        event->Invoke();
+        return;
+    }
+    counters.countdown = m_samplingPeriod;
+    uint64_t start = ReadCycles();
+    event->Invoke();
+    counters.cycles += ReadCycles() - start;
+    counters.sampled++;
+}
+
+std::string
+EventProfiler::GetName(const Site& site, const Counters& counters)
+{
+#ifdef NS3_EVENT_PROFILER_DLADDR
+    Dl_info info;
+    if (counters.known && dladdr(site.function, &info) && info.dli_sname)
+    {
+        std::string name = Demangle(info.dli_sname);
+        for (const std::string prefix : {"non-virtual thunk to ", "virtual thunk to "})
+        {
+            if (name.starts_with(prefix))
+            {
+                name.erase(0, prefix.size());
+            }
+        }
+        return name;
+    }
+#endif
+
+    // the events made by MakeEvent() are local classes of the function
+    // template: keep its first template argument, e.g., the lambda, and
+    // the address of the function, e.g., for addr2line
+    std::string name = Demangle(counters.type->name());
+    if (counters.known)
+    {
+        std::ostringstream address;
+        address << " [" << site.function << "]";
+        return TrimMakeEvent(name) + address.str();
+    }
+    return TrimMakeEvent(name);
+}
+
+std::string
+EventProfiler::TrimMakeEvent(const std::string& name)
+{
+    const std::string prefix = "ns3::MakeEvent<";
+    if (!name.starts_with(prefix))
+    {
+        return name;
+    }
+    int depth = 0;
+    for (std::size_t i = prefix.size(); i < name.size(); i++)
+    {
+        char c = name[i];
+        if (c == '<' || c == '(')
+        {
+            depth++;
+        }
+        else if ((c == '>' || c == ')') && depth > 0)
+        {
+            depth--;
+        }
+        else if ((c == ',' || c == '>') && depth == 0)
+        {
+            return name.substr(prefix.size(), i - prefix.size());
+        }
+    }
+    return name;
+}
+
+void
+EventProfiler::Print(std::ostream& os, std::size_t nContexts) const
+{
+    auto wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start).count();
+    uint64_t elapsed = ReadCycles() - m_startCycles;
+    double secondsPerCycle = elapsed ? wall / elapsed : 0;
+
+    // the sites, by function
+    typedef std::pair<Site, Counters> Entry;
+    std::vector<Entry> sites(m_sites.begin(), m_sites.end());
+    for (auto& [site, counters] : sites)
+    {
+        // estimate the run time of all the events from the events timed
+        double cycles = counters.cycles;
+        counters.cycles =
+            counters.sampled ? static_cast<uint64_t>(cycles * counters.count / counters.sampled)
+                             : 0;
+    }
+    std::unordered_map<const void*, Counters> byFunction;
+    uint64_t count = 0;
+    uint64_t cycles = 0;
+    for (const auto& [site, counters] : sites)
+    {
+        Counters& total = byFunction[site.function];
+        total.count += counters.count;
+        total.cycles += counters.cycles;
+        total.type = counters.type;
+        total.known = counters.known;
+        count += counters.count;
+        cycles += counters.cycles;
+    }
+    std::vector<Entry> functions;
+    for (const auto& [function, counters] : byFunction)
+    {
+        functions.emplace_back(Site{function, Simulator::NO_CONTEXT}, counters);
+    }
+    auto byCycles = [](const Entry& a, const Entry& b) {
+        return a.second.cycles > b.second.cycles;
+    };
+    std::sort(functions.begin(), functions.end(), byCycles);
+    std::sort(sites.begin(), sites.end(), byCycles);
+
+    auto printLine = [&](const Entry& entry, bool context) {
+        const Counters& counters = entry.second;
+        os << std::setw(12) << counters.count << std::setw(8) << std::fixed
+           << std::setprecision(2) << (cycles ? 100.0 * counters.cycles / cycles : 0)
+           << std::setw(12) << std::setprecision(6) << counters.cycles * secondsPerCycle
+           << std::setw(12) << std::setprecision(1)
+           << counters.cycles * secondsPerCycle * 1e9 / counters.count;
+        if (context)
+        {
+            os << std::setw(9);
+            if (entry.first.context == Simulator::NO_CONTEXT)
+            {
+                os << "-";
+            }
+            else
+            {
+                os << entry.first.context;
+            }
+        }
+        os << "  " << GetName(entry.first, counters) << std::endl;
+    };
+
+    std::ios_base::fmtflags flags = os.flags();
+    std::streamsize precision = os.precision();
+    os << "Event profile: " << count << " events, " << cycles * secondsPerCycle
+       << " s in the events, " << wall << " s of wall clock time" << std::endl;
+    os << std::setw(12) << "Events" << std::setw(8) << "%Time" << std::setw(12) << "Time (s)"
+       << std::setw(12) << "ns/event"
+       << "  Function" << std::endl;
+    for (const auto& entry : functions)
+    {
+        printLine(entry, false);
+    }
+    os << std::endl << "By function and context:" << std::endl;
+    os << std::setw(12) << "Events" << std::setw(8) << "%Time" << std::setw(12) << "Time (s)"
+       << std::setw(12) << "ns/event" << std::setw(9) << "Context"
+       << "  Function" << std::endl;
+    for (std::size_t i = 0; i < sites.size() && i < nContexts; i++)
+    {
+        printLine(sites[i], true);
+    }
+    os.flags(flags);
+    os.precision(precision);
+}
+
+} // namespace ns3
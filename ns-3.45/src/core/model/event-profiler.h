@@ -0,0 +1,141 @@
+//
+// SPDX-License-Identifier: GPL-2.0-only
+//
+
+#ifndef EVENT_PROFILER_H
+#define EVENT_PROFILER_H
+
+#include <chrono>
+#include <ostream>
+#include <stdint.h>
+#include <string>
+#include <typeinfo>
+#include <unordered_map>
+
+/**
+ * @file
+ * @ingroup simulator
+ * ns3::EventProfiler declaration.
+ */
+
+namespace ns3
+{
+
+class EventImpl;
+
+/**
+ * @ingroup simulator
+ * @brief Count the events, and their run time, by function and context.
+ *
+ * The simulator implementations invoke the events through Invoke() when
+ * profiling. The events are identified by EventImpl::GetFunction(), or by
+ * their type when the function is unknown, and by their context, e.g.,
+ * the node. The run time is measured with the time stamp counter of the
+ * processor, where available, and converted to seconds with the wall
+ * clock time since the start of the profile.
+ *
+ * Every event is counted, but only one event of a site in a sampling
+ * period is timed, starting with its first event: the run time of a site
+ * is estimated from its timed events. Each site has its own countdown, so
+ * that the events of a site which recur with the sampling period, e.g.,
+ * a periodic timer among the same packet events, are not timed always or
+ * never.
+ *
+ * Print() names the functions with their symbols, demangled; the
+ * functions without a public symbol, e.g., most lambdas, are named by the
+ * type of the lambda, or the signature of the class method.
+ */
+class EventProfiler
+{
+  public:
+    /**
+     * Constructor: start the profile.
+     *
+     * @param [in] samplingPeriod Time one event out of samplingPeriod.
+     */
+    EventProfiler(uint32_t samplingPeriod = 1);
+
+    /**
+     * Invoke an event, and account for its run time.
+     *
+     * @param [in] event The event.
+     * @param [in] context The context of the event.
+     */
+    void Invoke(EventImpl* event, uint32_t context);
+
+    /**
+     * Print the profile: the functions sorted by decreasing run time, then
+     * the functions and contexts with the largest run time.
+     *
+     * @param [in,out] os The output stream.
+     * @param [in] nContexts The number of lines by function and context.
+     */
+    void Print(std::ostream& os, std::size_t nContexts = 20) const;
+
+  private:
+    /** The key of the counters: the function and the context. */
+    struct Site
+    {
+        const void* function; //!< The function, or the type of the event if unknown
+        uint32_t context;     //!< The context
+
+        /**
+         * @param [in] other Another site.
+         * @returns true if the sites are the same.
+         */
+        bool operator==(const Site& other) const
+        {
+            return function == other.function && context == other.context;
+        }
+    };
+
+    /** Hash of a Site. */
+    struct SiteHash
+    {
+        /**
+         * @param [in] site The site.
+         * @returns The hash of the site.
+         */
+        std::size_t operator()(const Site& site) const
+        {
+            return std::hash<const void*>()(site.function) ^ (site.context * 0x9e3779b9U);
+        }
+    };
+
+    /** The counters of a site. */
+    struct Counters
+    {
+        uint64_t count{0};                   //!< Number of events
+        uint64_t sampled{0};                 //!< Number of events timed
+        uint64_t cycles{0};                  //!< Run time of the events timed, in cycles
+        const std::type_info* type{nullptr}; //!< Type of the first event
+        bool known{false};                   //!< Whether the function is known
+        uint32_t countdown{1};               //!< Events until the next timed one
+    };
+
+    /**
+     * @param [in] site A site.
+     * @param [in] counters Its counters.
+     * @returns The name of the function of the site.
+     */
+    static std::string GetName(const Site& site, const Counters& counters);
+
+    /**
+     * @param [in] name The name of the type of an event.
+     * @returns The first template argument of MakeEvent(), if the event
+     *          was made by MakeEvent(), or the name.
+     */
+    static std::string TrimMakeEvent(const std::string& name);
+
+    /** @returns The current value of the cycle counter. */
+    static uint64_t ReadCycles();
+
+    std::unordered_map<Site, Counters, SiteHash> m_sites; //!< The counters by site
+    uint64_t m_startCycles;                               //!< Cycle counter at the start
+    std::chrono::steady_clock::time_point m_start;        //!< Time of the start
+    uint32_t m_samplingPeriod;                            //!< Time one event out of this many
+};
+
+} // namespace ns3
+
+#endif /* EVENT_PROFILER_H */
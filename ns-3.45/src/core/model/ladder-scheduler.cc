@@ -0,0 +1,278 @@
+//
+// SPDX-License-Identifier: GPL-2.0-only
+//
+
+#include "ladder-scheduler.h"
+
+#include "assert.h"
+#include "event-impl.h"
+#include "log.h"
+#include "uinteger.h"
+
+#include <algorithm>
+#include <limits>
+
+/**
+ * @file
+ * @ingroup scheduler
+ * ns3::LadderScheduler implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("LadderScheduler");
+
+NS_OBJECT_ENSURE_REGISTERED(LadderScheduler);
+
+TypeId
+LadderScheduler::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::LadderScheduler")
+            .SetParent<Scheduler>()
+            .SetGroupName("Core")
+            .AddConstructor<LadderScheduler>()
+            .AddAttribute("Threshold",
+                          "Maximum number of events of a bucket which are sorted at once; "
+                          "larger buckets are spread on a new rung.",
+                          UintegerValue(50),
+                          MakeUintegerAccessor(&LadderScheduler::m_threshold),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("MaxRungs",
+                          "Maximum number of rungs of the ladder.",
+                          UintegerValue(8),
+                          MakeUintegerAccessor(&LadderScheduler::m_maxRungs),
+                          MakeUintegerChecker<uint32_t>(1));
+    return tid;
+}
+
+LadderScheduler::LadderScheduler()
+    : m_threshold(50),
+      m_maxRungs(8),
+      m_topStart(0),
+      m_topMin(std::numeric_limits<uint64_t>::max()),
+      m_topMax(0),
+      m_nRungs(0),
+      m_bottomHead(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+LadderScheduler::~LadderScheduler()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+uint64_t
+LadderScheduler::CurrentStart(const Rung& rung)
+{
+    return rung.start + rung.current * rung.width;
+}
+
+std::size_t
+LadderScheduler::FindRung(uint64_t ts) const
+{
+    if (ts >= m_topStart)
+    {
+        return m_nRungs + 1;
+    }
+    for (std::size_t i = 0; i < m_nRungs; i++)
+    {
+        if (ts >= CurrentStart(m_rungs[i]))
+        {
+            return i;
+        }
+    }
+    return m_nRungs;
+}
+
+void
+LadderScheduler::Spread(uint64_t start, uint64_t span, Events& events)
+{
+    NS_LOG_FUNCTION(this << start << span << events.size());
+    if (m_rungs.size() <= m_nRungs)
+    {
+        m_rungs.resize(m_nRungs + 1);
+    }
+    Rung& rung = m_rungs[m_nRungs];
+    m_nRungs++;
+
+    // one bucket per event on average: the events are spread again, or
+    // sorted, when they reach the bottom
+    uint64_t n = events.size();
+    rung.start = start;
+    rung.width = std::max<uint64_t>(1, (span + n - 1) / n);
+    rung.nBuckets = (span + rung.width - 1) / rung.width;
+    rung.current = 0;
+    rung.count = n;
+    // the buckets of a rung which is not in use are all empty
+    if (rung.buckets.size() < rung.nBuckets)
+    {
+        rung.buckets.resize(rung.nBuckets);
+    }
+    for (const auto& ev : events)
+    {
+        NS_ASSERT(ev.key.m_ts >= start && ev.key.m_ts - start < span);
+        rung.buckets[(ev.key.m_ts - start) / rung.width].push_back(ev);
+    }
+    events.clear();
+}
+
+void
+LadderScheduler::Refill()
+{
+    while (m_bottomHead == m_bottom.size())
+    {
+        m_bottom.clear();
+        m_bottomHead = 0;
+        if (m_nRungs == 0)
+        {
+            if (m_top.empty())
+            {
+                return;
+            }
+            Spread(m_topMin, m_topMax - m_topMin + 1, m_top);
+            m_topStart = m_rungs[0].start + m_rungs[0].nBuckets * m_rungs[0].width;
+            m_topMin = std::numeric_limits<uint64_t>::max();
+            m_topMax = 0;
+        }
+
+        std::size_t r = m_nRungs - 1;
+        Rung& rung = m_rungs[r];
+        if (rung.count == 0)
+        {
+            m_nRungs--;
+            continue;
+        }
+        while (rung.buckets[rung.current].empty())
+        {
+            rung.current++;
+        }
+        std::size_t b = rung.current;
+        uint64_t start = CurrentStart(rung);
+        uint64_t width = rung.width;
+        rung.current++;
+        rung.count -= rung.buckets[b].size();
+
+        if (rung.buckets[b].size() > m_threshold && width > 1 && m_nRungs < m_maxRungs)
+        {
+            // Spread() may move the rungs: it works on a local vector,
+            // whose capacity is then given back to the bucket
+            Events events;
+            events.swap(m_rungs[r].buckets[b]);
+            Spread(start, width, events);
+            m_rungs[r].buckets[b].swap(events);
+        }
+        else
+        {
+            m_bottom.swap(rung.buckets[b]);
+            std::sort(m_bottom.begin(), m_bottom.end());
+        }
+    }
+}
+
+void
+LadderScheduler::InsertBottom(const Scheduler::Event& ev)
+{
+    auto it = std::upper_bound(m_bottom.begin() + m_bottomHead, m_bottom.end(), ev);
+    m_bottom.insert(it, ev);
+
+    if (m_bottom.size() - m_bottomHead > m_threshold && m_nRungs < m_maxRungs &&
+        m_bottom[m_bottomHead].key.m_ts != m_bottom.back().key.m_ts)
+    {
+        // many events at a short delay: spread them between the next event
+        // and the start of the ladder
+        uint64_t end = m_nRungs ? CurrentStart(m_rungs[m_nRungs - 1]) : m_topStart;
+        m_bottom.erase(m_bottom.begin(), m_bottom.begin() + m_bottomHead);
+        m_bottomHead = 0;
+        uint64_t start = m_bottom.front().key.m_ts;
+        Spread(start, end - start, m_bottom);
+        Refill();
+    }
+}
+
+void
+LadderScheduler::Insert(const Scheduler::Event& ev)
+{
+    NS_LOG_FUNCTION(this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+    std::size_t r = FindRung(ev.key.m_ts);
+    if (r > m_nRungs)
+    {
+        m_top.push_back(ev);
+        m_topMin = std::min(m_topMin, ev.key.m_ts);
+        m_topMax = std::max(m_topMax, ev.key.m_ts);
+    }
+    else if (r < m_nRungs)
+    {
+        Rung& rung = m_rungs[r];
+        rung.buckets[(ev.key.m_ts - rung.start) / rung.width].push_back(ev);
+        rung.count++;
+    }
+    else
+    {
+        InsertBottom(ev);
+    }
+    // the bottom is empty only if the scheduler was empty
+    Refill();
+}
+
+bool
+LadderScheduler::IsEmpty() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_bottomHead == m_bottom.size();
+}
+
+Scheduler::Event
+LadderScheduler::PeekNext() const
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(!IsEmpty());
+    return m_bottom[m_bottomHead];
+}
+
+Scheduler::Event
+LadderScheduler::RemoveNext()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(!IsEmpty());
+    Scheduler::Event ev = m_bottom[m_bottomHead];
+    m_bottomHead++;
+    Refill();
+    return ev;
+}
+
+void
+LadderScheduler::Remove(const Scheduler::Event& ev)
+{
+    NS_LOG_FUNCTION(this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+    auto sameUid = [&ev](const Scheduler::Event& e) { return e.key.m_uid == ev.key.m_uid; };
+    std::size_t r = FindRung(ev.key.m_ts);
+    if (r > m_nRungs)
+    {
+        auto it = std::find_if(m_top.begin(), m_top.end(), sameUid);
+        NS_ASSERT_MSG(it != m_top.end(), "Event not found");
+        *it = m_top.back();
+        m_top.pop_back();
+    }
+    else if (r < m_nRungs)
+    {
+        Rung& rung = m_rungs[r];
+        Events& bucket = rung.buckets[(ev.key.m_ts - rung.start) / rung.width];
+        auto it = std::find_if(bucket.begin(), bucket.end(), sameUid);
+        NS_ASSERT_MSG(it != bucket.end(), "Event not found");
+        *it = bucket.back();
+        bucket.pop_back();
+        rung.count--;
+    }
+    else
+    {
+        auto it = std::lower_bound(m_bottom.begin() + m_bottomHead, m_bottom.end(), ev);
+        NS_ASSERT_MSG(it != m_bottom.end() && sameUid(*it), "Event not found");
+        m_bottom.erase(it);
+    }
+    Refill();
+}
+
+} // namespace ns3
@@ -0,0 +1,155 @@
+//
+// SPDX-License-Identifier: GPL-2.0-only
+//
+
+#ifndef LADDER_SCHEDULER_H
+#define LADDER_SCHEDULER_H
+
+#include "scheduler.h"
+
+#include <stdint.h>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup scheduler
+ * ns3::LadderScheduler declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * @ingroup scheduler
+ * @brief a ladder queue event scheduler
+ *
+ * This is the Ladder Queue of W. T. Tang, R. S. M. Goh and I. L.-J. Thng,
+ * "Ladder Queue: An O(1) priority queue structure for large-scale discrete
+ * event simulation", ACM TOMACS 15(3), 2005. The events are kept in three
+ * tiers:
+ *
+ *  - Top: an unsorted vector of the events later than the range of the
+ *    ladder, e.g., the retransmission timers and the application stop
+ *    events of a network simulation.
+ *  - Ladder: rungs of buckets. When the ladder is empty, the top is spread
+ *    on a first rung whose bucket width is the average interval between its
+ *    events. When the next bucket holds more than Threshold events, it is
+ *    spread on a finer rung instead of being sorted, up to MaxRungs rungs.
+ *  - Bottom: a short sorted vector of the next events, which comes from
+ *    the next bucket of the last rung.
+ *
+ * Unlike the CalendarScheduler, the bucket widths adapt to the events when
+ * they reach the ladder, so that the scheduler never resizes all its
+ * buckets at once: each event is moved at most MaxRungs + 1 times. The many
+ * events scheduled at a short delay (e.g., a transmission time) are sorted
+ * in the bottom, which is spread on a new rung if it grows beyond Threshold.
+ * All the containers keep their capacity, so that a steady simulation does
+ * not allocate memory.
+ *
+ * @par Time Complexity
+ *
+ * Operation    | Amortized %Time | Reason
+ * :----------- | :-------------- | :-----
+ * Insert()     | Constant        | Unsorted top, or bucket, or short bottom
+ * IsEmpty()    | Constant        | Explicit queue size
+ * PeekNext()   | Constant        | The bottom is kept not empty
+ * Remove()     | Linear          | Search in the top or a bucket
+ * RemoveNext() | Constant        | Each event is spread at most MaxRungs times
+ *
+ * @par Memory Complexity
+ *
+ * Category  | Memory                              | Reason
+ * :-------- | :---------------------------------- | :-----
+ * Overhead  | 24 bytes per bucket, 168 + 56/rung  | `std::vector` per bucket
+ * Per Event | 0                                   | Events stored in `std::vector` directly
+ */
+class LadderScheduler : public Scheduler
+{
+  public:
+    /**
+     *  Register this type.
+     *  @return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    /** Constructor. */
+    LadderScheduler();
+    /** Destructor. */
+    ~LadderScheduler() override;
+
+    // Inherited
+    void Insert(const Scheduler::Event& ev) override;
+    bool IsEmpty() const override;
+    Scheduler::Event PeekNext() const override;
+    Scheduler::Event RemoveNext() override;
+    void Remove(const Scheduler::Event& ev) override;
+
+  private:
+    /** Container type for the events of a tier or a bucket. */
+    typedef std::vector<Scheduler::Event> Events;
+
+    /** A rung of the ladder: buckets of events of equal time width. */
+    struct Rung
+    {
+        uint64_t start;              //!< Timestamp of the start of the first bucket
+        uint64_t width;              //!< Bucket width
+        std::size_t nBuckets;        //!< Number of buckets in use
+        std::size_t current;         //!< Index of the next bucket to move down
+        std::size_t count;           //!< Number of events in the buckets
+        std::vector<Events> buckets; //!< The buckets (may be more than nBuckets)
+    };
+
+    /**
+     * @param [in] rung A rung.
+     * @returns The start of the next bucket of the rung.
+     */
+    static uint64_t CurrentStart(const Rung& rung);
+
+    /**
+     * Spread events on a new rung.
+     *
+     * @param [in] start The start of the range of the rung.
+     * @param [in] span The width of the range of the rung.
+     * @param [in,out] events The events, all in the range; emptied.
+     */
+    void Spread(uint64_t start, uint64_t span, Events& events);
+
+    /**
+     * Move the next events to the bottom, if it is empty.
+     */
+    void Refill();
+
+    /**
+     * Insert an event in the sorted bottom.
+     *
+     * @param [in] ev The event.
+     */
+    void InsertBottom(const Scheduler::Event& ev);
+
+    /**
+     * Find the rung whose range covers a timestamp.
+     *
+     * @param [in] ts The timestamp.
+     * @returns The index of the rung, m_nRungs if the timestamp is before the
+     *          ladder, or m_nRungs + 1 if it is after.
+     */
+    std::size_t FindRung(uint64_t ts) const;
+
+    uint32_t m_threshold; //!< Maximum number of events of a bucket sorted at once
+    uint32_t m_maxRungs;  //!< Maximum number of rungs
+
+    Events m_top;        //!< The events after the ladder, unsorted
+    uint64_t m_topStart; //!< Start of the range of the top
+    uint64_t m_topMin;   //!< Smallest timestamp of the top
+    uint64_t m_topMax;   //!< Largest timestamp of the top
+
+    std::vector<Rung> m_rungs; //!< The rungs (may be more than m_nRungs)
+    std::size_t m_nRungs;      //!< Number of rungs in use
+
+    Events m_bottom;          //!< The next events, sorted from m_bottomHead
+    std::size_t m_bottomHead; //!< Index of the next event in m_bottom
+};
+
+} // namespace ns3
+
+#endif /* LADDER_SCHEDULER_H */
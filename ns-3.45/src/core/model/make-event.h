@@ -10,7 +10,10 @@
 
 #include "warnings.h"
 
+#include <cstdint>
+#include <cstring>
 #include <functional>
+#include <memory>
 #include <tuple>
 #include <type_traits>
 
@@ -126,6 +129,98 @@ struct EventMemberImplObjTraits<T*>
     }
 };
 
+/**
+ * @ingroup events
+ * Helper for EventImpl::GetFunction(): the class of a class method.
+ *
+ * This is the generic template declaration (with empty body).
+ *
+ * @tparam MEM \explicit The class method function signature.
+ */
+template <typename MEM>
+struct MemberClass
+{
+};
+
+/**
+ * @ingroup events
+ * Helper for EventImpl::GetFunction(): the class of a class method.
+ *
+ * This is the specialization for pointers to members.
+ *
+ * @tparam R \explicit The type of the member.
+ * @tparam C \explicit The class.
+ */
+template <typename R, typename C>
+struct MemberClass<R C::*>
+{
+    typedef C Type; //!< The class
+};
+
+/**
+ * @ingroup events
+ * Helper for EventImpl::GetFunction() of the events which call a class
+ * method, or the call operator of a lambda.
+ *
+ * With the Itanium C++ ABI (GCC and Clang), this decodes the pointer to
+ * member function: the address of the function, or the offset in the
+ * virtual table plus one for a virtual method, which is looked up in the
+ * virtual table of the object. The ARM variant of the ABI flags the
+ * virtual methods in the adjustment instead. With another ABI, the layout
+ * is unknown: the first word of the pointer to member function is
+ * returned as is, e.g., the address of the function or of a thunk, and
+ * the profiler prints it as an address if it has no symbol.
+ *
+ * @tparam MEM \deduced The class method function signature.
+ * @param [in] mem The class method.
+ * @param [in] obj The address of the object, to find a virtual method,
+ *                 or nullptr.
+ * @returns The address of the method, or nullptr if unknown.
+ */
+template <typename MEM>
+const void*
+GetMemberFunction(MEM mem, const void* obj)
+{
+    if constexpr (std::is_member_function_pointer_v<MEM> && sizeof(MEM) >= sizeof(void*))
+    {
+#ifdef __GXX_ABI_VERSION
+        if constexpr (sizeof(MEM) == 2 * sizeof(void*))
+        {
+            struct
+            {
+                uintptr_t ptr;
+                ptrdiff_t adj;
+            } rep;
+
+            std::memcpy(&rep, &mem, sizeof(rep));
+#if defined(__arm__) || defined(__aarch64__)
+            bool isVirtual = (rep.adj & 1) != 0;
+            uintptr_t offset = rep.ptr;
+            rep.adj >>= 1;
+#else
+            bool isVirtual = (rep.ptr & 1) != 0;
+            uintptr_t offset = rep.ptr - 1;
+#endif
+            if (!isVirtual)
+            {
+                return reinterpret_cast<const void*>(rep.ptr);
+            }
+            if (obj != nullptr)
+            {
+                auto self = static_cast<const char*>(obj) + rep.adj;
+                auto vtable = *reinterpret_cast<const char* const*>(self);
+                return *reinterpret_cast<const void* const*>(vtable + offset);
+            }
+        }
+#else
+        const void* raw;
+        std::memcpy(&raw, &mem, sizeof(raw));
+        return raw;
+#endif
+    }
+    return nullptr;
+}
+
 } // namespace internal
 
 template <typename MEM, typename OBJ, typename... Ts>
@@ -138,10 +233,24 @@ MakeEvent(MEM mem_ptr, OBJ obj, Ts... args)
         EventMemberImpl() = delete;
 
         EventMemberImpl(OBJ obj, MEM function, Ts... args)
-            : m_function(std::bind(function, obj, args...))
+            : m_obj(obj),
+              m_function(function),
+              m_arguments(args...)
         {
         }
 
+        const void* GetFunction() const override
+        {
+            // the address of the object, as the class of the method
+            typedef typename internal::MemberClass<MEM>::Type Class;
+            const void* object = nullptr;
+            if constexpr (requires { static_cast<const Class*>(std::addressof(*m_obj)); })
+            {
+                object = static_cast<const Class*>(std::addressof(*m_obj));
+            }
+            return internal::GetMemberFunction(m_function, object);
+        }
+
       protected:
         ~EventMemberImpl() override
         {
@@ -150,10 +259,13 @@ MakeEvent(MEM mem_ptr, OBJ obj, Ts... args)
       private:
         void Notify() override
         {
-            m_function();
+            std::apply([this](auto&... args) { std::invoke(m_function, m_obj, args...); },
+                       m_arguments);
         }
 
-        std::function<void()> m_function;
+        OBJ m_obj;
+        MEM m_function;
+        std::tuple<std::remove_reference_t<Ts>...> m_arguments;
     }* ev = new EventMemberImpl(obj, mem_ptr, args...);
 
     return ev;
@@ -172,6 +284,11 @@ MakeEvent(void (*f)(Us...), Ts... args)
         {
         }
 
+        const void* GetFunction() const override
+        {
+            return reinterpret_cast<const void*>(m_function);
+        }
+
       protected:
         ~EventFunctionImpl() override
         {
@@ -206,6 +323,15 @@ MakeEvent(T function)
         {
         }
 
+        const void* GetFunction() const override
+        {
+            if constexpr (requires { &T::operator(); })
+            {
+                return internal::GetMemberFunction(&T::operator(), nullptr);
+            }
+            return nullptr;
+        }
+
       private:
         void Notify() override
         {
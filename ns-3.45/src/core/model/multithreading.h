@@ -0,0 +1,79 @@
+//
+// SPDX-License-Identifier: GPL-2.0-only
+//
+
+#ifndef NS3_MULTITHREADING_H
+#define NS3_MULTITHREADING_H
+
+#include <stdint.h>
+
+#ifdef NS3_MTP
+#include <atomic>
+#endif
+
+/**
+ * @file
+ * @ingroup core
+ * Definitions that make the state shared by the simulated objects safe to
+ * use from several threads in the builds with multithreaded simulation
+ * support (the NS3_MTP option), or with one simulation per thread (the
+ * NS3_REPLICATIONS option), at no cost in the other builds.
+ */
+
+#if defined(NS3_MTP) && defined(NS3_REPLICATIONS)
+#error "NS3_MTP and NS3_REPLICATIONS are exclusive"
+#endif
+
+#if defined(NS3_MTP) || defined(NS3_REPLICATIONS)
+/**
+ * @ingroup core
+ * Defined in the builds where the simulated objects are used by several
+ * threads.
+ */
+#define NS3_MULTITHREADED
+#endif
+
+#ifdef NS3_MULTITHREADED
+/**
+ * @ingroup core
+ * Declare a static variable with one instance per thread in the builds
+ * where the simulated objects are used by several threads, e.g., a free
+ * list.
+ */
+#define NS3_THREAD_LOCAL thread_local
+#else
+#define NS3_THREAD_LOCAL
+#endif
+
+#ifdef NS3_REPLICATIONS
+/**
+ * @ingroup core
+ * Declare a static variable which belongs to the simulation, e.g., the
+ * simulator or the node list: in the builds with one simulation per
+ * thread, each thread has its own instance.
+ */
+#define NS3_SIMULATION_LOCAL thread_local
+#else
+#define NS3_SIMULATION_LOCAL
+#endif
+
+namespace ns3
+{
+
+/**
+ * @ingroup core
+ * The type of the reference counters of the objects that may be shared by
+ * several threads in the builds with multithreaded simulation support.
+ *
+ * A counter is decremented and tested in a single expression, e.g.,
+ * `if (--count == 0)`, so that exactly one thread sees it reach zero.
+ */
+#ifdef NS3_MTP
+using RefCounter = std::atomic<uint32_t>;
+#else
+using RefCounter = uint32_t;
+#endif
+
+} // namespace ns3
+
+#endif /* NS3_MULTITHREADING_H */
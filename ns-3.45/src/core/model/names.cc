@@ -9,6 +9,7 @@
 #include "abort.h"
 #include "assert.h"
 #include "log.h"
+#include "multithreading.h"
 #include "object.h"
 #include "singleton.h"
 
@@ -120,6 +121,18 @@ class NamesPriv : public Singleton<NamesPriv>
     /** Destructor. */
     ~NamesPriv() override;
 
+    /**
+     * Get the instance of the simulation: there is one instance per thread
+     * with the NS3_REPLICATIONS option.
+     *
+     * @return A pointer to the instance.
+     */
+    static NamesPriv* Get()
+    {
+        static NS3_SIMULATION_LOCAL NamesPriv object;
+        return &object;
+    }
+
     // Doxygen \copydoc bug: won't copy these docs, so we repeat them.
 
     /**
@@ -461,6 +461,20 @@ class Time
      */
     static Unit GetResolution();
 
+    /**
+     * Get the number of time steps in one second, for integer conversions
+     * of rates, e.g., in DataRate.
+     *
+     * @returns The number of time steps in one second at the current
+     *          resolution, which must be at most one second.
+     */
+    inline static int64_t GetStepsPerSecond()
+    {
+        Information* info = PeekInformation(Time::S);
+        NS_ASSERT_MSG(info->fromMul, "The resolution is coarser than one second.");
+        return info->factor;
+    }
+
     /**
      * Create a Time in the current unit.
      *
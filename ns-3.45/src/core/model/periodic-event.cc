@@ -0,0 +1,130 @@
+//
+// SPDX-License-Identifier: GPL-2.0-only
+//
+
+#include "periodic-event.h"
+
+#include "event-impl.h"
+#include "log.h"
+#include "simulator.h"
+
+#include <functional>
+
+/**
+ * @file
+ * @ingroup timer
+ * ns3::PeriodicEvent implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("PeriodicEvent");
+
+namespace
+{
+
+/**
+ * @ingroup timer
+ * The event of a PeriodicEvent.
+ */
+class PeriodicEventImpl : public EventImpl
+{
+  public:
+    /**
+     * Constructor.
+     * @param [in] expire The function which schedules the event again.
+     */
+    PeriodicEventImpl(std::function<void()> expire)
+        : m_expire(expire)
+    {
+    }
+
+  protected:
+    ~PeriodicEventImpl() override
+    {
+    }
+
+  private:
+    void Notify() override
+    {
+        m_expire();
+    }
+
+    std::function<void()> m_expire; //!< The function which schedules the event again
+};
+
+} // namespace
+
+PeriodicEvent::PeriodicEvent()
+    : m_impl(nullptr),
+      m_period(),
+      m_event(nullptr),
+      m_id()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+PeriodicEvent::~PeriodicEvent()
+{
+    NS_LOG_FUNCTION(this);
+    Stop();
+    delete m_impl;
+}
+
+void
+PeriodicEvent::SetPeriod(const Time& period)
+{
+    NS_LOG_FUNCTION(this << period);
+    NS_ASSERT_MSG(period.IsStrictlyPositive(), "The period must be strictly positive");
+    m_period = period;
+}
+
+Time
+PeriodicEvent::GetPeriod() const
+{
+    return m_period;
+}
+
+void
+PeriodicEvent::Start()
+{
+    Start(m_period);
+}
+
+void
+PeriodicEvent::Start(const Time& delay)
+{
+    NS_LOG_FUNCTION(this << delay);
+    NS_ASSERT_MSG(m_impl != nullptr, "The function of the PeriodicEvent is not set");
+    NS_ASSERT_MSG(m_period.IsStrictlyPositive(), "The period of the PeriodicEvent is not set");
+    Stop();
+    // a cancelled event cannot be run again: each start needs a new one
+    m_event = Create<PeriodicEventImpl>([this]() { Expire(); });
+    m_id = Simulator::Schedule(delay, m_event);
+}
+
+void
+PeriodicEvent::Stop()
+{
+    NS_LOG_FUNCTION(this);
+    m_id.Cancel();
+    m_event = nullptr;
+}
+
+bool
+PeriodicEvent::IsRunning() const
+{
+    return m_id.IsPending();
+}
+
+void
+PeriodicEvent::Expire()
+{
+    NS_LOG_FUNCTION(this);
+    // scheduled before the function is invoked, so that it can call Stop()
+    m_id = Simulator::Schedule(m_period, m_event);
+    m_impl->Invoke();
+}
+
+} // namespace ns3
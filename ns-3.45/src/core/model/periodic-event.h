@@ -0,0 +1,178 @@
+//
+// SPDX-License-Identifier: GPL-2.0-only
+//
+
+#ifndef PERIODIC_EVENT_H
+#define PERIODIC_EVENT_H
+
+#include "event-id.h"
+#include "nstime.h"
+#include "ptr.h"
+
+/**
+ * @file
+ * @ingroup timer
+ * ns3::PeriodicEvent declaration.
+ */
+
+namespace ns3
+{
+
+class EventImpl;
+
+namespace internal
+{
+
+class TimerImpl;
+
+} // namespace internal
+
+/**
+ * @ingroup timer
+ * @brief A function invoked periodically in virtual time.
+ *
+ * The event is scheduled once per period, when the previous one runs,
+ * and reuses the same EventImpl: unlike a function which schedules
+ * itself, or a loop which schedules all the periods in advance, it
+ * neither allocates an event per period nor fills the event list. It
+ * runs in the context in which it was started.
+ *
+ * The function may call Stop(), e.g., after a number of periods, or
+ * SetPeriod(), which applies to the next period.
+ *
+ * @code
+ *   PeriodicEvent sampler;
+ *   sampler.SetFunction(&RecordQueues);
+ *   sampler.SetPeriod(MilliSeconds(1));
+ *   sampler.Start(Seconds(0.1));
+ * @endcode
+ */
+class PeriodicEvent
+{
+  public:
+    /** Constructor. */
+    PeriodicEvent();
+    /** Destructor: stop the event. */
+    ~PeriodicEvent();
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    PeriodicEvent(const PeriodicEvent&) = delete;
+    PeriodicEvent& operator=(const PeriodicEvent&) = delete;
+
+    /**
+     * Set the function to invoke periodically.
+     *
+     * @tparam FN \deduced The type of the function.
+     * @param [in] fn The function
+     */
+    template <typename FN>
+    void SetFunction(FN fn);
+
+    /**
+     * Set the function to invoke periodically.
+     *
+     * @tparam MEM_PTR \deduced Class method function type.
+     * @tparam OBJ_PTR \deduced Class type containing the function.
+     * @param [in] memPtr The member function pointer
+     * @param [in] objPtr The pointer to object
+     */
+    template <typename MEM_PTR, typename OBJ_PTR>
+    void SetFunction(MEM_PTR memPtr, OBJ_PTR objPtr);
+
+    /**
+     * Set the arguments to be used when invoking the function.
+     *
+     * @tparam Ts \deduced Argument types.
+     * @param [in] args arguments
+     */
+    template <typename... Ts>
+    void SetArguments(Ts&&... args);
+
+    /**
+     * @param [in] period The period, strictly positive.
+     */
+    void SetPeriod(const Time& period);
+
+    /**
+     * @returns The period.
+     */
+    Time GetPeriod() const;
+
+    /**
+     * Start the event: the function is first invoked after one period.
+     */
+    void Start();
+
+    /**
+     * Start the event: the function is first invoked after a delay, then
+     * once per period.
+     *
+     * @param [in] delay The delay until the first invocation.
+     */
+    void Start(const Time& delay);
+
+    /** Stop the event; it may be started again. */
+    void Stop();
+
+    /**
+     * @returns true if the event is started.
+     */
+    bool IsRunning() const;
+
+  private:
+    /** Schedule the next period, then invoke the function. */
+    void Expire();
+
+    /** The bound function and arguments. */
+    internal::TimerImpl* m_impl;
+    /** The period. */
+    Time m_period;
+    /** The event which calls Expire(), scheduled again at each period. */
+    Ptr<EventImpl> m_event;
+    /** The next period. */
+    EventId m_id;
+};
+
+} // namespace ns3
+
+/********************************************************************
+ *  Implementation of the templates declared above.
+ ********************************************************************/
+
+#include "timer-impl.h"
+
+namespace ns3
+{
+
+template <typename FN>
+void
+PeriodicEvent::SetFunction(FN fn)
+{
+    delete m_impl;
+    m_impl = internal::MakeTimerImpl(fn);
+}
+
+template <typename MEM_PTR, typename OBJ_PTR>
+void
+PeriodicEvent::SetFunction(MEM_PTR memPtr, OBJ_PTR objPtr)
+{
+    delete m_impl;
+    m_impl = internal::MakeTimerImpl(memPtr, objPtr);
+}
+
+template <typename... Ts>
+void
+PeriodicEvent::SetArguments(Ts&&... args)
+{
+    if (m_impl == nullptr)
+    {
+        NS_FATAL_ERROR("You cannot set the arguments of a PeriodicEvent before setting its "
+                       "function.");
+        return;
+    }
+    m_impl->SetArgs(std::forward<Ts>(args)...);
+}
+
+} // namespace ns3
+
+#endif /* PERIODIC_EVENT_H */
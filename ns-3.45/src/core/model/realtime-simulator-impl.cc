@@ -75,6 +75,7 @@ RealtimeSimulatorImpl::RealtimeSimulatorImpl()
     m_currentContext = Simulator::NO_CONTEXT;
     m_unscheduledEvents = 0;
     m_eventCount = 0;
+    m_cancelledEventCount = 0;
 
     m_main = std::this_thread::get_id();
 
@@ -320,6 +321,10 @@ RealtimeSimulatorImpl::ProcessOneEvent()
 
         m_unscheduledEvents--;
         m_eventCount++;
+        if (next.impl->IsCancelled())
+        {
+            m_cancelledEventCount++;
+        }
 
         //
         // We cannot make any assumption that "next" is the same event we originally waited
@@ -791,6 +796,18 @@ RealtimeSimulatorImpl::GetEventCount() const
     return m_eventCount;
 }
 
+uint64_t
+RealtimeSimulatorImpl::GetCancelledEventCount() const
+{
+    return m_cancelledEventCount;
+}
+
+uint64_t
+RealtimeSimulatorImpl::GetPendingEventCount() const
+{
+    return m_unscheduledEvents;
+}
+
 void
 RealtimeSimulatorImpl::SetSynchronizationMode(SynchronizationMode mode)
 {
@@ -96,6 +96,8 @@ class RealtimeSimulatorImpl : public SimulatorImpl
     uint32_t GetSystemId() const override;
     uint32_t GetContext() const override;
     uint64_t GetEventCount() const override;
+    uint64_t GetCancelledEventCount() const override;
+    uint64_t GetPendingEventCount() const override;
 
     /** @copydoc ScheduleWithContext(uint32_t,const Time&,EventImpl*) */
     void ScheduleRealtimeWithContext(uint32_t context, const Time& delay, EventImpl* event);
@@ -202,6 +204,8 @@ class RealtimeSimulatorImpl : public SimulatorImpl
     uint32_t m_currentContext;
     /** The event count. */
     uint64_t m_eventCount;
+    /** The count of the cancelled events removed from the event list. */
+    uint64_t m_cancelledEventCount;
     /**@}*/
 
     /** Mutex to control access to key state. */
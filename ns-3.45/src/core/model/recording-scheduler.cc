@@ -0,0 +1,240 @@
+//
+// SPDX-License-Identifier: GPL-2.0-only
+//
+
+#include "recording-scheduler.h"
+
+#include "abort.h"
+#include "assert.h"
+#include "event-impl.h"
+#include "log.h"
+#include "map-scheduler.h"
+#include "string.h"
+
+#include <cstring>
+
+/**
+ * @file
+ * @ingroup scheduler
+ * ns3::RecordingScheduler implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("RecordingScheduler");
+
+NS_OBJECT_ENSURE_REGISTERED(RecordingScheduler);
+
+namespace
+{
+
+/** The first bytes of the file. */
+const char MAGIC[8] = {'n', 's', '3', 'e', 'v', 't', 'r', 'c'};
+
+/** The version of the format. */
+const uint32_t VERSION = 1;
+
+/**
+ * Get an object factory configured to the default scheduler.
+ * @return an object factory.
+ */
+ObjectFactory
+GetDefaultSchedulerFactory()
+{
+    ObjectFactory factory;
+    factory.SetTypeId(MapScheduler::GetTypeId());
+    return factory;
+}
+
+/**
+ * Read an unsigned LEB128 field.
+ *
+ * @param [in] input The file.
+ * @param [in] filename The name of the file, for the error message.
+ * @returns The value.
+ */
+uint64_t
+ReadField(std::istream& input, const std::string& filename)
+{
+    uint64_t value = 0;
+    for (uint32_t shift = 0; shift < 64; shift += 7)
+    {
+        int byte = input.get();
+        NS_ABORT_MSG_IF(byte == EOF, "Truncated event trace " << filename);
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0)
+        {
+            return value;
+        }
+    }
+    NS_FATAL_ERROR("Corrupted event trace " << filename);
+    return 0;
+}
+
+} // namespace
+
+TypeId
+RecordingScheduler::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::RecordingScheduler")
+            .SetParent<Scheduler>()
+            .SetGroupName("Core")
+            .AddConstructor<RecordingScheduler>()
+            .AddAttribute("SchedulerFactory",
+                          "Factory of the scheduler which holds the events.",
+                          ObjectFactoryValue(GetDefaultSchedulerFactory()),
+                          MakeObjectFactoryAccessor(&RecordingScheduler::m_schedulerFactory),
+                          MakeObjectFactoryChecker())
+            .AddAttribute("FileName",
+                          "Name of the file of the operations.",
+                          StringValue("events.evt"),
+                          MakeStringAccessor(&RecordingScheduler::m_filename),
+                          MakeStringChecker());
+    return tid;
+}
+
+RecordingScheduler::RecordingScheduler()
+    : m_now(0),
+      m_lastUid(0),
+      m_nOperations(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+RecordingScheduler::~RecordingScheduler()
+{
+    NS_LOG_FUNCTION(this);
+    NS_LOG_INFO("Recorded " << m_nOperations << " operations in " << m_filename);
+}
+
+void
+RecordingScheduler::NotifyConstructionCompleted()
+{
+    NS_LOG_FUNCTION(this);
+    m_events = m_schedulerFactory.Create<Scheduler>();
+    m_file.open(m_filename, std::ios::out | std::ios::binary | std::ios::trunc);
+    NS_ABORT_MSG_IF(!m_file, "Cannot open the event trace " << m_filename);
+    m_file.write(MAGIC, sizeof(MAGIC));
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        m_file.put(static_cast<char>((VERSION >> (8 * i)) & 0xff));
+    }
+    Scheduler::NotifyConstructionCompleted();
+}
+
+void
+RecordingScheduler::WriteType(Operation::Type type)
+{
+    m_file.put(static_cast<char>(type));
+    m_nOperations++;
+}
+
+void
+RecordingScheduler::WriteField(uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        m_file.put(static_cast<char>((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    m_file.put(static_cast<char>(value));
+}
+
+void
+RecordingScheduler::Insert(const Scheduler::Event& ev)
+{
+    NS_LOG_FUNCTION(this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+    WriteType(Operation::INSERT);
+    WriteField(ev.key.m_ts - m_now);
+    WriteField(static_cast<uint32_t>(ev.key.m_uid - m_lastUid));
+    WriteField(static_cast<uint32_t>(ev.key.m_context + 1));
+    m_lastUid = ev.key.m_uid;
+    m_events->Insert(ev);
+}
+
+bool
+RecordingScheduler::IsEmpty() const
+{
+    return m_events->IsEmpty();
+}
+
+Scheduler::Event
+RecordingScheduler::PeekNext() const
+{
+    return m_events->PeekNext();
+}
+
+Scheduler::Event
+RecordingScheduler::RemoveNext()
+{
+    NS_LOG_FUNCTION(this);
+    Scheduler::Event ev = m_events->RemoveNext();
+    WriteType(ev.impl->IsCancelled() ? Operation::CANCELLED : Operation::REMOVE_NEXT);
+    WriteField(ev.key.m_ts - m_now);
+    m_now = ev.key.m_ts;
+    return ev;
+}
+
+void
+RecordingScheduler::Remove(const Scheduler::Event& ev)
+{
+    NS_LOG_FUNCTION(this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+    WriteType(Operation::REMOVE);
+    WriteField(static_cast<uint32_t>(m_lastUid - ev.key.m_uid));
+    WriteField(ev.key.m_ts - m_now);
+    m_events->Remove(ev);
+}
+
+std::vector<RecordingScheduler::Operation>
+RecordingScheduler::ReadFile(const std::string& filename)
+{
+    NS_LOG_FUNCTION(filename);
+    std::ifstream input(filename, std::ios::in | std::ios::binary);
+    NS_ABORT_MSG_IF(!input, "Cannot open the event trace " << filename);
+    char magic[sizeof(MAGIC)];
+    uint8_t version[4];
+    input.read(magic, sizeof(magic));
+    input.read(reinterpret_cast<char*>(version), sizeof(version));
+    NS_ABORT_MSG_IF(!input || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0,
+                    filename << " is not an event trace");
+    uint32_t fileVersion = version[0] | (version[1] << 8) | (version[2] << 16) | (version[3] << 24);
+    NS_ABORT_MSG_IF(fileVersion != VERSION,
+                    "Unsupported version " << fileVersion << " of the event trace " << filename);
+
+    std::vector<Operation> operations;
+    uint64_t now = 0;
+    uint32_t lastUid = 0;
+    int type;
+    while ((type = input.get()) != EOF)
+    {
+        Operation op;
+        op.type = static_cast<Operation::Type>(type);
+        op.key = Scheduler::EventKey{0, 0, 0};
+        switch (op.type)
+        {
+        case Operation::INSERT:
+            op.key.m_ts = now + ReadField(input, filename);
+            op.key.m_uid = lastUid + static_cast<uint32_t>(ReadField(input, filename));
+            op.key.m_context = static_cast<uint32_t>(ReadField(input, filename)) - 1;
+            lastUid = op.key.m_uid;
+            break;
+        case Operation::REMOVE:
+            op.key.m_uid = lastUid - static_cast<uint32_t>(ReadField(input, filename));
+            op.key.m_ts = now + ReadField(input, filename);
+            break;
+        case Operation::REMOVE_NEXT:
+        case Operation::CANCELLED:
+            op.key.m_ts = now + ReadField(input, filename);
+            now = op.key.m_ts;
+            break;
+        default:
+            NS_FATAL_ERROR("Corrupted event trace " << filename);
+        }
+        operations.push_back(op);
+    }
+    return operations;
+}
+
+} // namespace ns3
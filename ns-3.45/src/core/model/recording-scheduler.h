@@ -0,0 +1,135 @@
+//
+// SPDX-License-Identifier: GPL-2.0-only
+//
+
+#ifndef RECORDING_SCHEDULER_H
+#define RECORDING_SCHEDULER_H
+
+#include "object-factory.h"
+#include "scheduler.h"
+
+#include <fstream>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup scheduler
+ * ns3::RecordingScheduler declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * @ingroup scheduler
+ * @brief a scheduler which records its operations in a file
+ *
+ * This scheduler forwards its operations to another scheduler, given by
+ * the SchedulerFactory attribute, and writes them to the file given by the
+ * FileName attribute. The operations of a real simulation can then be
+ * replayed against each scheduler by `utils/bench-scheduler --replay=<file>`,
+ * to choose a scheduler for the event distribution of the simulation:
+ *
+ * \code
+ *   $ ./my-sim --SchedulerType=ns3::RecordingScheduler \
+ *              --ns3::RecordingScheduler::FileName=my-sim.evt
+ * \endcode
+ *
+ * The file starts with a header: the 8 bytes `ns3evtrc` and the format
+ * version, a 32-bit little-endian integer. Each operation is then a byte,
+ * the type of the operation, followed by unsigned LEB128 fields:
+ *
+ * Type          | Fields
+ * :------------ | :-----
+ * 0 Insert      | timestamp - now, uid - previous uid, context + 1
+ * 1 Remove      | last inserted uid - uid, timestamp - now
+ * 2 RemoveNext  | timestamp - now
+ * 3 RemoveNext  | timestamp - now; the event was cancelled
+ *
+ * where `now` is the timestamp of the previous event removed by
+ * RemoveNext(), i.e., the time of the operation, and `context + 1` is zero
+ * for the events without context. The fields wrap around, e.g., for the
+ * events inserted before a later one was run. An insertion takes 4 to 6
+ * bytes for the usual delays, and a RemoveNext() 2 to 4 bytes.
+ *
+ * The simulation must use a single event list, e.g., with the
+ * DefaultSimulatorImpl or the RealtimeSimulatorImpl: all the instances of
+ * this scheduler write to the same file.
+ */
+class RecordingScheduler : public Scheduler
+{
+  public:
+    /**
+     *  Register this type.
+     *  @return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    /** Constructor. */
+    RecordingScheduler();
+    /** Destructor. */
+    ~RecordingScheduler() override;
+
+    // Inherited
+    void Insert(const Scheduler::Event& ev) override;
+    bool IsEmpty() const override;
+    Scheduler::Event PeekNext() const override;
+    Scheduler::Event RemoveNext() override;
+    void Remove(const Scheduler::Event& ev) override;
+
+    /** A recorded operation. */
+    struct Operation
+    {
+        /** The type of the operation. */
+        enum Type : uint8_t
+        {
+            INSERT = 0,      //!< Insert()
+            REMOVE = 1,      //!< Remove()
+            REMOVE_NEXT = 2, //!< RemoveNext()
+            CANCELLED = 3,   //!< RemoveNext() of a cancelled event
+        };
+
+        Type type;               //!< The type of the operation
+        Scheduler::EventKey key; //!< The event; only the timestamp for RemoveNext()
+    };
+
+    /**
+     * Read a file written by this scheduler.
+     *
+     * @param [in] filename The name of the file.
+     * @returns The operations, with the keys of the events inserted and removed.
+     */
+    static std::vector<Operation> ReadFile(const std::string& filename);
+
+  protected:
+    void NotifyConstructionCompleted() override;
+
+  private:
+    /**
+     * Write an operation.
+     *
+     * @param [in] type The type of the operation.
+     */
+    void WriteType(Operation::Type type);
+
+    /**
+     * Write an unsigned LEB128 field.
+     *
+     * @param [in] value The value.
+     */
+    void WriteField(uint64_t value);
+
+    ObjectFactory m_schedulerFactory; //!< Factory of the scheduler
+    Ptr<Scheduler> m_events;          //!< The scheduler
+    std::string m_filename;           //!< The name of the file
+    std::ofstream m_file;             //!< The file
+    uint64_t m_now;                   //!< Timestamp of the last event removed by RemoveNext()
+    uint32_t m_lastUid;               //!< Uid of the last event inserted
+    uint64_t m_nOperations;           //!< Number of operations written
+};
+
+} // namespace ns3
+
+#endif /* RECORDING_SCHEDULER_H */
@@ -0,0 +1,118 @@
+//
+// SPDX-License-Identifier: GPL-2.0-only
+//
+
+#include "reschedulable-timer.h"
+
+#include "event-impl.h"
+#include "log.h"
+#include "make-event.h"
+#include "simulator.h"
+
+/**
+ * @file
+ * @ingroup timer
+ * ns3::ReschedulableTimer implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("ReschedulableTimer");
+
+ReschedulableTimer::ReschedulableTimer()
+    : m_impl(nullptr),
+      m_running(false),
+      m_end(),
+      m_event(nullptr),
+      m_id()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+ReschedulableTimer::~ReschedulableTimer()
+{
+    NS_LOG_FUNCTION(this);
+    m_id.Cancel();
+    delete m_impl;
+}
+
+void
+ReschedulableTimer::Schedule(const Time& delay)
+{
+    NS_LOG_FUNCTION(this << delay);
+    NS_ASSERT_MSG(m_impl != nullptr, "The function of the ReschedulableTimer is not set");
+    m_end = Simulator::Now() + delay;
+    m_running = true;
+    auto end = static_cast<uint64_t>(m_end.GetTimeStep());
+    if (m_id.IsPending())
+    {
+        if (m_id.GetTs() <= end)
+        {
+            // Expire() moves the event to m_end
+            return;
+        }
+        // the event cannot be moved back: replace it
+        NS_LOG_LOGIC("replace the event at " << TimeStep(m_id.GetTs()));
+        m_id.Cancel();
+        m_event = nullptr;
+    }
+    else if (m_event && m_event->IsCancelled())
+    {
+        if (m_id.GetTs() > static_cast<uint64_t>(Simulator::Now().GetTimeStep()) &&
+            m_id.GetTs() <= end)
+        {
+            // cancelled by Cancel(), and still in the event list
+            m_event->Uncancel();
+            return;
+        }
+        // the cancelled event may still be in the event list
+        m_event = nullptr;
+    }
+    if (!m_event)
+    {
+        m_event = Ptr<EventImpl>(MakeEvent(&ReschedulableTimer::Expire, this), false);
+    }
+    m_id = Simulator::Schedule(delay, m_event);
+}
+
+void
+ReschedulableTimer::Cancel()
+{
+    NS_LOG_FUNCTION(this);
+    // the event stays in the event list, to be reused by Schedule(), and
+    // is counted as a cancelled event if it runs first
+    m_running = false;
+    m_id.Cancel();
+}
+
+bool
+ReschedulableTimer::IsRunning() const
+{
+    return m_running;
+}
+
+Time
+ReschedulableTimer::GetDelayLeft() const
+{
+    return m_running ? m_end - Simulator::Now() : Time(0);
+}
+
+void
+ReschedulableTimer::Expire()
+{
+    NS_LOG_FUNCTION(this);
+    if (!m_running)
+    {
+        return;
+    }
+    if (m_end > Simulator::Now())
+    {
+        m_id = Simulator::Schedule(m_end - Simulator::Now(), m_event);
+        return;
+    }
+    m_running = false;
+    m_impl->Invoke();
+}
+
+} // namespace ns3
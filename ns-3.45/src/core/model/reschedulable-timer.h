@@ -0,0 +1,172 @@
+//
+// SPDX-License-Identifier: GPL-2.0-only
+//
+
+#ifndef RESCHEDULABLE_TIMER_H
+#define RESCHEDULABLE_TIMER_H
+
+#include "event-id.h"
+#include "nstime.h"
+#include "ptr.h"
+
+/**
+ * @file
+ * @ingroup timer
+ * ns3::ReschedulableTimer declaration.
+ */
+
+namespace ns3
+{
+
+class EventImpl;
+
+namespace internal
+{
+
+class TimerImpl;
+
+} // namespace internal
+
+/**
+ * @ingroup timer
+ * @brief A timer which can be cancelled and rescheduled without leaving
+ * dead events in the event list.
+ *
+ * Cancelling an EventId and scheduling a new event, e.g., to restart a
+ * retransmission timeout, leaves the cancelled event in the event list
+ * until its time comes. This timer instead keeps its event when it is
+ * rescheduled later than the event, and moves it to the new expiration
+ * time when the event runs; when it is cancelled, the event is cancelled
+ * but stays in the list, and is restored if the timer is scheduled again
+ * before the event runs. Otherwise, it is counted by
+ * Simulator::GetCancelledEventCount() when it runs, like the other
+ * cancelled events. Scheduling the timer earlier than its event also
+ * cancels the event.
+ *
+ * The event is allocated once, and reused until it runs cancelled or is
+ * replaced by an earlier one.
+ *
+ * @see Simulator::GetCancelledEventCount
+ */
+class ReschedulableTimer
+{
+  public:
+    /** Constructor. */
+    ReschedulableTimer();
+    /** Destructor: cancel the timer. */
+    ~ReschedulableTimer();
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    ReschedulableTimer(const ReschedulableTimer&) = delete;
+    ReschedulableTimer& operator=(const ReschedulableTimer&) = delete;
+
+    /**
+     * Set the function to execute when the timer expires.
+     *
+     * @tparam FN \deduced The type of the function.
+     * @param [in] fn The function
+     */
+    template <typename FN>
+    void SetFunction(FN fn);
+
+    /**
+     * Set the function to execute when the timer expires.
+     *
+     * @tparam MEM_PTR \deduced Class method function type.
+     * @tparam OBJ_PTR \deduced Class type containing the function.
+     * @param [in] memPtr The member function pointer
+     * @param [in] objPtr The pointer to object
+     */
+    template <typename MEM_PTR, typename OBJ_PTR>
+    void SetFunction(MEM_PTR memPtr, OBJ_PTR objPtr);
+
+    /**
+     * Set the arguments to be used when invoking the function.
+     *
+     * @tparam Ts \deduced Argument types.
+     * @param [in] args arguments
+     */
+    template <typename... Ts>
+    void SetArguments(Ts&&... args);
+
+    /**
+     * Schedule the timer to expire after a delay, whether it is running or
+     * not.
+     *
+     * @param [in] delay The delay until the expiration.
+     */
+    void Schedule(const Time& delay);
+
+    /** Cancel the timer; it may be scheduled again. */
+    void Cancel();
+
+    /**
+     * @returns true if the timer is scheduled, and has not expired.
+     */
+    bool IsRunning() const;
+
+    /**
+     * @returns The delay until the expiration, or zero if the timer is not
+     *          running.
+     */
+    Time GetDelayLeft() const;
+
+  private:
+    /** Move the event to the expiration time, or invoke the function. */
+    void Expire();
+
+    /** The bound function and arguments. */
+    internal::TimerImpl* m_impl;
+    /** Whether the timer is running. */
+    bool m_running;
+    /** The expiration time, if the timer is running. */
+    Time m_end;
+    /** The event which calls Expire(), reused until it is cancelled. */
+    Ptr<EventImpl> m_event;
+    /** The event in the event list, at or before the expiration time. */
+    EventId m_id;
+};
+
+} // namespace ns3
+
+/********************************************************************
+ *  Implementation of the templates declared above.
+ ********************************************************************/
+
+#include "timer-impl.h"
+
+namespace ns3
+{
+
+template <typename FN>
+void
+ReschedulableTimer::SetFunction(FN fn)
+{
+    delete m_impl;
+    m_impl = internal::MakeTimerImpl(fn);
+}
+
+template <typename MEM_PTR, typename OBJ_PTR>
+void
+ReschedulableTimer::SetFunction(MEM_PTR memPtr, OBJ_PTR objPtr)
+{
+    delete m_impl;
+    m_impl = internal::MakeTimerImpl(memPtr, objPtr);
+}
+
+template <typename... Ts>
+void
+ReschedulableTimer::SetArguments(Ts&&... args)
+{
+    if (m_impl == nullptr)
+    {
+        NS_FATAL_ERROR("You cannot set the arguments of a ReschedulableTimer before setting its "
+                       "function.");
+        return;
+    }
+    m_impl->SetArgs(std::forward<Ts>(args)...);
+}
+
+} // namespace ns3
+
+#endif /* RESCHEDULABLE_TIMER_H */
@@ -11,8 +11,11 @@
 #include "config.h"
 #include "global-value.h"
 #include "log.h"
+#include "multithreading.h"
 #include "uinteger.h"
 
+#include <optional>
+
 /**
  * @file
  * @ingroup randomvariable
@@ -29,7 +32,21 @@ NS_LOG_COMPONENT_DEFINE("RngSeedManager");
  * The next random number generator stream number to use
  * for automatic assignment.
  */
-static uint64_t g_nextStreamIndex = 0;
+static NS3_SIMULATION_LOCAL uint64_t g_nextStreamIndex = 0;
+
+#ifdef NS3_REPLICATIONS
+/**
+ * @relates RngSeedManager
+ * The seed set by the thread, which overrides the global value: each
+ * replication sets its own seed, and its own run number.
+ */
+static thread_local std::optional<uint32_t> g_threadSeed;
+/**
+ * @relates RngSeedManager
+ * The run number set by the thread, which overrides the global value.
+ */
+static thread_local std::optional<uint64_t> g_threadRun;
+#endif
 /**
  * @relates RngSeedManager
  * @anchor GlobalValueRngSeed
@@ -63,6 +80,12 @@ uint32_t
 RngSeedManager::GetSeed()
 {
     NS_LOG_FUNCTION_NOARGS();
+#ifdef NS3_REPLICATIONS
+    if (g_threadSeed)
+    {
+        return *g_threadSeed;
+    }
+#endif
     UintegerValue seedValue;
     g_rngSeed.GetValue(seedValue);
     return static_cast<uint32_t>(seedValue.Get());
@@ -72,20 +95,34 @@ void
 RngSeedManager::SetSeed(uint32_t seed)
 {
     NS_LOG_FUNCTION(seed);
+#ifdef NS3_REPLICATIONS
+    g_threadSeed = seed;
+#else
     Config::SetGlobal("RngSeed", UintegerValue(seed));
+#endif
 }
 
 void
 RngSeedManager::SetRun(uint64_t run)
 {
     NS_LOG_FUNCTION(run);
+#ifdef NS3_REPLICATIONS
+    g_threadRun = run;
+#else
     Config::SetGlobal("RngRun", UintegerValue(run));
+#endif
 }
 
 uint64_t
 RngSeedManager::GetRun()
 {
     NS_LOG_FUNCTION_NOARGS();
+#ifdef NS3_REPLICATIONS
+    if (g_threadRun)
+    {
+        return *g_threadRun;
+    }
+#endif
     UintegerValue value;
     g_rngRun.GetValue(value);
     uint64_t run = value.Get();
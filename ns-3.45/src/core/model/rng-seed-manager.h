@@ -44,6 +44,10 @@ class RngSeedManager
      * @note While the underlying RNG takes six integer values as a seed;
      * it is sufficient to set these all to the same integer, so we provide
      * a simpler interface here that just takes one integer.
+     *
+     * With the NS3_REPLICATIONS option, the seed is set for the calling
+     * thread only; the threads which do not set it use the RngSeed global
+     * value. The same holds for SetRun().
      */
     static void SetSeed(uint32_t seed);
 
@@ -15,18 +15,123 @@
 
 #include "show-progress.h"
 
+#include "abort.h"
 #include "event-id.h"
 #include "log.h"
 #include "nstime.h"
 #include "simulator.h"
 
+#include <algorithm>
 #include <iomanip>
+#include <utility>
+
+#if __has_include(<sys/resource.h>) && __has_include(<unistd.h>)
+#include <sys/resource.h>
+#include <unistd.h>
+#define NS3_SHOW_PROGRESS_RUSAGE
+#endif
 
 namespace ns3
 {
 
 NS_LOG_COMPONENT_DEFINE("ShowProgress");
 
+namespace
+{
+
+/** The counters registered with ShowProgress::RegisterCounter(). */
+std::vector<std::pair<std::string, std::function<double()>>>&
+GetCounters()
+{
+    static std::vector<std::pair<std::string, std::function<double()>>> counters;
+    return counters;
+}
+
+/** The counters registered with ShowProgress::RegisterEventCounter(). */
+std::vector<std::pair<std::string, std::function<uint64_t()>>>&
+GetEventCounters()
+{
+    static std::vector<std::pair<std::string, std::function<uint64_t()>>> counters;
+    return counters;
+}
+
+/**
+ * Get the memory used by the process.
+ * @param [out] rss The resident memory, in bytes, or 0 if unknown.
+ * @param [out] maxRss The peak resident memory, in bytes, or 0 if unknown.
+ */
+void
+GetMemoryUsage(uint64_t& rss, uint64_t& maxRss)
+{
+    rss = 0;
+    maxRss = 0;
+#ifdef NS3_SHOW_PROGRESS_RUSAGE
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0)
+    {
+#ifdef __APPLE__
+        maxRss = usage.ru_maxrss;
+#else
+        maxRss = uint64_t(usage.ru_maxrss) * 1024;
+#endif
+    }
+    // the current resident memory is only known on Linux
+    std::ifstream statm("/proc/self/statm");
+    uint64_t size = 0;
+    uint64_t resident = 0;
+    if (statm >> size >> resident)
+    {
+        rss = resident * sysconf(_SC_PAGESIZE);
+        maxRss = std::max(maxRss, rss);
+    }
+#endif
+}
+
+/**
+ * Write a string as a quoted JSON string.
+ * @param [in,out] os The output stream.
+ * @param [in] value The string.
+ */
+void
+WriteJsonString(std::ostream& os, const std::string& value)
+{
+    os << '"';
+    for (const char c : value)
+    {
+        switch (c)
+        {
+        case '"':
+            os << "\\\"";
+            break;
+        case '\\':
+            os << "\\\\";
+            break;
+        case '\n':
+            os << "\\n";
+            break;
+        case '\t':
+            os << "\\t";
+            break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20)
+            {
+                const auto flags = os.flags();
+                os << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+                   << int(static_cast<unsigned char>(c));
+                os.flags(flags);
+                os << std::setfill(' ');
+            }
+            else
+            {
+                os << c;
+            }
+        }
+    }
+    os << '"';
+}
+
+} // namespace
+
 /* static */
 const int64x64_t ShowProgress::HYSTERESIS = 1.414;
 /* static */
@@ -44,7 +149,16 @@ ShowProgress::ShowProgress(const Time interval /* = Seconds (1.0) */,
       m_printer(DefaultTimePrinter),
       m_os(&os),
       m_verbose(false),
-      m_repCount(0)
+      m_repCount(0),
+      m_feedbackElapsed(),
+      m_feedbackTime(Simulator::Now()),
+      m_sidecar(),
+      m_sidecarInterval(),
+      m_sidecarElapsed(),
+      m_sidecarTime(),
+      m_sidecarEventCount(0),
+      m_wallTime(),
+      m_moduleEvents()
 {
     NS_LOG_FUNCTION(this << interval);
     ScheduleCheckProgress();
@@ -92,6 +206,39 @@ ShowProgress::SetStream(std::ostream& os)
     m_os = &os;
 }
 
+void
+ShowProgress::SetSidecar(const std::string& filename, const Time interval /* = Seconds (1) */)
+{
+    NS_LOG_FUNCTION(this << filename << interval);
+    NS_ABORT_MSG_UNLESS(interval.IsStrictlyPositive(), "The sidecar interval must be positive");
+    m_sidecar.reset();
+    if (!filename.empty())
+    {
+        m_sidecar = std::make_unique<std::ofstream>(filename, std::ios::trunc);
+        NS_ABORT_MSG_UNLESS(m_sidecar->is_open(), "Cannot open the sidecar file " << filename);
+        m_sidecarInterval = interval;
+        m_sidecarElapsed = Time(0);
+        m_sidecarTime = Simulator::Now();
+        m_sidecarEventCount = Simulator::GetEventCount();
+    }
+}
+
+/* static */
+void
+ShowProgress::RegisterCounter(const std::string& name, std::function<double()> counter)
+{
+    NS_LOG_FUNCTION(name);
+    GetCounters().emplace_back(name, counter);
+}
+
+/* static */
+void
+ShowProgress::RegisterEventCounter(const std::string& module, std::function<uint64_t()> counter)
+{
+    NS_LOG_FUNCTION(module);
+    GetEventCounters().emplace_back(module, counter);
+}
+
 void
 ShowProgress::ScheduleCheckProgress()
 {
@@ -113,7 +260,8 @@ ShowProgress::GiveFeedback(uint64_t nEvents, int64x64_t ratio, int64x64_t speed)
     {
         (*m_os) << std::right << std::setw(5) << m_repCount << std::left
                 << (ratio > (1.0 / HYSTERESIS) ? "-->" : "   ") << std::setprecision(9)
-                << " [del: " << m_elapsed.As(Time::S) << "/ int: " << m_interval.As(Time::S)
+                << " [del: " << m_feedbackElapsed.As(Time::S)
+                << "/ int: " << m_interval.As(Time::S)
                 << " = rat: " << ratio
                 << (ratio > HYSTERESIS ? " dn" : (ratio < 1.0 / HYSTERESIS ? " up" : " --"))
                 << ", vt: " << m_vtime.As(Time::S) << "] ";
@@ -131,11 +279,61 @@ ShowProgress::GiveFeedback(uint64_t nEvents, int64x64_t ratio, int64x64_t speed)
     m_os->flags(flags);
 }
 
+void
+ShowProgress::WriteSidecar(uint64_t events)
+{
+    uint64_t rss;
+    uint64_t maxRss;
+    GetMemoryUsage(rss, maxRss);
+    const uint64_t nEvents = events - m_sidecarEventCount;
+    const double elapsed = m_sidecarElapsed.GetSeconds();
+    const double speed =
+        elapsed > 0 ? (Simulator::Now() - m_sidecarTime).GetSeconds() / elapsed : 0;
+
+    std::ostream& os = *m_sidecar;
+    os << std::setprecision(9) << "{\"wall\":" << m_wallTime.GetSeconds()
+       << ",\"time\":" << Simulator::Now().GetSeconds() << ",\"speed\":" << speed
+       << ",\"events\":" << nEvents
+       << ",\"eventRate\":" << (elapsed > 0 ? nEvents / elapsed : 0)
+       << ",\"pending\":" << Simulator::GetPendingEventCount()
+       << ",\"cancelled\":" << Simulator::GetCancelledEventCount() << ",\"rss\":" << rss
+       << ",\"maxRss\":" << maxRss << ",\"counters\":{";
+    const char* separator = "";
+    for (const auto& [name, counter] : GetCounters())
+    {
+        os << separator;
+        WriteJsonString(os, name);
+        os << ":" << counter();
+        separator = ",";
+    }
+    os << "},\"eventShares\":{";
+    const auto& eventCounters = GetEventCounters();
+    m_moduleEvents.resize(eventCounters.size(), 0);
+    separator = "";
+    for (std::size_t i = 0; i < eventCounters.size(); i++)
+    {
+        uint64_t count = eventCounters[i].second();
+        uint64_t moduleEvents = count - m_moduleEvents[i];
+        m_moduleEvents[i] = count;
+        os << separator;
+        WriteJsonString(os, eventCounters[i].first);
+        os << ":" << (nEvents > 0 ? double(moduleEvents) / nEvents : 0);
+        separator = ",";
+    }
+    os << "}}" << std::endl;
+
+    m_sidecarElapsed = Time(0);
+    m_sidecarTime = Simulator::Now();
+    m_sidecarEventCount = events;
+}
+
 void
 ShowProgress::CheckProgress()
 {
     // Get elapsed wall clock time
-    m_elapsed += MilliSeconds(m_timer.End());
+    const Time elapsed = MilliSeconds(m_timer.End());
+    m_elapsed += elapsed;
+    m_wallTime += elapsed;
     NS_LOG_FUNCTION(this << m_elapsed);
 
     // Don't do anything unless the elapsed time is positive.
@@ -147,16 +345,12 @@ ShowProgress::CheckProgress()
         return;
     }
 
-    // Speed: how fast are we compared to real time
-    const int64x64_t speed = m_vtime / m_elapsed;
+    // The checks follow the shorter of the console and sidecar intervals
+    const Time target = m_sidecar ? std::min(m_interval, m_sidecarInterval) : m_interval;
 
     // Ratio: how much real time did we use,
     // compared to reporting interval target
-    const int64x64_t ratio = m_elapsed / m_interval;
-
-    // Elapsed event count
-    uint64_t events = Simulator::GetEventCount();
-    uint64_t nEvents = events - m_eventCount;
+    const int64x64_t ratio = m_elapsed / target;
     /**
      * @internal Update algorithm
      *
@@ -235,18 +429,34 @@ ShowProgress::CheckProgress()
         m_vtime = m_vtime * f;
     }
 
-    // Only give feedback if ratio is at least as big as 1/HYSTERESIS
+    // Only give feedback if ratio is at least as big as 1/HYSTERESIS,
+    // and each output only when its own interval is reached in the same way
     if (ratio > (1.0 / HYSTERESIS))
     {
-        GiveFeedback(nEvents, ratio, speed);
+        const uint64_t events = Simulator::GetEventCount();
+        m_feedbackElapsed += m_elapsed;
+        if (m_feedbackElapsed / m_interval > (1.0 / HYSTERESIS))
+        {
+            // Speed: how fast are we compared to real time
+            const int64x64_t speed = (Simulator::Now() - m_feedbackTime) / m_feedbackElapsed;
+            GiveFeedback(events - m_eventCount, ratio, speed);
+            m_feedbackElapsed = Time(0);
+            m_feedbackTime = Simulator::Now();
+            m_eventCount = events;
+        }
+        if (m_sidecar)
+        {
+            m_sidecarElapsed += m_elapsed;
+            if (m_sidecarElapsed / m_sidecarInterval > (1.0 / HYSTERESIS))
+            {
+                WriteSidecar(events);
+            }
+        }
         m_elapsed = Time(0);
-        m_eventCount = events;
     }
     else
     {
         NS_LOG_LOGIC("skipping update: " << ratio);
-        // enable this line for debugging, with --verbose
-        // GiveFeedback (nEvents, ratio, speed);
     }
     ++m_repCount;
 
@@ -22,7 +22,12 @@
 #include "system-wall-clock-timestamp.h"
 #include "time-printer.h"
 
+#include <fstream>
+#include <functional>
 #include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
 
 namespace ns3
 {
@@ -74,6 +79,27 @@ namespace ns3
  *
  * A more extensive example of use is provided in sample-show-progress.cc.
  *
+ * For monitoring long runs, SetSidecar() also writes a record to a file
+ * at its own wall clock interval, as one JSON object per line: the wall
+ * clock and simulation times, the speed, the events and events per second
+ * of wall clock time, the size of the event list, the resident memory,
+ * the counters registered by the modules with RegisterCounter(), and the
+ * share of the events of the modules which registered an event count
+ * with RegisterEventCounter():
+ * @code
+ *     {"wall":12.003,"time":1.5,"speed":0.124,"events":1250000,
+ *      "eventRate":104141,"pending":5312,"cancelled":10512,
+ *      "rss":210763776,"maxRss":211288064,
+ *      "counters":{"point-to-point/packets-in-flight":173},
+ *      "eventShares":{"point-to-point":0.61}}
+ * @endcode
+ * The counters are read at the records only: a module which counts with
+ * a plain integer, and registers a function reading it, adds no cost per
+ * event beyond the increment.  The progress checks are steered to the
+ * shorter of the two intervals, so a long console interval does not delay
+ * the records, nor a short sidecar interval multiply the console output.
+ *
+ *
  * Based on a python version by Gustavo Carneiro <gjcarneiro@gmail.com>,
  * as released here:
  *
@@ -121,6 +147,37 @@ class ShowProgress
      */
     void SetVerbose(bool verbose);
 
+    /**
+     * Write a record to a sidecar file every \p interval of wallclock time,
+     * as one JSON object per line.
+     *
+     * @param [in] filename The name of the file, which is truncated; an
+     *             empty name stops the records.
+     * @param [in] interval The target wallclock interval of the records.
+     */
+    void SetSidecar(const std::string& filename, const Time interval = Seconds(1));
+
+    /**
+     * Register a counter, recorded in the sidecar files at each record,
+     * e.g., the packets in flight.
+     *
+     * @param [in] name The name of the counter, prefixed by the module,
+     *             e.g., "point-to-point/packets-in-flight".
+     * @param [in] counter The function which reads the counter.
+     */
+    static void RegisterCounter(const std::string& name, std::function<double()> counter);
+
+    /**
+     * Register the number of events executed by a module, recorded in the
+     * sidecar files as the share of the events of each record.
+     *
+     * @param [in] module The name of the module.
+     * @param [in] counter The function which reads the number of events
+     *             executed by the module since the start of the program.
+     */
+    static void RegisterEventCounter(const std::string& module,
+                                     std::function<uint64_t()> counter);
+
   private:
     /**
      * Start the elapsed wallclock timestamp and print the start time.
@@ -158,6 +215,13 @@ class ShowProgress
      */
     void GiveFeedback(uint64_t nEvents, int64x64_t ratio, int64x64_t speed);
 
+    /**
+     * Write a record to the sidecar file, covering the events since the
+     * last record.
+     * @param [in] events The simulator event count.
+     */
+    void WriteSidecar(uint64_t events);
+
     /**
      * Hysteresis factor.
      * @see Feedback()
@@ -181,6 +245,17 @@ class ShowProgress
     std::ostream* m_os;    //!< The output stream to use.
     bool m_verbose;        //!< Verbose mode flag
     uint64_t m_repCount;   //!< Number of CheckProgress events
+
+    Time m_feedbackElapsed; //!< Elapsed wallclock time since the last output
+    Time m_feedbackTime;    //!< Simulation time of the last output
+
+    std::unique_ptr<std::ofstream> m_sidecar; //!< The sidecar file, if any
+    Time m_sidecarInterval;                   //!< The target record interval, in wallclock time
+    Time m_sidecarElapsed;                    //!< Elapsed wallclock time since the last record
+    Time m_sidecarTime;                       //!< Simulation time of the last record
+    uint64_t m_sidecarEventCount;             //!< Simulator event count at the last record
+    Time m_wallTime;                          //!< Total elapsed wallclock time
+    std::vector<uint64_t> m_moduleEvents;     //!< Module event counts at the last record
 };
 
 } // namespace ns3
@@ -12,6 +12,7 @@
 
 #include "assert.h"
 #include "default-deleter.h"
+#include "multithreading.h"
 
 #include <limits>
 #include <stdint.h>
@@ -114,8 +115,7 @@ class SimpleRefCount : public PARENT
      */
     inline void Unref() const
     {
-        m_count--;
-        if (m_count == 0)
+        if (--m_count == 0)
         {
             DELETER::Delete(static_cast<T*>(const_cast<SimpleRefCount*>(this)));
         }
@@ -140,7 +140,7 @@ class SimpleRefCount : public PARENT
      * Note we make this mutable so that the const methods can still
      * change it.
      */
-    mutable uint32_t m_count;
+    mutable RefCounter m_count;
 };
 
 } // namespace ns3
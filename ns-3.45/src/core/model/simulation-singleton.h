@@ -42,6 +42,7 @@ class SimulationSingleton
      *
      * This instance will be automatically deleted when the
      * simulation is destroyed by a call to Simulator::Destroy.
+     * With the NS3_REPLICATIONS option, each thread has its own instance.
      *
      * @returns A pointer to the singleton instance.
      */
@@ -69,6 +70,7 @@ class SimulationSingleton
  *  Implementation of the templates declared above.
  ********************************************************************/
 
+#include "multithreading.h"
 #include "simulator.h"
 
 namespace ns3
@@ -86,7 +88,7 @@ template <typename T>
 T**
 SimulationSingleton<T>::GetObject()
 {
-    static T* pobject = nullptr;
+    static NS3_SIMULATION_LOCAL T* pobject = nullptr;
     if (pobject == nullptr)
     {
         pobject = new T();
@@ -89,6 +89,10 @@ class SimulatorImpl : public Object
     virtual uint32_t GetContext() const = 0;
     /** @copydoc Simulator::GetEventCount */
     virtual uint64_t GetEventCount() const = 0;
+    /** @copydoc Simulator::GetCancelledEventCount */
+    virtual uint64_t GetCancelledEventCount() const = 0;
+    /** @copydoc Simulator::GetPendingEventCount */
+    virtual uint64_t GetPendingEventCount() const = 0;
 
     /**
      * Hook called before processing each event.
@@ -13,6 +13,7 @@
 #include "global-value.h"
 #include "log.h"
 #include "map-scheduler.h"
+#include "multithreading.h"
 #include "object-factory.h"
 #include "ptr.h"
 #include "scheduler.h"
@@ -21,6 +22,7 @@
 
 #include "ns3/core-config.h"
 
+#include <algorithm>
 #include <cmath>
 #include <fstream>
 #include <iomanip>
@@ -73,13 +75,14 @@ static GlobalValue g_schedTypeImpl =
 
 /**
  * @ingroup simulator
- * @brief Get the static SimulatorImpl instance.
+ * @brief Get the static SimulatorImpl instance, of the calling thread with
+ * the NS3_REPLICATIONS option.
  * @return The SimulatorImpl instance pointer.
  */
 static SimulatorImpl**
 PeekImpl()
 {
-    static SimulatorImpl* impl = nullptr;
+    static NS3_SIMULATION_LOCAL SimulatorImpl* impl = nullptr;
     return &impl;
 }
 
@@ -221,6 +224,79 @@ Simulator::ScheduleNow(const Ptr<EventImpl>& ev)
     return DoScheduleNow(GetPointer(ev));
 }
 
+namespace
+{
+
+/**
+ * @ingroup simulator
+ * The event of the functions of a batch with the same delay.
+ */
+class BatchEventImpl : public EventImpl
+{
+  public:
+    /**
+     * Constructor.
+     * @param [in] functions The functions to invoke, in order.
+     */
+    BatchEventImpl(std::vector<std::function<void()>> functions)
+        : m_functions(std::move(functions))
+    {
+    }
+
+  protected:
+    ~BatchEventImpl() override
+    {
+    }
+
+  private:
+    void Notify() override
+    {
+        for (const auto& function : m_functions)
+        {
+            function();
+        }
+    }
+
+    std::vector<std::function<void()>> m_functions; //!< The functions to invoke
+};
+
+} // namespace
+
+std::vector<EventId>
+Simulator::ScheduleBatch(const EventBatch& events)
+{
+    NS_LOG_FUNCTION(events.size());
+    std::vector<std::size_t> order(events.size());
+    for (std::size_t i = 0; i < order.size(); i++)
+    {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&events](std::size_t a, std::size_t b) {
+        return events[a].first < events[b].first;
+    });
+
+    std::vector<EventId> ids(events.size());
+    std::size_t first = 0;
+    while (first < order.size())
+    {
+        const Time& delay = events[order[first]].first;
+        std::size_t last = first;
+        std::vector<std::function<void()>> functions;
+        while (last < order.size() && events[order[last]].first == delay)
+        {
+            functions.push_back(events[order[last]].second);
+            last++;
+        }
+        EventId id = DoSchedule(delay, new BatchEventImpl(std::move(functions)));
+        for (std::size_t i = first; i < last; i++)
+        {
+            ids[order[i]] = id;
+        }
+        first = last;
+    }
+    return ids;
+}
+
 void
 Simulator::ScheduleWithContext(uint32_t context, const Time& delay, EventImpl* impl)
 {
@@ -315,6 +391,18 @@ Simulator::GetEventCount()
     return GetImpl()->GetEventCount();
 }
 
+uint64_t
+Simulator::GetCancelledEventCount()
+{
+    return GetImpl()->GetCancelledEventCount();
+}
+
+uint64_t
+Simulator::GetPendingEventCount()
+{
+    return GetImpl()->GetPendingEventCount();
+}
+
 uint32_t
 Simulator::GetSystemId()
 {
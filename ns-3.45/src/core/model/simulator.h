@@ -15,8 +15,11 @@
 #include "nstime.h"
 #include "object-factory.h"
 
+#include <functional>
 #include <stdint.h>
 #include <string>
+#include <utility>
+#include <vector>
 
 /**
  * @file
@@ -205,6 +208,27 @@ class Simulator
      */
     static uint64_t GetEventCount();
 
+    /**
+     * Get the number of cancelled events removed from the event list.
+     *
+     * A cancelled event stays in the event list until its time comes:
+     * these dead entries are included in GetEventCount(), and cost as
+     * much to the scheduler as the events which run. A timer which is
+     * often cancelled, or rescheduled, is better implemented by a
+     * ReschedulableTimer.
+     *
+     * @returns The number of cancelled events removed from the event list.
+     */
+    static uint64_t GetCancelledEventCount();
+
+    /**
+     * Get the number of events in the event list, i.e., the size of the
+     * scheduler, including the cancelled events not yet removed.
+     *
+     * @returns The number of events scheduled and not yet executed.
+     */
+    static uint64_t GetPendingEventCount();
+
     /**
      * @name Schedule events (in the same context) to run at a future time.
      */
@@ -487,6 +511,25 @@ class Simulator
      */
     static EventId ScheduleNow(const Ptr<EventImpl>& event);
 
+    /** A batch of events: the delays and the functions to invoke. */
+    typedef std::vector<std::pair<Time, std::function<void()>>> EventBatch;
+
+    /**
+     * Schedule a batch of events (in the same context), e.g., the fan-out
+     * of a packet to many receivers.
+     *
+     * The events with the same delay are inserted in the event list as a
+     * single event, which invokes their functions in the order of the
+     * batch: the cost of the scheduler is paid once per distinct delay
+     * rather than once per event.
+     *
+     * @param [in] events The events.
+     * @returns The identifiers of the events, in the order of the batch.
+     *          The events with the same delay share their identifier:
+     *          cancelling one of them cancels all of them.
+     */
+    static std::vector<EventId> ScheduleBatch(const EventBatch& events);
+
     /**
      * Get the system id of this simulator.
      *
@@ -0,0 +1,126 @@
+//
+// SPDX-License-Identifier: GPL-2.0-only
+//
+
+#include "ns3/event-impl.h"
+#include "ns3/periodic-event.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+#include <vector>
+
+/**
+ * @file
+ * @ingroup core-tests
+ * @ingroup timer
+ * @ingroup timer-tests
+ * PeriodicEvent test suite.
+ */
+
+namespace ns3
+{
+
+namespace tests
+{
+
+/**
+ * @ingroup timer-tests
+ *  PeriodicEvent test
+ */
+class PeriodicEventTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    PeriodicEventTestCase();
+    void DoRun() override;
+    /**
+     * Function invoked periodically: stop after a number of periods.
+     * @param arg The argument passed.
+     */
+    void Expire(int arg);
+    PeriodicEvent m_event;     //!< The periodic event
+    std::vector<Time> m_times; //!< Times of the invocations
+    int m_argument{0};         //!< Argument of the last invocation
+    uint32_t m_stopAfter{0};   //!< Number of invocations before stopping
+};
+
+PeriodicEventTestCase::PeriodicEventTestCase()
+    : TestCase("Check that a periodic event runs once per period, without allocations")
+{
+}
+
+void
+PeriodicEventTestCase::Expire(int arg)
+{
+    m_times.push_back(Simulator::Now());
+    m_argument = arg;
+    if (m_times.size() == m_stopAfter)
+    {
+        m_event.Stop();
+    }
+}
+
+void
+PeriodicEventTestCase::DoRun()
+{
+    m_event.SetFunction(&PeriodicEventTestCase::Expire, this);
+    m_event.SetArguments(7);
+    m_event.SetPeriod(MicroSeconds(10));
+    m_stopAfter = 3;
+    m_event.Start(MicroSeconds(5));
+    NS_TEST_EXPECT_MSG_EQ(m_event.IsRunning(), true, "started");
+    Simulator::Run();
+    NS_TEST_EXPECT_MSG_EQ(m_event.IsRunning(), false, "stopped by the function");
+    std::vector<Time> expected{MicroSeconds(5), MicroSeconds(15), MicroSeconds(25)};
+    NS_TEST_EXPECT_MSG_EQ((m_times == expected), true, "one invocation per period");
+    NS_TEST_EXPECT_MSG_EQ(m_argument, 7, "We did not get the right argument");
+
+    // restarted, the event is allocated once for all its periods
+    m_times.clear();
+    m_stopAfter = 1000;
+    Time start = Simulator::Now();
+    EventImpl::PoolStats before = EventImpl::GetPoolStats();
+    m_event.Start();
+    Simulator::Run();
+    EventImpl::PoolStats after = EventImpl::GetPoolStats();
+    NS_TEST_EXPECT_MSG_EQ(m_times.size(), 1000, "all the periods were run");
+    NS_TEST_EXPECT_MSG_EQ(m_times.front(),
+                          start + MicroSeconds(10),
+                          "first period after the start");
+    NS_TEST_EXPECT_MSG_EQ(m_times.back(), start + MicroSeconds(10000), "last period");
+    NS_TEST_EXPECT_MSG_EQ(after.allocations - before.allocations, 1, "a single event");
+
+    // stopped from outside
+    m_times.clear();
+    m_stopAfter = 0;
+    m_event.Start();
+    Simulator::Schedule(MicroSeconds(25), &PeriodicEvent::Stop, &m_event);
+    Simulator::Run();
+    NS_TEST_EXPECT_MSG_EQ(m_times.size(), 2, "stopped after two periods");
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup timer-tests
+ *  PeriodicEvent test suite
+ */
+class PeriodicEventTestSuite : public TestSuite
+{
+  public:
+    /** Constructor. */
+    PeriodicEventTestSuite()
+        : TestSuite("periodic-event")
+    {
+        AddTestCase(new PeriodicEventTestCase());
+    }
+};
+
+/**
+ * @ingroup timer-tests
+ * PeriodicEventTestSuite instance variable.
+ */
+static PeriodicEventTestSuite g_periodicEventTestSuite;
+
+} // namespace tests
+
+} // namespace ns3
@@ -0,0 +1,197 @@
+//
+// SPDX-License-Identifier: GPL-2.0-only
+//
+
+#include "ns3/event-impl.h"
+#include "ns3/reschedulable-timer.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+#include <vector>
+
+/**
+ * @file
+ * @ingroup core-tests
+ * @ingroup timer
+ * @ingroup timer-tests
+ * ReschedulableTimer test suite.
+ */
+
+namespace ns3
+{
+
+namespace tests
+{
+
+/**
+ * @ingroup timer-tests
+ *  ReschedulableTimer test
+ */
+class ReschedulableTimerTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    ReschedulableTimerTestCase();
+    void DoRun() override;
+    /**
+     * Function to invoke when the timer expires.
+     * @param arg The argument passed.
+     */
+    void Expire(int arg);
+    /** Restart a timeout, the way an acknowledgment restarts a retransmission timeout. */
+    void Restart();
+    /** Restart a timeout with a new event, for comparison. */
+    void RestartEvent();
+
+    /**
+     * Set the function of a timer.
+     * @param timer The timer.
+     */
+    void SetFunction(ReschedulableTimer& timer);
+
+    ReschedulableTimer* m_timer{nullptr}; //!< The timer restarted by Restart()
+    EventId m_event;                      //!< The timeout restarted by RestartEvent()
+    std::vector<Time> m_times;            //!< Times of the expirations
+    int m_argument{0};                    //!< Argument of the last expiration
+};
+
+ReschedulableTimerTestCase::ReschedulableTimerTestCase()
+    : TestCase("Check that a timer can be rescheduled without dead events")
+{
+}
+
+void
+ReschedulableTimerTestCase::Expire(int arg)
+{
+    m_times.push_back(Simulator::Now());
+    m_argument = arg;
+}
+
+void
+ReschedulableTimerTestCase::Restart()
+{
+    m_timer->Schedule(MicroSeconds(10));
+}
+
+void
+ReschedulableTimerTestCase::SetFunction(ReschedulableTimer& timer)
+{
+    timer.SetFunction(&ReschedulableTimerTestCase::Expire, this);
+    timer.SetArguments(3);
+}
+
+void
+ReschedulableTimerTestCase::RestartEvent()
+{
+    m_event.Cancel();
+    m_event = Simulator::Schedule(MicroSeconds(10), &ReschedulableTimerTestCase::Expire, this, 0);
+}
+
+void
+ReschedulableTimerTestCase::DoRun()
+{
+    // restarted 1000 times: no dead event, a single allocation
+    ReschedulableTimer timer;
+    SetFunction(timer);
+    m_timer = &timer;
+    EventImpl::PoolStats before = EventImpl::GetPoolStats();
+    for (int i = 0; i < 1000; i++)
+    {
+        Simulator::Schedule(MicroSeconds(i), &ReschedulableTimerTestCase::Restart, this);
+    }
+    EventImpl::PoolStats after = EventImpl::GetPoolStats();
+    Simulator::Run();
+    EventImpl::PoolStats end = EventImpl::GetPoolStats();
+    NS_TEST_EXPECT_MSG_EQ(m_times.size(), 1, "expired once");
+    NS_TEST_EXPECT_MSG_EQ(m_times.back(), MicroSeconds(1009), "after the last restart");
+    NS_TEST_EXPECT_MSG_EQ(m_argument, 3, "We did not get the right argument");
+    NS_TEST_EXPECT_MSG_EQ(Simulator::GetCancelledEventCount(), 0, "no dead event");
+    NS_TEST_EXPECT_MSG_EQ(after.allocations - before.allocations, 1000, "restart events");
+    NS_TEST_EXPECT_MSG_EQ(end.allocations - after.allocations, 1, "a single timer event");
+    NS_TEST_EXPECT_MSG_EQ(timer.IsRunning(), false, "expired");
+    Simulator::Destroy();
+
+    // the same with a new event at each restart
+    for (int i = 0; i < 1000; i++)
+    {
+        Simulator::Schedule(MicroSeconds(i), &ReschedulableTimerTestCase::RestartEvent, this);
+    }
+    Simulator::Run();
+    NS_TEST_EXPECT_MSG_EQ(Simulator::GetCancelledEventCount(), 999, "dead events");
+    Simulator::Destroy();
+
+    // scheduled earlier than its event
+    m_times.clear();
+    ReschedulableTimer earlier;
+    SetFunction(earlier);
+    earlier.Schedule(MicroSeconds(20));
+    Simulator::Schedule(MicroSeconds(5), &ReschedulableTimer::Schedule, &earlier, MicroSeconds(2));
+    Simulator::Run();
+    std::vector<Time> expected{MicroSeconds(7)};
+    NS_TEST_EXPECT_MSG_EQ((m_times == expected), true, "expired at the earlier time");
+    Simulator::Destroy();
+
+    // cancelled, then scheduled again before its event runs
+    m_times.clear();
+    ReschedulableTimer again;
+    SetFunction(again);
+    again.Schedule(MicroSeconds(10));
+    NS_TEST_EXPECT_MSG_EQ(again.GetDelayLeft(), MicroSeconds(10), "delay left");
+    Simulator::Schedule(MicroSeconds(2), &ReschedulableTimer::Cancel, &again);
+    Simulator::Schedule(MicroSeconds(3), &ReschedulableTimer::Schedule, &again, MicroSeconds(10));
+    Simulator::Run();
+    expected = {MicroSeconds(13)};
+    NS_TEST_EXPECT_MSG_EQ((m_times == expected), true, "expired once, after the second schedule");
+    NS_TEST_EXPECT_MSG_EQ(Simulator::GetCancelledEventCount(), 0, "no dead event");
+    Simulator::Destroy();
+
+    // cancelled
+    m_times.clear();
+    ReschedulableTimer cancelled;
+    SetFunction(cancelled);
+    cancelled.Schedule(MicroSeconds(10));
+    Simulator::Schedule(MicroSeconds(2), &ReschedulableTimer::Cancel, &cancelled);
+    Simulator::Run();
+    NS_TEST_EXPECT_MSG_EQ(m_times.size(), 0, "cancelled");
+    NS_TEST_EXPECT_MSG_EQ(cancelled.GetDelayLeft(), Time(0), "not running");
+    NS_TEST_EXPECT_MSG_EQ(Simulator::GetCancelledEventCount(), 1, "a dead event");
+    Simulator::Destroy();
+
+    // cancelled, then scheduled again after its event ran
+    m_times.clear();
+    ReschedulableTimer late;
+    SetFunction(late);
+    late.Schedule(MicroSeconds(10));
+    Simulator::Schedule(MicroSeconds(2), &ReschedulableTimer::Cancel, &late);
+    Simulator::Schedule(MicroSeconds(15), &ReschedulableTimer::Schedule, &late, MicroSeconds(5));
+    Simulator::Run();
+    expected = {MicroSeconds(20)};
+    NS_TEST_EXPECT_MSG_EQ((m_times == expected), true, "expired after the second schedule");
+    NS_TEST_EXPECT_MSG_EQ(Simulator::GetCancelledEventCount(), 1, "a dead event");
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup timer-tests
+ *  ReschedulableTimer test suite
+ */
+class ReschedulableTimerTestSuite : public TestSuite
+{
+  public:
+    /** Constructor. */
+    ReschedulableTimerTestSuite()
+        : TestSuite("reschedulable-timer")
+    {
+        AddTestCase(new ReschedulableTimerTestCase());
+    }
+};
+
+/**
+ * @ingroup timer-tests
+ * ReschedulableTimerTestSuite instance variable.
+ */
+static ReschedulableTimerTestSuite g_reschedulableTimerTestSuite;
+
+} // namespace tests
+
+} // namespace ns3
@@ -0,0 +1,191 @@
+//
+// SPDX-License-Identifier: GPL-2.0-only
+//
+
+#include "ns3/show-progress.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup core-tests
+ * @ingroup debugging
+ * ShowProgress test suite.
+ */
+
+namespace ns3
+{
+
+namespace tests
+{
+
+namespace
+{
+
+/** The ticks executed by ShowProgressSidecarTestCase, read by the registered counters. */
+uint64_t g_ticks = 0;
+
+/**
+ * Find the number following a key of a sidecar record.
+ * @param [in] record The record.
+ * @param [in] key The key.
+ * @param [out] value The number.
+ * @returns \c true if the key is followed by a number.
+ */
+bool
+FindNumber(const std::string& record, const std::string& key, double& value)
+{
+    const std::string quoted = "\"" + key + "\":";
+    const auto position = record.find(quoted);
+    if (position == std::string::npos)
+    {
+        return false;
+    }
+    std::istringstream is(record.substr(position + quoted.size()));
+    return bool(is >> value);
+}
+
+} // namespace
+
+/**
+ * @ingroup core-tests
+ * Check the sidecar records of ShowProgress.
+ */
+class ShowProgressSidecarTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    ShowProgressSidecarTestCase();
+
+  private:
+    void DoRun() override;
+
+    /** Spend a millisecond of wall clock time, and schedule the next tick. */
+    void Tick();
+};
+
+ShowProgressSidecarTestCase::ShowProgressSidecarTestCase()
+    : TestCase("Check the counters, keys and interval of the sidecar records")
+{
+}
+
+void
+ShowProgressSidecarTestCase::Tick()
+{
+    g_ticks++;
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    Simulator::Schedule(MilliSeconds(1), &ShowProgressSidecarTestCase::Tick, this);
+}
+
+void
+ShowProgressSidecarTestCase::DoRun()
+{
+    static const bool registered = [] {
+        ShowProgress::RegisterCounter("show-progress-test/ticks", [] { return double(g_ticks); });
+        ShowProgress::RegisterEventCounter("show-progress-test", [] { return g_ticks; });
+        ShowProgress::RegisterCounter("show-progress-test/\"quoted\"\\name", [] { return 1.0; });
+        return true;
+    }();
+    NS_TEST_ASSERT_MSG_EQ(registered, true, "the counters are registered");
+
+    const std::string filename = CreateTempDirFilename("show-progress.jsonl");
+    g_ticks = 0;
+    std::ostringstream os;
+    {
+        // the records follow their own interval, not the console one
+        ShowProgress progress(Seconds(100), os);
+        progress.SetSidecar(filename, MilliSeconds(10));
+        Simulator::Schedule(MilliSeconds(1), &ShowProgressSidecarTestCase::Tick, this);
+        Simulator::Stop(MilliSeconds(100));
+        Simulator::Run();
+    }
+    Simulator::Destroy();
+    NS_TEST_EXPECT_MSG_EQ(os.str().find("events processed"),
+                          std::string::npos,
+                          "console output before its interval");
+
+    std::ifstream is(filename);
+    std::vector<std::string> records;
+    for (std::string line; std::getline(is, line);)
+    {
+        records.push_back(line);
+    }
+    NS_TEST_ASSERT_MSG_GT(records.size(), 0, "no record in " << filename);
+
+    double lastTicks = 0;
+    for (const auto& record : records)
+    {
+        NS_TEST_ASSERT_MSG_EQ(record.substr(0, 8), "{\"wall\":", "bad record start " << record);
+        NS_TEST_ASSERT_MSG_EQ(record.substr(record.size() - 2), "}}", "bad record end " << record);
+        double value;
+        for (const std::string key : {"wall",
+                                      "time",
+                                      "speed",
+                                      "events",
+                                      "eventRate",
+                                      "pending",
+                                      "cancelled",
+                                      "rss",
+                                      "maxRss"})
+        {
+            NS_TEST_ASSERT_MSG_EQ(FindNumber(record, key, value), true, "no " << key);
+            NS_TEST_EXPECT_MSG_GT_OR_EQ(value, 0, "negative " << key);
+        }
+        NS_TEST_ASSERT_MSG_EQ(FindNumber(record, "time", value), true, "no time");
+        NS_TEST_EXPECT_MSG_LT_OR_EQ(value, 0.1, "record after the end of the simulation");
+
+        double ticks;
+        NS_TEST_ASSERT_MSG_EQ(FindNumber(record, "show-progress-test/ticks", ticks),
+                              true,
+                              "no counter in " << record);
+        NS_TEST_EXPECT_MSG_GT_OR_EQ(ticks, lastTicks, "the counter went back");
+        NS_TEST_EXPECT_MSG_LT_OR_EQ(ticks, double(g_ticks), "the counter ran ahead");
+        lastTicks = ticks;
+
+        double share;
+        NS_TEST_ASSERT_MSG_EQ(FindNumber(record, "show-progress-test", share),
+                              true,
+                              "no event share in " << record);
+        NS_TEST_EXPECT_MSG_GT_OR_EQ(share, 0, "negative event share");
+        NS_TEST_EXPECT_MSG_LT_OR_EQ(share, 1, "event share above one");
+
+        const std::string escaped = "show-progress-test/\\\"quoted\\\"\\\\name";
+        NS_TEST_EXPECT_MSG_EQ(FindNumber(record, escaped, value),
+                              true,
+                              "the counter name is not escaped in " << record);
+    }
+    NS_TEST_EXPECT_MSG_GT(lastTicks, 0, "the counter did not move");
+    NS_TEST_EXPECT_MSG_GT(records.size(), 1, "the records do not follow their interval");
+}
+
+/**
+ * @ingroup core-tests
+ * ShowProgress test suite.
+ */
+class ShowProgressTestSuite : public TestSuite
+{
+  public:
+    /** Constructor. */
+    ShowProgressTestSuite()
+        : TestSuite("show-progress")
+    {
+        AddTestCase(new ShowProgressSidecarTestCase());
+    }
+};
+
+/**
+ * @ingroup core-tests
+ * ShowProgressTestSuite instance variable.
+ */
+static ShowProgressTestSuite g_showProgressTestSuite;
+
+} // namespace tests
+
+} // namespace ns3
@@ -6,12 +6,24 @@
  * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
  */
 #include "ns3/calendar-scheduler.h"
+#include "ns3/event-profiler.h"
 #include "ns3/heap-scheduler.h"
+#include "ns3/ladder-scheduler.h"
 #include "ns3/list-scheduler.h"
 #include "ns3/map-scheduler.h"
 #include "ns3/priority-queue-scheduler.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/recording-scheduler.h"
+#include "ns3/rng-seed-manager.h"
 #include "ns3/simulator.h"
+#include "ns3/string.h"
 #include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <random>
+#include <set>
+#include <sstream>
+#include <thread>
 
 using namespace ns3;
 
@@ -651,6 +663,573 @@ SimulatorTemplateTestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup simulator-tests
+ *
+ * @brief Check the order of the events of a scheduler, with a skewed
+ * distribution of the event times and random removals.
+ */
+class SchedulerOrderTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor.
+     * @param schedulerFactory Scheduler factory.
+     */
+    SchedulerOrderTestCase(ObjectFactory schedulerFactory);
+
+  private:
+    void DoRun() override;
+
+    ObjectFactory m_schedulerFactory; //!< Scheduler factory.
+};
+
+SchedulerOrderTestCase::SchedulerOrderTestCase(ObjectFactory schedulerFactory)
+    : TestCase("Check the order of random events with " + schedulerFactory.GetTypeId().GetName()),
+      m_schedulerFactory(schedulerFactory)
+{
+}
+
+void
+SchedulerOrderTestCase::DoRun()
+{
+    Ptr<Scheduler> scheduler = m_schedulerFactory.Create<Scheduler>();
+    std::set<Scheduler::EventKey> expected;
+    std::vector<Scheduler::EventKey> pending; // for random removals
+    std::mt19937_64 rng(1);
+    uint64_t now = 0;
+    uint32_t uid = 0;
+
+    for (uint32_t i = 0; i < 200000; i++)
+    {
+        uint32_t op = rng() % 100;
+        if (op < 55 || expected.empty())
+        {
+            // mostly short delays, some medium ones, and a few long timers
+            uint32_t kind = rng() % 100;
+            uint64_t delay = kind < 70   ? rng() % 100
+                             : kind < 95 ? 1000 + rng() % 10000
+                                         : 100000000 + rng() % 900000000;
+            Scheduler::Event ev;
+            ev.impl = nullptr;
+            ev.key.m_ts = now + delay;
+            ev.key.m_uid = uid++;
+            ev.key.m_context = 0;
+            scheduler->Insert(ev);
+            expected.insert(ev.key);
+            pending.push_back(ev.key);
+        }
+        else if (op < 95)
+        {
+            NS_TEST_ASSERT_MSG_EQ(scheduler->IsEmpty(), false, "not empty");
+            Scheduler::Event next = scheduler->PeekNext();
+            NS_TEST_ASSERT_MSG_EQ(next.key.m_uid, expected.begin()->m_uid, "next event");
+            next = scheduler->RemoveNext();
+            NS_TEST_ASSERT_MSG_EQ(next.key.m_uid, expected.begin()->m_uid, "removed event");
+            now = next.key.m_ts;
+            expected.erase(expected.begin());
+        }
+        else
+        {
+            // remove a random event, which may have already run
+            std::size_t j = rng() % pending.size();
+            Scheduler::EventKey key = pending[j];
+            pending[j] = pending.back();
+            pending.pop_back();
+            if (expected.erase(key))
+            {
+                Scheduler::Event ev;
+                ev.impl = nullptr;
+                ev.key = key;
+                scheduler->Remove(ev);
+            }
+        }
+    }
+    while (!expected.empty())
+    {
+        Scheduler::Event next = scheduler->RemoveNext();
+        NS_TEST_ASSERT_MSG_EQ(next.key.m_uid, expected.begin()->m_uid, "removed event");
+        expected.erase(expected.begin());
+    }
+    NS_TEST_EXPECT_MSG_EQ(scheduler->IsEmpty(), true, "empty");
+}
+
+/**
+ * @ingroup simulator-tests
+ *
+ * @brief Check that the events are recycled by the event pool.
+ */
+class SimulatorEventPoolTestCase : public TestCase
+{
+  public:
+    SimulatorEventPoolTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Reschedule itself until the count is reached.
+     * @param value a value, to make the event larger than a bare member call
+     */
+    void Chain(uint64_t value);
+
+    uint32_t m_count{0}; //!< Number of events run
+};
+
+SimulatorEventPoolTestCase::SimulatorEventPoolTestCase()
+    : TestCase("Event pool")
+{
+}
+
+void
+SimulatorEventPoolTestCase::Chain(uint64_t value)
+{
+    if (++m_count < 10000)
+    {
+        Simulator::Schedule(NanoSeconds(1), &SimulatorEventPoolTestCase::Chain, this, value + 1);
+    }
+}
+
+void
+SimulatorEventPoolTestCase::DoRun()
+{
+    // warm up the pool, then check that a steady population does not reach the heap
+    Simulator::Schedule(NanoSeconds(1), &SimulatorEventPoolTestCase::Chain, this, 0);
+    Simulator::Run();
+    m_count = 0;
+    EventImpl::PoolStats before = EventImpl::GetPoolStats();
+    Simulator::Schedule(NanoSeconds(1), &SimulatorEventPoolTestCase::Chain, this, 0);
+    Simulator::Run();
+    EventImpl::PoolStats after = EventImpl::GetPoolStats();
+    NS_TEST_EXPECT_MSG_EQ(m_count, 10000, "all the events were run");
+    NS_TEST_EXPECT_MSG_GT_OR_EQ(after.allocations - before.allocations, 10000, "allocations");
+    NS_TEST_EXPECT_MSG_EQ(after.heapAllocations, before.heapAllocations, "recycled events");
+
+    // an event allocated by another thread can be released by this one
+    EventImpl* event = nullptr;
+    std::thread thread([&event]() { event = MakeEvent([]() {}); });
+    thread.join();
+    event->Invoke();
+    event->Unref();
+
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup simulator-tests
+ *
+ * @brief Check that the operations recorded by the RecordingScheduler can be
+ * replayed against another scheduler.
+ */
+class RecordingSchedulerTestCase : public TestCase
+{
+  public:
+    RecordingSchedulerTestCase();
+
+  private:
+    void DoRun() override;
+
+    /** Reschedule itself a few times, and cancel another event. */
+    void Chain();
+
+    uint32_t m_count{0}; //!< Number of events run
+};
+
+RecordingSchedulerTestCase::RecordingSchedulerTestCase()
+    : TestCase("Record and replay the scheduler operations")
+{
+}
+
+void
+RecordingSchedulerTestCase::Chain()
+{
+    if (++m_count < 100)
+    {
+        Simulator::Schedule(MicroSeconds(m_count % 7), &RecordingSchedulerTestCase::Chain, this);
+        EventId timer = Simulator::Schedule(Seconds(1), &RecordingSchedulerTestCase::Chain, this);
+        Simulator::Cancel(timer);
+    }
+}
+
+void
+RecordingSchedulerTestCase::DoRun()
+{
+    std::string filename = CreateTempDirFilename("simulator.evt");
+    ObjectFactory factory(RecordingScheduler::GetTypeId().GetName());
+    factory.Set("FileName", StringValue(filename));
+    Simulator::SetScheduler(factory);
+
+    Simulator::Schedule(Seconds(0), &RecordingSchedulerTestCase::Chain, this);
+    Simulator::ScheduleWithContext(7, MilliSeconds(1), []() {});
+    EventId removed = Simulator::Schedule(MilliSeconds(2), []() {});
+    Simulator::Remove(removed);
+    Simulator::Run();
+    Simulator::Destroy();
+
+    // 100 chained events and 99 cancelled timers, the event with a context,
+    // and the removed one
+    auto operations = RecordingScheduler::ReadFile(filename);
+    uint32_t count[4] = {0, 0, 0, 0};
+    for (const auto& op : operations)
+    {
+        count[op.type]++;
+    }
+    NS_TEST_EXPECT_MSG_EQ(count[RecordingScheduler::Operation::INSERT], 201, "insertions");
+    NS_TEST_EXPECT_MSG_EQ(count[RecordingScheduler::Operation::REMOVE], 1, "removal");
+    NS_TEST_EXPECT_MSG_EQ(count[RecordingScheduler::Operation::REMOVE_NEXT], 101, "events");
+    NS_TEST_EXPECT_MSG_EQ(count[RecordingScheduler::Operation::CANCELLED], 99, "cancelled");
+    NS_TEST_EXPECT_MSG_EQ(operations[1].key.m_context, 7, "context");
+    NS_TEST_EXPECT_MSG_EQ(operations[1].key.m_ts,
+                          static_cast<uint64_t>(MilliSeconds(1).GetTimeStep()),
+                          "timestamp");
+    NS_TEST_EXPECT_MSG_EQ(operations[0].key.m_context,
+                          static_cast<uint32_t>(Simulator::NO_CONTEXT),
+                          "no context");
+
+    // the events are removed in the same order by another scheduler
+    Ptr<Scheduler> scheduler = CreateObject<HeapScheduler>();
+    for (const auto& op : operations)
+    {
+        Scheduler::Event ev{nullptr, op.key};
+        if (op.type == RecordingScheduler::Operation::INSERT)
+        {
+            scheduler->Insert(ev);
+        }
+        else if (op.type == RecordingScheduler::Operation::REMOVE)
+        {
+            scheduler->Remove(ev);
+        }
+        else
+        {
+            NS_TEST_ASSERT_MSG_EQ(scheduler->RemoveNext().key.m_ts, op.key.m_ts, "replay");
+        }
+    }
+    NS_TEST_EXPECT_MSG_EQ(scheduler->IsEmpty(), true, "all the events were replayed");
+}
+
+#ifdef NS3_REPLICATIONS
+/**
+ * @ingroup simulator-tests
+ *
+ * @brief Check that the threads run independent simulations, with their own
+ * random number streams.
+ */
+class SimulatorReplicationsTestCase : public TestCase
+{
+  public:
+    SimulatorReplicationsTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Run a simulation which reschedules an event a number of times.
+     * @param run The run number.
+     * @param count The number of events.
+     * @param [out] end The time of the last event.
+     * @param [out] value A random value drawn by the first event.
+     */
+    static void Replication(uint64_t run, uint32_t count, Time* end, double* value);
+};
+
+SimulatorReplicationsTestCase::SimulatorReplicationsTestCase()
+    : TestCase("Replications in threads")
+{
+}
+
+void
+SimulatorReplicationsTestCase::Replication(uint64_t run, uint32_t count, Time* end, double* value)
+{
+    RngSeedManager::SetRun(run);
+    Ptr<UniformRandomVariable> uniform = CreateObject<UniformRandomVariable>();
+    *value = uniform->GetValue();
+    std::function<void()> chain = [&chain, &count]() {
+        if (--count > 0)
+        {
+            Simulator::Schedule(MicroSeconds(1), chain);
+        }
+    };
+    Simulator::Schedule(MicroSeconds(1), chain);
+    Simulator::Run();
+    *end = Simulator::Now();
+    Simulator::Destroy();
+}
+
+void
+SimulatorReplicationsTestCase::DoRun()
+{
+    // each run twice, concurrently
+    const uint32_t nRuns = 4;
+    std::vector<Time> ends(2 * nRuns);
+    std::vector<double> values(2 * nRuns);
+    std::vector<std::thread> threads;
+    for (uint32_t i = 0; i < ends.size(); i++)
+    {
+        uint32_t run = i % nRuns + 1;
+        threads.emplace_back(&Replication, run, 1000 * run, &ends[i], &values[i]);
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    for (uint32_t i = 0; i < ends.size(); i++)
+    {
+        uint32_t run = i % nRuns + 1;
+        NS_TEST_EXPECT_MSG_EQ(ends[i], MicroSeconds(1000 * run), "independent simulators");
+        NS_TEST_EXPECT_MSG_EQ(values[i], values[i % nRuns], "the random values of the run");
+        NS_TEST_EXPECT_MSG_NE(values[i], values[(i + 1) % nRuns], "the runs differ");
+    }
+}
+#endif
+
+/**
+ * @ingroup simulator-tests
+ *
+ * @brief Check that a batch of events runs in order, with one event per
+ * distinct delay.
+ */
+class SimulatorBatchTestCase : public TestCase
+{
+  public:
+    SimulatorBatchTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+SimulatorBatchTestCase::SimulatorBatchTestCase()
+    : TestCase("Batched scheduling")
+{
+}
+
+void
+SimulatorBatchTestCase::DoRun()
+{
+    std::vector<std::pair<int, Time>> runs;
+    auto record = [&runs](int i) { runs.emplace_back(i, Simulator::Now()); };
+    Simulator::EventBatch batch;
+    for (int i = 0; i < 6; i++)
+    {
+        batch.emplace_back(MicroSeconds(i % 3 == 1 ? 5 : 10 * (i % 3)), [record, i]() {
+            record(i);
+        });
+    }
+    std::vector<EventId> ids = Simulator::ScheduleBatch(batch);
+    NS_TEST_EXPECT_MSG_EQ(ids.size(), batch.size(), "one identifier per event");
+    NS_TEST_EXPECT_MSG_EQ((ids[1] == ids[4]), true, "the same delay shares an event");
+    NS_TEST_EXPECT_MSG_EQ((ids[1] == ids[2]), false, "distinct delays, distinct events");
+    Simulator::Cancel(ids[2]);
+    NS_TEST_EXPECT_MSG_EQ(Simulator::GetPendingEventCount(), 3, "cancelled events are pending");
+
+    uint64_t before = Simulator::GetEventCount();
+    Simulator::Run();
+    NS_TEST_EXPECT_MSG_EQ(Simulator::GetEventCount() - before, 3, "one event per delay");
+    NS_TEST_EXPECT_MSG_EQ(Simulator::GetPendingEventCount(), 0, "no event left");
+    std::vector<std::pair<int, Time>> expected{{0, MicroSeconds(0)},
+                                               {3, MicroSeconds(0)},
+                                               {1, MicroSeconds(5)},
+                                               {4, MicroSeconds(5)}};
+    NS_TEST_EXPECT_MSG_EQ((runs == expected), true, "the events ran in order");
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup simulator-tests
+ *
+ * @brief Check that the event profiler counts the events by function and
+ * context.
+ */
+class EventProfilerTestCase : public TestCase
+{
+  public:
+    EventProfilerTestCase();
+
+    /** An event function. */
+    void Tick();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * @param [in] report The report of the profiler.
+     * @param [in] name The name of a function, or its start.
+     * @param [in] context The context, or "" for the table by function.
+     * @returns The number of events of the function in the report.
+     */
+    uint64_t GetCount(const std::string& report,
+                      const std::string& name,
+                      const std::string& context);
+
+    /**
+     * @param [in] report The report of the profiler.
+     * @param [in] name The name of a function, or its start.
+     * @param [in] context The context, or "" for the table by function.
+     * @returns The mean run time of the events of the function in the
+     *          report, in nanoseconds.
+     */
+    double GetNsPerEvent(const std::string& report,
+                         const std::string& name,
+                         const std::string& context);
+
+    /**
+     * @param [in] report The report of the profiler.
+     * @param [in] name The name of a function, or its start.
+     * @param [in] context The context, or "" for the table by function.
+     * @param [out] count The number of events of the function.
+     * @param [out] nsPerEvent Their mean run time, in nanoseconds.
+     * @returns true if the function is in the report.
+     */
+    bool FindLine(const std::string& report,
+                  const std::string& name,
+                  const std::string& context,
+                  uint64_t& count,
+                  double& nsPerEvent);
+
+    uint32_t m_ticks{0}; //!< Number of calls to Tick()
+};
+
+EventProfilerTestCase::EventProfilerTestCase()
+    : TestCase("Event profiler")
+{
+}
+
+void
+EventProfilerTestCase::Tick()
+{
+    m_ticks++;
+}
+
+bool
+EventProfilerTestCase::FindLine(const std::string& report,
+                                const std::string& name,
+                                const std::string& context,
+                                uint64_t& count,
+                                double& nsPerEvent)
+{
+    // skip the table by function to look for a context
+    std::size_t start = context.empty() ? 0 : report.find("By function and context");
+    std::istringstream is(report.substr(start));
+    std::string line;
+    while (std::getline(is, line))
+    {
+        std::istringstream fields(line);
+        std::string percent;
+        std::string time;
+        std::string lineContext;
+        std::string function;
+        fields >> count >> percent >> time >> nsPerEvent;
+        if (!context.empty())
+        {
+            fields >> lineContext;
+        }
+        std::getline(fields >> std::ws, function);
+        if (fields && lineContext == context && function.starts_with(name))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+uint64_t
+EventProfilerTestCase::GetCount(const std::string& report,
+                                const std::string& name,
+                                const std::string& context)
+{
+    uint64_t count;
+    double nsPerEvent;
+    return FindLine(report, name, context, count, nsPerEvent) ? count : 0;
+}
+
+double
+EventProfilerTestCase::GetNsPerEvent(const std::string& report,
+                                     const std::string& name,
+                                     const std::string& context)
+{
+    uint64_t count;
+    double nsPerEvent;
+    return FindLine(report, name, context, count, nsPerEvent) ? nsPerEvent : 0;
+}
+
+void
+EventProfilerTestCase::DoRun()
+{
+    EventProfiler profiler;
+    uint32_t lambdas = 0;
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        EventImpl* tick = MakeEvent(&EventProfilerTestCase::Tick, this);
+        profiler.Invoke(tick, i % 2);
+        tick->Unref();
+        EventImpl* lambda = MakeEvent([&lambdas]() { lambdas++; });
+        profiler.Invoke(lambda, Simulator::NO_CONTEXT);
+        lambda->Unref();
+    }
+    NS_TEST_EXPECT_MSG_EQ(m_ticks, 10, "the events were run");
+    NS_TEST_EXPECT_MSG_EQ(lambdas, 10, "the events were run");
+
+    std::ostringstream os;
+    profiler.Print(os);
+    std::string report = os.str();
+    // the name of the symbol, or of the signature without dynamic symbols
+    std::string tick = "EventProfilerTestCase::Tick()";
+    std::string signature = "void (EventProfilerTestCase::*)()";
+    NS_TEST_EXPECT_MSG_EQ(GetCount(report, tick, "") + GetCount(report, signature, ""),
+                          10,
+                          "by function\n"
+                              << report);
+    NS_TEST_EXPECT_MSG_EQ(GetCount(report, tick, "0") + GetCount(report, signature, "0"),
+                          5,
+                          "by context\n"
+                              << report);
+    NS_TEST_EXPECT_MSG_EQ(GetCount(report, tick, "1") + GetCount(report, signature, "1"),
+                          5,
+                          "by context\n"
+                              << report);
+    NS_TEST_EXPECT_MSG_EQ(report.find("EventProfilerTestCase::DoRun()::{lambda()#1}") !=
+                              std::string::npos,
+                          true,
+                          "lambda\n"
+                              << report);
+
+    // only some events are timed, but all are counted
+    EventProfiler sampled(3);
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        EventImpl* event = MakeEvent(&EventProfilerTestCase::Tick, this);
+        sampled.Invoke(event, 0);
+        event->Unref();
+    }
+    NS_TEST_EXPECT_MSG_EQ(m_ticks, 20, "the sampled events were run");
+    std::ostringstream sampledOs;
+    sampled.Print(sampledOs);
+    report = sampledOs.str();
+    NS_TEST_EXPECT_MSG_EQ(GetCount(report, tick, "0") + GetCount(report, signature, "0"),
+                          10,
+                          "sampled\n"
+                              << report);
+
+    // two sites which alternate with the sampling period are both timed
+    EventProfiler alternate(2);
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        EventImpl* event = MakeEvent(&EventProfilerTestCase::Tick, this);
+        alternate.Invoke(event, i % 2);
+        event->Unref();
+    }
+    std::ostringstream alternateOs;
+    alternate.Print(alternateOs);
+    report = alternateOs.str();
+    for (const std::string context : {"0", "1"})
+    {
+        NS_TEST_EXPECT_MSG_GT(GetNsPerEvent(report, tick, context) +
+                                  GetNsPerEvent(report, signature, context),
+                              0,
+                              "timed in context " << context << "\n"
+                                                   << report);
+    }
+}
+
 /**
  * @ingroup simulator-tests
  *
@@ -670,10 +1249,24 @@ class SimulatorTestSuite : public TestSuite
         AddTestCase(new SimulatorEventsTestCase(factory), TestCase::Duration::QUICK);
         factory.SetTypeId(HeapScheduler::GetTypeId());
         AddTestCase(new SimulatorEventsTestCase(factory), TestCase::Duration::QUICK);
+        AddTestCase(new SchedulerOrderTestCase(factory), TestCase::Duration::QUICK);
         factory.SetTypeId(CalendarScheduler::GetTypeId());
         AddTestCase(new SimulatorEventsTestCase(factory), TestCase::Duration::QUICK);
         factory.SetTypeId(PriorityQueueScheduler::GetTypeId());
         AddTestCase(new SimulatorEventsTestCase(factory), TestCase::Duration::QUICK);
+        factory.SetTypeId(LadderScheduler::GetTypeId());
+        AddTestCase(new SimulatorEventsTestCase(factory), TestCase::Duration::QUICK);
+        AddTestCase(new SchedulerOrderTestCase(factory), TestCase::Duration::QUICK);
+        factory.Set("Threshold", UintegerValue(4));
+        factory.Set("MaxRungs", UintegerValue(3));
+        AddTestCase(new SchedulerOrderTestCase(factory), TestCase::Duration::QUICK);
+        AddTestCase(new SimulatorEventPoolTestCase, TestCase::Duration::QUICK);
+        AddTestCase(new SimulatorBatchTestCase, TestCase::Duration::QUICK);
+#ifdef NS3_REPLICATIONS
+        AddTestCase(new SimulatorReplicationsTestCase, TestCase::Duration::QUICK);
+#endif
+        AddTestCase(new RecordingSchedulerTestCase, TestCase::Duration::QUICK);
+        AddTestCase(new EventProfilerTestCase, TestCase::Duration::QUICK);
     }
 };
 
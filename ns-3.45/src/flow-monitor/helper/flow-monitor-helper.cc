@@ -8,6 +8,7 @@
 
 #include "flow-monitor-helper.h"
 
+#include "ns3/abort.h"
 #include "ns3/flow-monitor.h"
 #include "ns3/ipv4-flow-classifier.h"
 #include "ns3/ipv4-flow-probe.h"
@@ -17,6 +18,7 @@
 #include "ns3/ipv6-l3-protocol.h"
 #include "ns3/node-list.h"
 #include "ns3/node.h"
+#include "ns3/uinteger.h"
 
 namespace ns3
 {
@@ -43,6 +45,17 @@ FlowMonitorHelper::SetMonitorAttribute(std::string n1, const AttributeValue& v1)
     m_monitorFactory.Set(n1, v1);
 }
 
+void
+FlowMonitorHelper::SetSampling(uint32_t flowSamplingPeriod,
+                               uint32_t packetSamplingPeriod,
+                               uint32_t seed)
+{
+    NS_ABORT_MSG_IF(m_flowMonitor, "Sampling must be set before the monitor is created");
+    m_monitorFactory.Set("FlowSamplingPeriod", UintegerValue(flowSamplingPeriod));
+    m_monitorFactory.Set("PacketSamplingPeriod", UintegerValue(packetSamplingPeriod));
+    m_monitorFactory.Set("SamplingSeed", UintegerValue(seed));
+}
+
 Ptr<FlowMonitor>
 FlowMonitorHelper::GetMonitor()
 {
@@ -160,4 +173,13 @@ FlowMonitorHelper::SerializeToXmlFile(std::string fileName,
     }
 }
 
+void
+FlowMonitorHelper::SerializeToColumnarFile(std::string fileName)
+{
+    if (m_flowMonitor)
+    {
+        m_flowMonitor->SerializeToColumnarFile(fileName);
+    }
+}
+
 } // namespace ns3
@@ -43,6 +43,20 @@ class FlowMonitorHelper
      */
     void SetMonitorAttribute(std::string n1, const AttributeValue& v1);
 
+    /**
+     * @brief Monitor a sample of the flows and of their packets.
+     *
+     * Sets the FlowSamplingPeriod, PacketSamplingPeriod and SamplingSeed
+     * attributes of the to-be-created FlowMonitor. Unsampled packets are
+     * rejected by the classifiers with a hash check, before any lookup, and
+     * are ignored by all the probes. Use FlowMonitor::GetEstimatedTotals()
+     * to estimate the totals of all the flows.
+     * @param flowSamplingPeriod monitor 1 in this many flows (1: all)
+     * @param packetSamplingPeriod monitor 1 in this many packets of a monitored flow (1: all)
+     * @param seed the seed of the sampling hashes
+     */
+    void SetSampling(uint32_t flowSamplingPeriod, uint32_t packetSamplingPeriod, uint32_t seed = 0);
+
     /**
      * @brief Enable flow monitoring on a set of nodes
      * @param nodes A NodeContainer holding the set of nodes to work with.
@@ -108,6 +122,12 @@ class FlowMonitorHelper
      */
     void SerializeToXmlFile(std::string fileName, bool enableHistograms, bool enableProbes);
 
+    /**
+     * Writes the per-flow statistics to a binary columnar file
+     * @param fileName name or path of the output file that will be created
+     */
+    void SerializeToColumnarFile(std::string fileName);
+
   private:
     ObjectFactory m_monitorFactory;        //!< Object factory
     Ptr<FlowMonitor> m_flowMonitor;        //!< the FlowMonitor object
@@ -12,7 +12,10 @@ namespace ns3
 {
 
 FlowClassifier::FlowClassifier()
-    : m_lastNewFlowId(0)
+    : m_lastNewFlowId(0),
+      m_flowSamplingPeriod(1),
+      m_packetSamplingPeriod(1),
+      m_samplingSeed(0)
 {
 }
 
@@ -20,6 +23,16 @@ FlowClassifier::~FlowClassifier()
 {
 }
 
+void
+FlowClassifier::SetSampling(uint32_t flowSamplingPeriod,
+                            uint32_t packetSamplingPeriod,
+                            uint32_t seed)
+{
+    m_flowSamplingPeriod = flowSamplingPeriod;
+    m_packetSamplingPeriod = packetSamplingPeriod;
+    m_samplingSeed = seed;
+}
+
 FlowId
 FlowClassifier::GetNewFlowId()
 {
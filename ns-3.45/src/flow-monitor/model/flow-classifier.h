@@ -42,7 +42,10 @@ typedef uint32_t FlowPacketId;
 class FlowClassifier : public SimpleRefCount<FlowClassifier>
 {
   private:
-    FlowId m_lastNewFlowId; //!< Last known Flow ID
+    FlowId m_lastNewFlowId;         //!< Last known Flow ID
+    uint32_t m_flowSamplingPeriod;   //!< Classify 1 in m_flowSamplingPeriod flows
+    uint32_t m_packetSamplingPeriod; //!< Classify 1 in m_packetSamplingPeriod packets of a flow
+    uint64_t m_samplingSeed;         //!< Seed of the sampling hashes
 
   public:
     FlowClassifier();
@@ -57,7 +60,39 @@ class FlowClassifier : public SimpleRefCount<FlowClassifier>
     /// @param indent number of spaces to use as base indentation level
     virtual void SerializeToXmlStream(std::ostream& os, uint16_t indent) const = 0;
 
+    /// Configure deterministic flow and packet sampling. A flow is sampled
+    /// based on a hash of its key (e.g., its five-tuple), and a packet of a
+    /// sampled flow based on a hash of its identifiers, so that the same
+    /// flows and packets are selected by every run with the same seed.
+    /// Classify() only accepts the packets that are sampled.
+    /// @param flowSamplingPeriod 1 in flowSamplingPeriod flows is classified (1: all)
+    /// @param packetSamplingPeriod 1 in packetSamplingPeriod packets of a sampled flow
+    ///        is classified (1: all)
+    /// @param seed the seed of the sampling hashes
+    void SetSampling(uint32_t flowSamplingPeriod, uint32_t packetSamplingPeriod, uint32_t seed);
+
   protected:
+    /// Check whether a flow is sampled; this is meant to be called before
+    /// looking the flow up, so that unsampled packets are rejected cheaply.
+    /// The key is not hashed when all the flows are sampled.
+    /// @tparam Hash the hash function object of the flow key
+    /// @tparam Key the flow key type
+    /// @param key the flow key
+    /// @returns true if the flow is sampled
+    template <typename Hash, typename Key>
+    bool IsFlowSampled(const Key& key) const;
+
+    /// Check whether a packet of a sampled flow is sampled.
+    /// @param flowId the flow identifier
+    /// @param packetId the packet identifier
+    /// @returns true if the packet is sampled
+    bool IsPacketSampled(FlowId flowId, FlowPacketId packetId) const;
+
+    /// Mix the bits of a hash, so that its low-order bits are usable
+    /// @param h the hash
+    /// @returns the mixed hash
+    static uint64_t MixHash(uint64_t h);
+
     /// Returns a new, unique Flow Identifier
     /// @returns a new FlowId
     FlowId GetNewFlowId();
@@ -69,6 +104,33 @@ class FlowClassifier : public SimpleRefCount<FlowClassifier>
     void Indent(std::ostream& os, uint16_t level) const;
 };
 
+inline uint64_t
+FlowClassifier::MixHash(uint64_t h)
+{
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+template <typename Hash, typename Key>
+inline bool
+FlowClassifier::IsFlowSampled(const Key& key) const
+{
+    return m_flowSamplingPeriod <= 1 ||
+           MixHash(Hash()(key) ^ m_samplingSeed) % m_flowSamplingPeriod == 0;
+}
+
+inline bool
+FlowClassifier::IsPacketSampled(FlowId flowId, FlowPacketId packetId) const
+{
+    uint64_t key = (static_cast<uint64_t>(flowId) << 32) | packetId;
+    return m_packetSamplingPeriod <= 1 ||
+           MixHash(key ^ (m_samplingSeed * 0x9e3779b97f4a7c15ULL)) % m_packetSamplingPeriod == 0;
+}
+
 inline void
 FlowClassifier::Indent(std::ostream& os, uint16_t level) const
 {
@@ -0,0 +1,260 @@
+//
+// SPDX-License-Identifier: GPL-2.0-only
+//
+
+#ifndef FLOW_HASH_MAP_H
+#define FLOW_HASH_MAP_H
+
+#include "ns3/assert.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * @ingroup flow-monitor
+ * @brief Open-addressing hash map used on the per-packet paths of the flow monitor.
+ *
+ * Entries are stored inline in a single power-of-two sized array and
+ * collisions are resolved by linear probing; deletions use backward
+ * shifting, so there are no tombstones and lookups never degrade with
+ * churn. Memory is only allocated when the table grows, which makes
+ * insertions and removals allocation-free once the table has reached its
+ * working size.
+ *
+ * Pointers returned by Find() and Insert() are invalidated by any
+ * subsequent Insert() or Erase().
+ *
+ * @tparam Key the key type; must be default-constructible and copyable
+ * @tparam Value the value type; must be default-constructible and copyable
+ * @tparam Hash the hash functor for Key
+ * @tparam KeyEqual the equality functor for Key
+ */
+template <typename Key,
+          typename Value,
+          typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>>
+class FlowHashMap
+{
+  public:
+    FlowHashMap()
+        : m_size(0)
+    {
+    }
+
+    /**
+     * Find the value associated with a key.
+     * @param key the key
+     * @return a pointer to the value, or nullptr if the key is not present
+     */
+    Value* Find(const Key& key)
+    {
+        if (m_size == 0)
+        {
+            return nullptr;
+        }
+        std::size_t mask = m_slots.size() - 1;
+        for (std::size_t i = Home(key); m_slots[i].used; i = (i + 1) & mask)
+        {
+            if (KeyEqual()(m_slots[i].key, key))
+            {
+                return &m_slots[i].value;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * Find the value associated with a key.
+     * @param key the key
+     * @return a pointer to the value, or nullptr if the key is not present
+     */
+    const Value* Find(const Key& key) const
+    {
+        return const_cast<FlowHashMap*>(this)->Find(key);
+    }
+
+    /**
+     * Insert a key, unless it is already present.
+     * @param key the key
+     * @param value the value to associate with the key if it is not present
+     * @return a pointer to the value associated with the key, and true if the
+     *         key was inserted or false if it was already present
+     */
+    std::pair<Value*, bool> Insert(const Key& key, const Value& value)
+    {
+        if ((m_size + 1) * 2 > m_slots.size())
+        {
+            Rehash(m_slots.empty() ? 16 : m_slots.size() * 2);
+        }
+        std::size_t mask = m_slots.size() - 1;
+        std::size_t i = Home(key);
+        for (; m_slots[i].used; i = (i + 1) & mask)
+        {
+            if (KeyEqual()(m_slots[i].key, key))
+            {
+                return {&m_slots[i].value, false};
+            }
+        }
+        m_slots[i].key = key;
+        m_slots[i].value = value;
+        m_slots[i].used = true;
+        ++m_size;
+        return {&m_slots[i].value, true};
+    }
+
+    /**
+     * Remove a key.
+     * @param key the key
+     * @return true if the key was present
+     */
+    bool Erase(const Key& key)
+    {
+        if (m_size == 0)
+        {
+            return false;
+        }
+        std::size_t mask = m_slots.size() - 1;
+        std::size_t i = Home(key);
+        for (; m_slots[i].used; i = (i + 1) & mask)
+        {
+            if (KeyEqual()(m_slots[i].key, key))
+            {
+                break;
+            }
+        }
+        if (!m_slots[i].used)
+        {
+            return false;
+        }
+        // backward-shift the following entries of the cluster into the hole
+        for (std::size_t j = (i + 1) & mask; m_slots[j].used; j = (j + 1) & mask)
+        {
+            std::size_t k = Home(m_slots[j].key);
+            bool movable = (i <= j) ? (k <= i || k > j) : (k <= i && k > j);
+            if (movable)
+            {
+                m_slots[i] = m_slots[j];
+                i = j;
+            }
+        }
+        m_slots[i].used = false;
+        --m_size;
+        return true;
+    }
+
+    /**
+     * @return the number of entries
+     */
+    std::size_t GetSize() const
+    {
+        return m_size;
+    }
+
+    /**
+     * Remove all the entries, keeping the allocated storage.
+     */
+    void Clear()
+    {
+        for (auto& slot : m_slots)
+        {
+            slot.used = false;
+        }
+        m_size = 0;
+    }
+
+    /**
+     * Make room for a number of entries without further allocation.
+     * @param n the number of entries
+     */
+    void Reserve(std::size_t n)
+    {
+        std::size_t capacity = 16;
+        while (capacity < n * 2)
+        {
+            capacity *= 2;
+        }
+        if (capacity > m_slots.size())
+        {
+            Rehash(capacity);
+        }
+    }
+
+    /**
+     * Call a function on every entry, in unspecified order.
+     * @param f the function, called as f(const Key&, const Value&)
+     */
+    template <typename F>
+    void ForEach(F f) const
+    {
+        for (const auto& slot : m_slots)
+        {
+            if (slot.used)
+            {
+                f(slot.key, slot.value);
+            }
+        }
+    }
+
+  private:
+    /// A table slot
+    struct Slot
+    {
+        Key key;           //!< the key
+        Value value;       //!< the value
+        bool used = false; //!< whether the slot holds an entry
+    };
+
+    /**
+     * Compute the home slot of a key. The hash is passed through a 64-bit
+     * finalizer so that identity hashes of sequential ids spread well.
+     * @param key the key
+     * @return the slot index
+     */
+    std::size_t Home(const Key& key) const
+    {
+        uint64_t h = Hash()(key);
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ULL;
+        h ^= h >> 33;
+        return static_cast<std::size_t>(h) & (m_slots.size() - 1);
+    }
+
+    /**
+     * Move all the entries to a table of a new capacity.
+     * @param capacity the new capacity, a power of two
+     */
+    void Rehash(std::size_t capacity)
+    {
+        NS_ASSERT((capacity & (capacity - 1)) == 0);
+        std::vector<Slot> old(capacity);
+        old.swap(m_slots);
+        std::size_t mask = capacity - 1;
+        for (const auto& slot : old)
+        {
+            if (slot.used)
+            {
+                std::size_t i = Home(slot.key);
+                while (m_slots[i].used)
+                {
+                    i = (i + 1) & mask;
+                }
+                m_slots[i] = slot;
+            }
+        }
+    }
+
+    std::vector<Slot> m_slots; //!< the table
+    std::size_t m_size;        //!< the number of entries
+};
+
+} // namespace ns3
+
+#endif /* FLOW_HASH_MAP_H */
@@ -8,9 +8,12 @@
 
 #include "flow-monitor.h"
 
+#include "ns3/boolean.h"
+#include "ns3/columnar-writer.h"
 #include "ns3/double.h"
 #include "ns3/log.h"
 #include "ns3/simulator.h"
+#include "ns3/uinteger.h"
 
 #include <fstream>
 #include <limits>
@@ -70,12 +73,50 @@ FlowMonitor::GetTypeId()
                 ("The minimum inter-arrival time that is considered a flow interruption."),
                 TimeValue(Seconds(0.5)),
                 MakeTimeAccessor(&FlowMonitor::m_flowInterruptionsMinTime),
-                MakeTimeChecker());
+                MakeTimeChecker())
+            .AddAttribute("EnableQuantileSketches",
+                          "Fill per-flow and global quantile sketches of the delay and jitter, "
+                          "to estimate their percentiles in bounded memory.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&FlowMonitor::m_enableSketches),
+                          MakeBooleanChecker())
+            .AddAttribute("SketchRelativeAccuracy",
+                          "The relative accuracy of the quantile estimates of the sketches.",
+                          DoubleValue(0.01),
+                          MakeDoubleAccessor(&FlowMonitor::m_sketchRelativeAccuracy),
+                          MakeDoubleChecker<double>(1e-6, 0.5))
+            .AddAttribute("SketchMaxBins",
+                          "The maximum number of bins of a quantile sketch.",
+                          UintegerValue(2048),
+                          MakeUintegerAccessor(&FlowMonitor::m_sketchMaxBins),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("FlowSamplingPeriod",
+                          "Monitor 1 in this many flows, selected by a hash of their five-tuple "
+                          "(1: all the flows). Applies to the classifiers added afterwards.",
+                          UintegerValue(1),
+                          MakeUintegerAccessor(&FlowMonitor::m_flowSamplingPeriod),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("PacketSamplingPeriod",
+                          "Monitor 1 in this many packets of a monitored flow, selected by a "
+                          "hash of their identifiers (1: all the packets). Applies to the "
+                          "classifiers added afterwards.",
+                          UintegerValue(1),
+                          MakeUintegerAccessor(&FlowMonitor::m_packetSamplingPeriod),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("SamplingSeed",
+                          "The seed of the flow and packet sampling hashes.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&FlowMonitor::m_samplingSeed),
+                          MakeUintegerChecker<uint32_t>());
     return tid;
 }
 
 FlowMonitor::FlowMonitor()
-    : m_enabled(false)
+    : m_trackedFree(NO_RECORD),
+      m_lossHead(NO_RECORD),
+      m_lossTail(NO_RECORD),
+      m_enabled(false),
+      m_enableSketches(false)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -102,10 +143,11 @@ inline FlowMonitor::FlowStats&
 FlowMonitor::GetStatsForFlow(FlowId flowId)
 {
     NS_LOG_FUNCTION(this);
-    auto iter = m_flowStats.find(flowId);
-    if (iter == m_flowStats.end())
+    auto index = m_flowStatsIndex.Insert(flowId, nullptr);
+    if (index.second)
     {
         FlowMonitor::FlowStats& ref = m_flowStats[flowId];
+        *index.first = &ref;
         ref.delaySum = Seconds(0);
         ref.jitterSum = Seconds(0);
         ref.lastDelay = Seconds(0);
@@ -121,14 +163,96 @@ FlowMonitor::GetStatsForFlow(FlowId flowId)
         ref.jitterHistogram.SetDefaultBinWidth(m_jitterBinWidth);
         ref.packetSizeHistogram.SetDefaultBinWidth(m_packetSizeBinWidth);
         ref.flowInterruptionsHistogram.SetDefaultBinWidth(m_flowInterruptionsBinWidth);
+        ref.delaySketch.SetAccuracy(m_sketchRelativeAccuracy, m_sketchMaxBins);
+        ref.jitterSketch.SetAccuracy(m_sketchRelativeAccuracy, m_sketchMaxBins);
         return ref;
     }
     else
     {
-        return iter->second;
+        return **index.first;
+    }
+}
+
+inline uint64_t
+FlowMonitor::TrackedKey(FlowId flowId, FlowPacketId packetId)
+{
+    return (static_cast<uint64_t>(flowId) << 32) | packetId;
+}
+
+uint32_t
+FlowMonitor::AllocateTrackedPacket()
+{
+    uint32_t index = m_trackedFree;
+    if (index == NO_RECORD)
+    {
+        index = m_trackedPool.size();
+        m_trackedPool.emplace_back();
+    }
+    else
+    {
+        m_trackedFree = m_trackedPool[index].next;
+    }
+    LinkTrackedPacket(index);
+    return index;
+}
+
+void
+FlowMonitor::ReleaseTrackedPacket(uint32_t index)
+{
+    UnlinkTrackedPacket(index);
+    m_trackedPool[index].next = m_trackedFree;
+    m_trackedFree = index;
+}
+
+inline void
+FlowMonitor::TouchTrackedPacket(uint32_t index)
+{
+    if (index != m_lossTail)
+    {
+        UnlinkTrackedPacket(index);
+        LinkTrackedPacket(index);
+    }
+}
+
+inline void
+FlowMonitor::UnlinkTrackedPacket(uint32_t index)
+{
+    TrackedPacket& tracked = m_trackedPool[index];
+    if (tracked.prev == NO_RECORD)
+    {
+        m_lossHead = tracked.next;
+    }
+    else
+    {
+        m_trackedPool[tracked.prev].next = tracked.next;
+    }
+    if (tracked.next == NO_RECORD)
+    {
+        m_lossTail = tracked.prev;
+    }
+    else
+    {
+        m_trackedPool[tracked.next].prev = tracked.prev;
     }
 }
 
+inline void
+FlowMonitor::LinkTrackedPacket(uint32_t index)
+{
+    TrackedPacket& tracked = m_trackedPool[index];
+    tracked.prev = m_lossTail;
+    tracked.next = NO_RECORD;
+    if (m_lossTail == NO_RECORD)
+    {
+        m_lossHead = index;
+    }
+    else
+    {
+        m_trackedPool[m_lossTail].next = index;
+    }
+    m_lossTail = index;
+}
+
 void
 FlowMonitor::ReportFirstTx(Ptr<FlowProbe> probe,
                            uint32_t flowId,
@@ -142,7 +266,18 @@ FlowMonitor::ReportFirstTx(Ptr<FlowProbe> probe,
         return;
     }
     Time now = Simulator::Now();
-    TrackedPacket& tracked = m_trackedPackets[std::make_pair(flowId, packetId)];
+    auto slot = m_trackedPackets.Insert(TrackedKey(flowId, packetId), NO_RECORD);
+    if (slot.second)
+    {
+        *slot.first = AllocateTrackedPacket();
+    }
+    else
+    {
+        TouchTrackedPacket(*slot.first);
+    }
+    TrackedPacket& tracked = m_trackedPool[*slot.first];
+    tracked.flowId = flowId;
+    tracked.packetId = packetId;
     tracked.firstSeenTime = now;
     tracked.lastSeenTime = tracked.firstSeenTime;
     tracked.timesForwarded = 0;
@@ -173,19 +308,20 @@ FlowMonitor::ReportForwarding(Ptr<FlowProbe> probe,
         NS_LOG_DEBUG("FlowMonitor not enabled; returning");
         return;
     }
-    std::pair<FlowId, FlowPacketId> key(flowId, packetId);
-    auto tracked = m_trackedPackets.find(key);
-    if (tracked == m_trackedPackets.end())
+    const uint32_t* index = m_trackedPackets.Find(TrackedKey(flowId, packetId));
+    if (!index)
     {
         NS_LOG_WARN("Received packet forward report (flowId="
                     << flowId << ", packetId=" << packetId << ") but not known to be transmitted.");
         return;
     }
 
-    tracked->second.timesForwarded++;
-    tracked->second.lastSeenTime = Simulator::Now();
+    TrackedPacket& tracked = m_trackedPool[*index];
+    tracked.timesForwarded++;
+    tracked.lastSeenTime = Simulator::Now();
+    TouchTrackedPacket(*index);
 
-    Time delay = (Simulator::Now() - tracked->second.firstSeenTime);
+    Time delay = (Simulator::Now() - tracked.firstSeenTime);
     probe->AddPacketStats(flowId, packetSize, delay);
 }
 
@@ -201,33 +337,38 @@ FlowMonitor::ReportLastRx(Ptr<FlowProbe> probe,
         NS_LOG_DEBUG("FlowMonitor not enabled; returning");
         return;
     }
-    auto tracked = m_trackedPackets.find(std::make_pair(flowId, packetId));
-    if (tracked == m_trackedPackets.end())
+    uint64_t key = TrackedKey(flowId, packetId);
+    const uint32_t* index = m_trackedPackets.Find(key);
+    if (!index)
     {
         NS_LOG_WARN("Received packet last-tx report (flowId="
                     << flowId << ", packetId=" << packetId << ") but not known to be transmitted.");
         return;
     }
+    uint32_t trackedIndex = *index;
+    const TrackedPacket& tracked = m_trackedPool[trackedIndex];
 
     Time now = Simulator::Now();
-    Time delay = (now - tracked->second.firstSeenTime);
+    Time delay = (now - tracked.firstSeenTime);
     probe->AddPacketStats(flowId, packetSize, delay);
 
     FlowStats& stats = GetStatsForFlow(flowId);
     stats.delaySum += delay;
     stats.delayHistogram.AddValue(delay.GetSeconds());
+    if (m_enableSketches)
+    {
+        stats.delaySketch.AddValue(delay.GetSeconds());
+        m_globalDelaySketch.AddValue(delay.GetSeconds());
+    }
     if (stats.rxPackets > 0)
     {
-        Time jitter = stats.lastDelay - delay;
-        if (jitter.IsStrictlyPositive())
-        {
-            stats.jitterSum += jitter;
-            stats.jitterHistogram.AddValue(jitter.GetSeconds());
-        }
-        else
+        Time jitter = Abs(stats.lastDelay - delay);
+        stats.jitterSum += jitter;
+        stats.jitterHistogram.AddValue(jitter.GetSeconds());
+        if (m_enableSketches)
         {
-            stats.jitterSum -= jitter;
-            stats.jitterHistogram.AddValue(-jitter.GetSeconds());
+            stats.jitterSketch.AddValue(jitter.GetSeconds());
+            m_globalJitterSketch.AddValue(jitter.GetSeconds());
         }
     }
     stats.lastDelay = delay;
@@ -257,12 +398,14 @@ FlowMonitor::ReportLastRx(Ptr<FlowProbe> probe,
         }
     }
     stats.timeLastRxPacket = now;
-    stats.timesForwarded += tracked->second.timesForwarded;
+    stats.timesForwarded += tracked.timesForwarded;
 
     NS_LOG_DEBUG("ReportLastTx: removing tracked packet (flowId=" << flowId << ", packetId="
                                                                   << packetId << ").");
 
-    m_trackedPackets.erase(tracked); // we don't need to track this packet anymore
+    // we don't need to track this packet anymore
+    m_trackedPackets.Erase(key);
+    ReleaseTrackedPacket(trackedIndex);
 }
 
 void
@@ -293,14 +436,16 @@ FlowMonitor::ReportDrop(Ptr<FlowProbe> probe,
     NS_LOG_DEBUG("++stats.packetsDropped["
                  << reasonCode << "]; // becomes: " << stats.packetsDropped[reasonCode]);
 
-    auto tracked = m_trackedPackets.find(std::make_pair(flowId, packetId));
-    if (tracked != m_trackedPackets.end())
+    uint64_t key = TrackedKey(flowId, packetId);
+    const uint32_t* index = m_trackedPackets.Find(key);
+    if (index)
     {
         // we don't need to track this packet anymore
         // FIXME: this will not necessarily be true with broadcast/multicast
         NS_LOG_DEBUG("ReportDrop: removing tracked packet (flowId=" << flowId << ", packetId="
                                                                     << packetId << ").");
-        m_trackedPackets.erase(tracked);
+        ReleaseTrackedPacket(*index);
+        m_trackedPackets.Erase(key);
     }
 }
 
@@ -316,22 +461,25 @@ FlowMonitor::CheckForLostPackets(Time maxDelay)
     NS_LOG_FUNCTION(this << maxDelay.As(Time::S));
     Time now = Simulator::Now();
 
-    for (auto iter = m_trackedPackets.begin(); iter != m_trackedPackets.end();)
+    // The loss queue is ordered by last sighting, so only its expired head
+    // needs to be visited.
+    while (m_lossHead != NO_RECORD)
     {
-        if (now - iter->second.lastSeenTime >= maxDelay)
-        {
-            // packet is considered lost, add it to the loss statistics
-            auto flow = m_flowStats.find(iter->first.first);
-            NS_ASSERT(flow != m_flowStats.end());
-            flow->second.lostPackets++;
-
-            // we won't track it anymore
-            m_trackedPackets.erase(iter++);
-        }
-        else
+        uint32_t index = m_lossHead;
+        const TrackedPacket& tracked = m_trackedPool[index];
+        if (now - tracked.lastSeenTime < maxDelay)
         {
-            iter++;
+            break;
         }
+
+        // packet is considered lost, add it to the loss statistics
+        FlowStats** flow = m_flowStatsIndex.Find(tracked.flowId);
+        NS_ASSERT(flow);
+        (*flow)->lostPackets++;
+
+        // we won't track it anymore
+        m_trackedPackets.Erase(TrackedKey(tracked.flowId, tracked.packetId));
+        ReleaseTrackedPacket(index);
     }
 }
 
@@ -352,6 +500,8 @@ void
 FlowMonitor::NotifyConstructionCompleted()
 {
     Object::NotifyConstructionCompleted();
+    m_globalDelaySketch.SetAccuracy(m_sketchRelativeAccuracy, m_sketchMaxBins);
+    m_globalJitterSketch.SetAccuracy(m_sketchRelativeAccuracy, m_sketchMaxBins);
     Simulator::Schedule(PERIODIC_CHECK_INTERVAL, &FlowMonitor::PeriodicCheckForLostPackets, this);
 }
 
@@ -361,6 +511,18 @@ FlowMonitor::AddProbe(Ptr<FlowProbe> probe)
     m_flowProbes.push_back(probe);
 }
 
+const QuantileSketch&
+FlowMonitor::GetGlobalDelaySketch() const
+{
+    return m_globalDelaySketch;
+}
+
+const QuantileSketch&
+FlowMonitor::GetGlobalJitterSketch() const
+{
+    return m_globalJitterSketch;
+}
+
 const FlowMonitor::FlowProbeContainer&
 FlowMonitor::GetAllProbes() const
 {
@@ -418,9 +580,66 @@ FlowMonitor::StopRightNow()
 void
 FlowMonitor::AddFlowClassifier(Ptr<FlowClassifier> classifier)
 {
+    classifier->SetSampling(m_flowSamplingPeriod, m_packetSamplingPeriod, m_samplingSeed);
     m_classifiers.push_back(classifier);
 }
 
+uint32_t
+FlowMonitor::GetFlowSamplingPeriod() const
+{
+    return m_flowSamplingPeriod;
+}
+
+uint32_t
+FlowMonitor::GetPacketSamplingPeriod() const
+{
+    return m_packetSamplingPeriod;
+}
+
+FlowMonitor::SampledTotals
+FlowMonitor::GetEstimatedTotals() const
+{
+    SampledTotals totals = {};
+    for (const auto& [flowId, flowStats] : m_flowStats)
+    {
+        totals.txBytes += flowStats.txBytes;
+        totals.rxBytes += flowStats.rxBytes;
+        totals.txPackets += flowStats.txPackets;
+        totals.rxPackets += flowStats.rxPackets;
+        totals.lostPackets += flowStats.lostPackets;
+    }
+    totals.lossRatio = totals.txPackets > 0 ? totals.lostPackets / totals.txPackets : 0;
+    double scale = static_cast<double>(m_flowSamplingPeriod) * m_packetSamplingPeriod;
+    totals.txBytes *= scale;
+    totals.rxBytes *= scale;
+    totals.txPackets *= scale;
+    totals.rxPackets *= scale;
+    totals.lostPackets *= scale;
+    return totals;
+}
+
+FlowMonitor::SampledTotals
+FlowMonitor::GetEstimatedFlowTotals(FlowId flowId) const
+{
+    SampledTotals totals = {};
+    auto it = m_flowStats.find(flowId);
+    if (it == m_flowStats.end())
+    {
+        return totals;
+    }
+    const FlowStats& flowStats = it->second;
+    double scale = m_packetSamplingPeriod;
+    totals.txBytes = flowStats.txBytes * scale;
+    totals.rxBytes = flowStats.rxBytes * scale;
+    totals.txPackets = flowStats.txPackets * scale;
+    totals.rxPackets = flowStats.rxPackets * scale;
+    totals.lostPackets = flowStats.lostPackets * scale;
+    totals.lossRatio =
+        flowStats.txPackets > 0 ? static_cast<double>(flowStats.lostPackets) / flowStats.txPackets
+                                : 0;
+    return totals;
+}
+
 void
 FlowMonitor::SerializeToXmlStream(std::ostream& os,
                                   uint16_t indent,
@@ -432,6 +651,12 @@ FlowMonitor::SerializeToXmlStream(std::ostream& os,
 
     os << std::string(indent, ' ') << "<FlowMonitor>\n";
     indent += 2;
+    if (m_flowSamplingPeriod > 1 || m_packetSamplingPeriod > 1)
+    {
+        os << std::string(indent, ' ') << "<Sampling flowSamplingPeriod=\"" << m_flowSamplingPeriod
+           << "\" packetSamplingPeriod=\"" << m_packetSamplingPeriod << "\" seed=\""
+           << m_samplingSeed << "\" />\n";
+    }
     os << std::string(indent, ' ') << "<FlowStats>\n";
     indent += 2;
     for (const auto& [flowId, flowStats] : m_flowStats)
@@ -482,6 +707,11 @@ FlowMonitor::SerializeToXmlStream(std::ostream& os,
                                                                       indent,
                                                                       "flowInterruptionsHistogram");
         }
+        if (m_enableSketches)
+        {
+            flowStats.delaySketch.SerializeToXmlStream(os, indent, "delaySketch");
+            flowStats.jitterSketch.SerializeToXmlStream(os, indent, "jitterSketch");
+        }
         indent -= 2;
 
         os << std::string(indent, ' ') << "</Flow>\n";
@@ -489,6 +719,16 @@ FlowMonitor::SerializeToXmlStream(std::ostream& os,
     indent -= 2;
     os << std::string(indent, ' ') << "</FlowStats>\n";
 
+    if (m_enableSketches)
+    {
+        os << std::string(indent, ' ') << "<GlobalSketches>\n";
+        indent += 2;
+        m_globalDelaySketch.SerializeToXmlStream(os, indent, "delaySketch");
+        m_globalJitterSketch.SerializeToXmlStream(os, indent, "jitterSketch");
+        indent -= 2;
+        os << std::string(indent, ' ') << "</GlobalSketches>\n";
+    }
+
     for (auto iter = m_classifiers.begin(); iter != m_classifiers.end(); iter++)
     {
         (*iter)->SerializeToXmlStream(os, indent);
@@ -529,6 +769,82 @@ FlowMonitor::SerializeToXmlFile(std::string fileName, bool enableHistograms, boo
     os.close();
 }
 
+void
+FlowMonitor::SerializeToColumnarFile(std::string fileName)
+{
+    NS_LOG_FUNCTION(this << fileName);
+    CheckForLostPackets();
+
+    ColumnarWriter writer;
+    uint32_t flowId = writer.AddColumn("flowId", ColumnarWriter::UINT32);
+    // time columns, in the order of the XML attributes
+    const std::pair<const char*, Time FlowStats::*> timeMembers[] = {
+        {"timeFirstTxPacket", &FlowStats::timeFirstTxPacket},
+        {"timeFirstRxPacket", &FlowStats::timeFirstRxPacket},
+        {"timeLastTxPacket", &FlowStats::timeLastTxPacket},
+        {"timeLastRxPacket", &FlowStats::timeLastRxPacket},
+        {"delaySum", &FlowStats::delaySum},
+        {"jitterSum", &FlowStats::jitterSum},
+        {"lastDelay", &FlowStats::lastDelay},
+        {"maxDelay", &FlowStats::maxDelay},
+        {"minDelay", &FlowStats::minDelay},
+    };
+    std::vector<uint32_t> timeColumns;
+    for (const auto& [name, member] : timeMembers)
+    {
+        timeColumns.push_back(writer.AddColumn(name, ColumnarWriter::INT64));
+    }
+    uint32_t txBytes = writer.AddColumn("txBytes", ColumnarWriter::UINT64);
+    uint32_t rxBytes = writer.AddColumn("rxBytes", ColumnarWriter::UINT64);
+    uint32_t txPackets = writer.AddColumn("txPackets", ColumnarWriter::UINT32);
+    uint32_t rxPackets = writer.AddColumn("rxPackets", ColumnarWriter::UINT32);
+    uint32_t lostPackets = writer.AddColumn("lostPackets", ColumnarWriter::UINT32);
+    uint32_t timesForwarded = writer.AddColumn("timesForwarded", ColumnarWriter::UINT32);
+    uint32_t droppedPackets = writer.AddColumn("droppedPackets", ColumnarWriter::UINT32);
+    uint32_t delayP50 = 0;
+    uint32_t delayP99 = 0;
+    uint32_t delayP999 = 0;
+    uint32_t jitterP99 = 0;
+    if (m_enableSketches)
+    {
+        delayP50 = writer.AddColumn("delayP50", ColumnarWriter::DOUBLE);
+        delayP99 = writer.AddColumn("delayP99", ColumnarWriter::DOUBLE);
+        delayP999 = writer.AddColumn("delayP999", ColumnarWriter::DOUBLE);
+        jitterP99 = writer.AddColumn("jitterP99", ColumnarWriter::DOUBLE);
+    }
+
+    writer.Open(fileName);
+    for (const auto& [id, stats] : m_flowStats)
+    {
+        writer.Set(flowId, id);
+        for (std::size_t i = 0; i < timeColumns.size(); i++)
+        {
+            writer.Set(timeColumns[i], (stats.*timeMembers[i].second).GetNanoSeconds());
+        }
+        writer.Set(txBytes, stats.txBytes);
+        writer.Set(rxBytes, stats.rxBytes);
+        writer.Set(txPackets, stats.txPackets);
+        writer.Set(rxPackets, stats.rxPackets);
+        writer.Set(lostPackets, stats.lostPackets);
+        writer.Set(timesForwarded, stats.timesForwarded);
+        uint32_t dropped = 0;
+        for (auto packets : stats.packetsDropped)
+        {
+            dropped += packets;
+        }
+        writer.Set(droppedPackets, dropped);
+        if (m_enableSketches)
+        {
+            writer.Set(delayP50, stats.delaySketch.GetQuantile(0.5));
+            writer.Set(delayP99, stats.delaySketch.GetQuantile(0.99));
+            writer.Set(delayP999, stats.delaySketch.GetQuantile(0.999));
+            writer.Set(jitterP99, stats.jitterSketch.GetQuantile(0.99));
+        }
+        writer.EndRow();
+    }
+    writer.Close();
+}
+
 void
 FlowMonitor::ResetAllStats()
 {
@@ -555,7 +871,11 @@ FlowMonitor::ResetAllStats()
         flowStat.jitterHistogram.Clear();
         flowStat.packetSizeHistogram.Clear();
         flowStat.flowInterruptionsHistogram.Clear();
+        flowStat.delaySketch.Clear();
+        flowStat.jitterSketch.Clear();
     }
+    m_globalDelaySketch.Clear();
+    m_globalJitterSketch.Clear();
 }
 
 } // namespace ns3
@@ -10,6 +10,7 @@
 #define FLOW_MONITOR_H
 
 #include "flow-classifier.h"
+#include "flow-hash-map.h"
 #include "flow-probe.h"
 
 #include "ns3/event-id.h"
@@ -17,6 +18,7 @@
 #include "ns3/nstime.h"
 #include "ns3/object.h"
 #include "ns3/ptr.h"
+#include "ns3/quantile-sketch.h"
 
 #include <map>
 #include <vector>
@@ -129,6 +131,28 @@ class FlowMonitor : public Object
         /// comment in attribute packetsDropped.
         std::vector<uint64_t> bytesDropped;   // bytesDropped[reasonCode] => number of dropped bytes
         Histogram flowInterruptionsHistogram; //!< histogram of durations of flow interruptions
+
+        /// Quantile sketch of the packet delays, in seconds (only filled
+        /// if the EnableQuantileSketches attribute is set)
+        QuantileSketch delaySketch;
+        /// Quantile sketch of the packet jitters, in seconds (only filled
+        /// if the EnableQuantileSketches attribute is set)
+        QuantileSketch jitterSketch;
+    };
+
+    /// Totals of the monitored flows, scaled by the inverse of the sampling
+    /// probabilities (see the FlowSamplingPeriod and PacketSamplingPeriod
+    /// attributes) to estimate the totals of all the flows.
+    struct SampledTotals
+    {
+        double txBytes;     //!< estimated transmitted bytes
+        double rxBytes;     //!< estimated received bytes
+        double txPackets;   //!< estimated transmitted packets
+        double rxPackets;   //!< estimated received packets
+        double lostPackets; //!< estimated lost packets
+        /// estimated fraction of the transmitted packets that were lost
+        /// (a ratio of the sampled counts, since the scale factors cancel)
+        double lossRatio;
     };
 
     // --- basic methods ---
@@ -243,6 +267,39 @@ class FlowMonitor : public Object
     /// @returns a list of all the probes
     const FlowProbeContainer& GetAllProbes() const;
 
+    /// Get the quantile sketch of the delays of all the flows. It is only
+    /// filled if the EnableQuantileSketches attribute is set.
+    /// @returns the delay sketch, in seconds
+    const QuantileSketch& GetGlobalDelaySketch() const;
+
+    /// Get the quantile sketch of the jitters of all the flows. It is only
+    /// filled if the EnableQuantileSketches attribute is set.
+    /// @returns the jitter sketch, in seconds
+    const QuantileSketch& GetGlobalJitterSketch() const;
+
+    /// @returns the flow sampling period: 1 in this many flows is monitored
+    uint32_t GetFlowSamplingPeriod() const;
+
+    /// @returns the packet sampling period: 1 in this many packets of a
+    /// monitored flow is monitored
+    uint32_t GetPacketSamplingPeriod() const;
+
+    /// Estimate the totals of all the flows from the sampled flows and
+    /// packets, i.e., the sums of the statistics of the monitored flows
+    /// multiplied by FlowSamplingPeriod * PacketSamplingPeriod. Since flows
+    /// are sampled independently of their size, the estimates are unbiased
+    /// but their variance grows with the skew of the flow sizes. Without
+    /// sampling, these are the exact totals.
+    /// @returns the estimated totals
+    SampledTotals GetEstimatedTotals() const;
+
+    /// Estimate the totals of one monitored flow from its sampled packets,
+    /// i.e., its statistics multiplied by PacketSamplingPeriod. Divided by
+    /// the duration of the flow, rxBytes estimates its throughput.
+    /// @param flowId the flow identifier
+    /// @returns the estimated totals (all zero for an unknown flow)
+    SampledTotals GetEstimatedFlowTotals(FlowId flowId) const;
+
     /// Serializes the results to an std::ostream in XML format
     /// @param os the output stream
     /// @param indent number of spaces to use as base indentation level
@@ -266,6 +323,13 @@ class FlowMonitor : public Object
     /// @param enableProbes if true, include also the per-probe/flow pair statistics in the output
     void SerializeToXmlFile(std::string fileName, bool enableHistograms, bool enableProbes);
 
+    /// Writes the per-flow statistics to a binary columnar file (see
+    /// ColumnarWriter), one row per flow. Times are in nanoseconds; if the
+    /// quantile sketches are enabled, delay and jitter percentiles (in
+    /// seconds) are added.
+    /// @param fileName name or path of the output file that will be created
+    void SerializeToColumnarFile(std::string fileName);
+
     /// Reset all the statistics
     void ResetAllStats();
 
@@ -274,34 +338,58 @@ class FlowMonitor : public Object
     void DoDispose() override;
 
   private:
-    /// Structure to represent a single tracked packet data
+    /// Structure to represent a single tracked packet data.
+    ///
+    /// Records live in a pool and are linked, in order of last sighting,
+    /// in a queue that CheckForLostPackets consumes from its head.
     struct TrackedPacket
     {
         Time firstSeenTime;      //!< absolute time when the packet was first seen by a probe
         Time lastSeenTime;       //!< absolute time when the packet was last seen by a probe
         uint32_t timesForwarded; //!< number of times the packet was reportedly forwarded
+        FlowId flowId;           //!< flow of the packet
+        FlowPacketId packetId;   //!< identifier of the packet within the flow
+        uint32_t prev;           //!< previous record in the loss queue (or free list)
+        uint32_t next;           //!< next record in the loss queue (or free list)
     };
 
+    /// Marks the end of the loss queue and of the free list
+    static constexpr uint32_t NO_RECORD = UINT32_MAX;
+
     /// FlowId --> FlowStats
     FlowStatsContainer m_flowStats;
+    /// FlowId --> entry of m_flowStats (std::map nodes never move)
+    FlowHashMap<FlowId, FlowStats*> m_flowStatsIndex;
+
+    /// (FlowId,PacketId) --> index in m_trackedPool
+    FlowHashMap<uint64_t, uint32_t> m_trackedPackets;
+    std::vector<TrackedPacket> m_trackedPool; //!< Tracked packet records
+    uint32_t m_trackedFree;                   //!< Head of the free record list
+    uint32_t m_lossHead;                      //!< Least recently seen tracked packet
+    uint32_t m_lossTail;                      //!< Most recently seen tracked packet
 
-    /// (FlowId,PacketId) --> TrackedPacket
-    typedef std::map<std::pair<FlowId, FlowPacketId>, TrackedPacket> TrackedPacketMap;
-    TrackedPacketMap m_trackedPackets; //!< Tracked packets
     Time m_maxPerHopDelay;             //!< Minimum per-hop delay
     FlowProbeContainer m_flowProbes;   //!< all the FlowProbes
 
     // note: this is needed only for serialization
     std::list<Ptr<FlowClassifier>> m_classifiers; //!< the FlowClassifiers
 
-    EventId m_startEvent;               //!< Start event
-    EventId m_stopEvent;                //!< Stop event
-    bool m_enabled;                     //!< FlowMon is enabled
-    double m_delayBinWidth;             //!< Delay bin width (for histograms)
-    double m_jitterBinWidth;            //!< Jitter bin width (for histograms)
-    double m_packetSizeBinWidth;        //!< packet size bin width (for histograms)
-    double m_flowInterruptionsBinWidth; //!< Flow interruptions bin width (for histograms)
-    Time m_flowInterruptionsMinTime;    //!< Flow interruptions minimum time
+    EventId m_startEvent;                //!< Start event
+    EventId m_stopEvent;                 //!< Stop event
+    bool m_enabled;                      //!< FlowMon is enabled
+    double m_delayBinWidth;              //!< Delay bin width (for histograms)
+    double m_jitterBinWidth;             //!< Jitter bin width (for histograms)
+    double m_packetSizeBinWidth;         //!< packet size bin width (for histograms)
+    double m_flowInterruptionsBinWidth;  //!< Flow interruptions bin width (for histograms)
+    Time m_flowInterruptionsMinTime;     //!< Flow interruptions minimum time
+    bool m_enableSketches;               //!< Fill the delay and jitter quantile sketches
+    double m_sketchRelativeAccuracy;     //!< Relative accuracy of the quantile sketches
+    uint32_t m_sketchMaxBins;            //!< Maximum number of bins of a quantile sketch
+    QuantileSketch m_globalDelaySketch;  //!< Delays of all the flows
+    QuantileSketch m_globalJitterSketch; //!< Jitters of all the flows
+    uint32_t m_flowSamplingPeriod;       //!< Monitor 1 in this many flows
+    uint32_t m_packetSamplingPeriod;     //!< Monitor 1 in this many packets of a flow
+    uint32_t m_samplingSeed;             //!< Seed of the sampling hashes
 
     /// Get the stats for a given flow
     /// @param flowId the Flow identification
@@ -310,6 +398,32 @@ class FlowMonitor : public Object
 
     /// Periodic function to check for lost packets and prune statistics
     void PeriodicCheckForLostPackets();
+
+    /// Build the m_trackedPackets key of a packet
+    /// @param flowId the Flow identification
+    /// @param packetId the Packet identification
+    /// @returns the key
+    static uint64_t TrackedKey(FlowId flowId, FlowPacketId packetId);
+
+    /// Get a record from the pool and append it to the loss queue
+    /// @returns the index of the record
+    uint32_t AllocateTrackedPacket();
+
+    /// Remove a record from the loss queue and return it to the pool
+    /// @param index the index of the record
+    void ReleaseTrackedPacket(uint32_t index);
+
+    /// Move a record to the tail of the loss queue
+    /// @param index the index of the record
+    void TouchTrackedPacket(uint32_t index);
+
+    /// Remove a record from the loss queue
+    /// @param index the index of the record
+    void UnlinkTrackedPacket(uint32_t index);
+
+    /// Append a record to the loss queue
+    /// @param index the index of the record
+    void LinkTrackedPacket(uint32_t index);
 };
 
 } // namespace ns3
@@ -10,6 +10,7 @@
 #define FLOW_PROBE_H
 
 #include "flow-classifier.h"
+#include "flow-hash-map.h"
 
 #include "ns3/nstime.h"
 #include "ns3/object.h"
@@ -95,8 +96,17 @@ class FlowProbe : public Object
     void SerializeToXmlStream(std::ostream& os, uint16_t indent, uint32_t index) const;
 
   protected:
+    /// Get the stats entry of a flow, creating it if needed
+    /// @param flowId the flow Identifier
+    /// @returns the stats of the flow
+    FlowStats& GetStatsForFlow(FlowId flowId);
+
     Ptr<FlowMonitor> m_flowMonitor; //!< the FlowMonitor instance
     Stats m_stats;                  //!< The flow stats
+
+  private:
+    /// FlowId --> entry of m_stats (std::map nodes never move)
+    FlowHashMap<FlowId, FlowStats*> m_statsIndex;
 };
 
 } // namespace ns3
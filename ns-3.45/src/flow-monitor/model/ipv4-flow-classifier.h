@@ -10,10 +10,12 @@
 #define IPV4_FLOW_CLASSIFIER_H
 
 #include "flow-classifier.h"
+#include "flow-hash-map.h"
 
 #include "ns3/ipv4-header.h"
 
 #include <map>
+#include <vector>
 #include <stdint.h>
 
 namespace ns3
@@ -81,13 +83,41 @@ class Ipv4FlowClassifier : public FlowClassifier
 
     void SerializeToXmlStream(std::ostream& os, uint16_t indent) const override;
 
+    /// Writes the five-tuples of the flows to a binary columnar file (see
+    /// ColumnarWriter), one row per flow, with the addresses as 32-bit integers.
+    /// The file can be joined on flowId with the output of
+    /// FlowMonitor::SerializeToColumnarFile.
+    /// @param fileName name or path of the output file that will be created
+    void SerializeToColumnarFile(std::string fileName) const;
+
   private:
-    /// Map to Flows Identifiers to FlowIds
-    std::map<FiveTuple, FlowId> m_flowMap;
-    /// Map to FlowIds to FlowPacketId
-    std::map<FlowId, FlowPacketId> m_flowPktIdMap;
-    /// Map FlowIds to (DSCP value, packet count) pairs
-    std::map<FlowId, std::map<Ipv4Header::DscpType, uint32_t>> m_flowDscpMap;
+    /// Hash of a FiveTuple
+    struct FiveTupleHash
+    {
+        /// @param t the FiveTuple
+        /// @returns the hash of the FiveTuple
+        std::size_t operator()(const FiveTuple& t) const;
+    };
+
+    /// Per-flow classification state
+    struct FlowRecord
+    {
+        FiveTuple tuple;           //!< Flow five-tuple
+        FlowId flowId;             //!< Flow identifier
+        FlowPacketId lastPacketId; //!< Identifier of the last classified packet
+        /// (DSCP value, packet count) pairs, in order of first appearance
+        std::vector<std::pair<Ipv4Header::DscpType, uint32_t>> dscpCounts;
+    };
+
+    /// Get the record of a flow
+    /// @param flowId the flow identifier
+    /// @returns the record, or nullptr if the flow is unknown
+    const FlowRecord* FindRecord(FlowId flowId) const;
+
+    /// Map FiveTuples to indexes in m_flows
+    FlowHashMap<FiveTuple, uint32_t, FiveTupleHash> m_flowMap;
+    /// Flow records, in FlowId order
+    std::vector<FlowRecord> m_flows;
 };
 
 /**
@@ -113,6 +113,9 @@ class Ipv4FlowProbeTag : public Tag
     Ipv4Address m_dst;     //!< IP destination
 };
 
+// the tag is read at every hop to classify the packet
+NS_PACKET_TAG_SLOT_REGISTER(Ipv4FlowProbeTag);
+
 TypeId
 Ipv4FlowProbeTag::GetTypeId()
 {
@@ -232,6 +235,43 @@ Ipv4FlowProbeTag::IsSrcDstValid(Ipv4Address src, Ipv4Address dst) const
     return ((m_src == src) && (m_dst == dst));
 }
 
+/**
+ * @brief Find the Ipv4FlowProbeTag of a packet
+ *
+ * The tag is a byte tag, or a packet tag when the byte tags are disabled.
+ *
+ * @param packet the packet
+ * @param tag the tag found
+ * @returns true if the packet has the tag
+ */
+static bool
+FindFlowProbeTag(Ptr<const Packet> packet, Ipv4FlowProbeTag& tag)
+{
+    if (Packet::ByteTagsEnabled())
+    {
+        return packet->FindFirstMatchingByteTag(tag);
+    }
+    return packet->PeekPacketTag(tag);
+}
+
+/**
+ * @brief Add an Ipv4FlowProbeTag to a packet
+ * @param packet the packet
+ * @param tag the tag
+ */
+static void
+AddFlowProbeTag(Ptr<const Packet> packet, const Ipv4FlowProbeTag& tag)
+{
+    if (Packet::ByteTagsEnabled())
+    {
+        packet->AddByteTag(tag);
+    }
+    else
+    {
+        packet->AddPacketTag(tag);
+    }
+}
+
 ////////////////////////////////////////
 // Ipv4FlowProbe class implementation //
 ////////////////////////////////////////
@@ -325,7 +365,7 @@ Ipv4FlowProbe::SendOutgoingLogger(const Ipv4Header& ipHeader,
     }
 
     Ipv4FlowProbeTag fTag;
-    bool found = ipPayload->FindFirstMatchingByteTag(fTag);
+    bool found = FindFlowProbeTag(ipPayload, fTag);
     if (found)
     {
         return;
@@ -345,7 +385,7 @@ Ipv4FlowProbe::SendOutgoingLogger(const Ipv4Header& ipHeader,
                               size,
                               ipHeader.GetSource(),
                               ipHeader.GetDestination());
-        ipPayload->AddByteTag(fTag);
+        AddFlowProbeTag(ipPayload, fTag);
     }
 }
 
@@ -355,7 +395,7 @@ Ipv4FlowProbe::ForwardLogger(const Ipv4Header& ipHeader,
                              uint32_t interface)
 {
     Ipv4FlowProbeTag fTag;
-    bool found = ipPayload->FindFirstMatchingByteTag(fTag);
+    bool found = FindFlowProbeTag(ipPayload, fTag);
 
     if (found)
     {
@@ -386,7 +426,7 @@ Ipv4FlowProbe::ForwardUpLogger(const Ipv4Header& ipHeader,
                                uint32_t interface)
 {
     Ipv4FlowProbeTag fTag;
-    bool found = ipPayload->FindFirstMatchingByteTag(fTag);
+    bool found = FindFlowProbeTag(ipPayload, fTag);
 
     if (found)
     {
@@ -432,7 +472,7 @@ Ipv4FlowProbe::DropLogger(const Ipv4Header& ipHeader,
 #endif
 
     Ipv4FlowProbeTag fTag;
-    bool found = ipPayload->FindFirstMatchingByteTag(fTag);
+    bool found = FindFlowProbeTag(ipPayload, fTag);
 
     if (found)
     {
@@ -486,7 +526,7 @@ void
 Ipv4FlowProbe::QueueDropLogger(Ptr<const Packet> ipPayload)
 {
     Ipv4FlowProbeTag fTag;
-    bool tagFound = ipPayload->FindFirstMatchingByteTag(fTag);
+    bool tagFound = FindFlowProbeTag(ipPayload, fTag);
 
     if (!tagFound)
     {
@@ -507,7 +547,7 @@ void
 Ipv4FlowProbe::QueueDiscDropLogger(Ptr<const QueueDiscItem> item)
 {
     Ipv4FlowProbeTag fTag;
-    bool tagFound = item->GetPacket()->FindFirstMatchingByteTag(fTag);
+    bool tagFound = FindFlowProbeTag(item->GetPacket(), fTag);
 
     if (!tagFound)
     {
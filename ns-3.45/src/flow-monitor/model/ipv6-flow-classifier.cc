@@ -134,48 +134,81 @@ Ipv6FlowClassifier::Classify(const Ipv6Header& ipHeader,
     tuple.sourcePort = srcPort;
     tuple.destinationPort = dstPort;
 
+    // reject the packets of unsampled flows before touching the flow table
+    if (!IsFlowSampled<FiveTupleHash>(tuple))
+    {
+        return false;
+    }
+
     // try to insert the tuple, but check if it already exists
-    auto insert = m_flowMap.insert(std::pair<FiveTuple, FlowId>(tuple, 0));
+    auto insert = m_flowMap.Insert(tuple, static_cast<uint32_t>(m_flows.size()));
 
     // if the insertion succeeded, we need to assign this tuple a new flow identifier
     if (insert.second)
     {
-        FlowId newFlowId = GetNewFlowId();
-        insert.first->second = newFlowId;
-        m_flowPktIdMap[newFlowId] = 0;
-        m_flowDscpMap[newFlowId];
+        m_flows.push_back({tuple, GetNewFlowId(), 0, {}});
     }
-    else
+    FlowRecord& flow = m_flows[*insert.first];
+    if (!insert.second)
+    {
+        flow.lastPacketId++;
+    }
+    if (!IsPacketSampled(flow.flowId, flow.lastPacketId))
     {
-        m_flowPktIdMap[insert.first->second]++;
+        return false;
     }
 
     // increment the counter of packets with the same DSCP value
     Ipv6Header::DscpType dscp = ipHeader.GetDscp();
-    auto dscpInserter = m_flowDscpMap[insert.first->second].insert(
-        std::pair<Ipv6Header::DscpType, uint32_t>(dscp, 1));
-
-    // if the insertion did not succeed, we need to increment the counter
-    if (!dscpInserter.second)
+    auto dscpCount = std::find_if(flow.dscpCounts.begin(),
+                                  flow.dscpCounts.end(),
+                                  [dscp](const auto& count) { return count.first == dscp; });
+    if (dscpCount == flow.dscpCounts.end())
+    {
+        flow.dscpCounts.emplace_back(dscp, 1);
+    }
+    else
     {
-        m_flowDscpMap[insert.first->second][dscp]++;
+        dscpCount->second++;
     }
 
-    *out_flowId = insert.first->second;
-    *out_packetId = m_flowPktIdMap[*out_flowId];
+    *out_flowId = flow.flowId;
+    *out_packetId = flow.lastPacketId;
 
     return true;
 }
 
+std::size_t
+Ipv6FlowClassifier::FiveTupleHash::operator()(const FiveTuple& t) const
+{
+    std::size_t h = Ipv6AddressHash()(t.sourceAddress);
+    h = h * 31 + Ipv6AddressHash()(t.destinationAddress);
+    uint64_t ports = (static_cast<uint64_t>(t.protocol) << 32) |
+                     (static_cast<uint64_t>(t.sourcePort) << 16) | t.destinationPort;
+    return h * 31 + static_cast<std::size_t>(ports ^ (ports >> 32));
+}
+
+const Ipv6FlowClassifier::FlowRecord*
+Ipv6FlowClassifier::FindRecord(FlowId flowId) const
+{
+    // flow identifiers are handed out consecutively, in record order
+    if (m_flows.empty() || flowId < m_flows.front().flowId ||
+        flowId - m_flows.front().flowId >= m_flows.size())
+    {
+        return nullptr;
+    }
+    const FlowRecord& flow = m_flows[flowId - m_flows.front().flowId];
+    NS_ASSERT(flow.flowId == flowId);
+    return &flow;
+}
+
 Ipv6FlowClassifier::FiveTuple
 Ipv6FlowClassifier::FindFlow(FlowId flowId) const
 {
-    for (auto iter = m_flowMap.begin(); iter != m_flowMap.end(); iter++)
+    const FlowRecord* flow = FindRecord(flowId);
+    if (flow)
     {
-        if (iter->second == flowId)
-        {
-            return iter->first;
-        }
+        return flow->tuple;
     }
     NS_FATAL_ERROR("Could not find the flow with ID " << flowId);
     FiveTuple retval = {Ipv6Address::GetZero(), Ipv6Address::GetZero(), 0, 0, 0};
@@ -192,16 +225,16 @@ Ipv6FlowClassifier::SortByCount::operator()(std::pair<Ipv6Header::DscpType, uint
 std::vector<std::pair<Ipv6Header::DscpType, uint32_t>>
 Ipv6FlowClassifier::GetDscpCounts(FlowId flowId) const
 {
-    auto flow = m_flowDscpMap.find(flowId);
+    const FlowRecord* flow = FindRecord(flowId);
 
-    if (flow == m_flowDscpMap.end())
+    if (!flow)
     {
         NS_FATAL_ERROR("Could not find the flow with ID " << flowId);
     }
 
-    std::vector<std::pair<Ipv6Header::DscpType, uint32_t>> v(flow->second.begin(),
-                                                             flow->second.end());
-    std::sort(v.begin(), v.end(), SortByCount());
+    std::vector<std::pair<Ipv6Header::DscpType, uint32_t>> v(flow->dscpCounts);
+    std::sort(v.begin(), v.end());
+    std::stable_sort(v.begin(), v.end(), SortByCount());
     return v;
 }
 
@@ -212,27 +245,24 @@ Ipv6FlowClassifier::SerializeToXmlStream(std::ostream& os, uint16_t indent) cons
     os << "<Ipv6FlowClassifier>\n";
 
     indent += 2;
-    for (auto iter = m_flowMap.begin(); iter != m_flowMap.end(); iter++)
+    for (const auto& flow : m_flows)
     {
         Indent(os, indent);
-        os << "<Flow flowId=\"" << iter->second << "\""
-           << " sourceAddress=\"" << iter->first.sourceAddress << "\""
-           << " destinationAddress=\"" << iter->first.destinationAddress << "\""
-           << " protocol=\"" << int(iter->first.protocol) << "\""
-           << " sourcePort=\"" << iter->first.sourcePort << "\""
-           << " destinationPort=\"" << iter->first.destinationPort << "\">\n";
+        os << "<Flow flowId=\"" << flow.flowId << "\""
+           << " sourceAddress=\"" << flow.tuple.sourceAddress << "\""
+           << " destinationAddress=\"" << flow.tuple.destinationAddress << "\""
+           << " protocol=\"" << int(flow.tuple.protocol) << "\""
+           << " sourcePort=\"" << flow.tuple.sourcePort << "\""
+           << " destinationPort=\"" << flow.tuple.destinationPort << "\">\n";
 
         indent += 2;
-        auto flow = m_flowDscpMap.find(iter->second);
-
-        if (flow != m_flowDscpMap.end())
+        std::vector<std::pair<Ipv6Header::DscpType, uint32_t>> dscpCounts(flow.dscpCounts);
+        std::sort(dscpCounts.begin(), dscpCounts.end());
+        for (const auto& [dscp, packets] : dscpCounts)
         {
-            for (auto i = flow->second.begin(); i != flow->second.end(); i++)
-            {
-                Indent(os, indent);
-                os << "<Dscp value=\"0x" << std::hex << static_cast<uint32_t>(i->first) << "\""
-                   << " packets=\"" << std::dec << i->second << "\" />\n";
-            }
+            Indent(os, indent);
+            os << "<Dscp value=\"0x" << std::hex << static_cast<uint32_t>(dscp) << "\""
+               << " packets=\"" << std::dec << packets << "\" />\n";
         }
 
         indent -= 2;
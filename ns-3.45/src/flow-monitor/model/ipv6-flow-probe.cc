@@ -190,6 +190,48 @@ Ipv6FlowProbeTag::GetPacketSize() const
     return m_packetSize;
 }
 
+/**
+ * @brief Find the Ipv6FlowProbeTag of a packet
+ *
+ * The tag is a byte tag, or a packet tag when the byte tags are disabled.
+ *
+ * @param packet the packet
+ * @param tag the tag found
+ * @returns true if the packet has the tag
+ */
+static bool
+FindFlowProbeTag(Ptr<const Packet> packet, Ipv6FlowProbeTag& tag)
+{
+    if (Packet::ByteTagsEnabled())
+    {
+        return packet->FindFirstMatchingByteTag(tag);
+    }
+    return packet->PeekPacketTag(tag);
+}
+
+/**
+ * @brief Add an Ipv6FlowProbeTag to a packet
+ * @param packet the packet
+ * @param tag the tag
+ */
+static void
+AddFlowProbeTag(Ptr<const Packet> packet, const Ipv6FlowProbeTag& tag)
+{
+    if (Packet::ByteTagsEnabled())
+    {
+        packet->AddByteTag(tag);
+    }
+    else
+    {
+        // keep the first tag, which FindFirstMatchingByteTag would find
+        Ipv6FlowProbeTag first;
+        if (!packet->PeekPacketTag(first))
+        {
+            packet->AddPacketTag(tag);
+        }
+    }
+}
+
 ////////////////////////////////////////
 // Ipv6FlowProbe class implementation //
 ////////////////////////////////////////
@@ -284,7 +326,7 @@ Ipv6FlowProbe::SendOutgoingLogger(const Ipv6Header& ipHeader,
         // tag the packet with the flow id and packet id, so that the packet can be identified even
         // when Ipv6Header is not accessible at some non-IPv6 protocol layer
         Ipv6FlowProbeTag fTag(flowId, packetId, size);
-        ipPayload->AddByteTag(fTag);
+        AddFlowProbeTag(ipPayload, fTag);
     }
 }
 
@@ -294,7 +336,7 @@ Ipv6FlowProbe::ForwardLogger(const Ipv6Header& ipHeader,
                              uint32_t interface)
 {
     Ipv6FlowProbeTag fTag;
-    bool found = ipPayload->FindFirstMatchingByteTag(fTag);
+    bool found = FindFlowProbeTag(ipPayload, fTag);
 
     if (found)
     {
@@ -314,7 +356,7 @@ Ipv6FlowProbe::ForwardUpLogger(const Ipv6Header& ipHeader,
                                uint32_t interface)
 {
     Ipv6FlowProbeTag fTag;
-    bool found = ipPayload->FindFirstMatchingByteTag(fTag);
+    bool found = FindFlowProbeTag(ipPayload, fTag);
 
     if (found)
     {
@@ -354,7 +396,7 @@ Ipv6FlowProbe::DropLogger(const Ipv6Header& ipHeader,
 #endif
 
     Ipv6FlowProbeTag fTag;
-    bool found = ipPayload->FindFirstMatchingByteTag(fTag);
+    bool found = FindFlowProbeTag(ipPayload, fTag);
 
     if (found)
     {
@@ -415,7 +457,7 @@ void
 Ipv6FlowProbe::QueueDropLogger(Ptr<const Packet> ipPayload)
 {
     Ipv6FlowProbeTag fTag;
-    bool tagFound = ipPayload->FindFirstMatchingByteTag(fTag);
+    bool tagFound = FindFlowProbeTag(ipPayload, fTag);
 
     if (!tagFound)
     {
@@ -436,7 +478,7 @@ void
 Ipv6FlowProbe::QueueDiscDropLogger(Ptr<const QueueDiscItem> item)
 {
     Ipv6FlowProbeTag fTag;
-    bool tagFound = item->GetPacket()->FindFirstMatchingByteTag(fTag);
+    bool tagFound = FindFlowProbeTag(item->GetPacket(), fTag);
 
     if (!tagFound)
     {
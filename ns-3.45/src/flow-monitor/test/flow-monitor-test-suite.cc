@@ -0,0 +1,502 @@
+//
+// SPDX-License-Identifier: GPL-2.0-only
+//
+
+#include "ns3/boolean.h"
+#include "ns3/columnar-reader.h"
+#include "ns3/flow-hash-map.h"
+#include "ns3/flow-monitor-helper.h"
+#include "ns3/flow-monitor.h"
+#include "ns3/flow-probe.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/ipv4-flow-classifier.h"
+#include "ns3/ipv4-global-routing-helper.h"
+#include "ns3/packet.h"
+#include "ns3/simple-net-device-helper.h"
+#include "ns3/simulator.h"
+#include "ns3/socket.h"
+#include "ns3/test.h"
+#include "ns3/udp-socket-factory.h"
+#include "ns3/uinteger.h"
+
+#include <map>
+
+using namespace ns3;
+
+/**
+ * @defgroup flow-monitor-test Flow Monitor module tests
+ * @ingroup flow-monitor
+ * @ingroup tests
+ */
+
+/**
+ * @ingroup flow-monitor-test
+ *
+ * @brief FlowHashMap Test: checks the map against std::map under churn.
+ */
+class FlowHashMapTestCase : public TestCase
+{
+  public:
+    FlowHashMapTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+FlowHashMapTestCase::FlowHashMapTestCase()
+    : TestCase("FlowHashMap behaves like std::map")
+{
+}
+
+void
+FlowHashMapTestCase::DoRun()
+{
+    FlowHashMap<uint64_t, uint32_t> map;
+    std::map<uint64_t, uint32_t> reference;
+
+    // a deterministic mix of inserts and erases over a small key space, so
+    // that clusters are built and broken up by backward shifting
+    uint64_t state = 12345;
+    for (uint32_t i = 0; i < 20000; i++)
+    {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        uint64_t key = (state >> 33) % 512;
+        if ((state >> 20) & 1)
+        {
+            auto inserted = map.Insert(key, i);
+            auto expected = reference.insert({key, i});
+            NS_TEST_ASSERT_MSG_EQ(inserted.second, expected.second, "insert result");
+            NS_TEST_ASSERT_MSG_EQ(*inserted.first, expected.first->second, "inserted value");
+        }
+        else
+        {
+            NS_TEST_ASSERT_MSG_EQ(map.Erase(key), reference.erase(key) == 1, "erase result");
+        }
+        NS_TEST_ASSERT_MSG_EQ(map.GetSize(), reference.size(), "size");
+    }
+
+    for (uint64_t key = 0; key < 512; key++)
+    {
+        const uint32_t* value = map.Find(key);
+        auto expected = reference.find(key);
+        NS_TEST_ASSERT_MSG_EQ((value != nullptr), (expected != reference.end()), "presence");
+        if (value)
+        {
+            NS_TEST_EXPECT_MSG_EQ(*value, expected->second, "value of key " << key);
+        }
+    }
+
+    map.Clear();
+    NS_TEST_EXPECT_MSG_EQ(map.GetSize(), 0, "size after clear");
+    NS_TEST_EXPECT_MSG_EQ(map.Find(reference.begin()->first), nullptr, "find after clear");
+}
+
+/**
+ * @ingroup flow-monitor-test
+ *
+ * @brief A FlowProbe that is only used to report events to the monitor.
+ */
+class FlowMonitorTestProbe : public FlowProbe
+{
+  public:
+    /**
+     * Constructor
+     * @param monitor the FlowMonitor
+     */
+    FlowMonitorTestProbe(Ptr<FlowMonitor> monitor)
+        : FlowProbe(monitor)
+    {
+    }
+};
+
+/**
+ * @ingroup flow-monitor-test
+ *
+ * @brief FlowMonitor lost packet detection Test.
+ */
+class FlowMonitorLostPacketsTestCase : public TestCase
+{
+  public:
+    FlowMonitorLostPacketsTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+FlowMonitorLostPacketsTestCase::FlowMonitorLostPacketsTestCase()
+    : TestCase("FlowMonitor lost packet detection")
+{
+}
+
+void
+FlowMonitorLostPacketsTestCase::DoRun()
+{
+    Ptr<FlowMonitor> monitor = CreateObject<FlowMonitor>();
+    Ptr<FlowProbe> probe = Create<FlowMonitorTestProbe>(monitor);
+    monitor->StartRightNow();
+
+    // packets 0, 1 and 2 of flow 1 leave at t=0; packet 2 is received at
+    // t=1, packet 1 is forwarded at t=5, packet 0 is never seen again.
+    for (uint32_t packetId = 0; packetId < 3; packetId++)
+    {
+        monitor->ReportFirstTx(probe, 1, packetId, 100);
+    }
+    Simulator::Schedule(Seconds(1), &FlowMonitor::ReportLastRx, monitor, probe, 1, 2, 100);
+    Simulator::Schedule(Seconds(5), &FlowMonitor::ReportForwarding, monitor, probe, 1, 1, 100);
+
+    auto lostPackets = [monitor]() { return monitor->GetFlowStats().at(1).lostPackets; };
+    uint32_t lostAt8 = 0;
+    uint32_t lostAt12 = 0;
+    uint32_t lostAt16 = 0;
+    Simulator::Schedule(Seconds(8), [&]() {
+        monitor->CheckForLostPackets(Seconds(10));
+        lostAt8 = lostPackets();
+    });
+    Simulator::Schedule(Seconds(12), [&]() {
+        monitor->CheckForLostPackets(Seconds(10));
+        lostAt12 = lostPackets();
+    });
+    Simulator::Schedule(Seconds(16), [&]() {
+        monitor->CheckForLostPackets(Seconds(10));
+        lostAt16 = lostPackets();
+    });
+    Simulator::Stop(Seconds(20));
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_EQ(lostAt8, 0, "no packet is lost before the max delay");
+    NS_TEST_EXPECT_MSG_EQ(lostAt12, 1, "packet 0 is lost 10 s after being sent");
+    NS_TEST_EXPECT_MSG_EQ(lostAt16, 2, "packet 1 is lost 10 s after being forwarded");
+
+    const FlowMonitor::FlowStats& stats = monitor->GetFlowStats().at(1);
+    NS_TEST_EXPECT_MSG_EQ(stats.txPackets, 3, "transmitted packets");
+    NS_TEST_EXPECT_MSG_EQ(stats.rxPackets, 1, "received packets");
+    NS_TEST_EXPECT_MSG_EQ(stats.delaySum, Seconds(1), "delay of the received packet");
+
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup flow-monitor-test
+ *
+ * @brief FlowMonitor quantile sketches Test.
+ */
+class FlowMonitorSketchTestCase : public TestCase
+{
+  public:
+    FlowMonitorSketchTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+FlowMonitorSketchTestCase::FlowMonitorSketchTestCase()
+    : TestCase("FlowMonitor delay and jitter quantile sketches")
+{
+}
+
+void
+FlowMonitorSketchTestCase::DoRun()
+{
+    Ptr<FlowMonitor> monitor = CreateObjectWithAttributes<FlowMonitor>("EnableQuantileSketches",
+                                                                       BooleanValue(true));
+    Ptr<FlowProbe> probe = Create<FlowMonitorTestProbe>(monitor);
+    monitor->StartRightNow();
+
+    // flow 1 sends a packet every 10 ms, received i ms later; flow 2 sends
+    // the same packets, all received 200 ms later
+    for (uint32_t i = 1; i <= 100; i++)
+    {
+        Time sent = MilliSeconds(10 * i);
+        Simulator::Schedule(sent, &FlowMonitor::ReportFirstTx, monitor, probe, 1, i, 100);
+        Simulator::Schedule(sent + MilliSeconds(i),
+                            &FlowMonitor::ReportLastRx,
+                            monitor,
+                            probe,
+                            1,
+                            i,
+                            100);
+        Simulator::Schedule(sent, &FlowMonitor::ReportFirstTx, monitor, probe, 2, i, 100);
+        Simulator::Schedule(sent + MilliSeconds(200),
+                            &FlowMonitor::ReportLastRx,
+                            monitor,
+                            probe,
+                            2,
+                            i,
+                            100);
+    }
+    // the periodic check for lost packets keeps the simulation running
+    Simulator::Stop(Seconds(3));
+    Simulator::Run();
+
+    const FlowMonitor::FlowStats& stats = monitor->GetFlowStats().at(1);
+    NS_TEST_EXPECT_MSG_EQ(stats.delaySketch.GetCount(), 100, "delay samples of flow 1");
+    NS_TEST_EXPECT_MSG_EQ(stats.jitterSketch.GetCount(), 99, "jitter samples of flow 1");
+    NS_TEST_EXPECT_MSG_EQ_TOL(stats.delaySketch.GetQuantile(0.5),
+                              0.050,
+                              0.050 * 0.02,
+                              "median delay of flow 1");
+    NS_TEST_EXPECT_MSG_EQ_TOL(stats.jitterSketch.GetQuantile(0.99),
+                              0.001,
+                              0.001 * 0.01,
+                              "jitter of flow 1");
+    NS_TEST_EXPECT_MSG_EQ(monitor->GetFlowStats().at(2).jitterSketch.GetQuantile(0.99),
+                          0,
+                          "flow 2 has no jitter");
+
+    const QuantileSketch& delays = monitor->GetGlobalDelaySketch();
+    NS_TEST_EXPECT_MSG_EQ(delays.GetCount(), 200, "global delay samples");
+    NS_TEST_EXPECT_MSG_EQ(delays.GetMax(), 0.2, "global maximum delay");
+    NS_TEST_EXPECT_MSG_EQ_TOL(delays.GetQuantile(0.25),
+                              0.050,
+                              0.050 * 0.02,
+                              "global first quartile of the delay");
+    NS_TEST_EXPECT_MSG_EQ_TOL(delays.GetQuantile(0.75),
+                              0.2,
+                              0.2 * 0.01,
+                              "global third quartile of the delay");
+
+    std::string fileName = CreateTempDirFilename("flow-monitor-sketches.ncol");
+    monitor->SerializeToColumnarFile(fileName);
+    ColumnarReader reader;
+    NS_TEST_ASSERT_MSG_EQ(reader.Open(fileName), true, "columnar output");
+    NS_TEST_EXPECT_MSG_EQ(reader.GetNRows(), 2, "one row per flow");
+    std::vector<uint64_t> rxPackets;
+    std::vector<double> delayP50;
+    reader.ReadColumn(reader.GetColumnIndex("rxPackets"), rxPackets);
+    reader.ReadColumn(reader.GetColumnIndex("delayP50"), delayP50);
+    NS_TEST_EXPECT_MSG_EQ(rxPackets.at(0), 100, "received packets of flow 1");
+    NS_TEST_EXPECT_MSG_EQ(delayP50.at(0), stats.delaySketch.GetQuantile(0.5), "median delay");
+
+    monitor->ResetAllStats();
+    NS_TEST_EXPECT_MSG_EQ(monitor->GetGlobalDelaySketch().GetCount(), 0, "reset global sketch");
+    NS_TEST_EXPECT_MSG_EQ(monitor->GetFlowStats().at(1).delaySketch.GetCount(),
+                          0,
+                          "reset flow sketch");
+
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup flow-monitor-test
+ *
+ * @brief Flow and packet sampling Test.
+ */
+class FlowMonitorSamplingTestCase : public TestCase
+{
+  public:
+    FlowMonitorSamplingTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+FlowMonitorSamplingTestCase::FlowMonitorSamplingTestCase()
+    : TestCase("FlowMonitor flow and packet sampling")
+{
+}
+
+void
+FlowMonitorSamplingTestCase::DoRun()
+{
+    Ipv4Header header;
+    header.SetSource(Ipv4Address("10.0.0.1"));
+    header.SetDestination(Ipv4Address("10.0.0.2"));
+    header.SetProtocol(17);
+    auto classify = [&header](Ptr<Ipv4FlowClassifier> classifier,
+                              uint16_t srcPort,
+                              uint32_t* flowId,
+                              uint32_t* packetId) {
+        uint8_t ports[4] = {uint8_t(srcPort >> 8), uint8_t(srcPort), 0, 80};
+        return classifier->Classify(header, Create<Packet>(ports, 4), flowId, packetId);
+    };
+    uint32_t flowId;
+    uint32_t packetId;
+
+    // 1 in 4 flows, always the same ones
+    Ptr<Ipv4FlowClassifier> classifier = Create<Ipv4FlowClassifier>();
+    classifier->SetSampling(4, 1, 7);
+    uint32_t sampledFlows = 0;
+    for (uint16_t port = 1000; port < 1800; port++)
+    {
+        bool sampled = classify(classifier, port, &flowId, &packetId);
+        sampledFlows += sampled;
+        NS_TEST_EXPECT_MSG_EQ(classify(classifier, port, &flowId, &packetId),
+                              sampled,
+                              "packets of a flow are sampled together");
+        if (sampled)
+        {
+            NS_TEST_EXPECT_MSG_EQ(packetId, 1, "second packet of the flow");
+        }
+    }
+    NS_TEST_EXPECT_MSG_GT(sampledFlows, 150, "about 200 flows sampled");
+    NS_TEST_EXPECT_MSG_LT(sampledFlows, 250, "about 200 flows sampled");
+
+    // 1 in 8 packets of a flow, keeping their sequence numbers
+    classifier = Create<Ipv4FlowClassifier>();
+    classifier->SetSampling(1, 8, 0);
+    uint32_t sampledPackets = 0;
+    for (uint32_t i = 0; i < 8000; i++)
+    {
+        if (classify(classifier, 1000, &flowId, &packetId))
+        {
+            NS_TEST_EXPECT_MSG_EQ(packetId, i, "packet identifier");
+            sampledPackets++;
+        }
+    }
+    NS_TEST_EXPECT_MSG_GT(sampledPackets, 850, "about 1000 packets sampled");
+    NS_TEST_EXPECT_MSG_LT(sampledPackets, 1150, "about 1000 packets sampled");
+
+    // the estimates scale the sampled counts
+    Ptr<FlowMonitor> monitor =
+        CreateObjectWithAttributes<FlowMonitor>("FlowSamplingPeriod",
+                                                UintegerValue(4),
+                                                "PacketSamplingPeriod",
+                                                UintegerValue(2));
+    classifier = Create<Ipv4FlowClassifier>();
+    monitor->AddFlowClassifier(classifier);
+    sampledPackets = 0;
+    for (uint32_t i = 0; i < 100; i++)
+    {
+        sampledPackets += classify(classifier, 1000, &flowId, &packetId);
+    }
+    NS_TEST_EXPECT_MSG_LT(sampledPackets, 100, "sampling applied to the added classifier");
+    Ptr<FlowProbe> probe = Create<FlowMonitorTestProbe>(monitor);
+    monitor->StartRightNow();
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        Time sent = MilliSeconds(i);
+        Simulator::Schedule(sent, &FlowMonitor::ReportFirstTx, monitor, probe, 1, i, 100);
+        Simulator::Schedule(sent, &FlowMonitor::ReportFirstTx, monitor, probe, 2, i, 50);
+        if (i % 5)
+        {
+            Simulator::Schedule(sent + MilliSeconds(1),
+                                &FlowMonitor::ReportLastRx,
+                                monitor,
+                                probe,
+                                1,
+                                i,
+                                100);
+        }
+    }
+    Simulator::Stop(Seconds(1));
+    Simulator::Run();
+    monitor->CheckForLostPackets(Seconds(0));
+
+    FlowMonitor::SampledTotals totals = monitor->GetEstimatedTotals();
+    NS_TEST_EXPECT_MSG_EQ(totals.txPackets, 20 * 8, "estimated transmitted packets");
+    NS_TEST_EXPECT_MSG_EQ(totals.txBytes, 1500 * 8, "estimated transmitted bytes");
+    NS_TEST_EXPECT_MSG_EQ(totals.rxPackets, 8 * 8, "estimated received packets");
+    NS_TEST_EXPECT_MSG_EQ(totals.lostPackets, 12 * 8, "estimated lost packets");
+    NS_TEST_EXPECT_MSG_EQ_TOL(totals.lossRatio, 0.6, 1e-9, "estimated loss ratio");
+    FlowMonitor::SampledTotals flow = monitor->GetEstimatedFlowTotals(1);
+    NS_TEST_EXPECT_MSG_EQ(flow.rxBytes, 800 * 2, "estimated received bytes of flow 1");
+    NS_TEST_EXPECT_MSG_EQ_TOL(flow.lossRatio, 0.2, 1e-9, "estimated loss ratio of flow 1");
+    NS_TEST_EXPECT_MSG_EQ(monitor->GetEstimatedFlowTotals(3).txPackets, 0, "unknown flow");
+
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup flow-monitor-test
+ *
+ * @brief Flow monitoring with the byte tags disabled Test.
+ */
+class FlowMonitorNoByteTagsTestCase : public TestCase
+{
+  public:
+    FlowMonitorNoByteTagsTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+FlowMonitorNoByteTagsTestCase::FlowMonitorNoByteTagsTestCase()
+    : TestCase("FlowMonitor with the byte tags disabled")
+{
+}
+
+void
+FlowMonitorNoByteTagsTestCase::DoRun()
+{
+    Packet::DisableByteTags();
+
+    // restore the byte tags and destroy the simulator, even when an
+    // assertion returns early
+    struct Restore
+    {
+        ~Restore()
+        {
+            Simulator::Destroy();
+#ifndef NS3_NO_BYTE_TAGS
+            Packet::EnableByteTags();
+#endif
+        }
+    } restore;
+
+    // a source, a router and a sink
+    NodeContainer nodes;
+    nodes.Create(3);
+    SimpleNetDeviceHelper simpleHelper;
+    simpleHelper.SetNetDevicePointToPointMode(true);
+    NetDeviceContainer devices = simpleHelper.Install(NodeContainer(nodes.Get(0), nodes.Get(1)));
+    NetDeviceContainer devices2 = simpleHelper.Install(NodeContainer(nodes.Get(1), nodes.Get(2)));
+    InternetStackHelper internet;
+    internet.Install(nodes);
+    Ipv4AddressHelper address;
+    address.SetBase("10.0.0.0", "255.255.255.0");
+    address.Assign(devices);
+    address.SetBase("10.0.1.0", "255.255.255.0");
+    Ipv4InterfaceContainer interfaces = address.Assign(devices2);
+    Ipv4GlobalRoutingHelper::PopulateRoutingTables();
+
+    FlowMonitorHelper flowmon;
+    Ptr<FlowMonitor> monitor = flowmon.Install(nodes);
+
+    Ptr<Socket> sink = Socket::CreateSocket(nodes.Get(2), UdpSocketFactory::GetTypeId());
+    sink->Bind(InetSocketAddress(Ipv4Address::GetAny(), 9));
+    Ptr<Socket> source = Socket::CreateSocket(nodes.Get(0), UdpSocketFactory::GetTypeId());
+    source->Connect(InetSocketAddress(interfaces.GetAddress(1), 9));
+    for (uint32_t i = 0; i < 5; i++)
+    {
+        Simulator::ScheduleWithContext(nodes.Get(0)->GetId(), MilliSeconds(i), [source]() {
+            source->Send(Create<Packet>(100));
+        });
+    }
+    Simulator::Stop(Seconds(1));
+    Simulator::Run();
+    monitor->CheckForLostPackets();
+
+    // the probes find their packet tags at every hop
+    const FlowMonitor::FlowStatsContainer& stats = monitor->GetFlowStats();
+    NS_TEST_ASSERT_MSG_EQ(stats.size(), 1, "one flow");
+    const FlowMonitor::FlowStats& flow = stats.begin()->second;
+    NS_TEST_EXPECT_MSG_EQ(flow.txPackets, 5, "transmitted packets");
+    NS_TEST_EXPECT_MSG_EQ(flow.rxPackets, 5, "received packets");
+    NS_TEST_EXPECT_MSG_EQ(flow.timesForwarded, 5, "packets forwarded by the router");
+    NS_TEST_EXPECT_MSG_EQ(flow.lostPackets, 0, "lost packets");
+}
+
+/**
+ * @ingroup flow-monitor-test
+ *
+ * @brief Flow Monitor TestSuite
+ */
+class FlowMonitorTestSuite : public TestSuite
+{
+  public:
+    FlowMonitorTestSuite();
+};
+
+FlowMonitorTestSuite::FlowMonitorTestSuite()
+    : TestSuite("flow-monitor", Type::UNIT)
+{
+    AddTestCase(new FlowHashMapTestCase(), TestCase::Duration::QUICK);
+    AddTestCase(new FlowMonitorLostPacketsTestCase(), TestCase::Duration::QUICK);
+    AddTestCase(new FlowMonitorSketchTestCase(), TestCase::Duration::QUICK);
+    AddTestCase(new FlowMonitorSamplingTestCase(), TestCase::Duration::QUICK);
+    AddTestCase(new FlowMonitorNoByteTagsTestCase(), TestCase::Duration::QUICK);
+}
+
+static FlowMonitorTestSuite g_flowMonitorTestSuite; //!< Static variable for test initialization
@@ -0,0 +1,83 @@
+//
+// SPDX-License-Identifier: GPL-2.0-only
+//
+
+#include "forwarding-stack-helper.h"
+
+#include "ipv4-global-routing-helper.h"
+
+#include "ns3/ipv4-l3-protocol.h"
+#include "ns3/log.h"
+#include "ns3/names.h"
+#include "ns3/node.h"
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("ForwardingStackHelper");
+
+ForwardingStackHelper::ForwardingStackHelper()
+    : m_routing(Ipv4GlobalRoutingHelper().Copy())
+{
+}
+
+ForwardingStackHelper::~ForwardingStackHelper()
+{
+    delete m_routing;
+}
+
+ForwardingStackHelper::ForwardingStackHelper(const ForwardingStackHelper& o)
+    : m_routing(o.m_routing->Copy())
+{
+}
+
+ForwardingStackHelper&
+ForwardingStackHelper::operator=(const ForwardingStackHelper& o)
+{
+    if (this == &o)
+    {
+        return *this;
+    }
+    delete m_routing;
+    m_routing = o.m_routing->Copy();
+    return *this;
+}
+
+void
+ForwardingStackHelper::SetRoutingHelper(const Ipv4RoutingHelper& routing)
+{
+    delete m_routing;
+    m_routing = routing.Copy();
+}
+
+void
+ForwardingStackHelper::Install(std::string nodeName) const
+{
+    Ptr<Node> node = Names::Find<Node>(nodeName);
+    Install(node);
+}
+
+void
+ForwardingStackHelper::Install(Ptr<Node> node) const
+{
+    NS_LOG_FUNCTION(this << node);
+    if (node->GetObject<Ipv4>())
+    {
+        NS_LOG_LOGIC("IPv4 already installed on node " << node->GetId());
+        return;
+    }
+    Ptr<Ipv4L3Protocol> ipv4 = CreateObject<Ipv4L3Protocol>();
+    node->AggregateObject(ipv4);
+    ipv4->SetRoutingProtocol(m_routing->Create(node));
+}
+
+void
+ForwardingStackHelper::Install(NodeContainer c) const
+{
+    for (auto i = c.Begin(); i != c.End(); ++i)
+    {
+        Install(*i);
+    }
+}
+
+} // namespace ns3
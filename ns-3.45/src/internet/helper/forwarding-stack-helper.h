@@ -0,0 +1,107 @@
+//
+// SPDX-License-Identifier: GPL-2.0-only
+//
+
+#ifndef FORWARDING_STACK_HELPER_H
+#define FORWARDING_STACK_HELPER_H
+
+#include "ns3/node-container.h"
+#include "ns3/ptr.h"
+
+#include <string>
+
+namespace ns3
+{
+
+class Node;
+class Ipv4RoutingHelper;
+
+/**
+ * @ingroup ipv4Helpers
+ *
+ * @brief aggregate an IPv4 forwarding-only stack to the transit nodes, e.g.,
+ * the switches of a fabric.
+ *
+ * This helper aggregates to each node:
+ *  - ns3::Ipv4L3Protocol
+ *  - Ipv4 routing (a global routing object by default)
+ *
+ * Unlike InternetStackHelper, it does not aggregate ARP, ICMPv4, IPv6, UDP,
+ * TCP, the socket factories, nor the ns3::TrafficControlLayer.  Without a
+ * traffic control layer, Ipv4AddressHelper installs no queue disc, and the
+ * IPv4 interfaces hand the packets straight to their devices, whose queue is
+ * the only one.  The nodes forward the packets and deliver those sent to
+ * their addresses to nowhere: they cannot run applications, and they drop
+ * the packets whose TTL expires without an ICMP error.
+ *
+ * The devices of the nodes must not need ARP, e.g., point-to-point devices.
+ */
+class ForwardingStackHelper
+{
+  public:
+    /**
+     * Create a new ForwardingStackHelper which uses global routing by default.
+     */
+    ForwardingStackHelper();
+
+    /**
+     * Destroy the ForwardingStackHelper
+     */
+    ~ForwardingStackHelper();
+
+    /**
+     * @brief Copy constructor
+     * @param o Object to copy from.
+     */
+    ForwardingStackHelper(const ForwardingStackHelper& o);
+
+    /**
+     * @brief Copy constructor
+     * @param o Object to copy from.
+     * @returns A copy of the ForwardingStackHelper.
+     */
+    ForwardingStackHelper& operator=(const ForwardingStackHelper& o);
+
+    /**
+     * @param routing a new routing helper
+     *
+     * Set the routing helper to use during Install.
+     */
+    void SetRoutingHelper(const Ipv4RoutingHelper& routing);
+
+    /**
+     * Aggregate the forwarding-only stack onto the provided node.  This
+     * method does nothing if IPv4 is already installed.
+     *
+     * @param nodeName The name of the node on which to install the stack.
+     */
+    void Install(std::string nodeName) const;
+
+    /**
+     * Aggregate the forwarding-only stack onto the provided node.  This
+     * method does nothing if IPv4 is already installed.
+     *
+     * @param node The node on which to install the stack.
+     */
+    void Install(Ptr<Node> node) const;
+
+    /**
+     * For each node in the input container, aggregate the forwarding-only
+     * stack.  This method does nothing on the nodes where IPv4 is already
+     * installed.
+     *
+     * @param c NodeContainer that holds the set of nodes on which to install
+     * the new stacks.
+     */
+    void Install(NodeContainer c) const;
+
+  private:
+    /**
+     * @brief IPv4 routing helper.
+     */
+    const Ipv4RoutingHelper* m_routing;
+};
+
+} // namespace ns3
+
+#endif /* FORWARDING_STACK_HELPER_H */
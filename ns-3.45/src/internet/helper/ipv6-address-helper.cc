@@ -265,10 +265,12 @@ Ipv6AddressHelper::Assign(const NetDeviceContainer& c,
         retval.Add(ipv6, ifIndex);
 
         // Install the default traffic control configuration if the traffic
-        // control layer has been aggregated, if this is not
-        // a loopback interface, and there is no queue disc installed already
+        // control layer has been aggregated and does not bypass the devices
+        // without a queue disc, if this is not a loopback interface, and
+        // there is no queue disc installed already
         Ptr<TrafficControlLayer> tc = node->GetObject<TrafficControlLayer>();
-        if (tc && !DynamicCast<LoopbackNetDevice>(device) && !tc->GetRootQueueDiscOnDevice(device))
+        if (tc && !tc->GetQueueDiscBypass() && !DynamicCast<LoopbackNetDevice>(device) &&
+            !tc->GetRootQueueDiscOnDevice(device))
         {
             Ptr<NetDeviceQueueInterface> ndqi = device->GetObject<NetDeviceQueueInterface>();
             // It is useless to install a queue disc if the device has no
@@ -12,6 +12,7 @@
 
 #include "ns3/assert.h"
 #include "ns3/log.h"
+#include "ns3/multithreading.h"
 #include "ns3/simulation-singleton.h"
 
 namespace ns3
@@ -50,7 +51,7 @@ uint32_t
 GlobalRouteManager::AllocateRouterId()
 {
     NS_LOG_FUNCTION_NOARGS();
-    static uint32_t routerId = 0;
+    static NS3_SIMULATION_LOCAL uint32_t routerId = 0;
     return routerId++;
 }
 
@@ -12,6 +12,7 @@
 
 #include "ns3/boolean.h"
 #include "ns3/log.h"
+#include "ns3/multithreading.h"
 #include "ns3/names.h"
 #include "ns3/net-device.h"
 #include "ns3/node.h"
@@ -36,6 +37,7 @@
 // 修复：find_if / isspace 需要的头文件
 #include <algorithm>
 #include <cctype>
+#include <mutex>
 
 namespace ns3
 {
@@ -47,12 +49,14 @@ NS_OBJECT_ENSURE_REGISTERED(Ipv4GlobalRouting);
 // 匿名命名空间: ECMP 权重（按节点，来自单一文件）、节点重盐与哈希工具
 namespace
 {
-// (nodeId, N备选数) -> 该节点此N下的权重前缀（缓存）
-static std::map<std::pair<uint32_t, size_t>, std::vector<uint32_t>> g_ecmpWeightCacheByNodeN;
+// (nodeId, N备选数) -> 该节点此N下的权重前缀（缓存, 多线程构建中每线程一份）
+static NS3_THREAD_LOCAL std::map<std::pair<uint32_t, size_t>, std::vector<uint32_t>>
+    g_ecmpWeightCacheByNodeN;
 
 // 节点原始权重表：nodeId -> 一串权重（读取整行，运行时按前缀取 N 个）
+// 只加载一次, 之后只读: 同一进程内的各线程/各次仿真共享
 static std::map<uint32_t, std::vector<uint32_t>> g_nodeRawWeights;
-static bool g_weightsLoaded = false;
+static std::once_flag g_weightsLoaded;
 
 // 64-bit FNV-1a 常量
 static constexpr uint64_t FNV64_OFFSET = 1469598103934665603ull;
@@ -152,13 +156,10 @@ StripCommentAndTrim(const std::string& line)
 static bool
 LoadAllNodeWeightsFile()
 {
-    if (g_weightsLoaded) return !g_nodeRawWeights.empty();
-
     std::ifstream fin("ecmpProbability.txt");
     if (!fin.good())
     {
         NS_LOG_WARN("ECMP 权重文件无法打开: ecmpProbability.txt");
-        g_weightsLoaded = true;
         return false;
     }
 
@@ -222,7 +223,6 @@ LoadAllNodeWeightsFile()
         ++okCnt;
     }
 
-    g_weightsLoaded = true;
     if (okCnt == 0)
     {
         NS_LOG_WARN("ecmpProbability.txt 中未加载到任何节点权重");
@@ -244,10 +244,7 @@ GetNodeWeights(uint32_t nodeId, size_t n, std::vector<uint32_t>& out)
         return true;
     }
 
-    if (!g_weightsLoaded)
-    {
-        LoadAllNodeWeightsFile();
-    }
+    std::call_once(g_weightsLoaded, LoadAllNodeWeightsFile);
 
     auto itRaw = g_nodeRawWeights.find(nodeId);
     if (itRaw == g_nodeRawWeights.end())
@@ -459,8 +456,7 @@ Ipv4GlobalRouting::LookupGlobal(Ipv4Address dest,
                 if (proto == 6) // TCP
                 {
                     TcpHeader th;
-                    Ptr<Packet> pkt = payload->Copy();
-                    if (pkt->PeekHeader(th))
+                    if (payload->PeekHeader(th))
                     {
                         sport = th.GetSourcePort();
                         dport = th.GetDestinationPort();
@@ -470,8 +466,7 @@ Ipv4GlobalRouting::LookupGlobal(Ipv4Address dest,
                 else if (proto == 17) // UDP
                 {
                     UdpHeader uh;
-                    Ptr<Packet> pkt = payload->Copy();
-                    if (pkt->PeekHeader(uh))
+                    if (payload->PeekHeader(uh))
                     {
                         sport = uh.GetSourcePort();
                         dport = uh.GetDestinationPort();
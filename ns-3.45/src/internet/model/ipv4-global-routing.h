@@ -230,6 +230,9 @@ class Ipv4GlobalRouting : public Ipv4RoutingProtocol
     /// Set to true if this interface should respond to interface events by globally recomputing
     /// routes
     bool m_respondToInterfaceEvents;
+    /// Set to true to select among ECMP routes with a stable hash of the flow; overrides
+    /// m_randomEcmpRouting
+    bool m_perflowEcmpRouting;
     /// A uniform random number generator for randomly routing packets among ECMP
     Ptr<UniformRandomVariable> m_rand;
 
@@ -258,9 +261,14 @@ class Ipv4GlobalRouting : public Ipv4RoutingProtocol
      * @brief Lookup in the forwarding table for destination.
      * @param dest destination address
      * @param oif output interface if any (put 0 otherwise)
+     * @param hdr IPv4 header of the packet, used to hash the flow (if any)
+     * @param payload IPv4 payload of the packet, used to hash the flow (if any)
      * @return Ipv4Route to route the packet to reach dest address
      */
-    Ptr<Ipv4Route> LookupGlobal(Ipv4Address dest, Ptr<NetDevice> oif = nullptr);
+    Ptr<Ipv4Route> LookupGlobal(Ipv4Address dest,
+                                Ptr<NetDevice> oif = nullptr,
+                                const Ipv4Header* hdr = nullptr,
+                                Ptr<const Packet> payload = nullptr);
 
     HostRoutes m_hostRoutes;             //!< Routes to hosts
     NetworkRoutes m_networkRoutes;       //!< Routes to networks
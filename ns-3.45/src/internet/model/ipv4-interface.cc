@@ -232,14 +232,24 @@ Ipv4Interface::Send(Ptr<Packet> p, const Ipv4Header& hdr, Ipv4Address dest)
         return;
     }
 
-    NS_ASSERT(m_tc);
-
     // is this packet aimed at a local interface ?
     for (auto i = m_ifaddrs.begin(); i != m_ifaddrs.end(); ++i)
     {
         if (dest == (*i).GetLocal())
         {
             p->AddHeader(hdr);
+            if (!m_tc)
+            {
+                Simulator::ScheduleNow(&Ipv4L3Protocol::Receive,
+                                       m_node->GetObject<Ipv4L3Protocol>(),
+                                       m_device,
+                                       p,
+                                       Ipv4L3Protocol::PROT_NUMBER,
+                                       m_device->GetBroadcast(),
+                                       m_device->GetBroadcast(),
+                                       NetDevice::PACKET_HOST);
+                return;
+            }
             Simulator::ScheduleNow(&TrafficControlLayer::Receive,
                                    m_tc,
                                    m_device,
@@ -251,6 +261,16 @@ Ipv4Interface::Send(Ptr<Packet> p, const Ipv4Header& hdr, Ipv4Address dest)
             return;
         }
     }
+    // without a traffic control layer, i.e., on a forwarding-only node,
+    // the packet goes straight to the device
+    if (!m_tc)
+    {
+        NS_ASSERT(!m_device->NeedsArp());
+        p->AddHeader(hdr);
+        m_device->Send(p, m_device->GetBroadcast(), Ipv4L3Protocol::PROT_NUMBER);
+        return;
+    }
+
     if (m_device->NeedsArp())
     {
         NS_LOG_LOGIC("Needs ARP " << dest);
@@ -295,21 +315,35 @@ Ipv4Interface::Send(Ptr<Packet> p, const Ipv4Header& hdr, Ipv4Address dest)
         if (found)
         {
             NS_LOG_LOGIC("Address Resolved.  Send.");
-            m_tc->Send(m_device,
-                       Create<Ipv4QueueDiscItem>(p,
-                                                 hardwareDestination,
-                                                 Ipv4L3Protocol::PROT_NUMBER,
-                                                 hdr));
+            if (!m_tc->SendWithoutQueueDisc(m_device,
+                                            p,
+                                            hdr,
+                                            hardwareDestination,
+                                            Ipv4L3Protocol::PROT_NUMBER))
+            {
+                m_tc->Send(m_device,
+                           Create<Ipv4QueueDiscItem>(p,
+                                                     hardwareDestination,
+                                                     Ipv4L3Protocol::PROT_NUMBER,
+                                                     hdr));
+            }
         }
     }
     else
     {
         NS_LOG_LOGIC("Doesn't need ARP");
-        m_tc->Send(m_device,
-                   Create<Ipv4QueueDiscItem>(p,
-                                             m_device->GetBroadcast(),
-                                             Ipv4L3Protocol::PROT_NUMBER,
-                                             hdr));
+        if (!m_tc->SendWithoutQueueDisc(m_device,
+                                        p,
+                                        hdr,
+                                        m_device->GetBroadcast(),
+                                        Ipv4L3Protocol::PROT_NUMBER))
+        {
+            m_tc->Send(m_device,
+                       Create<Ipv4QueueDiscItem>(p,
+                                                 m_device->GetBroadcast(),
+                                                 Ipv4L3Protocol::PROT_NUMBER,
+                                                 hdr));
+        }
     }
 }
 
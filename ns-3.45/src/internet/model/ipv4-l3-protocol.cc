@@ -385,23 +385,38 @@ Ipv4L3Protocol::AddInterface(Ptr<NetDevice> device)
     NS_ASSERT(m_node);
 
     Ptr<TrafficControlLayer> tc = m_node->GetObject<TrafficControlLayer>();
+    Ptr<ArpL3Protocol> arp = GetObject<ArpL3Protocol>();
 
-    NS_ASSERT(tc);
-
-    m_node->RegisterProtocolHandler(MakeCallback(&TrafficControlLayer::Receive, tc),
+    //
+    // A forwarding-only node (see ForwardingStackHelper) has neither a
+    // traffic control layer nor ARP: the device hands the packets straight
+    // to IPv4, which hands them straight to the device.
+    //
+    if (!tc)
+    {
+        NS_ABORT_MSG_IF(device->NeedsArp(), "A node without ARP needs devices which do not");
+        m_node->RegisterProtocolHandler(MakeCallback(&Ipv4L3Protocol::Receive, this),
+                                        Ipv4L3Protocol::PROT_NUMBER,
+                                        device);
+    }
+    else
+    {
+        m_node->RegisterProtocolHandler(MakeCallback(&TrafficControlLayer::Receive, tc),
+                                        Ipv4L3Protocol::PROT_NUMBER,
+                                        device);
+        tc->RegisterProtocolHandler(MakeCallback(&Ipv4L3Protocol::Receive, this),
                                     Ipv4L3Protocol::PROT_NUMBER,
                                     device);
-    m_node->RegisterProtocolHandler(MakeCallback(&TrafficControlLayer::Receive, tc),
-                                    ArpL3Protocol::PROT_NUMBER,
-                                    device);
-
-    tc->RegisterProtocolHandler(MakeCallback(&Ipv4L3Protocol::Receive, this),
-                                Ipv4L3Protocol::PROT_NUMBER,
-                                device);
-    tc->RegisterProtocolHandler(
-        MakeCallback(&ArpL3Protocol::Receive, PeekPointer(GetObject<ArpL3Protocol>())),
-        ArpL3Protocol::PROT_NUMBER,
-        device);
+        if (arp)
+        {
+            m_node->RegisterProtocolHandler(MakeCallback(&TrafficControlLayer::Receive, tc),
+                                            ArpL3Protocol::PROT_NUMBER,
+                                            device);
+            tc->RegisterProtocolHandler(MakeCallback(&ArpL3Protocol::Receive, PeekPointer(arp)),
+                                        ArpL3Protocol::PROT_NUMBER,
+                                        device);
+        }
+    }
 
     Ptr<Ipv4Interface> interface = CreateObject<Ipv4Interface>();
     interface->SetNode(m_node);
@@ -1050,7 +1065,10 @@ Ipv4L3Protocol::IpForward(Ptr<Ipv4Route> rtentry, Ptr<const Packet> p, const Ipv
         if (!ipHeader.GetDestination().IsBroadcast() && !ipHeader.GetDestination().IsMulticast())
         {
             Ptr<Icmpv4L4Protocol> icmp = GetIcmp();
-            icmp->SendTimeExceededTtl(ipHeader, packet, false);
+            if (icmp)
+            {
+                icmp->SendTimeExceededTtl(ipHeader, packet, false);
+            }
         }
         NS_LOG_WARN("TTL exceeded.  Drop.");
         m_dropTrace(header, packet, DROP_TTL_EXPIRED, this, interface);
@@ -1127,9 +1145,10 @@ Ipv4L3Protocol::LocalDeliver(Ptr<const Packet> packet, const Ipv4Header& ip, uin
                     subnetDirected = true;
                 }
             }
-            if (!subnetDirected)
+            Ptr<Icmpv4L4Protocol> icmp = GetIcmp();
+            if (!subnetDirected && icmp)
             {
-                GetIcmp()->SendDestUnreachPort(ipHeader, copy);
+                icmp->SendDestUnreachPort(ipHeader, copy);
             }
         }
     }
@@ -1727,9 +1746,9 @@ Ipv4L3Protocol::HandleFragmentsTimeout(FragmentKey_t key, Ipv4Header& ipHeader,
     Ptr<Packet> packet = it->second->GetPartialPacket();
 
     // if we have at least 8 bytes, we can send an ICMP.
-    if (packet->GetSize() > 8)
+    Ptr<Icmpv4L4Protocol> icmp = GetIcmp();
+    if (packet->GetSize() > 8 && icmp)
     {
-        Ptr<Icmpv4L4Protocol> icmp = GetIcmp();
         icmp->SendTimeExceededTtl(ipHeader, packet, true);
     }
     m_dropTrace(ipHeader, packet, DROP_FRAGMENT_TIMEOUT, this, iif);
@@ -487,21 +487,35 @@ Ipv6Interface::Send(Ptr<Packet> p, const Ipv6Header& hdr, Ipv6Address dest)
         if (found)
         {
             NS_LOG_LOGIC("Address Resolved.  Send.");
-            m_tc->Send(m_device,
-                       Create<Ipv6QueueDiscItem>(p,
-                                                 hardwareDestination,
-                                                 Ipv6L3Protocol::PROT_NUMBER,
-                                                 hdr));
+            if (!m_tc->SendWithoutQueueDisc(m_device,
+                                            p,
+                                            hdr,
+                                            hardwareDestination,
+                                            Ipv6L3Protocol::PROT_NUMBER))
+            {
+                m_tc->Send(m_device,
+                           Create<Ipv6QueueDiscItem>(p,
+                                                     hardwareDestination,
+                                                     Ipv6L3Protocol::PROT_NUMBER,
+                                                     hdr));
+            }
         }
     }
     else
     {
         NS_LOG_LOGIC("Doesn't need NDISC");
-        m_tc->Send(m_device,
-                   Create<Ipv6QueueDiscItem>(p,
-                                             m_device->GetBroadcast(),
-                                             Ipv6L3Protocol::PROT_NUMBER,
-                                             hdr));
+        if (!m_tc->SendWithoutQueueDisc(m_device,
+                                        p,
+                                        hdr,
+                                        m_device->GetBroadcast(),
+                                        Ipv6L3Protocol::PROT_NUMBER))
+        {
+            m_tc->Send(m_device,
+                       Create<Ipv6QueueDiscItem>(p,
+                                                 m_device->GetBroadcast(),
+                                                 Ipv6L3Protocol::PROT_NUMBER,
+                                                 hdr));
+        }
     }
 }
 
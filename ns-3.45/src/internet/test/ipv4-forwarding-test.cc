@@ -8,11 +8,13 @@
 
 #include "ns3/arp-l3-protocol.h"
 #include "ns3/boolean.h"
+#include "ns3/forwarding-stack-helper.h"
 #include "ns3/icmpv4-l4-protocol.h"
 #include "ns3/inet-socket-address.h"
 #include "ns3/internet-stack-helper.h"
 #include "ns3/ipv4-l3-protocol.h"
 #include "ns3/ipv4-routing-helper.h"
+#include "ns3/ipv4-static-routing-helper.h"
 #include "ns3/ipv4-static-routing.h"
 #include "ns3/log.h"
 #include "ns3/node.h"
@@ -213,6 +215,145 @@ Ipv4ForwardingTest::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup internet-test
+ *
+ * @brief IPv4 Forwarding Test through a node with the ForwardingStackHelper stack
+ */
+class Ipv4ForwardingOnlyTest : public TestCase
+{
+    uint32_t m_received{0}; //!< Number of packets received
+
+    /**
+     * @brief Send data.
+     * @param socket The sending socket.
+     * @param to Destination address.
+     */
+    void SendData(Ptr<Socket> socket, std::string to);
+
+    /**
+     * @brief Add an interface to a node.
+     * @param node The node.
+     * @param address The address of the interface.
+     * @returns The device of the interface.
+     */
+    Ptr<SimpleNetDevice> AddInterface(Ptr<Node> node, std::string address);
+
+  public:
+    void DoRun() override;
+    Ipv4ForwardingOnlyTest();
+
+    /**
+     * @brief Receive data.
+     * @param socket The receiving socket.
+     */
+    void ReceivePkt(Ptr<Socket> socket);
+};
+
+Ipv4ForwardingOnlyTest::Ipv4ForwardingOnlyTest()
+    : TestCase("Forwarding-only stack")
+{
+}
+
+void
+Ipv4ForwardingOnlyTest::ReceivePkt(Ptr<Socket> socket)
+{
+    while (socket->Recv())
+    {
+        m_received++;
+    }
+}
+
+void
+Ipv4ForwardingOnlyTest::SendData(Ptr<Socket> socket, std::string to)
+{
+    m_received = 0;
+    Address realTo = InetSocketAddress(Ipv4Address(to.c_str()), 1234);
+    Simulator::ScheduleWithContext(socket->GetNode()->GetId(), Seconds(0), [socket, realTo] {
+        socket->SendTo(Create<Packet>(123), 0, realTo);
+    });
+    Simulator::Run();
+}
+
+Ptr<SimpleNetDevice>
+Ipv4ForwardingOnlyTest::AddInterface(Ptr<Node> node, std::string address)
+{
+    Ptr<SimpleNetDevice> dev = CreateObject<SimpleNetDevice>();
+    dev->SetAttribute("PointToPointMode", BooleanValue(true));
+    dev->SetAddress(Mac48Address::ConvertFrom(Mac48Address::Allocate()));
+    node->AddDevice(dev);
+    Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
+    uint32_t netdev_idx = ipv4->AddInterface(dev);
+    ipv4->AddAddress(netdev_idx,
+                     Ipv4InterfaceAddress(Ipv4Address(address.c_str()), Ipv4Mask(0xffff0000U)));
+    ipv4->SetUp(netdev_idx);
+    return dev;
+}
+
+void
+Ipv4ForwardingOnlyTest::DoRun()
+{
+    // Create topology: txNode - fwNode - rxNode
+
+    InternetStackHelper internet;
+    internet.SetIpv6StackInstall(false);
+    ForwardingStackHelper forwarding;
+    forwarding.SetRoutingHelper(Ipv4StaticRoutingHelper());
+
+    Ptr<Node> rxNode = CreateObject<Node>();
+    Ptr<Node> fwNode = CreateObject<Node>();
+    Ptr<Node> txNode = CreateObject<Node>();
+    internet.Install(rxNode);
+    forwarding.Install(fwNode);
+    internet.Install(txNode);
+
+    NS_TEST_EXPECT_MSG_NE(fwNode->GetObject<Ipv4L3Protocol>(), nullptr, "IPv4 installed");
+    NS_TEST_EXPECT_MSG_EQ(fwNode->GetObject<ArpL3Protocol>(), nullptr, "no ARP");
+    NS_TEST_EXPECT_MSG_EQ(fwNode->GetObject<Icmpv4L4Protocol>(), nullptr, "no ICMP");
+    NS_TEST_EXPECT_MSG_EQ(fwNode->GetObject<UdpL4Protocol>(), nullptr, "no UDP");
+    NS_TEST_EXPECT_MSG_EQ(fwNode->GetObject<TrafficControlLayer>(), nullptr, "no traffic control");
+
+    Ptr<SimpleNetDevice> rxDev = AddInterface(rxNode, "10.0.0.2");
+    Ptr<SimpleNetDevice> fwDev1 = AddInterface(fwNode, "10.0.0.1");
+    Ptr<SimpleNetDevice> fwDev2 = AddInterface(fwNode, "10.1.0.1");
+    Ptr<SimpleNetDevice> txDev = AddInterface(txNode, "10.1.0.2");
+    for (const auto& node : {rxNode, txNode})
+    {
+        Ptr<Ipv4StaticRouting> ipv4StaticRouting = Ipv4RoutingHelper::GetRouting<Ipv4StaticRouting>(
+            node->GetObject<Ipv4>()->GetRoutingProtocol());
+        ipv4StaticRouting->SetDefaultRoute(Ipv4Address(node == rxNode ? "10.0.0.1" : "10.1.0.1"),
+                                           1);
+    }
+
+    Ptr<SimpleChannel> channel1 = CreateObject<SimpleChannel>();
+    rxDev->SetChannel(channel1);
+    fwDev1->SetChannel(channel1);
+    Ptr<SimpleChannel> channel2 = CreateObject<SimpleChannel>();
+    fwDev2->SetChannel(channel2);
+    txDev->SetChannel(channel2);
+
+    Ptr<Socket> rxSocket = rxNode->GetObject<UdpSocketFactory>()->CreateSocket();
+    NS_TEST_EXPECT_MSG_EQ(rxSocket->Bind(InetSocketAddress(Ipv4Address("10.0.0.2"), 1234)),
+                          0,
+                          "trivial");
+    rxSocket->SetRecvCallback(MakeCallback(&Ipv4ForwardingOnlyTest::ReceivePkt, this));
+    Ptr<Socket> txSocket = txNode->GetObject<UdpSocketFactory>()->CreateSocket();
+
+    // ------ Now the tests ------------
+
+    SendData(txSocket, "10.0.0.2");
+    NS_TEST_EXPECT_MSG_EQ(m_received, 1, "forwarded");
+
+    // the forwarding node sends no ICMP error
+    SendData(txSocket, "10.0.0.1");
+    NS_TEST_EXPECT_MSG_EQ(m_received, 0, "delivered to the forwarding node");
+    txSocket->SetIpTtl(1);
+    SendData(txSocket, "10.0.0.2");
+    NS_TEST_EXPECT_MSG_EQ(m_received, 0, "TTL expired");
+
+    Simulator::Destroy();
+}
+
 /**
  * @ingroup internet-test
  *
@@ -230,6 +371,7 @@ Ipv4ForwardingTestSuite::Ipv4ForwardingTestSuite()
     : TestSuite("ipv4-forwarding", Type::UNIT)
 {
     AddTestCase(new Ipv4ForwardingTest, TestCase::Duration::QUICK);
+    AddTestCase(new Ipv4ForwardingOnlyTest, TestCase::Duration::QUICK);
 }
 
 static Ipv4ForwardingTestSuite
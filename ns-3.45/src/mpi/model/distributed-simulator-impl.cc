@@ -106,6 +106,7 @@ DistributedSimulatorImpl::DistributedSimulatorImpl()
     m_currentContext = Simulator::NO_CONTEXT;
     m_unscheduledEvents = 0;
     m_eventCount = 0;
+    m_cancelledEventCount = 0;
     m_events = nullptr;
 }
 
@@ -303,6 +304,10 @@ DistributedSimulatorImpl::ProcessOneEvent()
     NS_ASSERT(next.key.m_ts >= m_currentTs);
     m_unscheduledEvents--;
     m_eventCount++;
+    if (next.impl->IsCancelled())
+    {
+        m_cancelledEventCount++;
+    }
 
     NS_LOG_LOGIC("handle " << next.key.m_ts);
     m_currentTs = next.key.m_ts;
@@ -622,4 +627,16 @@ DistributedSimulatorImpl::GetEventCount() const
     return m_eventCount;
 }
 
+uint64_t
+DistributedSimulatorImpl::GetCancelledEventCount() const
+{
+    return m_cancelledEventCount;
+}
+
+uint64_t
+DistributedSimulatorImpl::GetPendingEventCount() const
+{
+    return m_unscheduledEvents;
+}
+
 } // namespace ns3
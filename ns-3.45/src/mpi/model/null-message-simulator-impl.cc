@@ -74,6 +74,7 @@ NullMessageSimulatorImpl::NullMessageSimulatorImpl()
     m_currentContext = Simulator::NO_CONTEXT;
     m_unscheduledEvents = 0;
     m_eventCount = 0;
+    m_cancelledEventCount = 0;
     m_events = nullptr;
 
     m_safeTime = Seconds(0);
@@ -223,6 +224,10 @@ NullMessageSimulatorImpl::ProcessOneEvent()
     NS_ASSERT(next.key.m_ts >= m_currentTs);
     m_unscheduledEvents--;
     m_eventCount++;
+    if (next.impl->IsCancelled())
+    {
+        m_cancelledEventCount++;
+    }
 
     NS_LOG_LOGIC("handle " << next.key.m_ts);
     m_currentTs = next.key.m_ts;
@@ -545,6 +550,18 @@ NullMessageSimulatorImpl::GetEventCount() const
     return m_eventCount;
 }
 
+uint64_t
+NullMessageSimulatorImpl::GetCancelledEventCount() const
+{
+    return m_cancelledEventCount;
+}
+
+uint64_t
+NullMessageSimulatorImpl::GetPendingEventCount() const
+{
+    return m_unscheduledEvents;
+}
+
 Time
 NullMessageSimulatorImpl::CalculateGuaranteeTime(uint32_t nodeSysId)
 {
@@ -72,6 +72,8 @@ class NullMessageSimulatorImpl : public SimulatorImpl
     uint32_t GetSystemId() const override;
     uint32_t GetContext() const override;
     uint64_t GetEventCount() const override;
+    uint64_t GetCancelledEventCount() const override;
+    uint64_t GetPendingEventCount() const override;
 
     /**
      * @return singleton instance
@@ -189,6 +191,8 @@ class NullMessageSimulatorImpl : public SimulatorImpl
     uint32_t m_currentContext;
     /** The event count. */
     uint64_t m_eventCount;
+    /** The count of the cancelled events removed from the event list. */
+    uint64_t m_cancelledEventCount;
     /**
      * Number of events that have been inserted but not yet scheduled,
      * not counting the "destroy" events; this is used for validation.
@@ -0,0 +1,866 @@
+//
+// SPDX-License-Identifier: GPL-2.0-only
+//
+
+#include "multithreaded-simulator-impl.h"
+
+#include "ns3/abort.h"
+#include "ns3/assert.h"
+#include "ns3/channel.h"
+#include "ns3/log.h"
+#include "ns3/net-device.h"
+#include "ns3/node-list.h"
+#include "ns3/node.h"
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <thread>
+
+/**
+ * @file
+ * @ingroup mtp
+ * ns3::MultithreadedSimulatorImpl implementation.
+ */
+
+namespace ns3
+{
+
+// Note:  as in DefaultSimulatorImpl, logging is avoided in the functions
+// called for each event; it is not thread-safe either.
+NS_LOG_COMPONENT_DEFINE("MultithreadedSimulatorImpl");
+
+NS_OBJECT_ENSURE_REGISTERED(MultithreadedSimulatorImpl);
+
+/// Number of windows between two updates of the processing order of the LPs
+static const uint64_t LOAD_BALANCING_PERIOD = 256;
+
+thread_local MultithreadedSimulatorImpl::LogicalProcess* MultithreadedSimulatorImpl::g_current =
+    nullptr;
+
+TypeId
+MultithreadedSimulatorImpl::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::MultithreadedSimulatorImpl")
+            .SetParent<SimulatorImpl>()
+            .SetGroupName("Mtp")
+            .AddConstructor<MultithreadedSimulatorImpl>()
+            .AddAttribute("MaxThreads",
+                          "The maximum number of threads running the simulation "
+                          "(0: the number of hardware threads).",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&MultithreadedSimulatorImpl::m_maxThreads),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("MinLookahead",
+                          "The point-to-point links with a smaller delay are not cut: "
+                          "their nodes are simulated by the same logical process.",
+                          TimeValue(Time(0)),
+                          MakeTimeAccessor(&MultithreadedSimulatorImpl::m_minLookahead),
+                          MakeTimeChecker());
+    return tid;
+}
+
+MultithreadedSimulatorImpl::MultithreadedSimulatorImpl()
+    : m_lookahead(Time::Max()),
+      m_minLookahead(Time(0)),
+      m_maxThreads(0),
+      m_nThreads(0),
+      m_windowCount(0),
+      m_partitioned(false),
+      m_running(false),
+      m_stop(false),
+      m_exit(false),
+      m_receiveIndex(0),
+      m_processIndex(0)
+{
+    NS_LOG_FUNCTION(this);
+    m_public = CreateLogicalProcess(0);
+}
+
+MultithreadedSimulatorImpl::~MultithreadedSimulatorImpl()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+std::unique_ptr<MultithreadedSimulatorImpl::LogicalProcess>
+MultithreadedSimulatorImpl::CreateLogicalProcess(uint32_t id) const
+{
+    auto lp = std::make_unique<LogicalProcess>();
+    lp->id = id;
+    if (m_public)
+    {
+        lp->currentTs = m_public->currentTs;
+        lp->currentContext = Simulator::NO_CONTEXT;
+        lp->currentUid = m_public->currentUid;
+        lp->uid = m_public->uid;
+    }
+    else
+    {
+        lp->currentTs = 0;
+        lp->currentContext = Simulator::NO_CONTEXT;
+        lp->currentUid = EventId::UID::INVALID;
+        lp->uid = EventId::UID::VALID;
+    }
+    lp->eventCount = 0;
+    lp->cancelledCount = 0;
+    lp->pendingCount = 0;
+    lp->balanceCount = 0;
+    lp->nextTs = std::numeric_limits<uint64_t>::max();
+    lp->windowStart = 0;
+    lp->windowEnd = std::numeric_limits<uint64_t>::max();
+    // the packets created outside of the LPs keep the uids below 2^32
+    lp->packetUid = static_cast<uint64_t>(id + 1) << 32;
+    if (m_public && m_public->events)
+    {
+        lp->events = m_schedulerFactory.Create<Scheduler>();
+    }
+    return lp;
+}
+
+void
+MultithreadedSimulatorImpl::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    std::vector<LogicalProcess*> lps{m_public.get()};
+    for (auto& lp : m_lps)
+    {
+        lps.push_back(lp.get());
+    }
+    for (auto lp : lps)
+    {
+        for (auto& inbox : lp->inboxes)
+        {
+            for (auto& message : inbox->messages)
+            {
+                message.event->Unref();
+            }
+        }
+        lp->inboxes.clear();
+        lp->outboxes.clear();
+        while (lp->events && !lp->events->IsEmpty())
+        {
+            Scheduler::Event next = lp->events->RemoveNext();
+            next.impl->Unref();
+        }
+        lp->events = nullptr;
+    }
+    SimulatorImpl::DoDispose();
+}
+
+void
+MultithreadedSimulatorImpl::Destroy()
+{
+    NS_LOG_FUNCTION(this);
+    while (!m_destroyEvents.empty())
+    {
+        Ptr<EventImpl> ev = m_destroyEvents.front().PeekEventImpl();
+        m_destroyEvents.pop_front();
+        NS_LOG_LOGIC("handle destroy " << ev);
+        if (!ev->IsCancelled())
+        {
+            ev->Invoke();
+        }
+    }
+}
+
+void
+MultithreadedSimulatorImpl::SetScheduler(ObjectFactory schedulerFactory)
+{
+    NS_LOG_FUNCTION(this << schedulerFactory);
+    NS_ABORT_MSG_IF(m_running, "The scheduler cannot be changed during Simulator::Run()");
+    m_schedulerFactory = schedulerFactory;
+
+    std::vector<LogicalProcess*> lps{m_public.get()};
+    for (auto& lp : m_lps)
+    {
+        lps.push_back(lp.get());
+    }
+    for (auto lp : lps)
+    {
+        Ptr<Scheduler> scheduler = schedulerFactory.Create<Scheduler>();
+        while (lp->events && !lp->events->IsEmpty())
+        {
+            scheduler->Insert(lp->events->RemoveNext());
+        }
+        lp->events = scheduler;
+    }
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetSystemId() const
+{
+    return 0;
+}
+
+void
+MultithreadedSimulatorImpl::Partition()
+{
+    NS_LOG_FUNCTION(this);
+    uint32_t nNodes = NodeList::GetNNodes();
+
+    // union-find of the nodes which are not separated by a link with a delay
+    std::vector<uint32_t> parent(nNodes);
+    std::iota(parent.begin(), parent.end(), 0);
+    auto find = [&parent](uint32_t n) {
+        while (parent[n] != n)
+        {
+            parent[n] = parent[parent[n]];
+            n = parent[n];
+        }
+        return n;
+    };
+
+    struct Link
+    {
+        uint32_t a;
+        uint32_t b;
+        Time delay;
+    };
+
+    std::vector<Link> links;
+    for (uint32_t n = 0; n < nNodes; n++)
+    {
+        Ptr<Node> node = NodeList::GetNode(n);
+        for (uint32_t d = 0; d < node->GetNDevices(); d++)
+        {
+            Ptr<NetDevice> device = node->GetDevice(d);
+            Ptr<Channel> channel = device->GetChannel();
+            if (!channel)
+            {
+                continue;
+            }
+            TimeValue delay;
+            bool cut = device->IsPointToPoint() && channel->GetNDevices() == 2 &&
+                       channel->GetAttributeFailSafe("Delay", delay) &&
+                       delay.Get().IsStrictlyPositive() && delay.Get() >= m_minLookahead;
+            for (std::size_t i = 0; i < channel->GetNDevices(); i++)
+            {
+                uint32_t peer = channel->GetDevice(i)->GetNode()->GetId();
+                if (peer == n)
+                {
+                    continue;
+                }
+                if (cut)
+                {
+                    links.push_back({n, peer, delay.Get()});
+                }
+                else
+                {
+                    parent[find(peer)] = find(n);
+                }
+            }
+        }
+    }
+
+    // the LPs are numbered in the order of their first node
+    std::vector<uint32_t> lpOfRoot(nNodes, std::numeric_limits<uint32_t>::max());
+    m_nodeLps.resize(nNodes);
+    for (uint32_t n = 0; n < nNodes; n++)
+    {
+        uint32_t root = find(n);
+        if (lpOfRoot[root] == std::numeric_limits<uint32_t>::max())
+        {
+            lpOfRoot[root] = m_lps.size();
+            m_lps.push_back(CreateLogicalProcess(m_lps.size()));
+        }
+        m_nodeLps[n] = m_lps[lpOfRoot[root]].get();
+    }
+    m_public->id = m_lps.size();
+
+    m_lookahead = Time::Max();
+    for (const auto& link : links)
+    {
+        if (m_nodeLps[link.a] != m_nodeLps[link.b])
+        {
+            m_lookahead = std::min(m_lookahead, link.delay);
+        }
+    }
+
+    m_order.clear();
+    for (auto& lp : m_lps)
+    {
+        m_order.push_back(lp.get());
+    }
+
+    // move the events scheduled before the partition to their LP
+    std::vector<Scheduler::Event> events;
+    while (!m_public->events->IsEmpty())
+    {
+        events.push_back(m_public->events->RemoveNext());
+    }
+    for (const auto& ev : events)
+    {
+        GetLogicalProcess(ev.key.m_context).events->Insert(ev);
+    }
+
+    m_partitioned = true;
+    NS_LOG_INFO(nNodes << " nodes in " << m_lps.size() << " logical processes, lookahead "
+                       << m_lookahead.As(Time::US));
+}
+
+MultithreadedSimulatorImpl::LogicalProcess&
+MultithreadedSimulatorImpl::GetCurrent() const
+{
+    return g_current ? *g_current : *m_public;
+}
+
+MultithreadedSimulatorImpl::LogicalProcess&
+MultithreadedSimulatorImpl::GetLogicalProcess(uint32_t context) const
+{
+    return context < m_nodeLps.size() ? *m_nodeLps[context] : *m_public;
+}
+
+bool
+MultithreadedSimulatorImpl::IsAccessible(const LogicalProcess& lp) const
+{
+    // the events without context run alone, between the windows
+    return !m_running || g_current == &lp || g_current == m_public.get();
+}
+
+uint32_t
+MultithreadedSimulatorImpl::Insert(LogicalProcess& lp,
+                                   uint64_t ts,
+                                   uint32_t context,
+                                   EventImpl* event)
+{
+    Scheduler::Event ev;
+    ev.impl = event;
+    ev.key.m_ts = ts;
+    ev.key.m_context = context;
+    ev.key.m_uid = lp.uid;
+    lp.uid++;
+    lp.pendingCount++;
+    lp.events->Insert(ev);
+    return ev.key.m_uid;
+}
+
+void
+MultithreadedSimulatorImpl::Send(LogicalProcess& source,
+                                 LogicalProcess& destination,
+                                 const Message& message)
+{
+    for (auto& [lp, mailbox] : source.outboxes)
+    {
+        if (lp == &destination)
+        {
+            mailbox->messages.push_back(message);
+            return;
+        }
+    }
+
+    // first event sent to this LP: several sources may create their mailbox
+    // in the same window
+    auto mailbox = std::make_unique<Mailbox>();
+    mailbox->source = source.id;
+    mailbox->messages.push_back(message);
+    source.outboxes.emplace_back(&destination, mailbox.get());
+    std::unique_lock lock{destination.inboxesMutex};
+    auto it = std::lower_bound(destination.inboxes.begin(),
+                               destination.inboxes.end(),
+                               source.id,
+                               [](const std::unique_ptr<Mailbox>& m, uint32_t id) {
+                                   return m->source < id;
+                               });
+    destination.inboxes.insert(it, std::move(mailbox));
+}
+
+void
+MultithreadedSimulatorImpl::ReceiveMessages(LogicalProcess& lp)
+{
+    // the mailboxes are sorted by source, so that the uids do not depend on
+    // the order in which the LPs were processed
+    for (auto& inbox : lp.inboxes)
+    {
+        for (const auto& message : inbox->messages)
+        {
+            if (message.kind == SCHEDULE)
+            {
+                Insert(lp, message.ts, message.context, message.event);
+                continue;
+            }
+            // the events earlier than the end of the window already ran
+            EventId id(message.event, message.ts, message.context, message.uid);
+            if (!HasExpired(lp, id))
+            {
+                if (message.kind == REMOVE)
+                {
+                    RemoveEvent(lp, id);
+                }
+                else
+                {
+                    message.event->Cancel();
+                }
+            }
+            message.event->Unref();
+        }
+        inbox->messages.clear();
+    }
+    lp.nextTs = lp.events->IsEmpty() ? std::numeric_limits<uint64_t>::max()
+                                     : lp.events->PeekNext().key.m_ts;
+}
+
+void
+MultithreadedSimulatorImpl::ProcessOneEvent(LogicalProcess& lp)
+{
+    Scheduler::Event next = lp.events->RemoveNext();
+    lp.pendingCount--;
+
+    PreEventHook(EventId(next.impl, next.key.m_ts, next.key.m_context, next.key.m_uid));
+
+    NS_ASSERT(next.key.m_ts >= lp.currentTs);
+    lp.eventCount++;
+    if (next.impl->IsCancelled())
+    {
+        lp.cancelledCount++;
+    }
+    lp.currentTs = next.key.m_ts;
+    lp.currentContext = next.key.m_context;
+    lp.currentUid = next.key.m_uid;
+    next.impl->Invoke();
+    next.impl->Unref();
+}
+
+void
+MultithreadedSimulatorImpl::ProcessWindow(LogicalProcess& lp,
+                                          uint64_t windowStart,
+                                          uint64_t windowEnd)
+{
+    g_current = &lp;
+    Packet::SetUidCounter(&lp.packetUid);
+    lp.windowStart = windowStart;
+    lp.windowEnd = windowEnd;
+    while (!lp.events->IsEmpty() && lp.events->PeekNext().key.m_ts < windowEnd)
+    {
+        ProcessOneEvent(lp);
+    }
+    Packet::SetUidCounter(nullptr);
+    g_current = nullptr;
+}
+
+void
+MultithreadedSimulatorImpl::ProcessPublicEvents(uint64_t ts)
+{
+    g_current = m_public.get();
+    m_public->windowEnd = ts;
+    while (!m_public->events->IsEmpty() && m_public->events->PeekNext().key.m_ts == ts &&
+           !m_stop)
+    {
+        ProcessOneEvent(*m_public);
+    }
+    g_current = nullptr;
+}
+
+void
+MultithreadedSimulatorImpl::RunThread(uint32_t threadIndex)
+{
+    const uint64_t never = std::numeric_limits<uint64_t>::max();
+    const uint64_t lookahead = m_lookahead.GetTimeStep();
+    const auto nLps = static_cast<uint32_t>(m_lps.size());
+
+    while (true)
+    {
+        // 1. move the events sent during the last window to the event lists
+        for (uint32_t i = m_receiveIndex++; i < nLps; i = m_receiveIndex++)
+        {
+            ReceiveMessages(*m_lps[i]);
+        }
+        if (threadIndex == 0)
+        {
+            ReceiveMessages(*m_public);
+            m_processIndex = 0;
+            m_exit = m_stop;
+            if (m_windowCount % LOAD_BALANCING_PERIOD == LOAD_BALANCING_PERIOD - 1)
+            {
+                // the busiest LPs are processed first, so that they do not
+                // end last, alone
+                std::stable_sort(m_order.begin(),
+                                 m_order.end(),
+                                 [](const LogicalProcess* a, const LogicalProcess* b) {
+                                     return a->eventCount - a->balanceCount >
+                                            b->eventCount - b->balanceCount;
+                                 });
+                for (auto lp : m_order)
+                {
+                    lp->balanceCount = lp->eventCount;
+                }
+            }
+        }
+        m_barrier->arrive_and_wait();
+
+        // 2. all the threads compute the same window
+        uint64_t minNext = never;
+        for (const auto& lp : m_lps)
+        {
+            minNext = std::min(minNext, lp->nextTs);
+        }
+        uint64_t publicNext = m_public->nextTs;
+        if (m_exit || (minNext == never && publicNext == never))
+        {
+            break;
+        }
+
+        if (publicNext <= minNext)
+        {
+            if (threadIndex == 0)
+            {
+                ProcessPublicEvents(publicNext);
+            }
+        }
+        else
+        {
+            uint64_t windowEnd = minNext > never - lookahead ? never : minNext + lookahead;
+            windowEnd = std::min(windowEnd, publicNext);
+            for (uint32_t i = m_processIndex++; i < nLps; i = m_processIndex++)
+            {
+                ProcessWindow(*m_order[i], minNext, windowEnd);
+            }
+        }
+        if (threadIndex == 0)
+        {
+            m_receiveIndex = 0;
+            m_windowCount++;
+        }
+        m_barrier->arrive_and_wait();
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Run()
+{
+    NS_LOG_FUNCTION(this);
+    if (!m_partitioned)
+    {
+        Partition();
+    }
+    NS_ABORT_MSG_IF(NodeList::GetNNodes() != m_nodeLps.size(),
+                    "Nodes cannot be added after the first call to Simulator::Run()");
+
+    uint32_t maxThreads = m_maxThreads ? m_maxThreads : std::thread::hardware_concurrency();
+    m_nThreads = std::max<uint32_t>(1, std::min<uint32_t>(maxThreads, m_lps.size()));
+    NS_LOG_INFO("running " << m_lps.size() << " logical processes with " << m_nThreads
+                           << " threads");
+
+    m_stop = false;
+    m_exit = false;
+    m_receiveIndex = 0;
+    m_processIndex = 0;
+    m_barrier = std::make_unique<std::barrier<>>(m_nThreads);
+    m_running = true;
+
+    std::vector<std::thread> threads;
+    for (uint32_t i = 1; i < m_nThreads; i++)
+    {
+        threads.emplace_back(&MultithreadedSimulatorImpl::RunThread, this, i);
+    }
+    RunThread(0);
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    m_running = false;
+    m_barrier.reset();
+
+    // the clock seen by the main program is the one of the last event
+    for (const auto& lp : m_lps)
+    {
+        m_public->currentTs = std::max(m_public->currentTs, lp->currentTs);
+    }
+}
+
+bool
+MultithreadedSimulatorImpl::IsFinished() const
+{
+    if (m_stop)
+    {
+        return true;
+    }
+    if (!m_public->events->IsEmpty())
+    {
+        return false;
+    }
+    for (const auto& lp : m_lps)
+    {
+        if (!lp->events->IsEmpty())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void
+MultithreadedSimulatorImpl::Stop()
+{
+    NS_LOG_FUNCTION(this);
+    m_stop = true;
+}
+
+EventId
+MultithreadedSimulatorImpl::Stop(const Time& delay)
+{
+    NS_LOG_FUNCTION(this << delay.GetTimeStep());
+    return Simulator::Schedule(delay, &Simulator::Stop);
+}
+
+EventId
+MultithreadedSimulatorImpl::Schedule(const Time& delay, EventImpl* event)
+{
+    NS_ASSERT_MSG(delay.IsPositive(), "MultithreadedSimulatorImpl::Schedule(): Negative delay");
+    LogicalProcess& lp = GetCurrent();
+    uint64_t ts = lp.currentTs + delay.GetTimeStep();
+    uint32_t uid = Insert(lp, ts, lp.currentContext, event);
+    return EventId(event, ts, lp.currentContext, uid);
+}
+
+void
+MultithreadedSimulatorImpl::ScheduleWithContext(uint32_t context,
+                                                const Time& delay,
+                                                EventImpl* event)
+{
+    LogicalProcess& current = GetCurrent();
+    LogicalProcess& destination = GetLogicalProcess(context);
+    uint64_t ts = current.currentTs + delay.GetTimeStep();
+    if (&current == &destination || IsAccessible(destination))
+    {
+        Insert(destination, ts, context, event);
+        return;
+    }
+    NS_ABORT_MSG_IF(ts < current.windowEnd,
+                    "Event scheduled on node " << context << " by node " << current.currentContext
+                                               << " with a delay smaller than the lookahead "
+                                               << m_lookahead.As(Time::US));
+    Send(current, destination, {ts, context, 0, event, SCHEDULE});
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleNow(EventImpl* event)
+{
+    return Schedule(Time(0), event);
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleDestroy(EventImpl* event)
+{
+    std::unique_lock lock{m_destroyEventsMutex};
+    EventId id(Ptr<EventImpl>(event, false),
+               GetCurrent().currentTs,
+               Simulator::NO_CONTEXT,
+               EventId::UID::DESTROY);
+    m_destroyEvents.push_back(id);
+    return id;
+}
+
+Time
+MultithreadedSimulatorImpl::Now() const
+{
+    // Do not add function logging here, to avoid stack overflow
+    return TimeStep(GetCurrent().currentTs);
+}
+
+Time
+MultithreadedSimulatorImpl::GetDelayLeft(const EventId& id) const
+{
+    if (IsExpired(id))
+    {
+        return TimeStep(0);
+    }
+    return TimeStep(id.GetTs() - GetCurrent().currentTs);
+}
+
+void
+MultithreadedSimulatorImpl::Remove(const EventId& id)
+{
+    if (id.GetUid() == EventId::UID::DESTROY)
+    {
+        std::unique_lock lock{m_destroyEventsMutex};
+        for (auto i = m_destroyEvents.begin(); i != m_destroyEvents.end(); i++)
+        {
+            if (*i == id)
+            {
+                m_destroyEvents.erase(i);
+                break;
+            }
+        }
+        return;
+    }
+    if (IsExpired(id))
+    {
+        return;
+    }
+    LogicalProcess& lp = GetLogicalProcess(id.GetContext());
+    if (!IsAccessible(lp))
+    {
+        // the event list of another LP is modified by the LP itself, at the
+        // end of the window
+        id.PeekEventImpl()->Ref();
+        Send(GetCurrent(),
+             lp,
+             {id.GetTs(), id.GetContext(), id.GetUid(), id.PeekEventImpl(), REMOVE});
+        return;
+    }
+    RemoveEvent(lp, id);
+}
+
+void
+MultithreadedSimulatorImpl::RemoveEvent(LogicalProcess& lp, const EventId& id)
+{
+    Scheduler::Event event;
+    event.impl = id.PeekEventImpl();
+    event.key.m_ts = id.GetTs();
+    event.key.m_context = id.GetContext();
+    event.key.m_uid = id.GetUid();
+    lp.events->Remove(event);
+    lp.pendingCount--;
+    event.impl->Cancel();
+    // whenever we remove an event from the event list, we have to unref it.
+    event.impl->Unref();
+}
+
+void
+MultithreadedSimulatorImpl::Cancel(const EventId& id)
+{
+    if (IsExpired(id))
+    {
+        return;
+    }
+    LogicalProcess& lp = GetLogicalProcess(id.GetContext());
+    if (id.GetUid() != EventId::UID::DESTROY && !IsAccessible(lp))
+    {
+        // the other LP may be running the event: it is cancelled by the LP
+        // itself, at the end of the window
+        id.PeekEventImpl()->Ref();
+        Send(GetCurrent(),
+             lp,
+             {id.GetTs(), id.GetContext(), id.GetUid(), id.PeekEventImpl(), CANCEL});
+        return;
+    }
+    id.PeekEventImpl()->Cancel();
+}
+
+bool
+MultithreadedSimulatorImpl::IsExpired(const EventId& id) const
+{
+    if (id.PeekEventImpl() == nullptr)
+    {
+        return true;
+    }
+    if (id.GetUid() == EventId::UID::DESTROY)
+    {
+        if (id.PeekEventImpl()->IsCancelled())
+        {
+            return true;
+        }
+        std::unique_lock lock{m_destroyEventsMutex};
+        for (auto i = m_destroyEvents.begin(); i != m_destroyEvents.end(); i++)
+        {
+            if (*i == id)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+    const LogicalProcess& lp = GetLogicalProcess(id.GetContext());
+    if (!IsAccessible(lp))
+    {
+        // the other LP may be running or cancelling its events of the
+        // current window: only the earlier ones are known to have expired
+        return id.GetTs() < GetCurrent().windowStart;
+    }
+    return HasExpired(lp, id);
+}
+
+bool
+MultithreadedSimulatorImpl::HasExpired(const LogicalProcess& lp, const EventId& id) const
+{
+    return id.PeekEventImpl()->IsCancelled() || id.GetTs() < lp.currentTs ||
+           (id.GetTs() == lp.currentTs && id.GetUid() <= lp.currentUid);
+}
+
+Time
+MultithreadedSimulatorImpl::GetMaximumSimulationTime() const
+{
+    return TimeStep(0x7fffffffffffffffLL);
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetContext() const
+{
+    return GetCurrent().currentContext;
+}
+
+uint64_t
+MultithreadedSimulatorImpl::GetEventCount() const
+{
+    // exact outside of Simulator::Run() only
+    uint64_t count = m_public->eventCount;
+    for (const auto& lp : m_lps)
+    {
+        count += lp->eventCount;
+    }
+    return count;
+}
+
+uint64_t
+MultithreadedSimulatorImpl::GetCancelledEventCount() const
+{
+    // exact outside of Simulator::Run() only
+    uint64_t count = m_public->cancelledCount;
+    for (const auto& lp : m_lps)
+    {
+        count += lp->cancelledCount;
+    }
+    return count;
+}
+
+uint64_t
+MultithreadedSimulatorImpl::GetPendingEventCount() const
+{
+    // exact outside of Simulator::Run() only: the events moved between the
+    // LPs are counted by the LP which scheduled them, and those in the
+    // mailboxes are not counted
+    int64_t count = m_public->pendingCount;
+    for (const auto& lp : m_lps)
+    {
+        count += lp->pendingCount;
+    }
+    return count;
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetNPartitions() const
+{
+    return m_lps.size();
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetPartition(uint32_t nodeId) const
+{
+    NS_ASSERT_MSG(nodeId < m_nodeLps.size(), "Node " << nodeId << " was not partitioned");
+    return m_nodeLps[nodeId]->id;
+}
+
+Time
+MultithreadedSimulatorImpl::GetLookahead() const
+{
+    return m_lookahead;
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetNThreads() const
+{
+    return m_nThreads;
+}
+
+uint64_t
+MultithreadedSimulatorImpl::GetWindowCount() const
+{
+    return m_windowCount;
+}
+
+} // namespace ns3
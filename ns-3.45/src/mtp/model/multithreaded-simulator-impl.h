@@ -0,0 +1,317 @@
+//
+// SPDX-License-Identifier: GPL-2.0-only
+//
+
+#ifndef MULTITHREADED_SIMULATOR_IMPL_H
+#define MULTITHREADED_SIMULATOR_IMPL_H
+
+#include "ns3/event-impl.h"
+#include "ns3/nstime.h"
+#include "ns3/object-factory.h"
+#include "ns3/ptr.h"
+#include "ns3/scheduler.h"
+#include "ns3/simulator-impl.h"
+
+#include <atomic>
+#include <barrier>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup mtp
+ * ns3::MultithreadedSimulatorImpl declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * @ingroup mtp
+ *
+ * @brief A parallel simulator implementation which runs the nodes of a
+ * simulation in several threads of one process.
+ *
+ * When Run() is first called, the nodes are partitioned in logical
+ * processes (LPs) by cutting the point-to-point links with a delay
+ * (e.g., PointToPointChannel, or SimpleChannel in point-to-point mode): the
+ * nodes connected by any other channel, or by a link faster than the
+ * MinLookahead attribute, are in the same LP. Each LP has its own event
+ * scheduler and the smallest delay of the cut links is the lookahead.
+ *
+ * The LPs are then run by a pool of threads, with a conservative,
+ * barrier-synchronized time window: all the events earlier than the
+ * earliest pending event plus the lookahead are safe, and the LPs process
+ * them in parallel, in an order which is balanced by the number of events
+ * they processed recently. An event scheduled on another LP (e.g., the
+ * reception of a packet at the end of a link) is passed by pointer to a
+ * single-producer, single-consumer mailbox of the destination LP, which
+ * moves it to its scheduler at the end of the window: the mailboxes do not
+ * need locks, since the barrier separates the producer and the consumer.
+ *
+ * The events without a node context (e.g., those scheduled by the main
+ * program with Simulator::Schedule, the Simulator::Stop event, or periodic
+ * statistics collection) run alone, between the windows, so that they can
+ * safely access the state of any node. Simulator::Stop() called by a node
+ * stops the simulation at the end of the current window.
+ *
+ * This implementation requires a build with the NS3_MTP option, which makes
+ * the reference counters and the packet free lists thread-safe. The
+ * objects shared by several nodes (e.g., a FlowMonitor or the trace sinks
+ * of the simulation program) are not protected and must either be
+ * thread-safe or only be used by events without a node context.
+ *
+ * An event of another LP is cancelled or removed by a message to its
+ * mailbox, which takes effect at the end of the window: an event earlier
+ * than the end of the current window runs anyway. For the same reason,
+ * IsExpired() only reports the events of another LP earlier than the
+ * start of the current window as expired, whether they were cancelled or
+ * not.
+ *
+ * The results do not depend on the number of threads: the events of an LP
+ * are run in the same order, as the mailboxes are emptied in the order of
+ * their source LP, and each LP numbers the packets it creates in its own
+ * range of packet uids.
+ */
+class MultithreadedSimulatorImpl : public SimulatorImpl
+{
+  public:
+    /**
+     *  Register this type.
+     *  @return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    /** Constructor. */
+    MultithreadedSimulatorImpl();
+    /** Destructor. */
+    ~MultithreadedSimulatorImpl() override;
+
+    // Inherited
+    void Destroy() override;
+    bool IsFinished() const override;
+    void Stop() override;
+    EventId Stop(const Time& delay) override;
+    EventId Schedule(const Time& delay, EventImpl* event) override;
+    void ScheduleWithContext(uint32_t context, const Time& delay, EventImpl* event) override;
+    EventId ScheduleNow(EventImpl* event) override;
+    EventId ScheduleDestroy(EventImpl* event) override;
+    void Remove(const EventId& id) override;
+    void Cancel(const EventId& id) override;
+    bool IsExpired(const EventId& id) const override;
+    void Run() override;
+    Time Now() const override;
+    Time GetDelayLeft(const EventId& id) const override;
+    Time GetMaximumSimulationTime() const override;
+    void SetScheduler(ObjectFactory schedulerFactory) override;
+    uint32_t GetSystemId() const override;
+    uint32_t GetContext() const override;
+    uint64_t GetEventCount() const override;
+    uint64_t GetCancelledEventCount() const override;
+    uint64_t GetPendingEventCount() const override;
+
+    /**
+     * @return the number of logical processes (zero until Run() is called)
+     */
+    uint32_t GetNPartitions() const;
+
+    /**
+     * @param nodeId the node identifier
+     * @return the logical process of the node
+     */
+    uint32_t GetPartition(uint32_t nodeId) const;
+
+    /**
+     * @return the lookahead, i.e., the smallest delay of the links between
+     *         two logical processes (Time::Max() if there is none)
+     */
+    Time GetLookahead() const;
+
+    /**
+     * @return the number of threads used by the last call to Run()
+     */
+    uint32_t GetNThreads() const;
+
+    /**
+     * @return the number of time windows processed so far
+     */
+    uint64_t GetWindowCount() const;
+
+  private:
+    void DoDispose() override;
+
+    /// What the destination of a message does with its event
+    enum MessageKind : uint8_t
+    {
+        SCHEDULE, //!< Insert the event in the event list
+        CANCEL,   //!< Cancel the event, unless it expired
+        REMOVE,   //!< Remove the event from the event list, unless it expired
+    };
+
+    /// An event sent to another logical process
+    struct Message
+    {
+        uint64_t ts;      //!< Absolute timestamp
+        uint32_t context; //!< Event context
+        uint32_t uid;     //!< Event unique id (CANCEL and REMOVE only)
+        EventImpl* event; //!< The event, with a reference owned by the message
+        MessageKind kind; //!< What to do with the event
+    };
+
+    /// The events sent by a logical process to another one during a window
+    struct Mailbox
+    {
+        uint32_t source;               //!< Sending logical process
+        std::vector<Message> messages; //!< The events, in the order they were sent
+    };
+
+    /// A logical process: a set of nodes, with its own event list and clock
+    struct LogicalProcess
+    {
+        uint32_t id;                //!< Identifier (m_lps.size() for the public LP)
+        Ptr<Scheduler> events;      //!< The event list
+        uint64_t currentTs;         //!< Timestamp of the current event
+        uint32_t currentContext;    //!< Context of the current event
+        uint32_t currentUid;        //!< Unique id of the current event
+        uint32_t uid;               //!< Next event unique id
+        uint64_t eventCount;        //!< Number of events processed
+        uint64_t cancelledCount;    //!< Number of cancelled events processed
+        int64_t pendingCount;       //!< Events inserted minus events removed
+        uint64_t balanceCount;      //!< Value of eventCount at the last load balancing
+        uint64_t nextTs;            //!< Timestamp of the next event, as of the last window
+        uint64_t windowStart;       //!< Start of the window being processed
+        uint64_t windowEnd;         //!< End (excluded) of the window being processed
+        uint64_t packetUid;         //!< Next uid of the packets created by the LP
+        std::mutex inboxesMutex;    //!< Protects the creation of the mailboxes
+        /// Mailboxes of the logical processes this one sends events to
+        std::vector<std::pair<LogicalProcess*, Mailbox*>> outboxes;
+        /// Mailboxes of the logical processes which send events to this one, by source
+        std::vector<std::unique_ptr<Mailbox>> inboxes;
+    };
+
+    /**
+     * Create a logical process, with the clock of the public one.
+     * @param id the identifier of the logical process
+     * @return the logical process
+     */
+    std::unique_ptr<LogicalProcess> CreateLogicalProcess(uint32_t id) const;
+
+    /// Partition the nodes in logical processes and compute the lookahead
+    void Partition();
+
+    /**
+     * Body of the simulation threads.
+     * @param threadIndex the index of the thread (0 is the calling thread)
+     */
+    void RunThread(uint32_t threadIndex);
+
+    /**
+     * Move the events of the mailboxes of a logical process to its event list.
+     * @param lp the logical process
+     */
+    void ReceiveMessages(LogicalProcess& lp);
+
+    /**
+     * Process the events of a logical process earlier than the end of a window.
+     * @param lp the logical process
+     * @param windowStart the start of the window
+     * @param windowEnd the end of the window (excluded)
+     */
+    void ProcessWindow(LogicalProcess& lp, uint64_t windowStart, uint64_t windowEnd);
+
+    /**
+     * Process the events of the public logical process at a given time.
+     * @param ts the timestamp
+     */
+    void ProcessPublicEvents(uint64_t ts);
+
+    /**
+     * Process the next event of a logical process.
+     * @param lp the logical process
+     */
+    void ProcessOneEvent(LogicalProcess& lp);
+
+    /**
+     * Insert an event in the event list of a logical process.
+     * @param lp the logical process
+     * @param ts the absolute timestamp
+     * @param context the event context
+     * @param event the event
+     * @return the unique id of the event
+     */
+    uint32_t Insert(LogicalProcess& lp, uint64_t ts, uint32_t context, EventImpl* event);
+
+    /**
+     * Remove an event which did not expire from the event list of its
+     * logical process.
+     * @param lp the logical process of the event
+     * @param id the event
+     */
+    void RemoveEvent(LogicalProcess& lp, const EventId& id);
+
+    /**
+     * @param lp the logical process of an event
+     * @param id the event
+     * @return true if the event was cancelled or already ran, as seen by
+     *         the logical process
+     */
+    bool HasExpired(const LogicalProcess& lp, const EventId& id) const;
+
+    /**
+     * Send an event to another logical process.
+     * @param source the sending logical process
+     * @param destination the destination logical process
+     * @param message the event
+     */
+    void Send(LogicalProcess& source, LogicalProcess& destination, const Message& message);
+
+    /**
+     * @return the logical process running in the calling thread
+     */
+    LogicalProcess& GetCurrent() const;
+
+    /**
+     * @param context an event context
+     * @return the logical process of the events with this context
+     */
+    LogicalProcess& GetLogicalProcess(uint32_t context) const;
+
+    /**
+     * @param lp a logical process
+     * @return true if the calling thread may access the clock and the event
+     *         list of the logical process
+     */
+    bool IsAccessible(const LogicalProcess& lp) const;
+
+    /// Container type for the events to run at Simulator::Destroy()
+    typedef std::list<EventId> DestroyEvents;
+
+    /// The logical process running in the calling thread, if any
+    static thread_local LogicalProcess* g_current;
+
+    ObjectFactory m_schedulerFactory;                  //!< Factory of the event lists
+    std::unique_ptr<LogicalProcess> m_public;          //!< Events without a node context
+    std::vector<std::unique_ptr<LogicalProcess>> m_lps; //!< The logical processes
+    std::vector<LogicalProcess*> m_nodeLps;            //!< Node id --> logical process
+    std::vector<LogicalProcess*> m_order;              //!< Processing order of the LPs
+    Time m_lookahead;                                  //!< The lookahead
+    Time m_minLookahead;                               //!< Minimum delay of a cut link
+    uint32_t m_maxThreads;                             //!< Maximum number of threads
+    uint32_t m_nThreads;                               //!< Number of threads of the last run
+    uint64_t m_windowCount;                            //!< Number of windows processed
+    bool m_partitioned;                                //!< The nodes were partitioned
+    bool m_running;                                    //!< Run() is being executed
+    std::atomic<bool> m_stop;                          //!< Stop was requested
+    bool m_exit;                                       //!< The threads must return
+    std::atomic<uint32_t> m_receiveIndex;              //!< Next LP to receive messages
+    std::atomic<uint32_t> m_processIndex;              //!< Next LP to process a window
+    std::unique_ptr<std::barrier<>> m_barrier;         //!< Synchronizes the threads
+    DestroyEvents m_destroyEvents;                     //!< Events to run at Destroy
+    mutable std::mutex m_destroyEventsMutex;           //!< Protects m_destroyEvents
+};
+
+} // namespace ns3
+
+#endif /* MULTITHREADED_SIMULATOR_IMPL_H */
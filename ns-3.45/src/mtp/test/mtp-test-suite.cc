@@ -0,0 +1,359 @@
+//
+// SPDX-License-Identifier: GPL-2.0-only
+//
+
+#include "ns3/default-simulator-impl.h"
+#include "ns3/multithreaded-simulator-impl.h"
+#include "ns3/node-container.h"
+#include "ns3/packet.h"
+#include "ns3/simple-net-device-helper.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <vector>
+
+/**
+ * @file
+ * @ingroup mtp-tests
+ * Multithreaded simulator test suite.
+ */
+
+/**
+ * @ingroup mtp
+ * @defgroup mtp-tests Multithreaded simulator module tests
+ */
+
+using namespace ns3;
+
+/**
+ * @ingroup mtp-tests
+ *
+ * @brief MultithreadedSimulatorImpl Test: packets forwarded around a ring of
+ * point-to-point links are received by the same nodes, at the same times, as
+ * with the default simulator implementation, and with the same uids with one
+ * thread and with several threads.
+ */
+class MultithreadedSimulatorRingTestCase : public TestCase
+{
+  public:
+    MultithreadedSimulatorRingTestCase();
+
+  private:
+    void DoRun() override;
+
+    /// The result of a simulation
+    struct Result
+    {
+        std::vector<uint32_t> rxCount; //!< Packets received by each node
+        std::vector<Time> lastRx;      //!< Time of the last reception of each node
+        std::vector<uint64_t> lastUid; //!< Uid of the last packet received by each node
+        uint64_t eventCount;           //!< Number of events
+        Time end;                      //!< Time at the end of the simulation
+    };
+
+    /**
+     * Simulate the ring.
+     * @param impl the simulator implementation
+     * @param stop the time of the call to Simulator::Stop, or zero
+     * @return the result
+     */
+    Result RunRing(Ptr<SimulatorImpl> impl, Time stop);
+
+    /**
+     * Receive a packet and forward a new packet on the other device of the node.
+     * @param device the receiving device
+     * @param packet the packet
+     * @param protocol the protocol
+     * @param from the sender address
+     * @return true
+     */
+    bool Receive(Ptr<NetDevice> device,
+                 Ptr<const Packet> packet,
+                 uint16_t protocol,
+                 const Address& from);
+
+    Result m_result;                            //!< Result of the current run
+    static const uint32_t N_NODES = 16;         //!< Number of nodes of the ring
+    const Time m_forwardUntil{MilliSeconds(1)}; //!< End of the forwarding
+};
+
+MultithreadedSimulatorRingTestCase::MultithreadedSimulatorRingTestCase()
+    : TestCase("MultithreadedSimulatorImpl ring")
+{
+}
+
+bool
+MultithreadedSimulatorRingTestCase::Receive(Ptr<NetDevice> device,
+                                            Ptr<const Packet> packet,
+                                            uint16_t protocol,
+                                            const Address& from)
+{
+    // each node only updates its own counters
+    uint32_t node = device->GetNode()->GetId();
+    m_result.rxCount[node]++;
+    m_result.lastRx[node] = Simulator::Now();
+    m_result.lastUid[node] = packet->GetUid();
+    if (Simulator::Now() < m_forwardUntil)
+    {
+        Ptr<NetDevice> out = device->GetNode()->GetDevice(device->GetIfIndex() == 0 ? 1 : 0);
+        out->Send(Create<Packet>(packet->GetSize()), out->GetBroadcast(), protocol);
+    }
+    return true;
+}
+
+MultithreadedSimulatorRingTestCase::Result
+MultithreadedSimulatorRingTestCase::RunRing(Ptr<SimulatorImpl> impl, Time stop)
+{
+    Simulator::Destroy();
+    Simulator::SetImplementation(impl);
+    m_result = Result();
+    m_result.rxCount.resize(N_NODES, 0);
+    m_result.lastRx.resize(N_NODES);
+    m_result.lastUid.resize(N_NODES, 0);
+
+    NodeContainer nodes(N_NODES);
+    SimpleNetDeviceHelper helper;
+    helper.SetChannelAttribute("Delay", TimeValue(MicroSeconds(1)));
+    helper.SetNetDevicePointToPointMode(true);
+    for (uint32_t i = 0; i < N_NODES; i++)
+    {
+        helper.Install(NodeContainer(nodes.Get(i), nodes.Get((i + 1) % N_NODES)));
+    }
+    for (uint32_t i = 0; i < N_NODES; i++)
+    {
+        for (uint32_t d = 0; d < 2; d++)
+        {
+            nodes.Get(i)->GetDevice(d)->SetReceiveCallback(
+                MakeCallback(&MultithreadedSimulatorRingTestCase::Receive, this));
+        }
+        // a first packet per node, sent in the context of the node
+        Ptr<NetDevice> device = nodes.Get(i)->GetDevice(i % 2);
+        Simulator::ScheduleWithContext(i,
+                                       NanoSeconds(i),
+                                       [device]() {
+                                           device->Send(Create<Packet>(100),
+                                                        device->GetBroadcast(),
+                                                        0x800);
+                                       });
+    }
+    if (stop.IsStrictlyPositive())
+    {
+        Simulator::Stop(stop);
+    }
+    Simulator::Run();
+    m_result.eventCount = Simulator::GetEventCount();
+    m_result.end = Simulator::Now();
+    Simulator::Destroy();
+    return m_result;
+}
+
+void
+MultithreadedSimulatorRingTestCase::DoRun()
+{
+    for (auto stop : {Time(0), MicroSeconds(500)})
+    {
+        Result expected = RunRing(CreateObject<DefaultSimulatorImpl>(), stop);
+
+        Ptr<MultithreadedSimulatorImpl> single = CreateObject<MultithreadedSimulatorImpl>();
+        single->SetAttribute("MaxThreads", UintegerValue(1));
+        Result sequential = RunRing(single, stop);
+
+        Ptr<MultithreadedSimulatorImpl> mtp = CreateObject<MultithreadedSimulatorImpl>();
+        mtp->SetAttribute("MaxThreads", UintegerValue(4));
+        Result result = RunRing(mtp, stop);
+
+        NS_TEST_EXPECT_MSG_EQ(mtp->GetNPartitions(), N_NODES, "one partition per node");
+        NS_TEST_EXPECT_MSG_EQ(mtp->GetLookahead(), MicroSeconds(1), "lookahead");
+        NS_TEST_EXPECT_MSG_EQ(mtp->GetNThreads(), 4, "threads");
+        NS_TEST_EXPECT_MSG_GT(expected.rxCount[0], 400, "packets were forwarded");
+        for (uint32_t i = 0; i < N_NODES; i++)
+        {
+            NS_TEST_EXPECT_MSG_EQ(result.rxCount[i], expected.rxCount[i], "received by " << i);
+            NS_TEST_EXPECT_MSG_EQ(result.lastRx[i], expected.lastRx[i], "last rx of " << i);
+            NS_TEST_EXPECT_MSG_EQ(result.lastUid[i],
+                                  sequential.lastUid[i],
+                                  "last uid received by " << i);
+        }
+        NS_TEST_EXPECT_MSG_EQ(result.eventCount, expected.eventCount, "event count");
+        NS_TEST_EXPECT_MSG_EQ(result.end, expected.end, "end of the simulation");
+    }
+}
+
+/**
+ * @ingroup mtp-tests
+ *
+ * @brief MultithreadedSimulatorImpl Test: the nodes connected by a channel
+ * without delay are simulated by the same logical process.
+ */
+class MultithreadedSimulatorPartitionTestCase : public TestCase
+{
+  public:
+    MultithreadedSimulatorPartitionTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+MultithreadedSimulatorPartitionTestCase::MultithreadedSimulatorPartitionTestCase()
+    : TestCase("MultithreadedSimulatorImpl partition")
+{
+}
+
+void
+MultithreadedSimulatorPartitionTestCase::DoRun()
+{
+    Simulator::Destroy();
+    Ptr<MultithreadedSimulatorImpl> mtp = CreateObject<MultithreadedSimulatorImpl>();
+    mtp->SetAttribute("MinLookahead", TimeValue(MicroSeconds(2)));
+    Simulator::SetImplementation(mtp);
+
+    // 0 -(5us)- 1 -(1us)- 2 -(0)- 3, and 4 on a shared channel with 0
+    NodeContainer nodes(5);
+    SimpleNetDeviceHelper p2p;
+    p2p.SetNetDevicePointToPointMode(true);
+    p2p.SetChannelAttribute("Delay", TimeValue(MicroSeconds(5)));
+    p2p.Install(NodeContainer(nodes.Get(0), nodes.Get(1)));
+    p2p.SetChannelAttribute("Delay", TimeValue(MicroSeconds(1)));
+    p2p.Install(NodeContainer(nodes.Get(1), nodes.Get(2)));
+    p2p.SetChannelAttribute("Delay", TimeValue(Time(0)));
+    p2p.Install(NodeContainer(nodes.Get(2), nodes.Get(3)));
+    SimpleNetDeviceHelper shared;
+    shared.SetChannelAttribute("Delay", TimeValue(MicroSeconds(10)));
+    shared.Install(NodeContainer(nodes.Get(0), nodes.Get(4)));
+
+    Simulator::Run();
+    NS_TEST_EXPECT_MSG_EQ(mtp->GetNPartitions(), 2, "partitions");
+    NS_TEST_EXPECT_MSG_EQ(mtp->GetPartition(4), mtp->GetPartition(0), "shared channel");
+    NS_TEST_EXPECT_MSG_EQ(mtp->GetPartition(2), mtp->GetPartition(1), "link below MinLookahead");
+    NS_TEST_EXPECT_MSG_EQ(mtp->GetPartition(3), mtp->GetPartition(1), "link without delay");
+    NS_TEST_EXPECT_MSG_NE(mtp->GetPartition(1), mtp->GetPartition(0), "cut link");
+    NS_TEST_EXPECT_MSG_EQ(mtp->GetLookahead(), MicroSeconds(5), "lookahead");
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup mtp-tests
+ *
+ * @brief MultithreadedSimulatorImpl Test: a node cancels and removes the
+ * events of a node of another logical process, which take effect at the end
+ * of the window.
+ */
+class MultithreadedSimulatorCancelTestCase : public TestCase
+{
+  public:
+    MultithreadedSimulatorCancelTestCase();
+
+  private:
+    void DoRun() override;
+
+    /// Schedule the events of node 0
+    void ScheduleEvents();
+    /// Cancel and remove the events of node 0, from node 1
+    void CancelEvents();
+    /// Check the events of node 0 at the end, from node 1
+    void CheckEvents();
+
+    EventId m_cancelled; //!< Event of node 0 cancelled by node 1
+    EventId m_removed;   //!< Event of node 0 removed by node 1
+    EventId m_window;    //!< Event of node 0 cancelled by node 1 in the same window
+    bool m_cancelledRun; //!< m_cancelled ran
+    bool m_removedRun;   //!< m_removed ran
+    bool m_windowRun;    //!< m_window ran
+    bool m_pending;      //!< m_cancelled was not expired, as seen by node 1
+    bool m_expired;      //!< m_cancelled was expired at the end, as seen by node 1
+};
+
+MultithreadedSimulatorCancelTestCase::MultithreadedSimulatorCancelTestCase()
+    : TestCase("MultithreadedSimulatorImpl cancel"),
+      m_cancelledRun(false),
+      m_removedRun(false),
+      m_windowRun(false),
+      m_pending(false),
+      m_expired(false)
+{
+}
+
+void
+MultithreadedSimulatorCancelTestCase::ScheduleEvents()
+{
+    m_cancelled = Simulator::Schedule(MicroSeconds(50), [this]() { m_cancelledRun = true; });
+    m_removed = Simulator::Schedule(MicroSeconds(60), [this]() { m_removedRun = true; });
+    m_window = Simulator::Schedule(MicroSeconds(25), [this]() { m_windowRun = true; });
+}
+
+void
+MultithreadedSimulatorCancelTestCase::CancelEvents()
+{
+    m_pending = !Simulator::IsExpired(m_cancelled);
+    Simulator::Cancel(m_cancelled);
+    Simulator::Remove(m_removed);
+    Simulator::Cancel(m_window);
+}
+
+void
+MultithreadedSimulatorCancelTestCase::CheckEvents()
+{
+    m_expired = Simulator::IsExpired(m_cancelled) && Simulator::IsExpired(m_removed);
+}
+
+void
+MultithreadedSimulatorCancelTestCase::DoRun()
+{
+    Simulator::Destroy();
+    Ptr<MultithreadedSimulatorImpl> mtp = CreateObject<MultithreadedSimulatorImpl>();
+    mtp->SetAttribute("MaxThreads", UintegerValue(2));
+    Simulator::SetImplementation(mtp);
+
+    // two LPs and a lookahead of 10us: the window of the cancellation, at
+    // 20us, ends at 30us
+    NodeContainer nodes(2);
+    SimpleNetDeviceHelper p2p;
+    p2p.SetNetDevicePointToPointMode(true);
+    p2p.SetChannelAttribute("Delay", TimeValue(MicroSeconds(10)));
+    p2p.Install(nodes);
+    Simulator::ScheduleWithContext(0,
+                                   Time(0),
+                                   &MultithreadedSimulatorCancelTestCase::ScheduleEvents,
+                                   this);
+    Simulator::ScheduleWithContext(1,
+                                   MicroSeconds(20),
+                                   &MultithreadedSimulatorCancelTestCase::CancelEvents,
+                                   this);
+    Simulator::ScheduleWithContext(1,
+                                   MicroSeconds(100),
+                                   &MultithreadedSimulatorCancelTestCase::CheckEvents,
+                                   this);
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_EQ(mtp->GetNPartitions(), 2, "partitions");
+    NS_TEST_EXPECT_MSG_EQ(m_pending, true, "event not expired before the cancellation");
+    NS_TEST_EXPECT_MSG_EQ(m_cancelledRun, false, "cancelled event");
+    NS_TEST_EXPECT_MSG_EQ(m_removedRun, false, "removed event");
+    NS_TEST_EXPECT_MSG_EQ(m_windowRun, true, "event of the window of the cancellation");
+    NS_TEST_EXPECT_MSG_EQ(m_expired, true, "events expired at the end");
+    NS_TEST_EXPECT_MSG_EQ(Simulator::GetCancelledEventCount(), 1, "cancelled event count");
+    NS_TEST_EXPECT_MSG_EQ(Simulator::GetPendingEventCount(), 0, "pending event count");
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup mtp-tests
+ *
+ * @brief Multithreaded simulator TestSuite
+ */
+class MtpTestSuite : public TestSuite
+{
+  public:
+    MtpTestSuite();
+};
+
+MtpTestSuite::MtpTestSuite()
+    : TestSuite("mtp", Type::UNIT)
+{
+    AddTestCase(new MultithreadedSimulatorRingTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new MultithreadedSimulatorPartitionTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new MultithreadedSimulatorCancelTestCase, TestCase::Duration::QUICK);
+}
+
+static MtpTestSuite g_mtpTestSuite; //!< Static variable for test initialization
@@ -23,7 +23,14 @@ void
 DelayJitterEstimation::PrepareTx(Ptr<const Packet> packet)
 {
     TimestampTag tag(Simulator::Now());
-    packet->AddByteTag(tag);
+    if (Packet::ByteTagsEnabled())
+    {
+        packet->AddByteTag(tag);
+    }
+    else
+    {
+        packet->AddPacketTag(tag);
+    }
 }
 
 void
@@ -31,7 +38,9 @@ DelayJitterEstimation::RecordRx(Ptr<const Packet> packet)
 {
     TimestampTag tag;
 
-    if (!packet->FindFirstMatchingByteTag(tag))
+    bool found = Packet::ByteTagsEnabled() ? packet->FindFirstMatchingByteTag(tag)
+                                           : packet->PeekPacketTag(tag);
+    if (!found)
     {
         return;
     }
@@ -37,6 +37,8 @@ class DelayJitterEstimation
      * tx time is stored in the packet as an ns3::Tag which means
      * that it does not use any network resources and is not
      * taken into account in transmission delay calculations.
+     * The tag is a byte tag, or a packet tag if Packet::DisableByteTags
+     * was called.
      *
      * @param packet the packet to send over a wire
      */
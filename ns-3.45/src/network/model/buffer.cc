@@ -43,7 +43,7 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("Buffer");
 
-uint32_t Buffer::g_recommendedStart = 0;
+NS3_THREAD_LOCAL uint32_t Buffer::g_recommendedStart = 0;
 #ifdef BUFFER_FREE_LIST
 /* The following macros are pretty evil but they are needed to allow us to
  * keep track of 3 possible states for the g_freeList variable:
@@ -68,9 +68,9 @@ uint32_t Buffer::g_recommendedStart = 0;
 #define IS_INITIALIZED(x) (!IS_UNINITIALIZED(x) && !IS_DESTROYED(x))
 #define DESTROYED ((Buffer::FreeList*)MAGIC_DESTROYED)
 #define UNINITIALIZED ((Buffer::FreeList*)0)
-uint32_t Buffer::g_maxSize = 0;
-Buffer::FreeList* Buffer::g_freeList = nullptr;
-Buffer::LocalStaticDestructor Buffer::g_localStaticDestructor;
+NS3_THREAD_LOCAL uint32_t Buffer::g_maxSize = 0;
+NS3_THREAD_LOCAL Buffer::FreeList* Buffer::g_freeList = nullptr;
+NS3_THREAD_LOCAL Buffer::LocalStaticDestructor Buffer::g_localStaticDestructor;
 
 Buffer::LocalStaticDestructor::~LocalStaticDestructor()
 {
@@ -113,6 +113,10 @@ Buffer::Create(uint32_t dataSize)
     if (IS_UNINITIALIZED(g_freeList))
     {
         g_freeList = new Buffer::FreeList();
+#ifdef NS3_MULTITHREADED
+        // a thread-local destructor only runs if it was used by the thread
+        (void)&g_localStaticDestructor;
+#endif
     }
     else if (IS_INITIALIZED(g_freeList))
     {
@@ -255,8 +259,7 @@ Buffer::operator=(const Buffer& o)
     if (m_data != o.m_data)
     {
         // not assignment to self.
-        m_data->m_count--;
-        if (m_data->m_count == 0)
+        if (--m_data->m_count == 0)
         {
             Recycle(m_data);
         }
@@ -278,8 +281,7 @@ Buffer::~Buffer()
     NS_LOG_FUNCTION(this);
     NS_ASSERT(CheckInternalState());
     g_recommendedStart = std::max(g_recommendedStart, m_maxZeroAreaStart);
-    m_data->m_count--;
-    if (m_data->m_count == 0)
+    if (--m_data->m_count == 0)
     {
         Recycle(m_data);
     }
@@ -322,8 +324,7 @@ Buffer::AddAtStart(uint32_t start)
         uint32_t newSize = GetInternalSize() + start;
         Buffer::Data* newData = Buffer::Create(newSize);
         memcpy(newData->m_data + start, m_data->m_data + m_start, GetInternalSize());
-        m_data->m_count--;
-        if (m_data->m_count == 0)
+        if (--m_data->m_count == 0)
         {
             Buffer::Recycle(m_data);
         }
@@ -368,8 +369,7 @@ Buffer::AddAtEnd(uint32_t end)
         uint32_t newSize = GetInternalSize() + end;
         Buffer::Data* newData = Buffer::Create(newSize);
         memcpy(newData->m_data, m_data->m_data + m_start, GetInternalSize());
-        m_data->m_count--;
-        if (m_data->m_count == 0)
+        if (--m_data->m_count == 0)
         {
             Buffer::Recycle(m_data);
         }
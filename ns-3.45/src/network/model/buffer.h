@@ -9,6 +9,7 @@
 #define BUFFER_H
 
 #include "ns3/assert.h"
+#include "ns3/multithreading.h"
 
 #include <ostream>
 #include <stdint.h>
@@ -654,7 +655,7 @@ class Buffer
          * The reference count of an instance of this data structure.
          * Each buffer which references an instance holds a count.
          */
-        uint32_t m_count;
+        RefCounter m_count;
         /**
          * the size of the m_data field below.
          */
@@ -758,7 +759,7 @@ class Buffer
      * writing data. i.e., m_start should be initialized to this
      * value.
      */
-    static uint32_t g_recommendedStart;
+    static NS3_THREAD_LOCAL uint32_t g_recommendedStart;
 
     /**
      * offset to the start of the virtual zero area from the start
@@ -791,9 +792,10 @@ class Buffer
         ~LocalStaticDestructor();
     };
 
-    static uint32_t g_maxSize;                            //!< Max observed data size
-    static FreeList* g_freeList;                          //!< Buffer data container
-    static LocalStaticDestructor g_localStaticDestructor; //!< Local static destructor
+    static NS3_THREAD_LOCAL uint32_t g_maxSize;   //!< Max observed data size
+    static NS3_THREAD_LOCAL FreeList* g_freeList; //!< Buffer data container
+    /// Local static destructor
+    static NS3_THREAD_LOCAL LocalStaticDestructor g_localStaticDestructor;
 #endif
 };
 
@@ -7,7 +7,10 @@
  */
 #include "byte-tag-list.h"
 
+#include "packet-allocator.h"
+
 #include "ns3/log.h"
+#include "ns3/multithreading.h"
 
 #include <cstring>
 #include <limits>
@@ -31,12 +34,22 @@ NS_LOG_COMPONENT_DEFINE("ByteTagList");
  */
 struct ByteTagListData
 {
-    uint32_t size;   //!< size of the data
-    uint32_t count;  //!< use counter (for smart deallocation)
-    uint32_t dirty;  //!< number of bytes actually in use
-    uint8_t data[4]; //!< data
+    uint32_t size;    //!< size of the data
+    RefCounter count; //!< use counter (for smart deallocation)
+    uint32_t dirty;   //!< number of bytes actually in use
+    uint8_t data[4];  //!< data
 };
 
+/**
+ * Release a ByteTagListData to the PacketAllocator.
+ * @param [in] data The ByteTagListData.
+ */
+static void
+FreeData(ByteTagListData* data)
+{
+    PacketAllocator::Deallocate(data, data->size + sizeof(ByteTagListData) - 4);
+}
+
 #ifdef USE_FREE_LIST
 /**
  * @ingroup packet
@@ -45,21 +58,20 @@ struct ByteTagListData
  *
  * Internal use only.
  */
-static class ByteTagListDataFreeList : public std::vector<ByteTagListData*>
+static NS3_THREAD_LOCAL class ByteTagListDataFreeList : public std::vector<ByteTagListData*>
 {
   public:
     ~ByteTagListDataFreeList();
 } g_freeList; //!< Container for struct ByteTagListData
 
-static uint32_t g_maxSize = 0; //!< maximum data size (used for allocation)
+static NS3_THREAD_LOCAL uint32_t g_maxSize = 0; //!< maximum data size (used for allocation)
 
 ByteTagListDataFreeList::~ByteTagListDataFreeList()
 {
     NS_LOG_FUNCTION(this);
     for (auto i = begin(); i != end(); i++)
     {
-        auto buffer = (uint8_t*)(*i);
-        delete[] buffer;
+        FreeData(*i);
     }
 }
 #endif /* USE_FREE_LIST */
@@ -355,11 +367,11 @@ ByteTagList::Allocate(uint32_t size)
             data->dirty = 0;
             return data;
         }
-        auto buffer = (uint8_t*)data;
-        delete[] buffer;
+        FreeData(data);
     }
-    auto buffer = new uint8_t[std::max(size, g_maxSize) + sizeof(ByteTagListData) - 4];
-    auto data = (ByteTagListData*)buffer;
+    size = std::max(size, g_maxSize);
+    void* block = PacketAllocator::Allocate(size + sizeof(ByteTagListData) - 4);
+    auto data = static_cast<ByteTagListData*>(block);
     data->count = 1;
     data->size = size;
     data->dirty = 0;
@@ -375,13 +387,11 @@ ByteTagList::Deallocate(ByteTagListData* data)
         return;
     }
     g_maxSize = std::max(g_maxSize, data->size);
-    data->count--;
-    if (data->count == 0)
+    if (--data->count == 0)
     {
         if (g_freeList.size() > FREE_LIST_SIZE || data->size < g_maxSize)
         {
-            auto buffer = (uint8_t*)data;
-            delete[] buffer;
+            FreeData(data);
         }
         else
         {
@@ -396,8 +406,8 @@ ByteTagListData*
 ByteTagList::Allocate(uint32_t size)
 {
     NS_LOG_FUNCTION(this << size);
-    uint8_t* buffer = new uint8_t[size + sizeof(ByteTagListData) - 4];
-    ByteTagListData* data = (ByteTagListData*)buffer;
+    void* block = PacketAllocator::Allocate(size + sizeof(ByteTagListData) - 4);
+    auto data = static_cast<ByteTagListData*>(block);
     data->count = 1;
     data->size = size;
     data->dirty = 0;
@@ -412,11 +422,9 @@ ByteTagList::Deallocate(ByteTagListData* data)
     {
         return;
     }
-    data->count--;
-    if (data->count == 0)
+    if (--data->count == 0)
     {
-        uint8_t* buffer = (uint8_t*)data;
-        delete[] buffer;
+        FreeData(data);
     }
 }
 
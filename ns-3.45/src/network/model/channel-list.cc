@@ -11,6 +11,7 @@
 #include "ns3/assert.h"
 #include "ns3/config.h"
 #include "ns3/log.h"
+#include "ns3/multithreading.h"
 #include "ns3/object-vector.h"
 #include "ns3/simulator.h"
 
@@ -119,7 +120,7 @@ Ptr<ChannelListPriv>*
 ChannelListPriv::DoGet()
 {
     NS_LOG_FUNCTION_NOARGS();
-    static Ptr<ChannelListPriv> ptr = nullptr;
+    static NS3_SIMULATION_LOCAL Ptr<ChannelListPriv> ptr = nullptr;
     if (!ptr)
     {
         ptr = CreateObject<ChannelListPriv>();
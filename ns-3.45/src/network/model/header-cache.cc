@@ -0,0 +1,71 @@
+//
+// SPDX-License-Identifier: GPL-2.0-only
+//
+
+#include "header-cache.h"
+
+#include "packet-allocator.h"
+
+#include "ns3/log.h"
+
+/**
+ * @file
+ * @ingroup packet
+ * ns3::HeaderCache implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("HeaderCache");
+
+HeaderCache::HeaderCache()
+    : m_nEntries(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+HeaderCache::~HeaderCache()
+{
+    NS_LOG_FUNCTION(this);
+    for (std::size_t i = 0; i < m_nEntries; i++)
+    {
+        Entry& entry = m_entries[i];
+        if (entry.inlined)
+        {
+            entry.header->~Header();
+        }
+        else
+        {
+            delete entry.header;
+        }
+    }
+}
+
+void*
+HeaderCache::operator new(std::size_t size)
+{
+    return PacketAllocator::Allocate(size);
+}
+
+void
+HeaderCache::operator delete(void* block, std::size_t size)
+{
+    PacketAllocator::Deallocate(block, size);
+}
+
+const HeaderCache::Entry*
+HeaderCache::Find(TypeId tid, uint32_t offset) const
+{
+    for (std::size_t i = 0; i < m_nEntries; i++)
+    {
+        const Entry& entry = m_entries[i];
+        if (entry.offset == offset && entry.tid == tid)
+        {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace ns3
@@ -0,0 +1,138 @@
+//
+// SPDX-License-Identifier: GPL-2.0-only
+//
+
+#ifndef HEADER_CACHE_H
+#define HEADER_CACHE_H
+
+#include "header.h"
+
+#include "ns3/simple-ref-count.h"
+#include "ns3/type-id.h"
+
+#include <cstddef>
+#include <new>
+#include <stdint.h>
+
+/**
+ * @file
+ * @ingroup packet
+ * ns3::HeaderCache declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * @ingroup packet
+ * @brief The headers already deserialized from a packet.
+ *
+ * A Packet and its copies share the cache until one of them is modified
+ * other than by removing bytes at its start: up to that point, their
+ * bytes at the same distance from the end are the same. A header is
+ * thus identified by its TypeId and by the size of the packet from the
+ * header to the end, i.e., its offset from the end of the buffer.
+ *
+ * The headers are copied into the cache itself when they fit, and the
+ * caches are allocated from the PacketAllocator: filling the cache of a
+ * packet usually does not allocate memory.
+ *
+ * \see Packet::EnableHeaderCache
+ */
+class HeaderCache : public SimpleRefCount<HeaderCache>
+{
+  public:
+    /// The size of the storage of a header in the cache.
+    static constexpr std::size_t STORAGE_SIZE = 128;
+
+    /// A deserialized header.
+    struct Entry
+    {
+        TypeId tid;      //!< The type of the header
+        uint32_t offset; //!< The offset of the header from the end of the buffer
+        uint32_t size;   //!< The number of bytes deserialized
+        Header* header;  //!< The header
+        bool inlined;    //!< Whether the header is in the storage
+        /// The storage of the header, if it fits
+        alignas(std::max_align_t) unsigned char storage[STORAGE_SIZE];
+    };
+
+    HeaderCache();
+    ~HeaderCache();
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    HeaderCache(const HeaderCache&) = delete;
+    HeaderCache& operator=(const HeaderCache&) = delete;
+
+    /**
+     * Allocate a cache from the PacketAllocator.
+     * @param [in] size The size of the cache.
+     * @returns The memory.
+     */
+    static void* operator new(std::size_t size);
+
+    /**
+     * Release a cache to the PacketAllocator.
+     * @param [in] block The memory.
+     * @param [in] size The size of the cache.
+     */
+    static void operator delete(void* block, std::size_t size);
+
+    /**
+     * Find a header.
+     * @param [in] tid The type of the header.
+     * @param [in] offset The offset of the header from the end of the buffer.
+     * @returns The entry, or nullptr if the header was not deserialized yet.
+     */
+    const Entry* Find(TypeId tid, uint32_t offset) const;
+
+    /**
+     * Add a copy of a header, unless the cache is full.
+     * @tparam T \deduced The type of the header.
+     * @param [in] tid The type of the header.
+     * @param [in] offset The offset of the header from the end of the buffer.
+     * @param [in] size The number of bytes deserialized.
+     * @param [in] header The header.
+     */
+    template <typename T>
+    void Insert(TypeId tid, uint32_t offset, uint32_t size, const T& header);
+
+  private:
+    /// The maximum number of headers: a packet only has a few.
+    static constexpr std::size_t MAX_ENTRIES = 4;
+
+    Entry m_entries[MAX_ENTRIES]; //!< The headers
+    std::size_t m_nEntries;       //!< The number of headers
+};
+
+/****************************************************************
+ *  Implementation of the templates declared above.
+ ****************************************************************/
+
+template <typename T>
+void
+HeaderCache::Insert(TypeId tid, uint32_t offset, uint32_t size, const T& header)
+{
+    if (m_nEntries == MAX_ENTRIES)
+    {
+        return;
+    }
+    Entry& entry = m_entries[m_nEntries++];
+    entry.tid = tid;
+    entry.offset = offset;
+    entry.size = size;
+    if constexpr (sizeof(T) <= STORAGE_SIZE && alignof(T) <= alignof(std::max_align_t))
+    {
+        entry.header = new (entry.storage) T(header);
+        entry.inlined = true;
+    }
+    else
+    {
+        entry.header = new T(header);
+        entry.inlined = false;
+    }
+}
+
+} // namespace ns3
+
+#endif /* HEADER_CACHE_H */
@@ -14,6 +14,7 @@
 #include "ns3/assert.h"
 #include "ns3/config.h"
 #include "ns3/log.h"
+#include "ns3/multithreading.h"
 #include "ns3/object-vector.h"
 #include "ns3/simulator.h"
 
@@ -122,7 +123,7 @@ Ptr<NodeListPriv>*
 NodeListPriv::DoGet()
 {
     NS_LOG_FUNCTION_NOARGS();
-    static Ptr<NodeListPriv> ptr = nullptr;
+    static NS3_SIMULATION_LOCAL Ptr<NodeListPriv> ptr = nullptr;
     if (!ptr)
     {
         ptr = CreateObject<NodeListPriv>();
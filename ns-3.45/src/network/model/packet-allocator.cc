@@ -0,0 +1,99 @@
+//
+// SPDX-License-Identifier: GPL-2.0-only
+//
+
+#include "packet-allocator.h"
+
+#include "ns3/log.h"
+
+#include <new>
+
+/**
+ * @file
+ * @ingroup packet
+ * ns3::PacketAllocator implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("PacketAllocator");
+
+NS3_THREAD_LOCAL PacketAllocator::FreeLists PacketAllocator::m_freeLists;
+NS3_THREAD_LOCAL bool PacketAllocator::m_freeListsDestroyed = false;
+uint32_t PacketAllocator::m_cacheSize = 1024;
+
+PacketAllocator::FreeLists::~FreeLists()
+{
+    for (std::size_t i = 0; i < N_CLASSES; i++)
+    {
+        while (m_heads[i] != nullptr)
+        {
+            Block* block = m_heads[i];
+            m_heads[i] = block->next;
+            ::operator delete(block);
+        }
+        m_sizes[i] = 0;
+    }
+    m_freeListsDestroyed = true;
+}
+
+std::size_t
+PacketAllocator::GetClass(std::size_t size)
+{
+    return (size + GRANULARITY - 1) / GRANULARITY - 1;
+}
+
+void*
+PacketAllocator::Allocate(std::size_t size)
+{
+    if (size == 0 || size > MAX_SIZE)
+    {
+        return ::operator new(size);
+    }
+    std::size_t c = GetClass(size);
+    Block* block = m_freeLists.m_heads[c];
+    if (block == nullptr)
+    {
+        // allocate the whole class, so that any block of the class fits
+        return ::operator new((c + 1) * GRANULARITY);
+    }
+    m_freeLists.m_heads[c] = block->next;
+    m_freeLists.m_sizes[c]--;
+    return block;
+}
+
+void
+PacketAllocator::Deallocate(void* block, std::size_t size)
+{
+    if (size == 0 || size > MAX_SIZE || m_freeListsDestroyed)
+    {
+        ::operator delete(block);
+        return;
+    }
+    std::size_t c = GetClass(size);
+    if (m_freeLists.m_sizes[c] >= m_cacheSize)
+    {
+        ::operator delete(block);
+        return;
+    }
+    auto head = static_cast<Block*>(block);
+    head->next = m_freeLists.m_heads[c];
+    m_freeLists.m_heads[c] = head;
+    m_freeLists.m_sizes[c]++;
+}
+
+void
+PacketAllocator::SetCacheSize(uint32_t blocks)
+{
+    NS_LOG_FUNCTION(blocks);
+    m_cacheSize = blocks;
+}
+
+uint32_t
+PacketAllocator::GetCacheSize()
+{
+    return m_cacheSize;
+}
+
+} // namespace ns3
@@ -0,0 +1,109 @@
+//
+// SPDX-License-Identifier: GPL-2.0-only
+//
+
+#ifndef PACKET_ALLOCATOR_H
+#define PACKET_ALLOCATOR_H
+
+#include "ns3/multithreading.h"
+
+#include <cstddef>
+#include <stdint.h>
+
+/**
+ * @file
+ * @ingroup packet
+ * ns3::PacketAllocator declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * @ingroup packet
+ * @brief A size-class pool for the structures allocated per packet.
+ *
+ * The Packet objects, the tags of their PacketTagList, their HeaderCache,
+ * and the storage of their PacketMetadata and ByteTagList are allocated
+ * and released at the rate of the packets. The pool keeps the blocks
+ * released in a free list per size class, by steps of GRANULARITY bytes up
+ * to MAX_SIZE bytes, and returns them to the next allocations of the
+ * class. The larger blocks go to the general allocator.
+ *
+ * The free lists are thread-local with the multithreaded simulator, and
+ * with one simulation per thread, so the threads allocate without locks.
+ * Each block is a separate allocation of the general allocator, so a block
+ * may be released by another thread than the one which allocated it: it
+ * joins the free lists of the thread which releases it.
+ */
+class PacketAllocator
+{
+  public:
+    /// The size of the steps between the size classes.
+    static constexpr std::size_t GRANULARITY = 16;
+    /// The size of the largest class.
+    static constexpr std::size_t MAX_SIZE = 1024;
+
+    /**
+     * Allocate a block.
+     * @param [in] size The size of the block.
+     * @returns The block.
+     */
+    static void* Allocate(std::size_t size);
+
+    /**
+     * Release a block.
+     * @param [in] block The block.
+     * @param [in] size The size of the block, as passed to Allocate().
+     */
+    static void Deallocate(void* block, std::size_t size);
+
+    /**
+     * Set the number of blocks kept by each free list, e.g., 0 to release
+     * every block to the general allocator. Call it before the simulation
+     * starts.
+     * @param [in] blocks The number of blocks.
+     */
+    static void SetCacheSize(uint32_t blocks);
+
+    /**
+     * Get the number of blocks kept by each free list.
+     * @returns The number of blocks.
+     */
+    static uint32_t GetCacheSize();
+
+  private:
+    /// The number of size classes.
+    static constexpr std::size_t N_CLASSES = MAX_SIZE / GRANULARITY;
+
+    /// A block in a free list.
+    struct Block
+    {
+        Block* next; //!< The next block of the free list
+    };
+
+    /// The free lists, which release their blocks when they are destroyed.
+    class FreeLists
+    {
+      public:
+        ~FreeLists();
+
+        Block* m_heads[N_CLASSES]{};   //!< The first block of each class
+        uint32_t m_sizes[N_CLASSES]{}; //!< The number of blocks of each class
+    };
+
+    /**
+     * Get the class of a size.
+     * @param [in] size The size, at most MAX_SIZE.
+     * @returns The class.
+     */
+    static std::size_t GetClass(std::size_t size);
+
+    static NS3_THREAD_LOCAL FreeLists m_freeLists;      //!< The blocks released
+    static NS3_THREAD_LOCAL bool m_freeListsDestroyed; //!< m_freeLists was destroyed
+    static uint32_t m_cacheSize;                        //!< The blocks kept per class
+};
+
+} // namespace ns3
+
+#endif /* PACKET_ALLOCATOR_H */
@@ -9,6 +9,7 @@
 
 #include "buffer.h"
 #include "header.h"
+#include "packet-allocator.h"
 #include "trailer.h"
 
 #include "ns3/assert.h"
@@ -28,7 +29,8 @@ bool PacketMetadata::m_enableChecking = false;
 bool PacketMetadata::m_metadataSkipped = false;
 uint32_t PacketMetadata::m_maxSize = 0;
 uint16_t PacketMetadata::m_chunkUid = 0;
-PacketMetadata::DataFreeList PacketMetadata::m_freeList;
+NS3_THREAD_LOCAL PacketMetadata::DataFreeList PacketMetadata::m_freeList;
+NS3_THREAD_LOCAL bool PacketMetadata::m_freeListDestroyed = false;
 
 PacketMetadata::DataFreeList::~DataFreeList()
 {
@@ -37,7 +39,12 @@ PacketMetadata::DataFreeList::~DataFreeList()
     {
         PacketMetadata::Deallocate(*i);
     }
+#ifdef NS3_MULTITHREADED
+    // the free lists of the simulation threads are destroyed when they exit
+    PacketMetadata::m_freeListDestroyed = true;
+#else
     PacketMetadata::m_enable = false;
+#endif
 }
 
 void
@@ -62,6 +69,12 @@ PacketMetadata::EnableChecking()
     m_enableChecking = true;
 }
 
+bool
+PacketMetadata::IsEnabled()
+{
+    return m_enable;
+}
+
 void
 PacketMetadata::ReserveCopy(uint32_t size)
 {
@@ -69,8 +82,7 @@ PacketMetadata::ReserveCopy(uint32_t size)
     PacketMetadata::Data* newData = PacketMetadata::Create(m_used + size);
     memcpy(newData->m_data, m_data->m_data, m_used);
     newData->m_dirtyEnd = m_used;
-    m_data->m_count--;
-    if (m_data->m_count == 0)
+    if (--m_data->m_count == 0)
     {
         PacketMetadata::Recycle(m_data);
     }
@@ -582,7 +594,7 @@ void
 PacketMetadata::Recycle(PacketMetadata::Data* data)
 {
     NS_LOG_FUNCTION(data);
-    if (!m_enable)
+    if (!m_enable || m_freeListDestroyed)
     {
         PacketMetadata::Deallocate(data);
         return;
@@ -609,8 +621,7 @@ PacketMetadata::Allocate(uint32_t n)
         n = PACKET_METADATA_DATA_M_DATA_SIZE;
     }
     size += n - PACKET_METADATA_DATA_M_DATA_SIZE;
-    auto buf = new uint8_t[size];
-    auto data = (PacketMetadata::Data*)buf;
+    auto data = static_cast<PacketMetadata::Data*>(PacketAllocator::Allocate(size));
     data->m_size = n;
     data->m_count = 1;
     data->m_dirtyEnd = 0;
@@ -621,8 +632,8 @@ void
 PacketMetadata::Deallocate(PacketMetadata::Data* data)
 {
     NS_LOG_FUNCTION(data);
-    auto buf = (uint8_t*)data;
-    delete[] buf;
+    PacketAllocator::Deallocate(data,
+                                sizeof(Data) + data->m_size - PACKET_METADATA_DATA_M_DATA_SIZE);
 }
 
 PacketMetadata
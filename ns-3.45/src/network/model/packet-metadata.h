@@ -12,6 +12,7 @@
 
 #include "ns3/assert.h"
 #include "ns3/callback.h"
+#include "ns3/multithreading.h"
 #include "ns3/type-id.h"
 
 #include <limits>
@@ -158,6 +159,11 @@ class PacketMetadata
      * @brief Enable the packet metadata checking
      */
     static void EnableChecking();
+    /**
+     * @brief Check whether the packet metadata is enabled
+     * @returns true if Enable or EnableChecking was called
+     */
+    static bool IsEnabled();
 
     /**
      * @brief Constructor
@@ -415,7 +421,7 @@ class PacketMetadata
     struct Data
     {
         /** number of references to this struct Data instance. */
-        uint32_t m_count;
+        RefCounter m_count;
         /** size (in bytes) of m_data buffer below */
         uint32_t m_size;
         /** max of the m_used field over all objects which reference this struct Data instance */
@@ -664,9 +670,10 @@ class PacketMetadata
      */
     static void Deallocate(PacketMetadata::Data* data);
 
-    static DataFreeList m_freeList; //!< the metadata data storage
-    static bool m_enable;           //!< Enable the packet metadata
-    static bool m_enableChecking;   //!< Enable the packet metadata checking
+    static NS3_THREAD_LOCAL DataFreeList m_freeList;   //!< the metadata data storage
+    static NS3_THREAD_LOCAL bool m_freeListDestroyed; //!< m_freeList was destroyed
+    static bool m_enable;                              //!< Enable the packet metadata
+    static bool m_enableChecking;                      //!< Enable the packet metadata checking
 
     /**
      * Set to true when adding metadata to a packet is skipped because
@@ -728,8 +735,7 @@ PacketMetadata::operator=(const PacketMetadata& o)
     {
         // not self assignment
         NS_ASSERT(m_data != nullptr);
-        m_data->m_count--;
-        if (m_data->m_count == 0)
+        if (--m_data->m_count == 0)
         {
             PacketMetadata::Recycle(m_data);
         }
@@ -747,8 +753,7 @@ PacketMetadata::operator=(const PacketMetadata& o)
 PacketMetadata::~PacketMetadata()
 {
     NS_ASSERT(m_data != nullptr);
-    m_data->m_count--;
-    if (m_data->m_count == 0)
+    if (--m_data->m_count == 0)
     {
         PacketMetadata::Recycle(m_data);
     }
@@ -26,6 +26,38 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("PacketTagList");
 
+uint16_t PacketTagList::m_slotUids[PacketTagList::MAX_SLOTS] = {};
+uint32_t PacketTagList::m_nSlots = 0;
+
+bool
+PacketTagList::RegisterSlot(TypeId tid)
+{
+    // No logging: this is usually called before the log components are constructed
+    if (FindSlot(tid) != MAX_SLOTS)
+    {
+        return true;
+    }
+    if (m_nSlots == MAX_SLOTS)
+    {
+        return false;
+    }
+    m_slotUids[m_nSlots++] = tid.GetUid();
+    return true;
+}
+
+uint32_t
+PacketTagList::FindSlot(TypeId tid)
+{
+    for (uint32_t i = 0; i < m_nSlots; ++i)
+    {
+        if (m_slotUids[i] == tid.GetUid())
+        {
+            return i;
+        }
+    }
+    return MAX_SLOTS;
+}
+
 PacketTagList::TagData*
 PacketTagList::CreateTagData(size_t dataSize)
 {
@@ -33,8 +65,8 @@ PacketTagList::CreateTagData(size_t dataSize)
                   "Requested TagData size " << dataSize << " exceeds maximum "
                                             << std::numeric_limits<decltype(TagData::size)>::max());
 
-    void* p = std::malloc(sizeof(TagData) + dataSize - 1);
-    // The matching frees are in RemoveAll and RemoveWriter
+    void* p = PacketAllocator::Allocate(sizeof(TagData) + dataSize - 1);
+    // The matching frees are in RemoveAllFromTree and RemoveWriter
 
     auto tag = new (p) TagData;
     tag->size = dataSize;
@@ -164,6 +196,16 @@ PacketTagList::COWTraverse(Tag& tag, PacketTagList::COWWriter Writer)
 bool
 PacketTagList::Remove(Tag& tag)
 {
+    TypeId tid = tag.GetInstanceTypeId();
+    uint32_t i = FindSlot(tid);
+    if (i != MAX_SLOTS && m_slots[i].tid == tid)
+    {
+        NS_LOG_FUNCTION(this << tid);
+        Slot& slot = m_slots[i];
+        tag.Deserialize(TagBuffer(slot.data, slot.data + slot.size));
+        slot.tid = TypeId();
+        return true;
+    }
     return COWTraverse(tag, &PacketTagList::RemoveWriter);
 }
 
@@ -184,8 +226,7 @@ PacketTagList::RemoveWriter(Tag& tag,
     if (preMerge)
     {
         // found tid before first merge, so delete cur
-        cur->~TagData();
-        std::free(cur);
+        FreeTagData(cur);
     }
     else
     {
@@ -204,6 +245,25 @@ PacketTagList::RemoveWriter(Tag& tag,
 bool
 PacketTagList::Replace(Tag& tag)
 {
+    TypeId tid = tag.GetInstanceTypeId();
+    uint32_t i = FindSlot(tid);
+    if (i != MAX_SLOTS && m_slots[i].tid == tid)
+    {
+        NS_LOG_FUNCTION(this << tid);
+        Slot& slot = m_slots[i];
+        uint32_t size = tag.GetSerializedSize();
+        if (size <= SLOT_SIZE)
+        {
+            slot.size = size;
+            tag.Serialize(TagBuffer(slot.data, slot.data + slot.size));
+        }
+        else
+        {
+            slot.tid = TypeId();
+            Add(tag);
+        }
+        return true;
+    }
     bool found = COWTraverse(tag, &PacketTagList::ReplaceWriter);
     if (!found)
     {
@@ -250,18 +310,35 @@ PacketTagList::ReplaceWriter(Tag& tag,
 void
 PacketTagList::Add(const Tag& tag) const
 {
-    NS_LOG_FUNCTION(this << tag.GetInstanceTypeId());
+    TypeId tid = tag.GetInstanceTypeId();
+    NS_LOG_FUNCTION(this << tid);
+    uint32_t i = FindSlot(tid);
+    if (i != MAX_SLOTS)
+    {
+        Slot& slot = const_cast<PacketTagList*>(this)->m_slots[i];
+        NS_ASSERT_MSG(slot.tid != tid,
+                      "Error: cannot add the same kind of tag twice. The tag type is "
+                          << tid.GetName());
+        uint32_t size = tag.GetSerializedSize();
+        if (size <= SLOT_SIZE)
+        {
+            slot.tid = tid;
+            slot.size = size;
+            tag.Serialize(TagBuffer(slot.data, slot.data + slot.size));
+            return;
+        }
+    }
     // ensure this id was not yet added
     for (TagData* cur = m_next; cur != nullptr; cur = cur->next)
     {
-        NS_ASSERT_MSG(cur->tid != tag.GetInstanceTypeId(),
+        NS_ASSERT_MSG(cur->tid != tid,
                       "Error: cannot add the same kind of tag twice. The tag type is "
-                          << tag.GetInstanceTypeId().GetName());
+                          << tid.GetName());
     }
     TagData* head = CreateTagData(tag.GetSerializedSize());
     head->count = 1;
     head->next = nullptr;
-    head->tid = tag.GetInstanceTypeId();
+    head->tid = tid;
     head->next = m_next;
     tag.Serialize(TagBuffer(head->data, head->data + head->size));
 
@@ -273,6 +350,14 @@ PacketTagList::Peek(Tag& tag) const
 {
     NS_LOG_FUNCTION(this << tag.GetInstanceTypeId());
     TypeId tid = tag.GetInstanceTypeId();
+    uint32_t i = FindSlot(tid);
+    if (i != MAX_SLOTS && m_slots[i].tid == tid)
+    {
+        const Slot& slot = m_slots[i];
+        tag.Deserialize(TagBuffer(const_cast<uint8_t*>(slot.data),
+                                  const_cast<uint8_t*>(slot.data) + slot.size));
+        return true;
+    }
     for (TagData* cur = m_next; cur != nullptr; cur = cur->next)
     {
         if (cur->tid == tid)
@@ -301,12 +386,21 @@ PacketTagList::GetSerializedSize() const
 
     size = 4; // numberOfTags
 
+    // TypeId hash; ensure size is multiple of 4 bytes
+    uint32_t hashSize = (sizeof(TypeId::hash_t) + 3) & (~3);
+
+    for (const Slot& slot : m_slots)
+    {
+        if (slot.tid != TypeId())
+        {
+            size += 4 + hashSize + ((slot.size + 3) & (~3));
+        }
+    }
+
     for (TagData* cur = m_next; cur != nullptr; cur = cur->next)
     {
         size += 4; // TagData -> size
 
-        // TypeId hash; ensure size is multiple of 4 bytes
-        uint32_t hashSize = (sizeof(TypeId::hash_t) + 3) & (~3);
         size += hashSize;
 
         // TagData -> data; ensure size is multiple of 4 bytes
@@ -335,18 +429,18 @@ PacketTagList::Serialize(uint32_t* buffer, uint32_t maxSize) const
     uint32_t* numberOfTags = p;
     *p++ = 0;
 
-    for (TagData* cur = m_next; cur != nullptr; cur = cur->next)
-    {
+    // serialize one tag, returns false if the buffer is too small
+    auto serializeTag = [&](TypeId tid, const uint8_t* data, uint32_t dataSize) {
         size += 4;
 
         if (size > maxSize)
         {
-            return 0;
+            return false;
         }
 
-        *p++ = cur->size;
+        *p++ = dataSize;
 
-        NS_LOG_INFO("Serializing tag id " << cur->tid);
+        NS_LOG_INFO("Serializing tag id " << tid);
 
         // ensure size is multiple of 4 bytes for 4 byte boundaries
         uint32_t hashSize = (sizeof(TypeId::hash_t) + 3) & (~3);
@@ -354,26 +448,43 @@ PacketTagList::Serialize(uint32_t* buffer, uint32_t maxSize) const
 
         if (size > maxSize)
         {
-            return 0;
+            return false;
         }
 
-        TypeId::hash_t tid = cur->tid.GetHash();
-        memcpy(p, &tid, sizeof(TypeId::hash_t));
+        TypeId::hash_t hash = tid.GetHash();
+        memcpy(p, &hash, sizeof(TypeId::hash_t));
         p += hashSize / 4;
 
         // ensure size is multiple of 4 bytes for 4 byte boundaries
-        uint32_t tagWordSize = (cur->size + 3) & (~3);
+        uint32_t tagWordSize = (dataSize + 3) & (~3);
         size += tagWordSize;
 
         if (size > maxSize)
         {
-            return 0;
+            return false;
         }
 
-        memcpy(p, cur->data, cur->size);
+        memcpy(p, data, dataSize);
         p += tagWordSize / 4;
 
         (*numberOfTags)++;
+        return true;
+    };
+
+    for (const Slot& slot : m_slots)
+    {
+        if (slot.tid != TypeId() && !serializeTag(slot.tid, slot.data, slot.size))
+        {
+            return 0;
+        }
+    }
+
+    for (TagData* cur = m_next; cur != nullptr; cur = cur->next)
+    {
+        if (!serializeTag(cur->tid, cur->data, cur->size))
+        {
+            return 0;
+        }
     }
 
     // Serialized successfully
@@ -411,6 +522,22 @@ PacketTagList::Deserialize(const uint32_t* buffer, uint32_t size)
 
         NS_LOG_INFO("Deserializing tag of type " << tid);
 
+        uint32_t slotIndex = FindSlot(tid);
+        if (slotIndex != MAX_SLOTS && tagSize <= SLOT_SIZE)
+        {
+            Slot& slot = m_slots[slotIndex];
+            slot.tid = tid;
+            slot.size = tagSize;
+            NS_ASSERT(sizeCheck >= tagSize);
+            memcpy(slot.data, p, tagSize);
+
+            // ensure 4 byte boundary
+            uint32_t tagWordSize = (tagSize + 3) & (~3);
+            p += tagWordSize / 4;
+            sizeCheck -= tagWordSize;
+            continue;
+        }
+
         TagData* newTag = CreateTagData(tagSize);
         newTag->count = 1;
         newTag->next = nullptr;
@@ -425,7 +552,7 @@ PacketTagList::Deserialize(const uint32_t* buffer, uint32_t size)
         sizeCheck -= tagWordSize;
 
         // Set link list pointers.
-        if (i == 0)
+        if (prevTag == nullptr)
         {
             m_next = newTag;
         }
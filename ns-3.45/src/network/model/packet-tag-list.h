@@ -13,8 +13,12 @@
 \brief  Defines a linked list of Packet tags, including copy-on-write semantics.
 */
 
+#include "packet-allocator.h"
+
+#include "ns3/multithreading.h"
 #include "ns3/type-id.h"
 
+#include <array>
 #include <ostream>
 #include <stdint.h>
 
@@ -109,6 +113,18 @@ class Tag;
  *       The portion of the list between the first branch and the target is
  *       shared. This portion is copied before the #Remove or #Replace is
  *       performed.
+ *
+ * @par <b> Slots </b>
+ *
+ *   - A few tag types, registered with #RegisterSlot (usually through
+ *     NS_PACKET_TAG_SLOT_REGISTER), are stored in a fixed array of slots
+ *     embedded in the PacketTagList instead of the tree, one slot per type.
+ *     Adding such a tag serializes it into its slot: it does not allocate.
+ *
+ *   - The slots are copied with the PacketTagList, so a copy can modify
+ *     them without affecting the original.
+ *
+ *   - A tag whose serialized size exceeds #SLOT_SIZE is stored in the tree.
  */
 class PacketTagList
 {
@@ -130,13 +146,43 @@ class PacketTagList
      */
     struct TagData
     {
-        TagData* next;   //!< Pointer to next in list
-        uint32_t count;  //!< Number of incoming links
-        TypeId tid;      //!< Type of the tag serialized into #data
-        uint32_t size;   //!< Size of the \c data buffer
-        uint8_t data[1]; //!< Serialization buffer
+        TagData* next;    //!< Pointer to next in list
+        RefCounter count; //!< Number of incoming links
+        TypeId tid;       //!< Type of the tag serialized into #data
+        uint32_t size;    //!< Size of the \c data buffer
+        uint8_t data[1];  //!< Serialization buffer
+    };
+
+    /// The maximum number of tag types stored in slots.
+    static constexpr uint32_t MAX_SLOTS = 4;
+    /// The maximum serialized size of a tag stored in a slot.
+    static constexpr uint32_t SLOT_SIZE = 20;
+
+    /**
+     * Slot storing a serialized tag.
+     *
+     * @internal
+     * Public for the same reason as TagData.
+     */
+    struct Slot
+    {
+        TypeId tid;              //!< Type of the tag serialized into #data, TypeId() if empty
+        uint8_t size;            //!< Size of the serialized tag
+        uint8_t data[SLOT_SIZE]; //!< Serialization buffer
     };
 
+    /**
+     * Store the tags of a type in a slot rather than in the tree.
+     *
+     * The slots must be registered before the tags of that type are added
+     * to packets, i.e., at static initialization time.
+     *
+     * @param [in] tid The type of the tags.
+     * @returns True if the tags of this type are stored in a slot,
+     *          false if all the slots are already taken.
+     */
+    static bool RegisterSlot(TypeId tid);
+
     /**
      * Create a new PacketTagList.
      */
@@ -200,13 +246,18 @@ class PacketTagList
      */
     bool Peek(Tag& tag) const;
     /**
-     * Remove all tags from this list (up to the first merge).
+     * Remove all tags from this list: the slots, and the tree up to the first merge.
      */
     inline void RemoveAll();
     /**
      * @returns pointer to head of tag list
      */
     const PacketTagList::TagData* Head() const;
+    /**
+     * @param [in] i The index of the slot, less than #MAX_SLOTS.
+     * @returns the slot
+     */
+    inline const Slot& GetSlot(uint32_t i) const;
     /**
      * Returns number of bytes required for packet serialization.
      *
@@ -242,6 +293,27 @@ class PacketTagList
      */
     static TagData* CreateTagData(size_t dataSize);
 
+    /**
+     * Destroy a TagData struct and release it to the PacketAllocator.
+     *
+     * @param [in] tag The TagData, created by CreateTagData().
+     */
+    static inline void FreeTagData(TagData* tag);
+
+    /**
+     * Find the slot of a tag type.
+     *
+     * @param [in] tid The type of the tag.
+     * @returns The index of the slot, or #MAX_SLOTS if the tags of this
+     *          type are stored in the tree.
+     */
+    static uint32_t FindSlot(TypeId tid);
+
+    /**
+     * Remove all the tags stored in the tree (up to the first merge).
+     */
+    inline void RemoveAllFromTree();
+
     /**
      * Typedef of method function pointer for copy-on-write operations
      *
@@ -294,6 +366,13 @@ class PacketTagList
      * Pointer to first \ref TagData on the list
      */
     TagData* m_next;
+    /**
+     * The tags stored in slots
+     */
+    std::array<Slot, MAX_SLOTS> m_slots;
+
+    static uint16_t m_slotUids[MAX_SLOTS]; //!< The uid of the type of the tags of each slot
+    static uint32_t m_nSlots;              //!< The number of slots registered
 };
 
 } // namespace ns3
@@ -306,12 +385,14 @@ namespace ns3
 {
 
 PacketTagList::PacketTagList()
-    : m_next()
+    : m_next(),
+      m_slots()
 {
 }
 
 PacketTagList::PacketTagList(const PacketTagList& o)
-    : m_next(o.m_next)
+    : m_next(o.m_next),
+      m_slots(o.m_slots)
 {
     if (m_next != nullptr)
     {
@@ -322,12 +403,13 @@ PacketTagList::PacketTagList(const PacketTagList& o)
 PacketTagList&
 PacketTagList::operator=(const PacketTagList& o)
 {
+    m_slots = o.m_slots;
     // self assignment
     if (m_next == o.m_next)
     {
         return *this;
     }
-    RemoveAll();
+    RemoveAllFromTree();
     m_next = o.m_next;
     if (m_next != nullptr)
     {
@@ -338,35 +420,73 @@ PacketTagList::operator=(const PacketTagList& o)
 
 PacketTagList::~PacketTagList()
 {
-    RemoveAll();
+    RemoveAllFromTree();
 }
 
 void
 PacketTagList::RemoveAll()
+{
+    for (auto& slot : m_slots)
+    {
+        slot.tid = TypeId();
+    }
+    RemoveAllFromTree();
+}
+
+void
+PacketTagList::FreeTagData(TagData* tag)
+{
+    std::size_t size = sizeof(TagData) + tag->size - 1;
+    tag->~TagData();
+    PacketAllocator::Deallocate(tag, size);
+}
+
+void
+PacketTagList::RemoveAllFromTree()
 {
     TagData* prev = nullptr;
     for (TagData* cur = m_next; cur != nullptr; cur = cur->next)
     {
-        cur->count--;
-        if (cur->count > 0)
+        if (--cur->count > 0)
         {
             break;
         }
         if (prev != nullptr)
         {
-            prev->~TagData();
-            std::free(prev);
+            FreeTagData(prev);
         }
         prev = cur;
     }
     if (prev != nullptr)
     {
-        prev->~TagData();
-        std::free(prev);
+        FreeTagData(prev);
     }
     m_next = nullptr;
 }
 
+const PacketTagList::Slot&
+PacketTagList::GetSlot(uint32_t i) const
+{
+    return m_slots[i];
+}
+
 } // namespace ns3
 
+/**
+ * @ingroup packet
+ * @brief Store the tags of a type in a slot of the PacketTagList.
+ *
+ * Invoke this macro at file scope, in the implementation file of the tag.
+ *
+ * @param [in] type The tag class, without a namespace qualifier.
+ */
+#define NS_PACKET_TAG_SLOT_REGISTER(type)                                                          \
+    static struct PacketTagSlot##type##RegistrationClass                                           \
+    {                                                                                              \
+        PacketTagSlot##type##RegistrationClass()                                                   \
+        {                                                                                          \
+            ns3::PacketTagList::RegisterSlot(type::GetTypeId());                                   \
+        }                                                                                          \
+    } PacketTagSlot##type##RegistrationVariable
+
 #endif /* PACKET_TAG_LIST_H */
@@ -7,6 +7,9 @@
  */
 #include "packet.h"
 
+#include "node.h"
+
+#include "ns3/abort.h"
 #include "ns3/assert.h"
 #include "ns3/log.h"
 #include "ns3/simulator.h"
@@ -19,7 +22,15 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("Packet");
 
-uint32_t Packet::m_globalUid = 0;
+NS3_SIMULATION_LOCAL uint32_t Packet::m_globalUid = 0;
+#ifdef NS3_MTP
+thread_local uint64_t* Packet::m_uidCounter = nullptr;
+#endif
+
+bool Packet::m_enableHeaderCache = false;
+#ifndef NS3_NO_BYTE_TAGS
+bool Packet::m_enableByteTags = true;
+#endif
 
 TypeId
 ByteTagIterator::Item::GetTypeId() const
@@ -78,42 +89,62 @@ ByteTagIterator::ByteTagIterator(ByteTagList::Iterator i)
 {
 }
 
-PacketTagIterator::PacketTagIterator(const PacketTagList::TagData* head)
-    : m_current(head)
+PacketTagIterator::PacketTagIterator(const PacketTagList& list)
+    : m_list(&list),
+      m_slot(0),
+      m_current(list.Head())
 {
+    SkipEmptySlots();
+}
+
+void
+PacketTagIterator::SkipEmptySlots()
+{
+    while (m_slot < PacketTagList::MAX_SLOTS && m_list->GetSlot(m_slot).tid == TypeId())
+    {
+        m_slot++;
+    }
 }
 
 bool
 PacketTagIterator::HasNext() const
 {
-    return m_current != nullptr;
+    return m_slot < PacketTagList::MAX_SLOTS || m_current != nullptr;
 }
 
 PacketTagIterator::Item
 PacketTagIterator::Next()
 {
     NS_ASSERT(HasNext());
+    if (m_slot < PacketTagList::MAX_SLOTS)
+    {
+        const PacketTagList::Slot& slot = m_list->GetSlot(m_slot++);
+        SkipEmptySlots();
+        return PacketTagIterator::Item(slot.tid, slot.data, slot.size);
+    }
     const PacketTagList::TagData* prev = m_current;
     m_current = m_current->next;
-    return PacketTagIterator::Item(prev);
+    return PacketTagIterator::Item(prev->tid, prev->data, prev->size);
 }
 
-PacketTagIterator::Item::Item(const PacketTagList::TagData* data)
-    : m_data(data)
+PacketTagIterator::Item::Item(TypeId tid, const uint8_t* data, uint32_t size)
+    : m_tid(tid),
+      m_data(data),
+      m_size(size)
 {
 }
 
 TypeId
 PacketTagIterator::Item::GetTypeId() const
 {
-    return m_data->tid;
+    return m_tid;
 }
 
 void
 PacketTagIterator::Item::GetTag(Tag& tag) const
 {
-    NS_ASSERT(tag.GetInstanceTypeId() == m_data->tid);
-    tag.Deserialize(TagBuffer((uint8_t*)m_data->data, (uint8_t*)m_data->data + m_data->size));
+    NS_ASSERT(tag.GetInstanceTypeId() == m_tid);
+    tag.Deserialize(TagBuffer((uint8_t*)m_data, (uint8_t*)m_data + m_size));
 }
 
 Ptr<Packet>
@@ -125,6 +156,26 @@ Packet::Copy() const
     return Ptr<Packet>(new Packet(*this), false);
 }
 
+uint64_t
+Packet::NewUid()
+{
+#ifdef NS3_MTP
+    if (m_uidCounter)
+    {
+        return (*m_uidCounter)++;
+    }
+#endif
+    return static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | m_globalUid++;
+}
+
+#ifdef NS3_MTP
+void
+Packet::SetUidCounter(uint64_t* counter)
+{
+    m_uidCounter = counter;
+}
+#endif
+
 Packet::Packet()
     : m_buffer(),
       m_byteTagList(),
@@ -135,10 +186,9 @@ Packet::Packet()
        * zero.  The lower 32 bits are for the
        * global UID
        */
-      m_metadata(static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | m_globalUid, 0),
+      m_metadata(NewUid(), 0),
       m_nixVector(nullptr)
 {
-    m_globalUid++;
 }
 
 Packet::Packet(const Packet& o)
@@ -147,6 +197,12 @@ Packet::Packet(const Packet& o)
       m_packetTagList(o.m_packetTagList),
       m_metadata(o.m_metadata)
 {
+    if (m_enableHeaderCache && !o.m_headerCache)
+    {
+        // created here, so that the original and its copies share it
+        o.m_headerCache = Create<HeaderCache>();
+    }
+    m_headerCache = o.m_headerCache;
     o.m_nixVector ? m_nixVector = o.m_nixVector->Copy() : m_nixVector = nullptr;
 }
 
@@ -161,10 +217,23 @@ Packet::operator=(const Packet& o)
     m_byteTagList = o.m_byteTagList;
     m_packetTagList = o.m_packetTagList;
     m_metadata = o.m_metadata;
+    m_headerCache = o.m_headerCache;
     o.m_nixVector ? m_nixVector = o.m_nixVector->Copy() : m_nixVector = nullptr;
     return *this;
 }
 
+void*
+Packet::operator new(std::size_t size)
+{
+    return PacketAllocator::Allocate(size);
+}
+
+void
+Packet::operator delete(void* block, std::size_t size)
+{
+    PacketAllocator::Deallocate(block, size);
+}
+
 Packet::Packet(uint32_t size)
     : m_buffer(size),
       m_byteTagList(),
@@ -175,10 +244,9 @@ Packet::Packet(uint32_t size)
        * zero.  The lower 32 bits are for the
        * global UID
        */
-      m_metadata(static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | m_globalUid, size),
+      m_metadata(NewUid(), size),
       m_nixVector(nullptr)
 {
-    m_globalUid++;
 }
 
 Packet::Packet(const uint8_t* buffer, uint32_t size, bool magic)
@@ -202,10 +270,9 @@ Packet::Packet(const uint8_t* buffer, uint32_t size)
        * zero.  The lower 32 bits are for the
        * global UID
        */
-      m_metadata(static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | m_globalUid, size),
+      m_metadata(NewUid(), size),
       m_nixVector(nullptr)
 {
-    m_globalUid++;
     m_buffer.AddAtStart(size);
     Buffer::Iterator i = m_buffer.Begin();
     i.Write(buffer, size);
@@ -229,10 +296,13 @@ Packet::CreateFragment(uint32_t start, uint32_t length) const
     NS_LOG_FUNCTION(this << start << length);
     Buffer buffer = m_buffer.CreateFragment(start, length);
     ByteTagList byteTagList = m_byteTagList;
-    byteTagList.Adjust(-start);
+    if (m_enableByteTags)
+    {
+        byteTagList.Adjust(-start);
+    }
     NS_ASSERT(m_buffer.GetSize() >= start + length);
     uint32_t end = m_buffer.GetSize() - (start + length);
-    PacketMetadata metadata = m_metadata.CreateFragment(start, end);
+    PacketMetadata metadata = m_enableByteTags ? m_metadata.CreateFragment(start, end) : m_metadata;
     // again, call the constructor directly rather than
     // through Create because it is private.
     Ptr<Packet> ret =
@@ -257,12 +327,16 @@ void
 Packet::AddHeader(const Header& header)
 {
     uint32_t size = header.GetSerializedSize();
+    m_headerCache = nullptr;
     NS_LOG_FUNCTION(this << header.GetInstanceTypeId().GetName() << size);
     m_buffer.AddAtStart(size);
-    m_byteTagList.Adjust(size);
-    m_byteTagList.AddAtStart(size);
     header.Serialize(m_buffer.Begin());
-    m_metadata.AddHeader(header, size);
+    if (m_enableByteTags)
+    {
+        m_byteTagList.Adjust(size);
+        m_byteTagList.AddAtStart(size);
+        m_metadata.AddHeader(header, size);
+    }
 }
 
 uint32_t
@@ -274,8 +348,11 @@ Packet::RemoveHeader(Header& header, uint32_t size)
     uint32_t deserialized = header.Deserialize(m_buffer.Begin(), end);
     NS_LOG_FUNCTION(this << header.GetInstanceTypeId().GetName() << deserialized);
     m_buffer.RemoveAtStart(deserialized);
-    m_byteTagList.Adjust(-deserialized);
-    m_metadata.RemoveHeader(header, deserialized);
+    if (m_enableByteTags)
+    {
+        m_byteTagList.Adjust(-deserialized);
+        m_metadata.RemoveHeader(header, deserialized);
+    }
     return deserialized;
 }
 
@@ -285,8 +362,11 @@ Packet::RemoveHeader(Header& header)
     uint32_t deserialized = header.Deserialize(m_buffer.Begin());
     NS_LOG_FUNCTION(this << header.GetInstanceTypeId().GetName() << deserialized);
     m_buffer.RemoveAtStart(deserialized);
-    m_byteTagList.Adjust(-deserialized);
-    m_metadata.RemoveHeader(header, deserialized);
+    if (m_enableByteTags)
+    {
+        m_byteTagList.Adjust(-deserialized);
+        m_metadata.RemoveHeader(header, deserialized);
+    }
     return deserialized;
 }
 
@@ -313,21 +393,29 @@ void
 Packet::AddTrailer(const Trailer& trailer)
 {
     uint32_t size = trailer.GetSerializedSize();
+    m_headerCache = nullptr;
     NS_LOG_FUNCTION(this << trailer.GetInstanceTypeId().GetName() << size);
-    m_byteTagList.AddAtEnd(GetSize());
+    if (m_enableByteTags)
+    {
+        m_byteTagList.AddAtEnd(GetSize());
+        m_metadata.AddTrailer(trailer, size);
+    }
     m_buffer.AddAtEnd(size);
     Buffer::Iterator end = m_buffer.End();
     trailer.Serialize(end);
-    m_metadata.AddTrailer(trailer, size);
 }
 
 uint32_t
 Packet::RemoveTrailer(Trailer& trailer)
 {
     uint32_t deserialized = trailer.Deserialize(m_buffer.End());
+    m_headerCache = nullptr;
     NS_LOG_FUNCTION(this << trailer.GetInstanceTypeId().GetName() << deserialized);
     m_buffer.RemoveAtEnd(deserialized);
-    m_metadata.RemoveTrailer(trailer, deserialized);
+    if (m_enableByteTags)
+    {
+        m_metadata.RemoveTrailer(trailer, deserialized);
+    }
     return deserialized;
 }
 
@@ -343,30 +431,42 @@ void
 Packet::AddAtEnd(Ptr<const Packet> packet)
 {
     NS_LOG_FUNCTION(this << packet << packet->GetSize());
-    m_byteTagList.AddAtEnd(GetSize());
-    ByteTagList copy = packet->m_byteTagList;
-    copy.AddAtStart(0);
-    copy.Adjust(GetSize());
-    m_byteTagList.Add(copy);
+    m_headerCache = nullptr;
+    if (m_enableByteTags)
+    {
+        m_byteTagList.AddAtEnd(GetSize());
+        ByteTagList copy = packet->m_byteTagList;
+        copy.AddAtStart(0);
+        copy.Adjust(GetSize());
+        m_byteTagList.Add(copy);
+        m_metadata.AddAtEnd(packet->m_metadata);
+    }
     m_buffer.AddAtEnd(packet->m_buffer);
-    m_metadata.AddAtEnd(packet->m_metadata);
 }
 
 void
 Packet::AddPaddingAtEnd(uint32_t size)
 {
     NS_LOG_FUNCTION(this << size);
-    m_byteTagList.AddAtEnd(GetSize());
+    m_headerCache = nullptr;
+    if (m_enableByteTags)
+    {
+        m_byteTagList.AddAtEnd(GetSize());
+        m_metadata.AddPaddingAtEnd(size);
+    }
     m_buffer.AddAtEnd(size);
-    m_metadata.AddPaddingAtEnd(size);
 }
 
 void
 Packet::RemoveAtEnd(uint32_t size)
 {
     NS_LOG_FUNCTION(this << size);
+    m_headerCache = nullptr;
     m_buffer.RemoveAtEnd(size);
-    m_metadata.RemoveAtEnd(size);
+    if (m_enableByteTags)
+    {
+        m_metadata.RemoveAtEnd(size);
+    }
 }
 
 void
@@ -374,8 +474,11 @@ Packet::RemoveAtStart(uint32_t size)
 {
     NS_LOG_FUNCTION(this << size);
     m_buffer.RemoveAtStart(size);
-    m_byteTagList.Adjust(-size);
-    m_metadata.RemoveAtStart(size);
+    if (m_enableByteTags)
+    {
+        m_byteTagList.Adjust(-size);
+        m_metadata.RemoveAtStart(size);
+    }
 }
 
 void
@@ -585,6 +688,7 @@ void
 Packet::EnablePrinting()
 {
     NS_LOG_FUNCTION_NOARGS();
+    NS_ABORT_MSG_IF(!m_enableByteTags, "The packet metadata is disabled with the byte tags");
     PacketMetadata::Enable();
 }
 
@@ -592,9 +696,59 @@ void
 Packet::EnableChecking()
 {
     NS_LOG_FUNCTION_NOARGS();
+    NS_ABORT_MSG_IF(!m_enableByteTags, "The packet metadata is disabled with the byte tags");
     PacketMetadata::EnableChecking();
 }
 
+void
+Packet::EnableHeaderCache()
+{
+    NS_LOG_FUNCTION_NOARGS();
+#ifdef NS3_MTP
+    NS_FATAL_ERROR("The parsed-header cache is not available with the multithreaded simulator");
+#endif
+    NS_ABORT_MSG_IF(Node::ChecksumEnabled(),
+                    "The parsed-header cache cannot be used with checksums: a header "
+                    "verifies its checksum when it is deserialized");
+    m_enableHeaderCache = true;
+}
+
+void
+Packet::CheckHeaderCache()
+{
+    NS_ABORT_MSG_IF(Node::ChecksumEnabled(),
+                    "The checksums were enabled after the parsed-header cache");
+}
+
+void
+Packet::DisableHeaderCache()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    m_enableHeaderCache = false;
+}
+
+void
+Packet::DisableByteTags()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    NS_ABORT_MSG_IF(PacketMetadata::IsEnabled(),
+                    "The byte tags cannot be disabled once the packet metadata is enabled");
+#ifndef NS3_NO_BYTE_TAGS
+    m_enableByteTags = false;
+#endif
+}
+
+void
+Packet::EnableByteTags()
+{
+    NS_LOG_FUNCTION_NOARGS();
+#ifdef NS3_NO_BYTE_TAGS
+    NS_FATAL_ERROR("The byte tags are compiled out of this build");
+#else
+    m_enableByteTags = true;
+#endif
+}
+
 uint32_t
 Packet::GetSerializedSize() const
 {
@@ -835,6 +989,11 @@ Packet::Deserialize(const uint8_t* buffer, uint32_t size)
         // byte tags not deserialized completely
         return 0;
     }
+    if (!m_enableByteTags)
+    {
+        // the offsets of the byte tags would not be maintained
+        m_byteTagList.RemoveAll();
+    }
     // increment p by byteTagSize ensuring
     // 4-byte boundary
     p += ((((byteTagSize - 4) + 3) & (~3)) / 4);
@@ -904,6 +1063,9 @@ void
 Packet::AddByteTag(const Tag& tag) const
 {
     NS_LOG_FUNCTION(this << tag.GetInstanceTypeId().GetName() << tag.GetSerializedSize());
+    NS_ABORT_MSG_IF(!m_enableByteTags,
+                    "The byte tags are disabled: add " << tag.GetInstanceTypeId().GetName()
+                                                       << " as a packet tag");
     auto list = const_cast<ByteTagList*>(&m_byteTagList);
     TagBuffer buffer = list->Add(tag.GetInstanceTypeId(), tag.GetSerializedSize(), 0, GetSize());
     tag.Serialize(buffer);
@@ -913,6 +1075,9 @@ void
 Packet::AddByteTag(const Tag& tag, uint32_t start, uint32_t end) const
 {
     NS_LOG_FUNCTION(this << tag.GetInstanceTypeId().GetName() << tag.GetSerializedSize());
+    NS_ABORT_MSG_IF(!m_enableByteTags,
+                    "The byte tags are disabled: add " << tag.GetInstanceTypeId().GetName()
+                                                       << " as a packet tag");
     NS_ABORT_MSG_IF(end < start, "Invalid byte range");
     auto list = const_cast<ByteTagList*>(&m_byteTagList);
     TagBuffer buffer = list->Add(tag.GetInstanceTypeId(),
@@ -931,6 +1096,10 @@ Packet::GetByteTagIterator() const
 bool
 Packet::FindFirstMatchingByteTag(Tag& tag) const
 {
+    if (!m_enableByteTags)
+    {
+        return false;
+    }
     TypeId tid = tag.GetInstanceTypeId();
     ByteTagIterator i = GetByteTagIterator();
     while (i.HasNext())
@@ -1008,7 +1177,7 @@ Packet::PrintPacketTags(std::ostream& os) const
 PacketTagIterator
 Packet::GetPacketTagIterator() const
 {
-    return PacketTagIterator(m_packetTagList.Head());
+    return PacketTagIterator(m_packetTagList);
 }
 
 std::ostream&
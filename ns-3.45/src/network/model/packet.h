@@ -10,8 +10,10 @@
 
 #include "buffer.h"
 #include "byte-tag-list.h"
+#include "header-cache.h"
 #include "header.h"
 #include "nix-vector.h"
+#include "packet-allocator.h"
 #include "packet-metadata.h"
 #include "packet-tag-list.h"
 #include "tag.h"
@@ -22,6 +24,7 @@
 #include "ns3/mac48-address.h"
 #include "ns3/ptr.h"
 
+#include <concepts>
 #include <stdint.h>
 
 namespace ns3
@@ -35,6 +38,20 @@ class Address;
  * @defgroup packet Packet
  */
 
+/**
+ * @ingroup packet
+ * @brief A header which the parsed-header cache can store.
+ *
+ * The cache identifies a header of type T by T::GetTypeId(), so T must be
+ * copyable and declare its own type identity, rather than inherit the one
+ * of its base class: another header derived from the same base would find
+ * it in the cache. The other headers are never cached.
+ */
+template <typename T>
+concept CacheableHeader =
+    std::derived_from<T, Header> && std::copyable<T> &&
+    std::same_as<decltype(&T::GetInstanceTypeId), TypeId (T::*)() const>;
+
 /**
  * @ingroup packet
  * @brief Iterator over the set of byte tags in a packet
@@ -149,10 +166,14 @@ class PacketTagIterator
         friend class PacketTagIterator;
         /**
          * Constructor
-         * @param data the data to copy.
+         * @param tid the type of the tag.
+         * @param data the serialized tag.
+         * @param size the size of the serialized tag.
          */
-        Item(const PacketTagList::TagData* data);
-        const PacketTagList::TagData* m_data; //!< the tag data
+        Item(TypeId tid, const uint8_t* data, uint32_t size);
+        TypeId m_tid;          //!< the type of the tag
+        const uint8_t* m_data; //!< the serialized tag
+        uint32_t m_size;       //!< the size of the serialized tag
     };
 
     /**
@@ -169,9 +190,15 @@ class PacketTagIterator
     friend class Packet;
     /**
      * Constructor
-     * @param head head of the items
+     * @param list the tags, in slots then in the list starting at its head
+     */
+    PacketTagIterator(const PacketTagList& list);
+    /**
+     * Move to the first slot holding a tag, starting from m_slot.
      */
-    PacketTagIterator(const PacketTagList::TagData* head);
+    void SkipEmptySlots();
+    const PacketTagList* m_list;             //!< the tags of the packet
+    uint32_t m_slot;                         //!< actual position over the slots of the tags
     const PacketTagList::TagData* m_current; //!< actual position over the set of tags in a packet
 };
 
@@ -243,6 +270,18 @@ class Packet : public SimpleRefCount<Packet>
      * @return the copied object
      */
     Packet& operator=(const Packet& o);
+    /**
+     * @brief Allocate a packet from the PacketAllocator.
+     * @param size the size of a packet
+     * @returns the memory
+     */
+    static void* operator new(std::size_t size);
+    /**
+     * @brief Release a packet to the PacketAllocator.
+     * @param block the memory
+     * @param size the size of a packet
+     */
+    static void operator delete(void* block, std::size_t size);
     /**
      * @brief Create a packet with a zero-filled payload.
      *
@@ -351,6 +390,38 @@ class Packet : public SimpleRefCount<Packet>
      * @returns the number of bytes read from the packet.
      */
     uint32_t PeekHeader(Header& header, uint32_t size) const;
+    /**
+     * @brief Deserialize and remove the header from the internal buffer, or
+     * copy it from the parsed-header cache.
+     *
+     * Once EnableHeaderCache is called, a header already peeked at by this
+     * packet or by its copies is copied from the cache instead of
+     * deserialized again, overwriting all the state of \p header.
+     * Otherwise, this is RemoveHeader(Header&).
+     *
+     * @tparam T \deduced the type of the header, a CacheableHeader
+     * @param header a reference to the header to remove from the internal buffer.
+     * @returns the number of bytes removed from the packet.
+     */
+    template <typename T>
+        requires CacheableHeader<T>
+    uint32_t RemoveHeader(T& header);
+    /**
+     * @brief Deserialize but does _not_ remove the header from the internal
+     * buffer, or copy it from the parsed-header cache.
+     *
+     * Once EnableHeaderCache is called, a header of a given type is only
+     * deserialized once from the same bytes, by this packet or by its
+     * copies, and the next reads copy it, overwriting all the state of
+     * \p header. Otherwise, this is PeekHeader(Header&).
+     *
+     * @tparam T \deduced the type of the header, a CacheableHeader
+     * @param header a reference to the header to read from the internal buffer.
+     * @returns the number of bytes read from the packet.
+     */
+    template <typename T>
+        requires CacheableHeader<T>
+    uint32_t PeekHeader(T& header) const;
     /**
      * @brief Add trailer to this packet.
      *
@@ -525,6 +596,78 @@ class Packet : public SimpleRefCount<Packet>
      * errors will be detected and will abort the program.
      */
     static void EnableChecking();
+    /**
+     * @brief Enable the parsed-header cache.
+     *
+     * A packet then keeps the headers it deserializes with PeekHeader,
+     * keyed by their TypeId and their offset from the end of the buffer,
+     * and shares them with its copies. A cached header is copied instead
+     * of deserialized again by PeekHeader and RemoveHeader, e.g., when
+     * several layers of a node, or several copies of a packet, each peek
+     * at its IP header, then one of them removes it. A
+     * packet drops its cache when it is modified other than by removing
+     * bytes at its start.
+     *
+     * The cache assumes that a header only depends on its bytes: a header
+     * whose Deserialize depends on the state of the object it deserializes
+     * into should be read with PeekHeader(Header&). This is the case of
+     * checksums, which a header verifies when it is deserialized: the
+     * cache cannot be enabled with the ChecksumEnabled global value, nor
+     * can the value be set afterwards, which builds with asserts check on
+     * each use of the cache. It is not available with the multithreaded
+     * simulator either, where copies of a packet may be read concurrently.
+     *
+     * On a cache hit, the whole header object is assigned from the cached
+     * copy: any state the caller set on the header before the call, and
+     * which Deserialize would have left alone, is overwritten with that of
+     * the header which was first deserialized.
+     */
+    static void EnableHeaderCache();
+    /**
+     * @brief Disable the parsed-header cache, e.g., at the end of a test.
+     */
+    static void DisableHeaderCache();
+    /**
+     * @brief Disable the byte tags, and keep the packet metadata disabled.
+     *
+     * The packets then skip the byte-tag and metadata bookkeeping of their
+     * header, trailer, padding and fragment operations. They carry no byte
+     * tag: AddByteTag aborts, and FindFirstMatchingByteTag finds nothing.
+     * FlowMonitor and DelayJitterEstimation tag their packets with packet
+     * tags instead. EnablePrinting and EnableChecking abort, which makes
+     * this mode unavailable with the ASCII traces and the animations.
+     *
+     * Call it before the packets with byte tags are created. The builds
+     * configured with --disable-byte-tags always run in this mode, and
+     * compile the bookkeeping out.
+     */
+    static void DisableByteTags();
+    /**
+     * @brief Enable the byte tags again, e.g., at the end of a test.
+     *
+     * The packets created while the byte tags were disabled must have been
+     * released. It aborts in the builds without byte tags.
+     */
+    static void EnableByteTags();
+    /**
+     * @brief Check whether the packets carry byte tags.
+     * @returns false after DisableByteTags, and in the builds without byte tags
+     */
+    static inline bool ByteTagsEnabled();
+#ifdef NS3_MTP
+    /**
+     * @brief Set the counter of the uids of the packets created by the
+     * calling thread.
+     *
+     * The multithreaded simulator gives each logical process its own range
+     * of uids, so that the uids do not depend on the order in which the
+     * threads run. The packets created without a counter, e.g., by the
+     * simulation program, are numbered by the global counter.
+     *
+     * @param [in] counter the next uid, or nullptr for the global counter
+     */
+    static void SetUidCounter(uint64_t* counter);
+#endif
 
     /**
      * @brief Returns number of bytes required for packet
@@ -625,6 +768,10 @@ class Packet : public SimpleRefCount<Packet>
      * Note that this method is const, that is, it does not
      * modify the state of this packet, which is fairly
      * un-intuitive.  See AddByteTag"()" discussion.
+     *
+     * The tags whose type is registered with NS_PACKET_TAG_SLOT_REGISTER
+     * are stored in slots embedded in the packet, which avoids a memory
+     * allocation per tag.
      */
     void AddPacketTag(const Tag& tag) const;
     /**
@@ -776,6 +923,12 @@ class Packet : public SimpleRefCount<Packet>
      */
     uint32_t Deserialize(const uint8_t* buffer, uint32_t size);
 
+    /**
+     * @brief Allocate the uid of a new packet.
+     * @returns the uid
+     */
+    static uint64_t NewUid();
+
     Buffer m_buffer;               //!< the packet buffer (it's actual contents)
     ByteTagList m_byteTagList;     //!< the ByteTag list
     PacketTagList m_packetTagList; //!< the packet's Tag list
@@ -784,7 +937,25 @@ class Packet : public SimpleRefCount<Packet>
     /* Please see comments above about nix-vector */
     mutable Ptr<NixVector> m_nixVector; //!< the packet's Nix vector
 
-    static uint32_t m_globalUid; //!< Global counter of packets Uid
+    /**
+     * Check that the checksums were not enabled after the parsed-header
+     * cache: a header copied from the cache does not verify its checksum.
+     */
+    static void CheckHeaderCache();
+
+    mutable Ptr<HeaderCache> m_headerCache; //!< the headers deserialized, shared by copies
+    static bool m_enableHeaderCache;        //!< Enable the parsed-header cache
+
+#ifdef NS3_NO_BYTE_TAGS
+    static constexpr bool m_enableByteTags = false; //!< The byte tags are compiled out
+#else
+    static bool m_enableByteTags; //!< Enable the byte tags and the packet metadata
+#endif
+
+    static NS3_SIMULATION_LOCAL uint32_t m_globalUid; //!< Global counter of packets Uid
+#ifdef NS3_MTP
+    static thread_local uint64_t* m_uidCounter; //!< Uid counter of the calling thread, if any
+#endif
 };
 
 /**
@@ -852,6 +1023,67 @@ Packet::GetSize() const
     return m_buffer.GetSize();
 }
 
+bool
+Packet::ByteTagsEnabled()
+{
+    return m_enableByteTags;
+}
+
+template <typename T>
+    requires CacheableHeader<T>
+uint32_t
+Packet::RemoveHeader(T& header)
+{
+    if (m_enableHeaderCache && m_headerCache)
+    {
+#ifdef NS3_ASSERT_ENABLE
+        CheckHeaderCache();
+#endif
+        if (const HeaderCache::Entry* entry = m_headerCache->Find(T::GetTypeId(), GetSize()))
+        {
+            header = static_cast<const T&>(*entry->header);
+            m_buffer.RemoveAtStart(entry->size);
+            if (m_enableByteTags)
+            {
+                m_byteTagList.Adjust(-entry->size);
+                m_metadata.RemoveHeader(header, entry->size);
+            }
+            return entry->size;
+        }
+    }
+    return RemoveHeader(static_cast<Header&>(header));
+}
+
+template <typename T>
+    requires CacheableHeader<T>
+uint32_t
+Packet::PeekHeader(T& header) const
+{
+    if (!m_enableHeaderCache)
+    {
+        return PeekHeader(static_cast<Header&>(header));
+    }
+#ifdef NS3_ASSERT_ENABLE
+    CheckHeaderCache();
+#endif
+    TypeId tid = T::GetTypeId();
+    if (!m_headerCache)
+    {
+        m_headerCache = Create<HeaderCache>();
+    }
+    else if (const HeaderCache::Entry* entry = m_headerCache->Find(tid, GetSize()))
+    {
+        header = static_cast<const T&>(*entry->header);
+        return entry->size;
+    }
+    uint32_t deserialized = PeekHeader(static_cast<Header&>(header));
+    NS_ASSERT_MSG(header.GetInstanceTypeId() == tid,
+                  "The header " << header.GetInstanceTypeId().GetName()
+                                << " must declare its own GetTypeId to be cached");
+    m_headerCache->Insert(tid, GetSize(), deserialized, header);
+    return deserialized;
+}
+
 } // namespace ns3
 
 #endif /* PACKET_H */
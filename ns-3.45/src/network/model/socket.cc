@@ -851,6 +851,9 @@ SocketPriorityTag::GetPriority() const
     return m_priority;
 }
 
+// the priority is read by the traffic control layer of every hop
+NS_PACKET_TAG_SLOT_REGISTER(SocketPriorityTag);
+
 TypeId
 SocketPriorityTag::GetTypeId()
 {
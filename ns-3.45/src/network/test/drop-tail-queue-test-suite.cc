@@ -5,9 +5,12 @@
  */
 
 #include "ns3/drop-tail-queue.h"
+#include "ns3/ring-buffer.h"
 #include "ns3/string.h"
 #include "ns3/test.h"
 
+#include <list>
+
 using namespace ns3;
 
 /**
@@ -15,23 +18,32 @@ using namespace ns3;
  * @ingroup tests
  *
  * DropTailQueue unit tests.
+ *
+ * @tparam Container \explicit The container of the packets.
  */
+template <typename Container>
 class DropTailQueueTestCase : public TestCase
 {
   public:
-    DropTailQueueTestCase();
+    /**
+     * Constructor.
+     * @param name The name of the test case.
+     */
+    DropTailQueueTestCase(const std::string& name);
     void DoRun() override;
 };
 
-DropTailQueueTestCase::DropTailQueueTestCase()
-    : TestCase("Sanity check on the drop tail queue implementation")
+template <typename Container>
+DropTailQueueTestCase<Container>::DropTailQueueTestCase(const std::string& name)
+    : TestCase(name)
 {
 }
 
+template <typename Container>
 void
-DropTailQueueTestCase::DoRun()
+DropTailQueueTestCase<Container>::DoRun()
 {
-    Ptr<DropTailQueue<Packet>> queue = CreateObject<DropTailQueue<Packet>>();
+    auto queue = CreateObject<DropTailQueue<Packet, Container>>();
     NS_TEST_EXPECT_MSG_EQ(queue->SetAttributeFailSafe("MaxSize", StringValue("3p")),
                           true,
                           "Verify that we can actually set the attribute");
@@ -76,6 +88,80 @@ DropTailQueueTestCase::DoRun()
     NS_TEST_EXPECT_MSG_EQ(packet, nullptr, "There are really no packets in there");
 }
 
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * RingBuffer unit tests: the container behaves as a std::list when it
+ * wraps around and grows.
+ */
+class RingBufferTestCase : public TestCase
+{
+  public:
+    RingBufferTestCase();
+    void DoRun() override;
+};
+
+RingBufferTestCase::RingBufferTestCase()
+    : TestCase("Check the ring buffer container against std::list")
+{
+}
+
+void
+RingBufferTestCase::DoRun()
+{
+    RingBuffer<int> ring;
+    std::list<int> list;
+    auto check = [&](const std::string& step) {
+        NS_TEST_ASSERT_MSG_EQ(ring.size(), list.size(), "Size after " << step);
+        NS_TEST_ASSERT_MSG_EQ(std::equal(ring.begin(), ring.end(), list.begin()),
+                              true,
+                              "Elements after " << step);
+    };
+
+    // a FIFO which wraps around, growing to hold 5 elements
+    int value = 0;
+    for (int i = 0; i < 40; i++)
+    {
+        ring.insert(ring.end(), value);
+        list.push_back(value++);
+        if (i % 3 == 0 || list.size() == 5)
+        {
+            ring.erase(ring.begin());
+            list.pop_front();
+        }
+        check("a FIFO operation");
+    }
+    NS_TEST_EXPECT_MSG_EQ(ring.capacity(), 8, "The buffer grows to a power of two");
+
+    // insertions and erasures in the middle, near either end
+    for (std::size_t pos : {1, 3, 0, 4, 2})
+    {
+        auto rit = ring.begin();
+        auto lit = list.begin();
+        std::advance(rit, pos);
+        std::advance(lit, pos);
+        NS_TEST_EXPECT_MSG_EQ(*ring.insert(rit, value), value, "The inserted element");
+        list.insert(lit, value++);
+        check("an insertion");
+    }
+    for (std::size_t pos : {2, 0, 5, 1})
+    {
+        auto rit = ring.begin();
+        auto lit = list.begin();
+        std::advance(rit, pos);
+        std::advance(lit, pos);
+        rit = ring.erase(rit);
+        lit = list.erase(lit);
+        NS_TEST_EXPECT_MSG_EQ(*rit, *lit, "The element after the erased one");
+        check("an erasure");
+    }
+
+    ring.clear();
+    list.clear();
+    check("clear");
+}
+
 /**
  * @ingroup network-test
  * @ingroup tests
@@ -88,7 +174,13 @@ class DropTailQueueTestSuite : public TestSuite
     DropTailQueueTestSuite()
         : TestSuite("drop-tail-queue", Type::UNIT)
     {
-        AddTestCase(new DropTailQueueTestCase(), TestCase::Duration::QUICK);
+        AddTestCase(new DropTailQueueTestCase<std::list<Ptr<Packet>>>(
+                        "Sanity check on the drop tail queue implementation"),
+                    TestCase::Duration::QUICK);
+        AddTestCase(new DropTailQueueTestCase<PacketRingBuffer>(
+                        "Sanity check on the drop tail queue implementation, with a ring buffer"),
+                    TestCase::Duration::QUICK);
+        AddTestCase(new RingBufferTestCase(), TestCase::Duration::QUICK);
     }
 };
 
@@ -5,6 +5,7 @@
  *
  * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
  */
+#include "ns3/packet-allocator.h"
 #include "ns3/packet-tag-list.h"
 #include "ns3/packet.h"
 #include "ns3/test.h"
@@ -15,6 +16,7 @@
 #include <iostream>
 #include <limits> // std:numeric_limits
 #include <string>
+#include <vector>
 
 using namespace ns3;
 
@@ -441,6 +443,74 @@ class ATestTrailer : public ATestTrailerBase
     }
 };
 
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * @brief Test header which counts its deserializations
+ *
+ * @note Class internal to packet-test-suite.cc
+ */
+class ACountedTestHeader : public Header
+{
+  public:
+    /**
+     * Constructor
+     * @param value The value carried by the header
+     */
+    ACountedTestHeader(uint16_t value = 0)
+        : m_value(value)
+    {
+    }
+
+    /**
+     * Register this type.
+     * @return The TypeId.
+     */
+    static TypeId GetTypeId()
+    {
+        static TypeId tid = TypeId("anon::ACountedTestHeader")
+                                .SetParent<Header>()
+                                .SetGroupName("Network")
+                                .HideFromDocumentation()
+                                .AddConstructor<ACountedTestHeader>();
+        return tid;
+    }
+
+    TypeId GetInstanceTypeId() const override
+    {
+        return GetTypeId();
+    }
+
+    uint32_t GetSerializedSize() const override
+    {
+        return 2;
+    }
+
+    void Serialize(Buffer::Iterator iter) const override
+    {
+        iter.WriteHtonU16(m_value);
+    }
+
+    uint32_t Deserialize(Buffer::Iterator iter) override
+    {
+        m_deserializations++;
+        m_value = iter.ReadNtohU16();
+        return 2;
+    }
+
+    void Print(std::ostream& os) const override
+    {
+        os << "value=" << m_value;
+    }
+
+    uint16_t m_value;                   //!< The value carried by the header
+    bool m_caller{false};               //!< A state set by the caller, not serialized
+    static uint32_t m_deserializations; //!< The number of deserializations
+};
+
+uint32_t ACountedTestHeader::m_deserializations = 0;
+
 /**
  * @ingroup network-test
  * @ingroup tests
@@ -1257,6 +1327,281 @@ PacketTagListTest::DoRun()
     }
 }
 
+#ifndef NS3_MTP
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * Parsed-header cache unit tests.
+ */
+class PacketHeaderCacheTest : public TestCase
+{
+  public:
+    PacketHeaderCacheTest();
+    void DoRun() override;
+};
+
+PacketHeaderCacheTest::PacketHeaderCacheTest()
+    : TestCase("Check the parsed-header cache")
+{
+}
+
+void
+PacketHeaderCacheTest::DoRun()
+{
+    Packet::EnableHeaderCache();
+    uint32_t& count = ACountedTestHeader::m_deserializations;
+    count = 0;
+
+    Ptr<Packet> p = Create<Packet>(100);
+    p->AddHeader(ACountedTestHeader(7));
+    p->AddHeader(ATestHeader<3>());
+
+    // the copies of a packet share the headers deserialized by any of them
+    ATestHeader<3> outer;
+    ACountedTestHeader header;
+    Ptr<Packet> c1 = p->Copy();
+    c1->RemoveHeader(outer);
+    NS_TEST_EXPECT_MSG_EQ(c1->PeekHeader(header), 2, "Size of the header");
+    NS_TEST_EXPECT_MSG_EQ(header.m_value, 7, "Value of the header");
+    NS_TEST_EXPECT_MSG_EQ(count, 1, "First peek deserializes the header");
+    Ptr<Packet> c2 = p->Copy();
+    c2->RemoveHeader(outer);
+    header.m_value = 0;
+    NS_TEST_EXPECT_MSG_EQ(c2->PeekHeader(header), 2, "Size of the cached header");
+    NS_TEST_EXPECT_MSG_EQ(header.m_value, 7, "Value of the cached header");
+    NS_TEST_EXPECT_MSG_EQ(count, 1, "Peek at a copy uses the cache");
+    header.m_value = 0;
+    NS_TEST_EXPECT_MSG_EQ(c2->RemoveHeader(header), 2, "Size of the removed header");
+    NS_TEST_EXPECT_MSG_EQ(header.m_value, 7, "Value of the removed header");
+    NS_TEST_EXPECT_MSG_EQ(c2->GetSize(), 100, "Size of the packet after the removal");
+    NS_TEST_EXPECT_MSG_EQ(count, 1, "Removal uses the cache");
+
+    // adding a header drops the cache of that packet only
+    c2->AddHeader(ACountedTestHeader(9));
+    NS_TEST_EXPECT_MSG_EQ(c2->PeekHeader(header), 2, "Size of the new header");
+    NS_TEST_EXPECT_MSG_EQ(header.m_value, 9, "Value of the new header");
+    NS_TEST_EXPECT_MSG_EQ(count, 2, "New header is deserialized");
+    c1->PeekHeader(header);
+    NS_TEST_EXPECT_MSG_EQ(header.m_value, 7, "Value of the header of the other copy");
+    NS_TEST_EXPECT_MSG_EQ(count, 2, "Other copy keeps the cache");
+
+    // so does a change at the end
+    c1->AddPaddingAtEnd(10);
+    c1->PeekHeader(header);
+    NS_TEST_EXPECT_MSG_EQ(header.m_value, 7, "Value of the header after the padding");
+    NS_TEST_EXPECT_MSG_EQ(count, 3, "Padding drops the cache");
+
+    // a header read through its base class is not cached
+    c1->PeekHeader(static_cast<Header&>(header));
+    NS_TEST_EXPECT_MSG_EQ(count, 4, "Peek through the base class deserializes the header");
+
+    // a hit overwrites the state set by the caller along with the bytes
+    header.m_caller = true;
+    c1->PeekHeader(header);
+    NS_TEST_EXPECT_MSG_EQ(count, 4, "Peek uses the cache");
+    NS_TEST_EXPECT_MSG_EQ(header.m_caller, false, "A hit overwrites the state of the caller");
+
+    Packet::DisableHeaderCache();
+    c1->PeekHeader(header);
+    NS_TEST_EXPECT_MSG_EQ(count, 5, "Disabled cache");
+}
+#endif /* NS3_MTP */
+
+/// Test tag stored in a slot of the PacketTagList
+using ASlotTestTag = ATestTag<15>;
+/// Test tag registered for a slot, but too large to be stored in it
+using ALargeSlotTestTag = ATestTag<30>;
+
+NS_PACKET_TAG_SLOT_REGISTER(ASlotTestTag);
+NS_PACKET_TAG_SLOT_REGISTER(ALargeSlotTestTag);
+
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * Packet tag slots unit tests.
+ */
+class PacketTagSlotTest : public TestCase
+{
+  public:
+    PacketTagSlotTest();
+    void DoRun() override;
+};
+
+PacketTagSlotTest::PacketTagSlotTest()
+    : TestCase("Check the packet tags stored in slots")
+{
+}
+
+void
+PacketTagSlotTest::DoRun()
+{
+    Ptr<Packet> p = Create<Packet>(100);
+    p->AddPacketTag(ASlotTestTag(1));
+    p->AddPacketTag(ATestTag<1>(2));
+
+    // a copy modifies its slots without affecting the original
+    ASlotTestTag tag(3);
+    Ptr<Packet> c = p->Copy();
+    NS_TEST_EXPECT_MSG_EQ(c->ReplacePacketTag(tag), true, "Replace");
+    NS_TEST_EXPECT_MSG_EQ(p->PeekPacketTag(tag), true, "Peek at the original");
+    NS_TEST_EXPECT_MSG_EQ(tag.GetData(), 1, "Value in the original");
+    NS_TEST_EXPECT_MSG_EQ(c->PeekPacketTag(tag), true, "Peek at the copy");
+    NS_TEST_EXPECT_MSG_EQ(tag.GetData(), 3, "Value in the copy");
+    NS_TEST_EXPECT_MSG_EQ(tag.m_error, false, "Serialization of the tag");
+
+    // the iterator visits the slots, then the list
+    PacketTagIterator i = p->GetPacketTagIterator();
+    NS_TEST_ASSERT_MSG_EQ(i.HasNext(), true, "First tag");
+    NS_TEST_EXPECT_MSG_EQ(i.Next().GetTypeId(), ASlotTestTag::GetTypeId(), "Tag in the slot");
+    NS_TEST_ASSERT_MSG_EQ(i.HasNext(), true, "Second tag");
+    NS_TEST_EXPECT_MSG_EQ(i.Next().GetTypeId(), ATestTag<1>::GetTypeId(), "Tag in the list");
+    NS_TEST_EXPECT_MSG_EQ(i.HasNext(), false, "No other tag");
+
+    NS_TEST_EXPECT_MSG_EQ(p->RemovePacketTag(tag), true, "Remove");
+    NS_TEST_EXPECT_MSG_EQ(tag.GetData(), 1, "Value removed");
+    NS_TEST_EXPECT_MSG_EQ(p->PeekPacketTag(tag), false, "Tag removed");
+    NS_TEST_EXPECT_MSG_EQ(c->PeekPacketTag(tag), true, "Tag of the copy kept");
+
+    // a tag too large for its slot is stored in the list
+    p->AddPacketTag(ALargeSlotTestTag(4));
+    ALargeSlotTestTag large(5);
+    NS_TEST_EXPECT_MSG_EQ(p->ReplacePacketTag(large), true, "Replace the large tag");
+    NS_TEST_EXPECT_MSG_EQ(p->PeekPacketTag(large), true, "Peek at the large tag");
+    NS_TEST_EXPECT_MSG_EQ(large.GetData(), 5, "Value of the large tag");
+    NS_TEST_EXPECT_MSG_EQ(large.m_error, false, "Serialization of the large tag");
+
+    // the tags in slots are serialized with the packet
+    uint32_t serializedSize = c->GetSerializedSize();
+    std::vector<uint8_t> buffer(serializedSize);
+    c->Serialize(buffer.data(), serializedSize);
+    Ptr<Packet> d = Create<Packet>(buffer.data(), serializedSize, true);
+    NS_TEST_EXPECT_MSG_EQ(d->PeekPacketTag(tag), true, "Peek at the deserialized packet");
+    NS_TEST_EXPECT_MSG_EQ(tag.GetData(), 3, "Value in the deserialized packet");
+    NS_TEST_EXPECT_MSG_EQ(tag.m_error, false, "Deserialization of the tag");
+    ATestTag<1> other;
+    NS_TEST_EXPECT_MSG_EQ(d->PeekPacketTag(other), true, "Tag of the list deserialized");
+    NS_TEST_EXPECT_MSG_EQ(other.GetData(), 2, "Value of the tag of the list");
+
+    d->RemoveAllPacketTags();
+    NS_TEST_EXPECT_MSG_EQ(d->GetPacketTagIterator().HasNext(), false, "All tags removed");
+}
+
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * Packets without byte tags unit tests.
+ */
+class PacketNoByteTagsTest : public TestCase
+{
+  public:
+    PacketNoByteTagsTest();
+    void DoRun() override;
+};
+
+PacketNoByteTagsTest::PacketNoByteTagsTest()
+    : TestCase("Check the packets without byte tags")
+{
+}
+
+void
+PacketNoByteTagsTest::DoRun()
+{
+    Packet::DisableByteTags();
+    NS_TEST_EXPECT_MSG_EQ(Packet::ByteTagsEnabled(), false, "Byte tags disabled");
+
+    Ptr<Packet> p = Create<Packet>(100);
+    p->AddPacketTag(ATestTag<1>(6));
+    p->AddHeader(ATestHeader<10>());
+    p->AddTrailer(ATestTrailer<4>());
+    NS_TEST_EXPECT_MSG_EQ(p->GetSize(), 114, "Size with the header and the trailer");
+
+    // the fragments keep their bytes and the packet tags
+    Ptr<Packet> first = p->CreateFragment(0, 60);
+    Ptr<Packet> second = p->CreateFragment(60, 54);
+    ATestTag<1> tag;
+    NS_TEST_EXPECT_MSG_EQ(second->PeekPacketTag(tag), true, "Packet tag of the fragment");
+    NS_TEST_EXPECT_MSG_EQ(tag.GetData(), 6, "Value of the packet tag");
+    first->AddAtEnd(second);
+    first->AddPaddingAtEnd(6);
+    first->RemoveAtEnd(6);
+    NS_TEST_EXPECT_MSG_EQ(first->GetSize(), 114, "Size of the reassembled packet");
+    ATestHeader<10> header;
+    first->RemoveHeader(header);
+    NS_TEST_EXPECT_MSG_EQ(header.m_error, false, "Header of the reassembled packet");
+    ATestTrailer<4> trailer;
+    first->RemoveTrailer(trailer);
+    NS_TEST_EXPECT_MSG_EQ(trailer.m_error, false, "Trailer of the reassembled packet");
+    first->RemoveAtStart(50);
+    NS_TEST_EXPECT_MSG_EQ(first->GetSize(), 50, "Size of the payload left");
+
+    // no byte tag is found
+    NS_TEST_EXPECT_MSG_EQ(first->FindFirstMatchingByteTag(tag), false, "No byte tag");
+    NS_TEST_EXPECT_MSG_EQ(first->GetByteTagIterator().HasNext(), false, "Empty byte tag list");
+
+    p = nullptr;
+    first = nullptr;
+    second = nullptr;
+#ifndef NS3_NO_BYTE_TAGS
+    Packet::EnableByteTags();
+    NS_TEST_EXPECT_MSG_EQ(Packet::ByteTagsEnabled(), true, "Byte tags enabled");
+#endif
+}
+
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * Packet allocator unit tests.
+ */
+class PacketAllocatorTest : public TestCase
+{
+  public:
+    PacketAllocatorTest();
+    void DoRun() override;
+};
+
+PacketAllocatorTest::PacketAllocatorTest()
+    : TestCase("Check the reuse of the blocks of the packet allocator")
+{
+}
+
+void
+PacketAllocatorTest::DoRun()
+{
+    // a block is reused by the next allocation of its size class
+    void* block = PacketAllocator::Allocate(40);
+    PacketAllocator::Deallocate(block, 40);
+    NS_TEST_EXPECT_MSG_EQ(PacketAllocator::Allocate(33), block, "Same class");
+    void* other = PacketAllocator::Allocate(49);
+    NS_TEST_EXPECT_MSG_NE(other, block, "Other class");
+    PacketAllocator::Deallocate(block, 33);
+    PacketAllocator::Deallocate(other, 49);
+
+    // the packets come from the allocator
+    Ptr<Packet> p = Create<Packet>(100);
+    p->AddPacketTag(ATestTag<1>(1));
+    const Packet* released = PeekPointer(p);
+    p = nullptr;
+    p = Create<Packet>(100);
+    NS_TEST_EXPECT_MSG_EQ(PeekPointer(p), released, "Packet reused");
+    NS_TEST_EXPECT_MSG_EQ(p->GetPacketTagIterator().HasNext(), false, "No tag left");
+
+    // the blocks larger than the classes go to the general allocator
+    block = PacketAllocator::Allocate(PacketAllocator::MAX_SIZE + 1);
+    PacketAllocator::Deallocate(block, PacketAllocator::MAX_SIZE + 1);
+
+    // without a cache, the blocks are released
+    uint32_t cacheSize = PacketAllocator::GetCacheSize();
+    PacketAllocator::SetCacheSize(0);
+    block = PacketAllocator::Allocate(24);
+    PacketAllocator::Deallocate(block, 24);
+    PacketAllocator::SetCacheSize(cacheSize);
+    NS_TEST_EXPECT_MSG_EQ(PacketAllocator::GetCacheSize(), cacheSize, "Cache size restored");
+}
+
 /**
  * @ingroup network-test
  * @ingroup tests
@@ -1274,6 +1619,12 @@ PacketTestSuite::PacketTestSuite()
 {
     AddTestCase(new PacketTest, TestCase::Duration::QUICK);
     AddTestCase(new PacketTagListTest, TestCase::Duration::QUICK);
+#ifndef NS3_MTP
+    AddTestCase(new PacketHeaderCacheTest, TestCase::Duration::QUICK);
+#endif
+    AddTestCase(new PacketTagSlotTest, TestCase::Duration::QUICK);
+    AddTestCase(new PacketAllocatorTest, TestCase::Duration::QUICK);
+    AddTestCase(new PacketNoByteTagsTest, TestCase::Duration::QUICK);
 }
 
 static PacketTestSuite g_packetTestSuite; //!< Static variable for test initialization
@@ -4,9 +4,13 @@
  * Author:  Craig Dowell (craigdo@ee.washington.edu)
  */
 
+#include "ns3/callback.h"
 #include "ns3/log.h"
+#include "ns3/packet.h"
+#include "ns3/pcap-file-wrapper.h"
 #include "ns3/pcap-file.h"
 #include "ns3/test.h"
+#include "ns3/uinteger.h"
 
 #include <cstdio>
 #include <cstdlib>
@@ -1364,6 +1368,155 @@ DiffTestCase::DoRun()
     NS_TEST_EXPECT_MSG_EQ(usec, 3696, "Files are different from 2.3696 seconds");
 }
 
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * @brief Test case to make sure that the packets written through a write
+ * buffer and the writer thread give the same file as the synchronous writes,
+ * also when several buffered files share the writer thread.
+ */
+class WriteBufferTestCase : public TestCase
+{
+  public:
+    WriteBufferTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+WriteBufferTestCase::WriteBufferTestCase()
+    : TestCase("Check that PcapFile::SetWriteBuffer writes the same file")
+{
+}
+
+void
+WriteBufferTestCase::DoRun()
+{
+    std::string filename = CreateTempDirFilename("synchronous.pcap");
+    std::string filename2 = CreateTempDirFilename("buffered.pcap");
+    std::string filename3 = CreateTempDirFilename("buffered2.pcap");
+
+    // buffers smaller than a record (16 + 32 bytes), so that the records
+    // are split between the buffers handed to the writer thread
+    uint32_t snapLen = sizeof(knownPackets[0].data);
+    PcapFile files[3];
+    files[0].Open(filename, std::ios::out);
+    files[1].Open(filename2, std::ios::out);
+    files[2].Open(filename3, std::ios::out);
+    for (uint32_t j = 0; j < 3; ++j)
+    {
+        files[j].Init(1, snapLen);
+        files[j].SetWriteBuffer(j == 0 ? 0 : 20 * j);
+    }
+    // the writes to the two buffered files interleave in the writer queue
+    for (uint32_t i = 0; i < N_KNOWN_PACKETS; ++i)
+    {
+        const PacketEntry& p = knownPackets[i];
+        for (PcapFile& f : files)
+        {
+            f.Write(p.tsSec, p.tsUsec, (const uint8_t*)p.data, p.origLen);
+            f.Write(p.tsSec, p.tsUsec, Create<Packet>((const uint8_t*)p.data, snapLen));
+        }
+    }
+    // closing the first buffered file leaves the writer to the second one
+    for (PcapFile& f : files)
+    {
+        NS_TEST_EXPECT_MSG_EQ(f.Fail(), false, "Write must not fail");
+        f.Close();
+        NS_TEST_EXPECT_MSG_EQ(f.Fail(), false, "Close must not fail");
+    }
+
+    for (const std::string& buffered : {filename2, filename3})
+    {
+        uint32_t sec(0);
+        uint32_t usec(0);
+        uint32_t packets(0);
+        bool diff = PcapFile::Diff(filename, buffered, sec, usec, packets, snapLen);
+        NS_TEST_EXPECT_MSG_EQ(diff, false, "The buffered file differs from the synchronous one");
+        NS_TEST_EXPECT_MSG_EQ(packets, 2 * N_KNOWN_PACKETS, "Packets missing from the files");
+    }
+    remove(filename.c_str());
+    remove(filename2.c_str());
+    remove(filename3.c_str());
+}
+
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * @brief Test case to make sure that the PcapFileWrapper captures the packets
+ * selected by its Filter and SamplingPeriod attributes, truncated to its
+ * CaptureSize.
+ */
+class WrapperCaptureTestCase : public TestCase
+{
+  public:
+    WrapperCaptureTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+WrapperCaptureTestCase::WrapperCaptureTestCase()
+    : TestCase("Check the filter and the sampling of PcapFileWrapper")
+{
+}
+
+/**
+ * Capture the packets larger than 100 bytes.
+ * @param p the packet
+ * @returns true if the packet is captured
+ */
+static bool
+IsLargePacket(Ptr<const Packet> p)
+{
+    return p->GetSize() > 100;
+}
+
+void
+WrapperCaptureTestCase::DoRun()
+{
+    std::string filename = CreateTempDirFilename("captured.pcap");
+
+    auto wrapper = CreateObject<PcapFileWrapper>();
+    wrapper->SetAttribute("CaptureSize", UintegerValue(50));
+    wrapper->SetAttribute("SamplingPeriod", UintegerValue(2));
+    wrapper->SetAttribute("Filter", CallbackValue(MakeCallback(&IsLargePacket)));
+    wrapper->SetAttribute("WriteBufferSize", UintegerValue(256));
+    wrapper->Open(filename, std::ios::out);
+    wrapper->Init(1);
+
+    // 5 large packets pass the filter, the 1st, 3rd and 5th are sampled
+    for (uint32_t i = 0; i < 10; ++i)
+    {
+        wrapper->Write(MicroSeconds(i), Create<Packet>(i % 2 ? 200 : 40));
+    }
+    wrapper->Close();
+
+    PcapFile f;
+    f.Open(filename, std::ios::in);
+    NS_TEST_ASSERT_MSG_EQ(f.Fail(), false, "Open (" << filename << ") returns error");
+    uint8_t data[256];
+    uint32_t tsSec;
+    uint32_t tsUsec;
+    uint32_t inclLen;
+    uint32_t origLen;
+    uint32_t readLen;
+    for (uint32_t us : {1, 5, 9})
+    {
+        f.Read(data, sizeof(data), tsSec, tsUsec, inclLen, origLen, readLen);
+        NS_TEST_ASSERT_MSG_EQ(f.Fail(), false, "Packet missing from the file");
+        NS_TEST_EXPECT_MSG_EQ(tsUsec, us, "Unexpected packet captured");
+        NS_TEST_EXPECT_MSG_EQ(inclLen, 50, "The packet is not truncated to CaptureSize");
+        NS_TEST_EXPECT_MSG_EQ(origLen, 200, "Unexpected original length");
+    }
+    f.Read(data, sizeof(data), tsSec, tsUsec, inclLen, origLen, readLen);
+    NS_TEST_EXPECT_MSG_EQ(f.Eof(), true, "Unexpected packet captured");
+    f.Close();
+    remove(filename.c_str());
+}
+
 /**
  * @ingroup network-test
  * @ingroup tests
@@ -1387,6 +1540,8 @@ PcapFileTestSuite::PcapFileTestSuite()
     AddTestCase(new RecordHeaderTestCase, TestCase::Duration::QUICK);
     AddTestCase(new ReadFileTestCase, TestCase::Duration::QUICK);
     AddTestCase(new DiffTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new WriteBufferTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new WrapperCaptureTestCase, TestCase::Duration::QUICK);
 }
 
 static PcapFileTestSuite pcapFileTestSuite; //!< Static variable for test initialization
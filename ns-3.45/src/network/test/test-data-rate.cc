@@ -143,6 +143,70 @@ DataRateTestCase1::DoRun()
     }
 }
 
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * @brief Test the integer conversions between DataRate, bytes and time
+ *
+ */
+class DataRateTestCase3 : public DataRateTestCase
+{
+  public:
+    DataRateTestCase3();
+
+  private:
+    void DoRun() override;
+};
+
+DataRateTestCase3::DataRateTestCase3()
+    : DataRateTestCase("Test the conversion from DataRate and time to bytes")
+{
+}
+
+void
+DataRateTestCase3::DoRun()
+{
+    if (Time::GetResolution() != Time::FS)
+    {
+        Time::SetResolution(Time::FS);
+    }
+    // transmission times are rounded to the nearest time step
+    CheckTimesEqual(DataRate("3Gb/s").CalculateBitsTxTime(1),
+                    FemtoSeconds(333333),
+                    "CalculateBitsTxTime did not round down");
+    CheckTimesEqual(DataRate("3Gb/s").CalculateBitsTxTime(2),
+                    FemtoSeconds(666667),
+                    "CalculateBitsTxTime did not round up");
+
+    // the bytes sent are rounded down
+    NS_TEST_EXPECT_MSG_EQ(DataRate("1Gb/s").CalculateBytesInTime(MicroSeconds(1)),
+                          125,
+                          "CalculateBytesInTime returned incorrect value");
+    NS_TEST_EXPECT_MSG_EQ(DataRate("10Gb/s").CalculateBytesInTime(NanoSeconds(1)),
+                          1,
+                          "CalculateBytesInTime returned incorrect value");
+    NS_TEST_EXPECT_MSG_EQ(DataRate("3Gb/s").CalculateBytesInTime(NanoSeconds(1)),
+                          0,
+                          "CalculateBytesInTime did not round down");
+    NS_TEST_EXPECT_MSG_EQ(DataRate("400Gb/s").CalculateBytesInTime(Seconds(10)),
+                          500000000000ULL,
+                          "CalculateBytesInTime overflowed");
+
+    for (const std::string rate : {"1Mb/s", "3Gb/s", "25Gb/s", "400Gb/s"})
+    {
+        DataRate dr(rate);
+        for (uint32_t bytes : {0, 1, 64, 1500, 9000})
+        {
+            NS_TEST_EXPECT_MSG_EQ(dr.CalculateBytesInTime(dr.CalculateBytesTxTime(bytes)),
+                                  bytes,
+                                  "The bytes sent in the transmission time of " << bytes
+                                                                                << " bytes at "
+                                                                                << rate);
+        }
+    }
+}
+
 /**
  * @ingroup network-test
  * @ingroup tests
@@ -356,6 +420,7 @@ DataRateTestSuite::DataRateTestSuite()
 {
     AddTestCase(new DataRateTestCase1(), TestCase::Duration::QUICK);
     AddTestCase(new DataRateTestCase2(), TestCase::Duration::QUICK);
+    AddTestCase(new DataRateTestCase3(), TestCase::Duration::QUICK);
     AddTestCase(new DataRateTupleSetGetTestCase(), TestCase::Duration::QUICK);
 }
 
@@ -216,18 +216,54 @@ DataRate::operator!=(const DataRate& rhs) const
     return m_bps != rhs.m_bps;
 }
 
+/**
+ * @ingroup network
+ * Calculate the transmission time of a number of bits.
+ *
+ * The product of the bits and the time steps per second is computed in
+ * 128 bits, when int64x64_t is, and rounded to the nearest time step like
+ * the conversion from int64x64_t, without the int64x64_t division.
+ *
+ * @param [in] bits The number of bits.
+ * @param [in] bps The bit rate, in bits per second.
+ * @returns The transmission time.
+ */
+static Time
+BitsToTime(uint64_t bits, uint64_t bps)
+{
+#ifdef INT64X64_USE_128
+    uint128_t steps = uint128_t(bits) * Time::GetStepsPerSecond();
+    return TimeStep((steps + bps / 2) / bps);
+#else
+    return Seconds(int64x64_t(bits) / bps);
+#endif
+}
+
 Time
 DataRate::CalculateBytesTxTime(uint32_t bytes) const
 {
     NS_LOG_FUNCTION(this << bytes);
-    return CalculateBitsTxTime(bytes * 8);
+    return BitsToTime(uint64_t(bytes) * 8, m_bps);
 }
 
 Time
 DataRate::CalculateBitsTxTime(uint32_t bits) const
 {
     NS_LOG_FUNCTION(this << bits);
-    return Seconds(int64x64_t(bits) / m_bps);
+    return BitsToTime(bits, m_bps);
+}
+
+uint64_t
+DataRate::CalculateBytesInTime(const Time& duration) const
+{
+    NS_LOG_FUNCTION(this << duration);
+    NS_ASSERT_MSG(!duration.IsStrictlyNegative(), "The duration must not be negative");
+#ifdef INT64X64_USE_128
+    uint128_t bits = uint128_t(duration.GetTimeStep()) * m_bps;
+    return bits / (uint64_t(Time::GetStepsPerSecond()) * 8);
+#else
+    return (duration.To(Time::S) * m_bps / 8).GetHigh();
+#endif
 }
 
 uint64_t
@@ -229,12 +229,25 @@ class DataRate
     /**
      * @brief Calculate transmission time
      *
-     * Calculates the transmission time at this data rate
+     * Calculates the transmission time at this data rate, rounded to
+     * the nearest time step, with integers only
      * @param bits The number of bits (not bytes) for which to calculate
      * @return The transmission time for the number of bits specified
      */
     Time CalculateBitsTxTime(uint32_t bits) const;
 
+    /**
+     * @brief Calculate the number of bytes sent in a duration
+     *
+     * Calculates the number of whole bytes transmitted at this data rate
+     * in a duration, e.g., the credit of a token bucket. Like the
+     * transmission times, it is computed with integers only, and is exact.
+     *
+     * @param duration The duration, which must not be negative
+     * @return The number of bytes sent in the duration, rounded down
+     */
+    uint64_t CalculateBytesInTime(const Time& duration) const;
+
     /**
      * Get the underlying bitrate
      * @return The underlying bitrate in bits per second
@@ -8,6 +8,7 @@
 #include "flow-id-tag.h"
 
 #include "ns3/log.h"
+#include "ns3/multithreading.h"
 
 namespace ns3
 {
@@ -91,7 +92,7 @@ uint32_t
 FlowIdTag::AllocateFlowId()
 {
     NS_LOG_FUNCTION_NOARGS();
-    static uint32_t nextFlowId = 1;
+    static NS3_SIMULATION_LOCAL uint32_t nextFlowId = 1;
     uint32_t flowId = nextFlowId;
     nextFlowId++;
     return flowId;
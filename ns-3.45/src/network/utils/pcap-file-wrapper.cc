@@ -8,6 +8,7 @@
 
 #include "ns3/boolean.h"
 #include "ns3/buffer.h"
+#include "ns3/callback.h"
 #include "ns3/header.h"
 #include "ns3/log.h"
 #include "ns3/uinteger.h"
@@ -37,11 +38,29 @@ PcapFileWrapper::GetTypeId()
                           "microseconds(default).",
                           BooleanValue(false),
                           MakeBooleanAccessor(&PcapFileWrapper::m_nanosecMode),
-                          MakeBooleanChecker());
+                          MakeBooleanChecker())
+            .AddAttribute("WriteBufferSize",
+                          "Size of the buffers of the writer thread, in bytes. "
+                          "0 writes the packets to the file synchronously.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&PcapFileWrapper::m_bufferSize),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("SamplingPeriod",
+                          "Capture one packet in every SamplingPeriod packets.",
+                          UintegerValue(1),
+                          MakeUintegerAccessor(&PcapFileWrapper::m_samplingPeriod),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("Filter",
+                          "Callback returning true for the packets to capture. "
+                          "All the packets are captured if it is null.",
+                          CallbackValue(),
+                          MakeCallbackAccessor(&PcapFileWrapper::m_filter),
+                          MakeCallbackChecker());
     return tid;
 }
 
 PcapFileWrapper::PcapFileWrapper()
+    : m_sampled(0)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -104,12 +123,27 @@ PcapFileWrapper::Init(uint32_t dataLinkType, uint32_t snapLen, int32_t tzCorrect
     {
         m_file.Init(dataLinkType, m_snapLen, tzCorrection, false, m_nanosecMode);
     }
+    m_file.SetWriteBuffer(m_bufferSize);
+}
+
+bool
+PcapFileWrapper::Capture(Ptr<const Packet> p)
+{
+    if (p && !m_filter.IsNull() && !m_filter(p))
+    {
+        return false;
+    }
+    return m_sampled++ % m_samplingPeriod == 0;
 }
 
 void
 PcapFileWrapper::Write(Time t, Ptr<const Packet> p)
 {
     NS_LOG_FUNCTION(this << t << p);
+    if (!Capture(p))
+    {
+        return;
+    }
     if (m_file.IsNanoSecMode())
     {
         uint64_t current = t.GetNanoSeconds();
@@ -130,6 +164,10 @@ void
 PcapFileWrapper::Write(Time t, const Header& header, Ptr<const Packet> p)
 {
     NS_LOG_FUNCTION(this << t << &header << p);
+    if (!Capture(p))
+    {
+        return;
+    }
     if (m_file.IsNanoSecMode())
     {
         uint64_t current = t.GetNanoSeconds();
@@ -150,6 +188,10 @@ void
 PcapFileWrapper::Write(Time t, const uint8_t* buffer, uint32_t length)
 {
     NS_LOG_FUNCTION(this << t << &buffer << length);
+    if (!Capture(nullptr))
+    {
+        return;
+    }
     if (m_file.IsNanoSecMode())
     {
         uint64_t current = t.GetNanoSeconds();
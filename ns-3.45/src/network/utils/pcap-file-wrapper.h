@@ -9,6 +9,7 @@
 
 #include "pcap-file.h"
 
+#include "ns3/callback.h"
 #include "ns3/nstime.h"
 #include "ns3/object.h"
 #include "ns3/packet.h"
@@ -26,6 +27,11 @@ namespace ns3
  * ns-3 interface to the low-level public methods of PcapFile.  Users are
  * encouraged to use this object instead of class ns3::PcapFile in ns-3
  * public APIs.
+ *
+ * To keep the captures of large simulations affordable, the attributes can
+ * truncate the packets (CaptureSize), keep only the packets accepted by a
+ * filter (Filter) and one packet in a number of them (SamplingPeriod), and
+ * move the writes to the file to a writer thread (WriteBufferSize).
  */
 class PcapFileWrapper : public Object
 {
@@ -132,6 +138,13 @@ class PcapFileWrapper : public Object
      */
     void Write(Time t, const uint8_t* buffer, uint32_t length);
 
+    /**
+     * Callback deciding which packets are captured, e.g., to keep only some
+     * priorities. It receives the packet as passed to Write, without the
+     * header passed separately, and returns true to capture it.
+     */
+    typedef Callback<bool, Ptr<const Packet>> FilterCallback;
+
     /**
      * @brief Read the next packet from the file.
      *
@@ -211,9 +224,22 @@ class PcapFileWrapper : public Object
     uint32_t GetDataLinkType();
 
   private:
-    PcapFile m_file;    //!< Pcap file
-    uint32_t m_snapLen; //!< max length of saved packets
-    bool m_nanosecMode; //!< Timestamps in nanosecond mode
+    /**
+     * @brief Decide whether the next packet is captured, from the filter
+     * and the sampling period.
+     *
+     * @param p the packet, or nullptr if it is a data buffer
+     * @returns true if the packet is captured
+     */
+    bool Capture(Ptr<const Packet> p);
+
+    PcapFile m_file;           //!< Pcap file
+    uint32_t m_snapLen;        //!< max length of saved packets
+    bool m_nanosecMode;        //!< Timestamps in nanosecond mode
+    uint32_t m_bufferSize;     //!< size of the write buffers, 0 to write synchronously
+    uint32_t m_samplingPeriod; //!< one packet captured every m_samplingPeriod
+    uint64_t m_sampled;        //!< packets accepted by the filter so far
+    FilterCallback m_filter;   //!< packets captured, all if null
 };
 
 } // namespace ns3
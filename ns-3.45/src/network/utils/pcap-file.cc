@@ -17,8 +17,12 @@
 #include "ns3/log.h"
 #include "ns3/packet.h"
 
+#include <condition_variable>
 #include <cstring>
+#include <deque>
 #include <iostream>
+#include <mutex>
+#include <thread>
 
 //
 // This file is used as part of the ns-3 test framework, so please refrain from
@@ -40,10 +44,55 @@ const uint32_t NS_SWAPPED_MAGIC = 0x4d3cb2a1; /**< Looks this way if byte swappi
 const uint16_t VERSION_MAJOR = 2; /**< Major version of supported pcap file format */
 const uint16_t VERSION_MINOR = 4; /**< Minor version of supported pcap file format */
 
+namespace
+{
+
+/**
+ * The writer thread shared by the buffered files, with the queue of the
+ * buffers handed off to it.
+ */
+struct PcapWriter
+{
+    std::mutex mutex;                //!< protects the queue, the count and the handoffs
+    std::condition_variable handOff; //!< notifies the handoffs and the writes
+    std::deque<PcapFile*> queue;     //!< files whose buffer handed off is to write, in order
+    uint32_t files{0};               //!< number of buffered files
+    std::thread thread;              //!< the writer thread
+
+    ~PcapWriter()
+    {
+        // files leaked at exit: write what they queued, then stop
+        {
+            std::lock_guard lock(mutex);
+            files = 0;
+        }
+        handOff.notify_all();
+        if (thread.joinable())
+        {
+            thread.join();
+        }
+    }
+};
+
+/**
+ * @returns the writer shared by the buffered files
+ */
+PcapWriter&
+GetWriter()
+{
+    static PcapWriter writer;
+    return writer;
+}
+
+} // namespace
+
 PcapFile::PcapFile()
     : m_file(),
       m_swapMode(false),
-      m_nanosecMode(false)
+      m_nanosecMode(false),
+      m_bufferSize(0),
+      m_handedOff(false),
+      m_writeFailed(false)
 {
     NS_LOG_FUNCTION(this);
     FatalImpl::RegisterStream(&m_file);
@@ -52,14 +101,19 @@ PcapFile::PcapFile()
 PcapFile::~PcapFile()
 {
     NS_LOG_FUNCTION(this);
-    FatalImpl::UnregisterStream(&m_file);
     Close();
+    FatalImpl::UnregisterStream(&m_file);
 }
 
 bool
 PcapFile::Fail() const
 {
     NS_LOG_FUNCTION(this);
+    if (m_bufferSize != 0)
+    {
+        // the writer thread owns the stream
+        return m_writeFailed;
+    }
     return m_file.fail();
 }
 
@@ -81,6 +135,7 @@ void
 PcapFile::Close()
 {
     NS_LOG_FUNCTION(this);
+    StopWriter();
     m_file.close();
 }
 
@@ -402,7 +457,7 @@ uint32_t
 PcapFile::WritePacketHeader(uint32_t tsSec, uint32_t tsUsec, uint32_t totalLen)
 {
     NS_LOG_FUNCTION(this << tsSec << tsUsec << totalLen);
-    NS_ASSERT(m_file.good());
+    NS_ASSERT(m_bufferSize != 0 || m_file.good());
 
     uint32_t inclLen = totalLen > m_fileHeader.m_snapLen ? m_fileHeader.m_snapLen : totalLen;
 
@@ -417,6 +472,16 @@ PcapFile::WritePacketHeader(uint32_t tsSec, uint32_t tsUsec, uint32_t totalLen)
         Swap(&header, &header);
     }
 
+    if (m_bufferSize != 0)
+    {
+        uint8_t* out = Reserve(16);
+        std::memcpy(out, &header.m_tsSec, 4);
+        std::memcpy(out + 4, &header.m_tsUsec, 4);
+        std::memcpy(out + 8, &header.m_inclLen, 4);
+        std::memcpy(out + 12, &header.m_origLen, 4);
+        return inclLen;
+    }
+
     //
     // Watch out for memory alignment differences between machines, so write
     // them all individually.
@@ -434,6 +499,11 @@ PcapFile::Write(uint32_t tsSec, uint32_t tsUsec, const uint8_t* const data, uint
 {
     NS_LOG_FUNCTION(this << tsSec << tsUsec << &data << totalLen);
     uint32_t inclLen = WritePacketHeader(tsSec, tsUsec, totalLen);
+    if (m_bufferSize != 0)
+    {
+        std::memcpy(Reserve(inclLen), data, inclLen);
+        return;
+    }
     m_file.write((const char*)data, inclLen);
     NS_BUILD_DEBUG(m_file.flush());
 }
@@ -443,6 +513,11 @@ PcapFile::Write(uint32_t tsSec, uint32_t tsUsec, Ptr<const Packet> p)
 {
     NS_LOG_FUNCTION(this << tsSec << tsUsec << p);
     uint32_t inclLen = WritePacketHeader(tsSec, tsUsec, p->GetSize());
+    if (m_bufferSize != 0)
+    {
+        p->CopyData(Reserve(inclLen), inclLen);
+        return;
+    }
     p->CopyData(&m_file, inclLen);
     NS_BUILD_DEBUG(m_file.flush());
 }
@@ -459,11 +534,140 @@ PcapFile::Write(uint32_t tsSec, uint32_t tsUsec, const Header& header, Ptr<const
     headerBuffer.AddAtStart(headerSize);
     header.Serialize(headerBuffer.Begin());
     uint32_t toCopy = std::min(headerSize, inclLen);
+    if (m_bufferSize != 0)
+    {
+        headerBuffer.CopyData(Reserve(toCopy), toCopy);
+        inclLen -= toCopy;
+        p->CopyData(Reserve(inclLen), inclLen);
+        return;
+    }
     headerBuffer.CopyData(&m_file, toCopy);
     inclLen -= toCopy;
     p->CopyData(&m_file, inclLen);
 }
 
+void
+PcapFile::SetWriteBuffer(uint32_t bufferSize)
+{
+    NS_LOG_FUNCTION(this << bufferSize);
+    NS_ASSERT_MSG(m_bufferSize == 0, "The write buffer of " << m_filename << " is already set");
+    if (bufferSize == 0)
+    {
+        return;
+    }
+    m_bufferSize = bufferSize;
+    m_filling.reserve(bufferSize);
+    m_writing.reserve(bufferSize);
+    m_handedOff = false;
+    m_writeFailed = m_file.fail();
+    // the writer thread may write to the stream while a fatal error flushes it
+    FatalImpl::UnregisterStream(&m_file);
+
+    PcapWriter& writer = GetWriter();
+    std::lock_guard lock(writer.mutex);
+    ++writer.files;
+    if (!writer.thread.joinable())
+    {
+        writer.thread = std::thread(&PcapFile::RunWriter);
+    }
+}
+
+uint8_t*
+PcapFile::Reserve(uint32_t length)
+{
+    if (!m_filling.empty() && m_filling.size() + length > m_bufferSize)
+    {
+        HandOff();
+    }
+    // a packet larger than the buffer grows it
+    std::size_t used = m_filling.size();
+    m_filling.resize(used + length);
+    return m_filling.data() + used;
+}
+
+void
+PcapFile::HandOff()
+{
+    NS_LOG_FUNCTION(this << m_filling.size());
+    PcapWriter& writer = GetWriter();
+    std::unique_lock lock(writer.mutex);
+    writer.handOff.wait(lock, [this] { return !m_handedOff; });
+    m_filling.swap(m_writing);
+    m_handedOff = true;
+    writer.queue.push_back(this);
+    lock.unlock();
+    writer.handOff.notify_all();
+    m_filling.clear();
+}
+
+void
+PcapFile::WriteBuffer()
+{
+    m_file.write((const char*)m_writing.data(), m_writing.size());
+    m_file.flush();
+    if (m_file.fail())
+    {
+        m_writeFailed = true;
+    }
+}
+
+void
+PcapFile::RunWriter()
+{
+    PcapWriter& writer = GetWriter();
+    std::unique_lock lock(writer.mutex);
+    while (true)
+    {
+        writer.handOff.wait(lock, [&writer] { return !writer.queue.empty() || writer.files == 0; });
+        if (writer.queue.empty())
+        {
+            break;
+        }
+        PcapFile* file = writer.queue.front();
+        writer.queue.pop_front();
+        // the buffer and the stream are left to this thread until m_handedOff is reset
+        lock.unlock();
+        file->WriteBuffer();
+        lock.lock();
+        file->m_handedOff = false;
+        writer.handOff.notify_all();
+    }
+}
+
+void
+PcapFile::StopWriter()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_bufferSize == 0)
+    {
+        return;
+    }
+    if (!m_filling.empty())
+    {
+        HandOff();
+    }
+    PcapWriter& writer = GetWriter();
+    std::thread stopped;
+    {
+        std::unique_lock lock(writer.mutex);
+        writer.handOff.wait(lock, [this] { return !m_handedOff; });
+        if (--writer.files == 0)
+        {
+            // the last buffered file stops the writer thread
+            stopped = std::move(writer.thread);
+        }
+    }
+    writer.handOff.notify_all();
+    if (stopped.joinable())
+    {
+        stopped.join();
+    }
+    m_bufferSize = 0;
+    std::vector<uint8_t>().swap(m_filling);
+    std::vector<uint8_t>().swap(m_writing);
+    FatalImpl::RegisterStream(&m_file);
+}
+
 void
 PcapFile::Read(uint8_t* const data,
                uint32_t maxBytes,
@@ -11,9 +11,11 @@
 
 #include "ns3/ptr.h"
 
+#include <atomic>
 #include <fstream>
 #include <stdint.h>
 #include <string>
+#include <vector>
 
 namespace ns3
 {
@@ -41,6 +43,7 @@ class PcapFile
 
     /**
      * @return true if the 'fail' bit is set in the underlying iostream, false otherwise.
+     * With a write buffer, true if a write of the writer thread failed.
      */
     bool Fail() const;
     /**
@@ -141,6 +144,26 @@ class PcapFile
      */
     void Write(uint32_t tsSec, uint32_t tsUsec, const Header& header, Ptr<const Packet> p);
 
+    /**
+     * @brief Write the packets through a buffer and the writer thread
+     *
+     * The next packets are appended to a buffer instead of the file. When
+     * the buffer is full, it is queued to a writer thread shared by all the
+     * buffered files while the packets fill a second buffer, so the Write
+     * methods only wait when the previous buffer of this file is not
+     * written yet. The writer thread runs while at least one file is
+     * buffered. Close writes the packets left.
+     *
+     * While buffered, the stream belongs to the writer thread and is not
+     * flushed by NS_FATAL_ERROR; the writer flushes each buffer it writes.
+     *
+     * Call it after Init, on a file opened for writing.
+     *
+     * @param bufferSize The size of each of the two buffers, in bytes. 0
+     * leaves the packets written synchronously.
+     */
+    void SetWriteBuffer(uint32_t bufferSize);
+
     /**
      * @brief Read next packet from file
      *
@@ -357,6 +380,35 @@ class PcapFile
      */
     uint32_t WritePacketHeader(uint32_t tsSec, uint32_t tsUsec, uint32_t totalLen);
 
+    /**
+     * @brief Reserve space at the end of the buffer being filled
+     *
+     * The buffer is handed off to the writer thread first if the space
+     * does not fit in it.
+     *
+     * @param length the number of bytes
+     * @returns the space reserved
+     */
+    uint8_t* Reserve(uint32_t length);
+    /**
+     * @brief Queue the buffer being filled to the writer thread, once it
+     * has written the previous buffer of this file
+     */
+    void HandOff();
+    /**
+     * @brief Write and flush the buffer handed off, from the writer thread
+     */
+    void WriteBuffer();
+    /**
+     * @brief Body of the writer thread: write the buffers queued by all the
+     * files, until no file is buffered
+     */
+    static void RunWriter();
+    /**
+     * @brief Write the packets left in the buffer and leave the writer thread
+     */
+    void StopWriter();
+
     /**
      * @brief Read and verify a Pcap file header
      */
@@ -367,6 +419,12 @@ class PcapFile
     PcapFileHeader m_fileHeader; //!< file header
     bool m_swapMode;             //!< swap mode
     bool m_nanosecMode;          //!< nanosecond timestamp mode
+
+    uint32_t m_bufferSize;           //!< size of the write buffers, 0 to write synchronously
+    std::vector<uint8_t> m_filling;  //!< buffer filled with the packets
+    std::vector<uint8_t> m_writing;  //!< buffer handed off to the writer thread
+    bool m_handedOff;                //!< m_writing is queued or being written
+    std::atomic<bool> m_writeFailed; //!< a write of the writer thread failed
 };
 
 } // namespace ns3
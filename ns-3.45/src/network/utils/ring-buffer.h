@@ -0,0 +1,328 @@
+//
+// SPDX-License-Identifier: GPL-2.0-only
+//
+
+#ifndef RING_BUFFER_H
+#define RING_BUFFER_H
+
+#include "ns3/assert.h"
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup queue
+ * ns3::RingBuffer declaration and implementation.
+ */
+
+namespace ns3
+{
+
+/**
+ * @ingroup queue
+ * @brief A circular buffer, usable as the container of a Queue.
+ *
+ * The elements are stored contiguously in a buffer whose capacity is a
+ * power of two, and which only grows, by doubling, when it is full: a
+ * bounded queue stops allocating once it has reached its largest size,
+ * where a std::list allocates a node per item. Inserting or erasing at
+ * either end takes constant time; elsewhere, the elements between the
+ * position and the nearest end are moved.
+ *
+ * The iterators are a position in the buffer: an insertion or an erasure
+ * invalidates the iterators after the position, and, when the buffer
+ * grows, all of them. The container provides the interface required by
+ * Queue: begin(), end(), insert(), erase() and clear().
+ *
+ * @tparam T \explicit The type of the elements, default constructible.
+ */
+template <typename T>
+class RingBuffer
+{
+  public:
+    /// The type of the elements.
+    typedef T value_type;
+
+    /**
+     * An iterator over the elements.
+     * @tparam IsConst Whether the elements are constant.
+     */
+    template <bool IsConst>
+    class Iter
+    {
+      public:
+        /// The category of the iterator.
+        typedef std::bidirectional_iterator_tag iterator_category;
+        /// The type of the elements.
+        typedef T value_type;
+        /// The difference between two iterators.
+        typedef std::ptrdiff_t difference_type;
+        /// A pointer to an element.
+        typedef std::conditional_t<IsConst, const T*, T*> pointer;
+        /// A reference to an element.
+        typedef std::conditional_t<IsConst, const T&, T&> reference;
+        /// The container.
+        typedef std::conditional_t<IsConst, const RingBuffer, RingBuffer> container;
+
+        Iter()
+            : m_buffer(nullptr),
+              m_index(0)
+        {
+        }
+
+        /**
+         * Constructor.
+         * @param [in] buffer The container.
+         * @param [in] index The position of the element, from the front.
+         */
+        Iter(container* buffer, std::size_t index)
+            : m_buffer(buffer),
+              m_index(index)
+        {
+        }
+
+        /**
+         * Convert an iterator to a const iterator.
+         * @tparam OtherConst \deduced false: the iterator is not const.
+         * @param [in] it The iterator.
+         */
+        template <bool OtherConst>
+            requires(IsConst && !OtherConst)
+        Iter(const Iter<OtherConst>& it)
+            : m_buffer(it.m_buffer),
+              m_index(it.m_index)
+        {
+        }
+
+        /** @returns The element. */
+        reference operator*() const
+        {
+            return m_buffer->At(m_index);
+        }
+
+        /** @returns A pointer to the element. */
+        pointer operator->() const
+        {
+            return &m_buffer->At(m_index);
+        }
+
+        /** @returns This iterator, moved to the next element. */
+        Iter& operator++()
+        {
+            m_index++;
+            return *this;
+        }
+
+        /** @returns This iterator, before it is moved to the next element. */
+        Iter operator++(int)
+        {
+            Iter it = *this;
+            m_index++;
+            return it;
+        }
+
+        /** @returns This iterator, moved to the previous element. */
+        Iter& operator--()
+        {
+            m_index--;
+            return *this;
+        }
+
+        /** @returns This iterator, before it is moved to the previous element. */
+        Iter operator--(int)
+        {
+            Iter it = *this;
+            m_index--;
+            return it;
+        }
+
+        /**
+         * @param [in] other Another iterator.
+         * @returns true if the iterators point to the same position.
+         */
+        bool operator==(const Iter& other) const
+        {
+            return m_buffer == other.m_buffer && m_index == other.m_index;
+        }
+
+      private:
+        friend class RingBuffer;
+        friend class Iter<true>;
+
+        container* m_buffer; //!< The container
+        std::size_t m_index; //!< The position of the element, from the front
+    };
+
+    /// An iterator.
+    typedef Iter<false> iterator;
+    /// A const iterator.
+    typedef Iter<true> const_iterator;
+
+    RingBuffer()
+        : m_head(0),
+          m_size(0)
+    {
+    }
+
+    /** @returns An iterator to the first element. */
+    iterator begin()
+    {
+        return iterator(this, 0);
+    }
+
+    /** @returns An iterator past the last element. */
+    iterator end()
+    {
+        return iterator(this, m_size);
+    }
+
+    /** @returns A const iterator to the first element. */
+    const_iterator begin() const
+    {
+        return const_iterator(this, 0);
+    }
+
+    /** @returns A const iterator past the last element. */
+    const_iterator end() const
+    {
+        return const_iterator(this, m_size);
+    }
+
+    /** @returns The number of elements. */
+    std::size_t size() const
+    {
+        return m_size;
+    }
+
+    /** @returns true if there are no elements. */
+    bool empty() const
+    {
+        return m_size == 0;
+    }
+
+    /** @returns The number of elements which fit without growing. */
+    std::size_t capacity() const
+    {
+        return m_buffer.size();
+    }
+
+    /**
+     * Insert an element.
+     * @param [in] pos The position before which to insert the element.
+     * @param [in] value The element.
+     * @returns An iterator to the inserted element.
+     */
+    iterator insert(const_iterator pos, const T& value)
+    {
+        NS_ASSERT(pos.m_buffer == this && pos.m_index <= m_size);
+        if (m_size == m_buffer.size())
+        {
+            Grow();
+        }
+        std::size_t index = pos.m_index;
+        if (index < m_size - index)
+        {
+            // move the elements before the position one slot backwards
+            m_head = (m_head - 1) & (m_buffer.size() - 1);
+            for (std::size_t i = 0; i < index; i++)
+            {
+                At(i) = std::move(At(i + 1));
+            }
+        }
+        else
+        {
+            // move the elements after the position one slot forwards
+            for (std::size_t i = m_size; i > index; i--)
+            {
+                At(i) = std::move(At(i - 1));
+            }
+        }
+        m_size++;
+        At(index) = value;
+        return iterator(this, index);
+    }
+
+    /**
+     * Erase an element.
+     * @param [in] pos The position of the element.
+     * @returns An iterator to the element which followed the erased one.
+     */
+    iterator erase(const_iterator pos)
+    {
+        NS_ASSERT(pos.m_buffer == this && pos.m_index < m_size);
+        std::size_t index = pos.m_index;
+        if (index < m_size - 1 - index)
+        {
+            for (std::size_t i = index; i > 0; i--)
+            {
+                At(i) = std::move(At(i - 1));
+            }
+            At(0) = T();
+            m_head = (m_head + 1) & (m_buffer.size() - 1);
+        }
+        else
+        {
+            for (std::size_t i = index; i + 1 < m_size; i++)
+            {
+                At(i) = std::move(At(i + 1));
+            }
+            At(m_size - 1) = T();
+        }
+        m_size--;
+        return iterator(this, index);
+    }
+
+    /** Erase all the elements; the capacity is kept. */
+    void clear()
+    {
+        for (std::size_t i = 0; i < m_size; i++)
+        {
+            At(i) = T();
+        }
+        m_head = 0;
+        m_size = 0;
+    }
+
+  private:
+    /**
+     * @param [in] index The position of an element, from the front.
+     * @returns The element.
+     */
+    T& At(std::size_t index)
+    {
+        return m_buffer[(m_head + index) & (m_buffer.size() - 1)];
+    }
+
+    /**
+     * @param [in] index The position of an element, from the front.
+     * @returns The element.
+     */
+    const T& At(std::size_t index) const
+    {
+        return m_buffer[(m_head + index) & (m_buffer.size() - 1)];
+    }
+
+    /** Double the capacity, with at least one slot for an element. */
+    void Grow()
+    {
+        std::vector<T> buffer(m_buffer.empty() ? 1 : 2 * m_buffer.size());
+        for (std::size_t i = 0; i < m_size; i++)
+        {
+            buffer[i] = std::move(At(i));
+        }
+        m_buffer.swap(buffer);
+        m_head = 0;
+    }
+
+    std::vector<T> m_buffer; //!< The slots, a power of two
+    std::size_t m_head;      //!< The slot of the first element
+    std::size_t m_size;      //!< The number of elements
+};
+
+} // namespace ns3
+
+#endif /* RING_BUFFER_H */
@@ -0,0 +1,81 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// Implement an object to install the links of an auto.txt fabric.
+
+#include "point-to-point-auto-topology.h"
+
+#include "ns3/log.h"
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("PointToPointAutoTopologyHelper");
+
+PointToPointAutoTopologyHelper::PointToPointAutoTopologyHelper(PointToPointHelper p2pHelper,
+                                                               LinkConfigCallback config)
+    : m_p2p(p2pHelper),
+      m_config(config)
+{
+}
+
+PointToPointAutoTopologyHelper::~PointToPointAutoTopologyHelper()
+{
+}
+
+PointToPointHelper&
+PointToPointAutoTopologyHelper::GetHelper(uint32_t weight)
+{
+    auto it = m_helpers.find(weight);
+    if (it == m_helpers.end())
+    {
+        NS_LOG_LOGIC("Configuring the links with weight " << weight);
+        it = m_helpers.emplace(weight, m_p2p).first;
+        if (!m_config.IsNull())
+        {
+            m_config(it->second, weight);
+        }
+    }
+    return it->second;
+}
+
+std::vector<NetDeviceContainer>
+PointToPointAutoTopologyHelper::Install(Ptr<const AutoTopologyReader> reader,
+                                        Ipv4AddressHelper& address)
+{
+    NodeContainer nodes = reader->GetNodes();
+    NS_ASSERT_MSG(nodes.GetN() > 0, "AutoTopologyReader::Read must be called first");
+
+    const std::vector<AutoTopologyReader::LinkInfo>& links = reader->GetLinkInfos();
+    std::vector<NetDeviceContainer> devices;
+    devices.reserve(links.size());
+
+    // the last helper is kept, as consecutive links usually share a weight
+    PointToPointHelper* helper = nullptr;
+    uint32_t weight = 0;
+    for (const auto& info : links)
+    {
+        if (!helper || info.weight != weight)
+        {
+            helper = &GetHelper(info.weight);
+            weight = info.weight;
+        }
+        devices.push_back(helper->Install(nodes.Get(info.from), nodes.Get(info.to)));
+    }
+
+    for (const auto& ndc : devices)
+    {
+        address.Assign(ndc);
+        address.NewNetwork();
+    }
+    return devices;
+}
+
+uint32_t
+PointToPointAutoTopologyHelper::GetNConfigured() const
+{
+    return m_helpers.size();
+}
+
+} // namespace ns3
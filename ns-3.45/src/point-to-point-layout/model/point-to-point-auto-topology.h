@@ -0,0 +1,92 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// Define an object to install the links of an auto.txt fabric.
+
+#ifndef POINT_TO_POINT_AUTO_TOPOLOGY_HELPER_H
+#define POINT_TO_POINT_AUTO_TOPOLOGY_HELPER_H
+
+#include "ns3/auto-topology-reader.h"
+#include "ns3/callback.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/net-device-container.h"
+#include "ns3/point-to-point-helper.h"
+
+#include <map>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * @ingroup point-to-point-layout
+ *
+ * @brief A helper to install the links read by an AutoTopologyReader
+ * with PointToPoint links and one /30 subnet per link
+ */
+class PointToPointAutoTopologyHelper
+{
+  public:
+    /**
+     * Callback configuring the PointToPointHelper of the links of a given
+     * weight, e.g., their DataRate and Delay attributes.
+     */
+    typedef Callback<void, PointToPointHelper&, uint32_t> LinkConfigCallback;
+
+    /**
+     * Create a PointToPointAutoTopologyHelper
+     *
+     * @param p2pHelper the link helper for p2p links, copied and passed
+     *        to the callback once for each distinct link weight
+     * @param config optional callback configuring the copy of p2pHelper
+     *        used for the links of a weight
+     */
+    PointToPointAutoTopologyHelper(PointToPointHelper p2pHelper,
+                                   LinkConfigCallback config = LinkConfigCallback());
+
+    ~PointToPointAutoTopologyHelper();
+
+    /**
+     * @brief Install a point-to-point link and a /30 subnet on every link
+     * of the reader.
+     *
+     * The helper of each distinct weight is configured once, so the
+     * callback runs once per weight whatever the order of the links.
+     * Links are nevertheless installed in file order, so the devices of
+     * each node, the links of its LSAs and thus the order of its ECMP
+     * routes follow the file. Addresses are assigned in file order, one
+     * network per link.
+     *
+     * AutoTopologyReader::Read must have been called, and an Internet
+     * stack must already be installed on the nodes.
+     *
+     * @param reader the reader holding the nodes and the links
+     * @param address the helper used to assign the addresses. Its base
+     *        should have a /30 mask.
+     * @returns the devices of every link, in file order
+     */
+    std::vector<NetDeviceContainer> Install(Ptr<const AutoTopologyReader> reader,
+                                            Ipv4AddressHelper& address);
+
+    /**
+     * @returns the number of distinct link weights configured so far
+     */
+    uint32_t GetNConfigured() const;
+
+  private:
+    /**
+     * @param weight a link weight
+     * @returns the helper of the links of this weight, configured on the
+     *          first call for the weight
+     */
+    PointToPointHelper& GetHelper(uint32_t weight);
+
+    PointToPointHelper m_p2p;                         //!< Helper copied for each weight
+    LinkConfigCallback m_config;                      //!< Configuration of each weight
+    std::map<uint32_t, PointToPointHelper> m_helpers; //!< Configured helper of each weight
+};
+
+} // namespace ns3
+
+#endif /* POINT_TO_POINT_AUTO_TOPOLOGY_HELPER_H */
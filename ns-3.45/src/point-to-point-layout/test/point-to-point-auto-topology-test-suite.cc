@@ -0,0 +1,125 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/auto-topology-reader.h"
+#include "ns3/data-rate.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/ipv4.h"
+#include "ns3/node-container.h"
+#include "ns3/point-to-point-auto-topology.h"
+#include "ns3/point-to-point-helper.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+
+using namespace ns3;
+
+/**
+ * @file
+ * @ingroup point-to-point-layout
+ * ns3::PointToPointAutoTopologyHelper test suite.
+ */
+
+/**
+ * @ingroup point-to-point-layout
+ *
+ * @brief Check that the links of an auto.txt file are installed in file
+ * order, with one configuration per distinct weight.
+ */
+class PointToPointAutoTopologyInstallTest : public TestCase
+{
+  public:
+    PointToPointAutoTopologyInstallTest();
+
+  private:
+    void DoRun() override;
+};
+
+PointToPointAutoTopologyInstallTest::PointToPointAutoTopologyInstallTest()
+    : TestCase("Install the links of an auto.txt fabric")
+{
+}
+
+void
+PointToPointAutoTopologyInstallTest::DoRun()
+{
+    Ptr<AutoTopologyReader> inFile = CreateObject<AutoTopologyReader>();
+    inFile->SetFileName("./src/topology-read/examples/Auto_toposample.txt");
+
+    NodeContainer nodes = inFile->Read();
+    InternetStackHelper stack;
+    stack.Install(nodes);
+
+    Ipv4AddressHelper address("10.0.0.0", "255.255.255.252");
+    uint32_t configs = 0;
+    auto config = [&configs](PointToPointHelper& helper, uint32_t weight) {
+        helper.SetDeviceAttribute("DataRate", StringValue(std::to_string(weight) + "Mbps"));
+        ++configs;
+    };
+    PointToPointHelper p2p;
+    PointToPointAutoTopologyHelper fabric(
+        p2p,
+        PointToPointAutoTopologyHelper::LinkConfigCallback(config));
+    std::vector<NetDeviceContainer> devices = fabric.Install(inFile, address);
+
+    NS_TEST_ASSERT_MSG_EQ(devices.size(), 7, "one device pair per link");
+    // weights 100 (x4), 200, 100, 50: one configuration per distinct weight
+    NS_TEST_EXPECT_MSG_EQ(configs, 3, "one configuration per distinct weight");
+    NS_TEST_EXPECT_MSG_EQ(fabric.GetNConfigured(), 3, "one helper per distinct weight");
+
+    // Addresses follow file order: link i uses 10.0.0.(4 * i)/30.
+    for (uint32_t i = 0; i < devices.size(); ++i)
+    {
+        Ptr<NetDevice> dev = devices[i].Get(0);
+        Ptr<Ipv4> ipv4 = dev->GetNode()->GetObject<Ipv4>();
+        int32_t interface = ipv4->GetInterfaceForDevice(dev);
+        NS_TEST_ASSERT_MSG_GT_OR_EQ(interface, 0, "device has an interface");
+        NS_TEST_EXPECT_MSG_EQ(ipv4->GetAddress(interface, 0).GetLocal(),
+                              Ipv4Address(0x0a000001 + 4 * i),
+                              "address of link " << i);
+        NS_TEST_EXPECT_MSG_EQ(dev->GetNode(),
+                              nodes.Get(inFile->GetLinkInfos()[i].from),
+                              "link " << i << " endpoint");
+    }
+
+    // The devices of the 100 Mbps link installed after the 200 Mbps one got
+    // the configuration of their weight back.
+    DataRateValue rate;
+    devices[5].Get(0)->GetAttribute("DataRate", rate);
+    NS_TEST_EXPECT_MSG_EQ(rate.Get(), DataRate("100Mbps"), "data rate of link 5");
+
+    // Devices are created in file order: node 0 has the links 0 2, 0 3 and 0 1,
+    // after its loopback device.
+    Ptr<Node> node = nodes.Get(0);
+    NS_TEST_ASSERT_MSG_EQ(node->GetNDevices(), 4, "devices of node 0");
+    NS_TEST_EXPECT_MSG_EQ(node->GetDevice(1), devices[0].Get(0), "first link of node 0");
+    NS_TEST_EXPECT_MSG_EQ(node->GetDevice(2), devices[1].Get(0), "second link of node 0");
+    NS_TEST_EXPECT_MSG_EQ(node->GetDevice(3), devices[4].Get(0), "third link of node 0");
+
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup point-to-point-layout
+ *
+ * @brief PointToPointAutoTopologyHelper TestSuite
+ */
+class PointToPointAutoTopologyTestSuite : public TestSuite
+{
+  public:
+    PointToPointAutoTopologyTestSuite();
+};
+
+PointToPointAutoTopologyTestSuite::PointToPointAutoTopologyTestSuite()
+    : TestSuite("point-to-point-auto-topology", Type::UNIT)
+{
+    AddTestCase(new PointToPointAutoTopologyInstallTest(), TestCase::Duration::QUICK);
+}
+
+/**
+ * @ingroup point-to-point-layout
+ * Static variable for test initialization
+ */
+static PointToPointAutoTopologyTestSuite g_pointToPointAutoTopologyTestSuite;
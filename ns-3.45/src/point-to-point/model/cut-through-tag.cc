@@ -0,0 +1,73 @@
+//
+// SPDX-License-Identifier: GPL-2.0-only
+//
+
+#include "cut-through-tag.h"
+
+#include "ns3/packet-tag-list.h"
+
+namespace ns3
+{
+
+NS_OBJECT_ENSURE_REGISTERED(CutThroughTag);
+
+// the tag is added and removed at every hop of a cut-through switch
+NS_PACKET_TAG_SLOT_REGISTER(CutThroughTag);
+
+TypeId
+CutThroughTag::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::CutThroughTag")
+                            .SetParent<Tag>()
+                            .SetGroupName("PointToPoint")
+                            .AddConstructor<CutThroughTag>();
+    return tid;
+}
+
+TypeId
+CutThroughTag::GetInstanceTypeId() const
+{
+    return GetTypeId();
+}
+
+uint32_t
+CutThroughTag::GetSerializedSize() const
+{
+    return 8;
+}
+
+void
+CutThroughTag::Serialize(TagBuffer buf) const
+{
+    buf.WriteU64(m_frameEnd.GetTimeStep());
+}
+
+void
+CutThroughTag::Deserialize(TagBuffer buf)
+{
+    m_frameEnd = TimeStep(buf.ReadU64());
+}
+
+void
+CutThroughTag::Print(std::ostream& os) const
+{
+    os << "FrameEnd=" << m_frameEnd.As(Time::S);
+}
+
+CutThroughTag::CutThroughTag()
+    : m_frameEnd()
+{
+}
+
+CutThroughTag::CutThroughTag(Time frameEnd)
+    : m_frameEnd(frameEnd)
+{
+}
+
+Time
+CutThroughTag::GetFrameEnd() const
+{
+    return m_frameEnd;
+}
+
+} // namespace ns3
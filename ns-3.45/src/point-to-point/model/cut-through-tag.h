@@ -0,0 +1,60 @@
+//
+// SPDX-License-Identifier: GPL-2.0-only
+//
+
+#ifndef CUT_THROUGH_TAG_H
+#define CUT_THROUGH_TAG_H
+
+#include "ns3/nstime.h"
+#include "ns3/tag.h"
+
+namespace ns3
+{
+
+/**
+ * @ingroup point-to-point
+ * @brief The time at which the last bit of a frame is received.
+ *
+ * A PointToPointChannel adds this tag to the frames it delivers to a
+ * device in cut-through mode, which receives them after their first bytes
+ * only. The device which forwards the frame removes the tag, and does not
+ * finish the transmission before this time.
+ *
+ * @see PointToPointNetDevice::SetCutThroughBytes
+ */
+class CutThroughTag : public Tag
+{
+  public:
+    /**
+     * @brief Get the TypeId
+     *
+     * @return The TypeId for this class
+     */
+    static TypeId GetTypeId();
+    TypeId GetInstanceTypeId() const override;
+    uint32_t GetSerializedSize() const override;
+    void Serialize(TagBuffer buf) const override;
+    void Deserialize(TagBuffer buf) override;
+    void Print(std::ostream& os) const override;
+
+    CutThroughTag();
+
+    /**
+     * @brief Constructor
+     * @param frameEnd the time at which the last bit of the frame is received
+     */
+    CutThroughTag(Time frameEnd);
+
+    /**
+     * @brief Get the time at which the last bit of the frame is received
+     * @returns the time
+     */
+    Time GetFrameEnd() const;
+
+  private:
+    Time m_frameEnd; //!< the time at which the last bit of the frame is received
+};
+
+} // namespace ns3
+
+#endif /* CUT_THROUGH_TAG_H */
@@ -6,6 +6,7 @@
 
 #include "point-to-point-channel.h"
 
+#include "cut-through-tag.h"
 #include "point-to-point-net-device.h"
 
 #include "ns3/log.h"
@@ -84,15 +85,31 @@ PointToPointChannel::TransmitStart(Ptr<const Packet> p, Ptr<PointToPointNetDevic
     NS_ASSERT(m_link[1].m_state != INITIALIZING);
 
     uint32_t wire = src == m_link[0].m_src ? 0 : 1;
+    Ptr<PointToPointNetDevice> dst = m_link[wire].m_dst;
 
-    Simulator::ScheduleWithContext(m_link[wire].m_dst->GetNode()->GetId(),
-                                   txTime + m_delay,
+    //
+    // A device in cut-through mode receives the frame when its first bytes
+    // arrive, i.e., before the bytes which follow them, and learns when the
+    // last bit arrives from a tag.
+    //
+    Ptr<Packet> copy = p->Copy();
+    Time rxTime = txTime;
+    uint32_t cutThroughBytes = dst->GetCutThroughBytes();
+    if (cutThroughBytes > 0 && p->GetSize() > cutThroughBytes && dst->IsCutThroughPort())
+    {
+        rxTime -= src->GetDataRate().CalculateBytesTxTime(p->GetSize() - cutThroughBytes);
+        CutThroughTag tag(Simulator::Now() + txTime + m_delay);
+        copy->ReplacePacketTag(tag);
+    }
+
+    Simulator::ScheduleWithContext(dst->GetNode()->GetId(),
+                                   rxTime + m_delay,
                                    &PointToPointNetDevice::Receive,
-                                   m_link[wire].m_dst,
-                                   p->Copy());
+                                   dst,
+                                   copy);
 
     // Call the tx anim callback on the net device
-    m_txrxPointToPoint(p, src, m_link[wire].m_dst, txTime, txTime + m_delay);
+    m_txrxPointToPoint(p, src, dst, txTime, txTime + m_delay);
     return true;
 }
 
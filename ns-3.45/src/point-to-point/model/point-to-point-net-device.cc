@@ -6,6 +6,7 @@
 
 #include "point-to-point-net-device.h"
 
+#include "cut-through-tag.h"
 #include "point-to-point-channel.h"
 #include "ppp-header.h"
 
@@ -15,10 +16,13 @@
 #include "ns3/mac48-address.h"
 #include "ns3/pointer.h"
 #include "ns3/queue.h"
+#include "ns3/show-progress.h"
 #include "ns3/simulator.h"
 #include "ns3/trace-source-accessor.h"
 #include "ns3/uinteger.h"
 
+#include <atomic>
+
 namespace ns3
 {
 
@@ -26,6 +30,41 @@ NS_LOG_COMPONENT_DEFINE("PointToPointNetDevice");
 
 NS_OBJECT_ENSURE_REGISTERED(PointToPointNetDevice);
 
+namespace
+{
+
+#ifdef NS3_MTP
+/// A progress counter, incremented by the devices of every logical process.
+using ProgressCounter = std::atomic<uint64_t>;
+#else
+/// A progress counter.
+using ProgressCounter = uint64_t;
+#endif
+
+ProgressCounter g_txPackets = 0; //!< Packets transmitted by all the devices
+ProgressCounter g_rxPackets = 0; //!< Packets received by all the devices
+ProgressCounter g_events = 0;    //!< TransmitComplete and Receive events executed
+
+/**
+ * Whether a device enabled cut-through, so that the frames may carry a
+ * CutThroughTag. Atomic, as the devices of every logical process read it.
+ */
+std::atomic<bool> g_cutThrough = false;
+
+/**
+ * Register the packets in flight on the point-to-point channels, and the
+ * events executed by the devices, with ShowProgress.
+ */
+const bool g_progressCounters = [] {
+    ShowProgress::RegisterCounter("point-to-point/packets-in-flight", [] {
+        return double(g_txPackets) - double(g_rxPackets);
+    });
+    ShowProgress::RegisterEventCounter("point-to-point", [] { return uint64_t(g_events); });
+    return true;
+}();
+
+} // namespace
+
 TypeId
 PointToPointNetDevice::GetTypeId()
 {
@@ -55,6 +94,13 @@ PointToPointNetDevice::GetTypeId()
                           PointerValue(),
                           MakePointerAccessor(&PointToPointNetDevice::m_receiveErrorModel),
                           MakePointerChecker<ErrorModel>())
+            .AddAttribute("CutThroughBytes",
+                          "The number of bytes of a frame received before the device passes "
+                          "it up, to be forwarded by cut-through; 0 for store-and-forward",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&PointToPointNetDevice::SetCutThroughBytes,
+                                               &PointToPointNetDevice::GetCutThroughBytes),
+                          MakeUintegerChecker<uint32_t>())
             .AddAttribute("InterframeGap",
                           "The time to wait between packet (frame) transmissions",
                           TimeValue(Seconds(0)),
@@ -167,7 +213,10 @@ PointToPointNetDevice::PointToPointNetDevice()
     : m_txMachineState(READY),
       m_channel(nullptr),
       m_linkUp(false),
-      m_currentPkt(nullptr)
+      m_currentPkt(nullptr),
+      m_txPackets(0),
+      m_rxPackets(0),
+      m_cutThroughBytes(0)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -215,6 +264,60 @@ PointToPointNetDevice::SetDataRate(DataRate bps)
     m_bps = bps;
 }
 
+DataRate
+PointToPointNetDevice::GetDataRate() const
+{
+    return m_bps;
+}
+
+uint64_t
+PointToPointNetDevice::GetTxPacketCount() const
+{
+    return m_txPackets;
+}
+
+uint64_t
+PointToPointNetDevice::GetRxPacketCount() const
+{
+    return m_rxPackets;
+}
+
+void
+PointToPointNetDevice::SetCutThroughBytes(uint32_t bytes)
+{
+    NS_LOG_FUNCTION(this << bytes);
+    m_cutThroughBytes = bytes;
+    if (bytes > 0)
+    {
+        g_cutThrough.store(true, std::memory_order_relaxed);
+    }
+}
+
+uint32_t
+PointToPointNetDevice::GetCutThroughBytes() const
+{
+    return m_cutThroughBytes;
+}
+
+bool
+PointToPointNetDevice::IsCutThroughPort() const
+{
+    if (m_cutThroughBytes == 0 || !m_node)
+    {
+        return false;
+    }
+    // the node must have another point-to-point port to forward the frame to
+    for (uint32_t i = 0; i < m_node->GetNDevices(); i++)
+    {
+        Ptr<NetDevice> device = m_node->GetDevice(i);
+        if (device != this && DynamicCast<PointToPointNetDevice>(device) && device->GetChannel())
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 void
 PointToPointNetDevice::SetInterframeGap(Time t)
 {
@@ -223,9 +326,9 @@ PointToPointNetDevice::SetInterframeGap(Time t)
 }
 
 bool
-PointToPointNetDevice::TransmitStart(Ptr<Packet> p)
+PointToPointNetDevice::TransmitStart(Ptr<Packet> p, bool cutThrough)
 {
-    NS_LOG_FUNCTION(this << p);
+    NS_LOG_FUNCTION(this << p << cutThrough);
     NS_LOG_LOGIC("UID is " << p->GetUid() << ")");
 
     //
@@ -239,6 +342,25 @@ PointToPointNetDevice::TransmitStart(Ptr<Packet> p)
     m_phyTxBeginTrace(m_currentPkt);
 
     Time txTime = m_bps.CalculateBytesTxTime(p->GetSize());
+
+    //
+    // A frame received by cut-through may not be completely received yet.
+    // If it waited in the queue, it is stored and forwarded: it starts when
+    // it is completely received.  Otherwise it starts late enough for its
+    // last bit to leave no earlier than it arrives.  The device is busy in
+    // the meantime, so neither case needs another event.
+    //
+    CutThroughTag tag;
+    if (g_cutThrough.load(std::memory_order_relaxed) && p->RemovePacketTag(tag))
+    {
+        Time remaining = tag.GetFrameEnd() - Simulator::Now();
+        Time start = cutThrough ? remaining - txTime : remaining;
+        if (start.IsStrictlyPositive())
+        {
+            NS_LOG_LOGIC("Wait " << start.As(Time::S) << " for the end of the frame");
+            txTime += start;
+        }
+    }
     Time txCompleteTime = txTime + m_tInterframeGap;
 
     NS_LOG_LOGIC("Schedule TransmitCompleteEvent in " << txCompleteTime.As(Time::S));
@@ -249,6 +371,11 @@ PointToPointNetDevice::TransmitStart(Ptr<Packet> p)
     {
         m_phyTxDropTrace(p);
     }
+    else
+    {
+        m_txPackets++;
+        g_txPackets++;
+    }
     return result;
 }
 
@@ -256,6 +383,7 @@ void
 PointToPointNetDevice::TransmitComplete()
 {
     NS_LOG_FUNCTION(this);
+    g_events++;
 
     //
     // This function is called to when we're all done transmitting a packet.
@@ -283,7 +411,7 @@ PointToPointNetDevice::TransmitComplete()
     //
     m_snifferTrace(p);
     m_promiscSnifferTrace(p);
-    TransmitStart(p);
+    TransmitStart(p, false);
 }
 
 bool
@@ -323,6 +451,9 @@ PointToPointNetDevice::Receive(Ptr<Packet> packet)
 {
     NS_LOG_FUNCTION(this << packet);
     uint16_t protocol = 0;
+    m_rxPackets++;
+    g_rxPackets++;
+    g_events++;
 
     if (m_receiveErrorModel && m_receiveErrorModel->IsCorrupt(packet))
     {
@@ -343,6 +474,16 @@ PointToPointNetDevice::Receive(Ptr<Packet> packet)
         m_promiscSnifferTrace(packet);
         m_phyRxEndTrace(packet);
 
+        //
+        // A frame delivered to a port which cannot forward it is received
+        // at its last bit: it leaves the link layer without a tag.
+        //
+        if (g_cutThrough.load(std::memory_order_relaxed) && !IsCutThroughPort())
+        {
+            CutThroughTag tag;
+            packet->RemovePacketTag(tag);
+        }
+
         //
         // Trace sinks will expect complete packets, not packets without some of the
         // headers.
@@ -536,7 +677,7 @@ PointToPointNetDevice::Send(Ptr<Packet> packet, const Address& dest, uint16_t pr
             packet = m_queue->Dequeue();
             m_snifferTrace(packet);
             m_promiscSnifferTrace(packet);
-            bool ret = TransmitStart(packet);
+            bool ret = TransmitStart(packet, true);
             return ret;
         }
         return true;
@@ -88,6 +88,62 @@ class PointToPointNetDevice : public NetDevice
      */
     void SetDataRate(DataRate bps);
 
+    /**
+     * Get the Data Rate used for transmission of packets, without the
+     * attribute system.
+     *
+     * @returns the data rate at which this object operates
+     */
+    DataRate GetDataRate() const;
+
+    /**
+     * @returns the number of packets this device started to transmit on
+     *          the channel
+     */
+    uint64_t GetTxPacketCount() const;
+
+    /**
+     * @returns the number of packets this device received from the channel
+     */
+    uint64_t GetRxPacketCount() const;
+
+    /**
+     * Set the number of bytes of a frame this device receives before it
+     * passes the frame up, so that a switch can forward it by cut-through.
+     *
+     * The channel delivers a frame to the device when its first \p bytes
+     * are received, instead of its last bit. If the egress device of the
+     * frame is idle, it starts the transmission at once, but does not
+     * finish it before the last bit of the frame is received, i.e., it
+     * starts late enough not to run out of bits when it is faster than
+     * the ingress link. If the egress device is busy, the frame is stored:
+     * its transmission does not start before its last bit is received.
+     * This costs no event beyond those of store-and-forward.
+     *
+     * Only the forwarding ports use cut-through, i.e., those whose node has
+     * another point-to-point device: a host receives its frames at their
+     * last bit, and passes them up without the tag even if \p bytes is set.
+     * The traces of the reception, e.g., PhyRxEnd, are fired when the frame
+     * is delivered.
+     *
+     * @param bytes the number of bytes, e.g., those of the headers a
+     *        switch reads to forward a frame, or 0 for store-and-forward.
+     */
+    void SetCutThroughBytes(uint32_t bytes);
+
+    /**
+     * @returns the number of bytes of a frame this device receives before it
+     *          passes the frame up, or 0 for store-and-forward
+     */
+    uint32_t GetCutThroughBytes() const;
+
+    /**
+     * @returns true if this device receives the frames after their first
+     *          CutThroughBytes, i.e., cut-through is enabled and the node has
+     *          another point-to-point device to forward the frames to
+     */
+    bool IsCutThroughPort() const;
+
     /**
      * Set the interframe gap used to separate packets.  The interframe gap
      * defines the minimum space required between packets sent by this device.
@@ -137,7 +193,7 @@ class PointToPointNetDevice : public NetDevice
      * The PointToPointNetDevice receives packets from its connected channel
      * and forwards them up the protocol stack.  This is the public method
      * used by the channel to indicate that the last bit of a packet has
-     * arrived at the device.
+     * arrived at the device, or its first bytes in cut-through mode.
      *
      * @param p Ptr to the received packet.
      */
@@ -238,9 +294,11 @@ class PointToPointNetDevice : public NetDevice
      * @see PointToPointChannel::TransmitStart ()
      * @see TransmitComplete()
      * @param p a reference to the packet to send
+     * @param cutThrough whether the packet may be sent before it is
+     *        completely received, i.e., it did not wait in the queue
      * @returns true if success, false on failure
      */
-    bool TransmitStart(Ptr<Packet> p);
+    bool TransmitStart(Ptr<Packet> p, bool cutThrough);
 
     /**
      * Stop Sending a Packet Down the Wire and Begin the Interframe Gap.
@@ -433,6 +491,11 @@ class PointToPointNetDevice : public NetDevice
 
     Ptr<Packet> m_currentPkt; //!< Current packet processed
 
+    uint64_t m_txPackets; //!< Packets transmitted on the channel
+    uint64_t m_rxPackets; //!< Packets received from the channel
+
+    uint32_t m_cutThroughBytes; //!< Bytes received before a frame is passed up, 0 if none
+
     /**
      * @brief PPP to Ethernet protocol number mapping
      * @param protocol A PPP protocol number
@@ -6,6 +6,7 @@
  * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
  */
 
+#include "ns3/cut-through-tag.h"
 #include "ns3/drop-tail-queue.h"
 #include "ns3/net-device-queue-interface.h"
 #include "ns3/point-to-point-channel.h"
@@ -14,6 +15,7 @@
 #include "ns3/test.h"
 
 #include <string>
+#include <vector>
 
 using namespace ns3;
 
@@ -128,6 +130,194 @@ PointToPointTest::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @brief Test of the cut-through mode of PointToPointNetDevice
+ *
+ * A switch forwards a frame from a host to another, passing it from its
+ * ingress device to its egress device as soon as it is received.
+ */
+class PointToPointCutThroughTest : public TestCase
+{
+  public:
+    /**
+     * @brief Create the test
+     */
+    PointToPointCutThroughTest();
+
+    /**
+     * @brief Run the test
+     */
+    void DoRun() override;
+
+  private:
+    /**
+     * @brief Send a frame from the first host to the second one
+     *
+     * @param cutThroughBytes The bytes received by the switch before it forwards a frame.
+     * @param egressRate The data rate of the link from the switch to the second host.
+     * @param busyEgress Whether the switch sends a frame of its own first.
+     * @param [out] events The number of events executed.
+     * @param hostCutThrough Whether the second host enables cut-through too.
+     * @return The time at which the second host receives the frame.
+     */
+    Time Forward(uint32_t cutThroughBytes,
+                 DataRate egressRate,
+                 bool busyEgress,
+                 uint64_t& events,
+                 bool hostCutThrough = false);
+
+    /**
+     * @brief Callback function which forwards the frames received by the switch
+     *
+     * @param dev The receiving device.
+     * @param pkt The received packet.
+     * @param mode The protocol mode used.
+     * @param sender The sender address.
+     *
+     * @return A boolean indicating packet handled properly.
+     */
+    bool SwitchRx(Ptr<NetDevice> dev, Ptr<const Packet> pkt, uint16_t mode, const Address& sender);
+
+    /**
+     * @brief Callback function which records the time the second host receives a frame
+     *
+     * @param dev The receiving device.
+     * @param pkt The received packet.
+     * @param mode The protocol mode used.
+     * @param sender The sender address.
+     *
+     * @return A boolean indicating packet handled properly.
+     */
+    bool HostRx(Ptr<NetDevice> dev, Ptr<const Packet> pkt, uint16_t mode, const Address& sender);
+
+    Ptr<PointToPointNetDevice> m_egress; //!< egress device of the switch
+    std::vector<Time> m_rxTimes;         //!< times the second host received frames
+    uint32_t m_rxTags;                   //!< cut-through tags received by the second host
+};
+
+PointToPointCutThroughTest::PointToPointCutThroughTest()
+    : TestCase("PointToPoint cut-through"),
+      m_rxTags(0)
+{
+}
+
+bool
+PointToPointCutThroughTest::SwitchRx(Ptr<NetDevice> dev,
+                                     Ptr<const Packet> pkt,
+                                     uint16_t mode,
+                                     const Address& sender)
+{
+    m_egress->Send(pkt->Copy(), m_egress->GetBroadcast(), mode);
+    return true;
+}
+
+bool
+PointToPointCutThroughTest::HostRx(Ptr<NetDevice> dev,
+                                   Ptr<const Packet> pkt,
+                                   uint16_t mode,
+                                   const Address& sender)
+{
+    m_rxTimes.push_back(Simulator::Now());
+    CutThroughTag tag;
+    if (pkt->PeekPacketTag(tag))
+    {
+        m_rxTags++;
+    }
+    return true;
+}
+
+Time
+PointToPointCutThroughTest::Forward(uint32_t cutThroughBytes,
+                                    DataRate egressRate,
+                                    bool busyEgress,
+                                    uint64_t& events,
+                                    bool hostCutThrough)
+{
+    // host - switch - host, with the devices in this order
+    Ptr<Node> nodes[3];
+    Ptr<PointToPointNetDevice> devices[4];
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        nodes[i] = CreateObject<Node>();
+    }
+    for (uint32_t link = 0; link < 2; link++)
+    {
+        Ptr<PointToPointChannel> channel = CreateObject<PointToPointChannel>();
+        channel->SetAttribute("Delay", TimeValue(MicroSeconds(10)));
+        for (uint32_t end = 0; end < 2; end++)
+        {
+            Ptr<PointToPointNetDevice> device = CreateObject<PointToPointNetDevice>();
+            device->Attach(channel);
+            device->SetAddress(Mac48Address::Allocate());
+            device->SetQueue(CreateObject<DropTailQueue<Packet>>());
+            device->SetDataRate(link == 0 ? DataRate("8Mbps") : egressRate);
+            nodes[link + end]->AddDevice(device);
+            devices[2 * link + end] = device;
+        }
+    }
+    devices[1]->SetCutThroughBytes(cutThroughBytes);
+    devices[3]->SetCutThroughBytes(hostCutThrough ? cutThroughBytes : 0);
+    devices[1]->SetReceiveCallback(MakeCallback(&PointToPointCutThroughTest::SwitchRx, this));
+    devices[3]->SetReceiveCallback(MakeCallback(&PointToPointCutThroughTest::HostRx, this));
+    m_egress = devices[2];
+    m_rxTimes.clear();
+    m_rxTags = 0;
+
+    // 1000 bytes with the PPP header, i.e., 1 ms at 8 Mb/s
+    Ptr<PointToPointNetDevice> host = devices[0];
+    Simulator::ScheduleNow([host] {
+        host->Send(Create<Packet>(998), host->GetBroadcast(), 0x800);
+    });
+    if (busyEgress)
+    {
+        Ptr<PointToPointNetDevice> egress = devices[2];
+        Simulator::ScheduleNow([egress] {
+            egress->Send(Create<Packet>(498), egress->GetBroadcast(), 0x800);
+        });
+    }
+    Simulator::Run();
+    events = Simulator::GetEventCount();
+    Simulator::Destroy();
+    m_egress = nullptr;
+
+    NS_TEST_EXPECT_MSG_EQ(m_rxTimes.size(), (busyEgress ? 2 : 1), "frames received");
+    NS_TEST_EXPECT_MSG_EQ(m_rxTags, 0, "the host received a cut-through tag");
+    return m_rxTimes.empty() ? Time() : m_rxTimes.back();
+}
+
+void
+PointToPointCutThroughTest::DoRun()
+{
+    uint64_t storeAndForwardEvents;
+    uint64_t events;
+
+    // store-and-forward: two transmissions and two propagation delays
+    Time rxTime = Forward(0, DataRate("8Mbps"), false, storeAndForwardEvents);
+    NS_TEST_EXPECT_MSG_EQ(rxTime, MicroSeconds(2020), "store-and-forward");
+
+    // the switch forwards the frame after its first 64 bytes
+    rxTime = Forward(64, DataRate("8Mbps"), false, events);
+    NS_TEST_EXPECT_MSG_EQ(rxTime, MicroSeconds(64 + 10 + 1000 + 10), "cut-through");
+    NS_TEST_EXPECT_MSG_EQ(events, storeAndForwardEvents, "cut-through adds no event");
+
+    // a faster egress link does not run out of bits: the last bit leaves
+    // the switch when it arrives
+    rxTime = Forward(64, DataRate("16Mbps"), false, events);
+    NS_TEST_EXPECT_MSG_EQ(rxTime, MicroSeconds(1000 + 10 + 10), "cut-through to a faster link");
+
+    // a busy egress link queues the frame, which leaves once received
+    rxTime = Forward(64, DataRate("8Mbps"), true, events);
+    NS_TEST_EXPECT_MSG_EQ(rxTime, MicroSeconds(2020), "cut-through to a busy link");
+
+    // a host is not a forwarding port: it receives the frame at its last bit
+    rxTime = Forward(64, DataRate("8Mbps"), false, events, true);
+    NS_TEST_EXPECT_MSG_EQ(rxTime, MicroSeconds(64 + 10 + 1000 + 10), "cut-through to a host");
+
+    // the frames no larger than the cut-through bytes are stored and forwarded
+    rxTime = Forward(1000, DataRate("8Mbps"), false, events);
+    NS_TEST_EXPECT_MSG_EQ(rxTime, MicroSeconds(2020), "small frame");
+}
+
 /**
  * @brief TestSuite for PointToPoint module
  */
@@ -144,6 +334,7 @@ PointToPointTestSuite::PointToPointTestSuite()
     : TestSuite("devices-point-to-point", Type::UNIT)
 {
     AddTestCase(new PointToPointTest, TestCase::Duration::QUICK);
+    AddTestCase(new PointToPointCutThroughTest, TestCase::Duration::QUICK);
 }
 
 static PointToPointTestSuite g_pointToPointTestSuite; //!< The testsuite
@@ -0,0 +1,253 @@
+//
+// SPDX-License-Identifier: GPL-2.0-only
+//
+
+#include "columnar-reader.h"
+
+#include "ns3/log.h"
+
+#include <cstring>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("ColumnarReader");
+
+ColumnarReader::ColumnarReader()
+    : m_rowSize(0),
+      m_nRows(0),
+      m_complete(false)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+bool
+ColumnarReader::Open(const std::string& fileName)
+{
+    NS_LOG_FUNCTION(this << fileName);
+    Close();
+
+    m_file.open(fileName, std::ios::in | std::ios::binary);
+    if (!m_file.is_open())
+    {
+        NS_LOG_WARN("Unable to open " << fileName);
+        return false;
+    }
+    m_file.seekg(0, std::ios::end);
+    std::streamoff fileSize = m_file.tellg();
+    m_file.seekg(0, std::ios::beg);
+
+    auto read = [this](auto& v) {
+        m_file.read(reinterpret_cast<char*>(&v), sizeof(v));
+        return m_file.good();
+    };
+
+    char magic[8];
+    uint32_t byteOrder;
+    uint32_t nColumns;
+    if (!read(magic) || std::memcmp(magic, "NS3COL1", sizeof(magic)) != 0 || !read(byteOrder) ||
+        byteOrder != 0x01020304 || !read(nColumns))
+    {
+        NS_LOG_WARN(fileName << " is not a columnar file written on this platform");
+        Close();
+        return false;
+    }
+
+    for (uint32_t i = 0; i < nColumns; i++)
+    {
+        Column column;
+        uint8_t type;
+        uint16_t nameLength;
+        if (!read(type) || !read(nameLength))
+        {
+            Close();
+            return false;
+        }
+        column.type = static_cast<ColumnarWriter::ColumnType>(type);
+        column.size = ColumnarWriter::GetTypeSize(column.type);
+        column.offset = m_rowSize;
+        column.name.resize(nameLength);
+        m_file.read(column.name.data(), nameLength);
+        if (!m_file.good() || column.size == 0)
+        {
+            NS_LOG_WARN("Bad schema in " << fileName);
+            Close();
+            return false;
+        }
+        m_rowSize += column.size;
+        m_columns.push_back(column);
+    }
+
+    // index the blocks, stopping at the end marker or at a truncated block
+    while (true)
+    {
+        uint32_t nRows;
+        if (!read(nRows))
+        {
+            break;
+        }
+        if (nRows == 0)
+        {
+            m_complete = true;
+            break;
+        }
+        Block block;
+        block.position = m_file.tellg();
+        block.nRows = nRows;
+        std::streamoff end = block.position + static_cast<std::streamoff>(nRows) * m_rowSize;
+        if (end > fileSize)
+        {
+            break;
+        }
+        m_blocks.push_back(block);
+        m_nRows += nRows;
+        m_file.seekg(end);
+    }
+    if (!m_complete)
+    {
+        NS_LOG_WARN(fileName << " is truncated, reading " << m_nRows << " rows");
+    }
+    m_file.clear();
+    return true;
+}
+
+void
+ColumnarReader::Close()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_file.is_open())
+    {
+        m_file.close();
+    }
+    m_file.clear();
+    m_columns.clear();
+    m_blocks.clear();
+    m_rowSize = 0;
+    m_nRows = 0;
+    m_complete = false;
+}
+
+uint32_t
+ColumnarReader::GetNColumns() const
+{
+    return m_columns.size();
+}
+
+std::string
+ColumnarReader::GetColumnName(uint32_t column) const
+{
+    NS_ASSERT(column < m_columns.size());
+    return m_columns[column].name;
+}
+
+ColumnarWriter::ColumnType
+ColumnarReader::GetColumnType(uint32_t column) const
+{
+    NS_ASSERT(column < m_columns.size());
+    return m_columns[column].type;
+}
+
+int32_t
+ColumnarReader::GetColumnIndex(const std::string& name) const
+{
+    for (uint32_t i = 0; i < m_columns.size(); i++)
+    {
+        if (m_columns[i].name == name)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+uint64_t
+ColumnarReader::GetNRows() const
+{
+    return m_nRows;
+}
+
+bool
+ColumnarReader::IsComplete() const
+{
+    return m_complete;
+}
+
+template <typename T>
+bool
+ColumnarReader::DoReadColumn(uint32_t column, std::vector<T>& values)
+{
+    NS_LOG_FUNCTION(this << column);
+    values.clear();
+    if (!m_file.is_open() || column >= m_columns.size())
+    {
+        return false;
+    }
+    const Column& c = m_columns[column];
+    values.reserve(m_nRows);
+
+    std::vector<char> buffer;
+    for (const auto& block : m_blocks)
+    {
+        // the columns of a block follow each other
+        std::size_t bytes = static_cast<std::size_t>(block.nRows) * c.size;
+        buffer.resize(bytes);
+        m_file.seekg(block.position + static_cast<std::streamoff>(block.nRows) * c.offset);
+        m_file.read(buffer.data(), bytes);
+        if (!m_file.good())
+        {
+            m_file.clear();
+            return false;
+        }
+        for (std::size_t i = 0; i < bytes; i += c.size)
+        {
+            switch (c.type)
+            {
+            case ColumnarWriter::UINT32: {
+                uint32_t v;
+                std::memcpy(&v, buffer.data() + i, sizeof(v));
+                values.push_back(static_cast<T>(v));
+                break;
+            }
+            case ColumnarWriter::UINT64: {
+                uint64_t v;
+                std::memcpy(&v, buffer.data() + i, sizeof(v));
+                values.push_back(static_cast<T>(v));
+                break;
+            }
+            case ColumnarWriter::INT64: {
+                int64_t v;
+                std::memcpy(&v, buffer.data() + i, sizeof(v));
+                values.push_back(static_cast<T>(v));
+                break;
+            }
+            case ColumnarWriter::DOUBLE: {
+                double v;
+                std::memcpy(&v, buffer.data() + i, sizeof(v));
+                values.push_back(static_cast<T>(v));
+                break;
+            }
+            }
+        }
+    }
+    return true;
+}
+
+bool
+ColumnarReader::ReadColumn(uint32_t column, std::vector<double>& values)
+{
+    return DoReadColumn(column, values);
+}
+
+bool
+ColumnarReader::ReadColumn(uint32_t column, std::vector<uint64_t>& values)
+{
+    return DoReadColumn(column, values);
+}
+
+bool
+ColumnarReader::ReadColumn(uint32_t column, std::vector<int64_t>& values)
+{
+    return DoReadColumn(column, values);
+}
+
+} // namespace ns3
@@ -0,0 +1,137 @@
+//
+// SPDX-License-Identifier: GPL-2.0-only
+//
+
+#ifndef NS3_COLUMNAR_READER_H
+#define NS3_COLUMNAR_READER_H
+
+#include "columnar-writer.h"
+
+#include <fstream>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * @ingroup stats
+ * @brief Reads the files written by ColumnarWriter.
+ *
+ * Open() reads the schema and indexes the blocks; a column is then read
+ * on its own, seeking over the data of the other columns.
+ */
+class ColumnarReader
+{
+  public:
+    ColumnarReader();
+
+    /**
+     * @brief Open a file and read its schema and block index.
+     * @param fileName the file name
+     * @return false if the file cannot be read or is not a columnar file
+     */
+    bool Open(const std::string& fileName);
+
+    /**
+     * @brief Close the file.
+     */
+    void Close();
+
+    /**
+     * @return the number of columns
+     */
+    uint32_t GetNColumns() const;
+
+    /**
+     * @param column the column index
+     * @return the column name
+     */
+    std::string GetColumnName(uint32_t column) const;
+
+    /**
+     * @param column the column index
+     * @return the column type
+     */
+    ColumnarWriter::ColumnType GetColumnType(uint32_t column) const;
+
+    /**
+     * @brief Find a column by name.
+     * @param name the column name
+     * @return the column index, or -1 if there is no such column
+     */
+    int32_t GetColumnIndex(const std::string& name) const;
+
+    /**
+     * @return the number of rows in the complete blocks of the file
+     */
+    uint64_t GetNRows() const;
+
+    /**
+     * @return true if the file has the end marker written by ColumnarWriter::Close()
+     */
+    bool IsComplete() const;
+
+    /**
+     * @brief Read all the values of a column, converted to double.
+     * @param column the column index
+     * @param [out] values the values
+     * @return true on success
+     */
+    bool ReadColumn(uint32_t column, std::vector<double>& values);
+
+    /**
+     * @brief Read all the values of a column, converted to uint64_t.
+     * @param column the column index
+     * @param [out] values the values
+     * @return true on success
+     */
+    bool ReadColumn(uint32_t column, std::vector<uint64_t>& values);
+
+    /**
+     * @brief Read all the values of a column, converted to int64_t.
+     * @param column the column index
+     * @param [out] values the values
+     * @return true on success
+     */
+    bool ReadColumn(uint32_t column, std::vector<int64_t>& values);
+
+  private:
+    /// A column of the schema
+    struct Column
+    {
+        std::string name;                //!< column name
+        ColumnarWriter::ColumnType type; //!< value type
+        uint32_t size;                   //!< value size in bytes
+        uint32_t offset;                 //!< offset of the column in a one-row block
+    };
+
+    /// A block of rows
+    struct Block
+    {
+        std::streamoff position; //!< file position of the first value
+        uint32_t nRows;          //!< number of rows
+    };
+
+    /**
+     * @brief Read a column, converting the values.
+     * @tparam T the output value type
+     * @param column the column index
+     * @param [out] values the values
+     * @return true on success
+     */
+    template <typename T>
+    bool DoReadColumn(uint32_t column, std::vector<T>& values);
+
+    std::ifstream m_file;          //!< The input file
+    std::vector<Column> m_columns; //!< The schema
+    std::vector<Block> m_blocks;   //!< The complete blocks
+    uint32_t m_rowSize;            //!< Size of a row in bytes
+    uint64_t m_nRows;              //!< Number of rows
+    bool m_complete;               //!< End marker found
+};
+
+} // namespace ns3
+
+#endif /* NS3_COLUMNAR_READER_H */
@@ -0,0 +1,157 @@
+//
+// SPDX-License-Identifier: GPL-2.0-only
+//
+
+#include "columnar-writer.h"
+
+#include "ns3/abort.h"
+#include "ns3/log.h"
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("ColumnarWriter");
+
+ColumnarWriter::ColumnarWriter()
+    : m_rowsPerBlock(0),
+      m_bufferedRows(0),
+      m_nRows(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+ColumnarWriter::~ColumnarWriter()
+{
+    NS_LOG_FUNCTION(this);
+    if (IsOpen())
+    {
+        Close();
+    }
+}
+
+uint32_t
+ColumnarWriter::GetTypeSize(ColumnType type)
+{
+    switch (type)
+    {
+    case UINT32:
+        return sizeof(uint32_t);
+    case UINT64:
+        return sizeof(uint64_t);
+    case INT64:
+        return sizeof(int64_t);
+    case DOUBLE:
+        return sizeof(double);
+    }
+    return 0;
+}
+
+uint32_t
+ColumnarWriter::AddColumn(const std::string& name, ColumnType type)
+{
+    NS_LOG_FUNCTION(this << name << +type);
+    NS_ABORT_MSG_IF(IsOpen(), "Columns must be added before the file is opened");
+    NS_ABORT_MSG_IF(name.size() > UINT16_MAX, "Column name too long");
+    Column column;
+    column.name = name;
+    column.type = type;
+    column.size = GetTypeSize(type);
+    NS_ABORT_MSG_UNLESS(column.size, "Unknown column type " << +type);
+    m_columns.push_back(column);
+    return m_columns.size() - 1;
+}
+
+void
+ColumnarWriter::Open(const std::string& fileName, uint32_t rowsPerBlock)
+{
+    NS_LOG_FUNCTION(this << fileName << rowsPerBlock);
+    NS_ABORT_MSG_IF(IsOpen(), "ColumnarWriter is already open");
+    NS_ABORT_MSG_IF(m_columns.empty(), "ColumnarWriter has no columns");
+    NS_ABORT_MSG_IF(rowsPerBlock == 0, "Blocks must hold at least one row");
+
+    m_file.open(fileName, std::ios::out | std::ios::binary | std::ios::trunc);
+    NS_ABORT_MSG_UNLESS(m_file.is_open(), "Unable to open " << fileName << " for writing");
+
+    m_rowsPerBlock = rowsPerBlock;
+    m_bufferedRows = 0;
+    m_nRows = 0;
+
+    const char magic[8] = "NS3COL1";
+    uint32_t byteOrder = 0x01020304;
+    uint32_t nColumns = m_columns.size();
+    m_file.write(magic, sizeof(magic));
+    m_file.write(reinterpret_cast<const char*>(&byteOrder), sizeof(byteOrder));
+    m_file.write(reinterpret_cast<const char*>(&nColumns), sizeof(nColumns));
+    for (auto& column : m_columns)
+    {
+        uint16_t nameLength = column.name.size();
+        m_file.write(reinterpret_cast<const char*>(&column.type), sizeof(column.type));
+        m_file.write(reinterpret_cast<const char*>(&nameLength), sizeof(nameLength));
+        m_file.write(column.name.data(), nameLength);
+        column.data.assign(static_cast<std::size_t>(rowsPerBlock) * column.size, 0);
+    }
+}
+
+bool
+ColumnarWriter::IsOpen() const
+{
+    return m_file.is_open();
+}
+
+void
+ColumnarWriter::EndRow()
+{
+    NS_ASSERT_MSG(IsOpen(), "ColumnarWriter is not open");
+    m_bufferedRows++;
+    m_nRows++;
+    if (m_bufferedRows == m_rowsPerBlock)
+    {
+        Flush();
+    }
+}
+
+void
+ColumnarWriter::Flush()
+{
+    NS_LOG_FUNCTION(this << m_bufferedRows);
+    if (!IsOpen() || m_bufferedRows == 0)
+    {
+        return;
+    }
+    m_file.write(reinterpret_cast<const char*>(&m_bufferedRows), sizeof(m_bufferedRows));
+    for (auto& column : m_columns)
+    {
+        std::size_t bytes = static_cast<std::size_t>(m_bufferedRows) * column.size;
+        m_file.write(reinterpret_cast<const char*>(column.data.data()), bytes);
+        std::memset(column.data.data(), 0, bytes);
+    }
+    m_bufferedRows = 0;
+    NS_ABORT_MSG_UNLESS(m_file.good(), "Error writing the columnar file");
+}
+
+void
+ColumnarWriter::Close()
+{
+    NS_LOG_FUNCTION(this);
+    if (!IsOpen())
+    {
+        return;
+    }
+    Flush();
+    uint32_t endMarker = 0;
+    m_file.write(reinterpret_cast<const char*>(&endMarker), sizeof(endMarker));
+    m_file.close();
+    for (auto& column : m_columns)
+    {
+        column.data.clear();
+        column.data.shrink_to_fit();
+    }
+}
+
+uint64_t
+ColumnarWriter::GetNRows() const
+{
+    return m_nRows;
+}
+
+} // namespace ns3
@@ -0,0 +1,176 @@
+//
+// SPDX-License-Identifier: GPL-2.0-only
+//
+
+#ifndef NS3_COLUMNAR_WRITER_H
+#define NS3_COLUMNAR_WRITER_H
+
+#include "ns3/assert.h"
+
+#include <cstring>
+#include <fstream>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * @ingroup stats
+ * @brief Streams a table of numbers to a binary, column-oriented file.
+ *
+ * The table schema (column names and types) is declared with AddColumn()
+ * before the file is opened. Rows are then filled with Set() and committed
+ * with EndRow(). Rows are buffered column by column in blocks of a fixed
+ * number of rows, and each full block is written to the file, so the
+ * memory used is bounded by the block size whatever the number of rows.
+ *
+ * File layout (host byte order, checked by the reader):
+ * \verbatim
+   char     magic[8]        "NS3COL1"
+   uint32_t byteOrder       0x01020304
+   uint32_t nColumns
+   nColumns x { uint8_t type; uint16_t nameLength; char name[nameLength]; }
+   blocks:  uint32_t nRows (> 0), then for each column nRows values
+   uint32_t 0               end marker, written by Close()
+   \endverbatim
+ *
+ * A file missing the end marker (e.g., the simulation was interrupted)
+ * can still be read up to the last complete block. See ColumnarReader.
+ */
+class ColumnarWriter
+{
+  public:
+    /// The type of the values of a column
+    enum ColumnType : uint8_t
+    {
+        UINT32 = 0, //!< uint32_t
+        UINT64 = 1, //!< uint64_t
+        INT64 = 2,  //!< int64_t
+        DOUBLE = 3, //!< double
+    };
+
+    ColumnarWriter();
+    ~ColumnarWriter();
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    ColumnarWriter(const ColumnarWriter&) = delete;
+    ColumnarWriter& operator=(const ColumnarWriter&) = delete;
+
+    /**
+     * @brief Returns the size in bytes of a value of a given type.
+     * @param type the column type
+     * @return the size in bytes
+     */
+    static uint32_t GetTypeSize(ColumnType type);
+
+    /**
+     * @brief Declare a column. Columns can only be added before Open().
+     * @param name the column name
+     * @param type the type of the values
+     * @return the column index, to be used with Set()
+     */
+    uint32_t AddColumn(const std::string& name, ColumnType type);
+
+    /**
+     * @brief Create the file and write the schema header.
+     * @param fileName the file name
+     * @param rowsPerBlock the number of rows buffered before a block is written
+     */
+    void Open(const std::string& fileName, uint32_t rowsPerBlock = 4096);
+
+    /**
+     * @return true if the file is open
+     */
+    bool IsOpen() const;
+
+    /**
+     * @brief Set a value of the current row. Values that are not set are zero.
+     * @tparam T an arithmetic type, converted to the column type
+     * @param column the column index
+     * @param value the value
+     */
+    template <typename T>
+    void Set(uint32_t column, T value);
+
+    /**
+     * @brief Commit the current row, writing a block if the buffer is full.
+     */
+    void EndRow();
+
+    /**
+     * @brief Write the buffered rows as a block.
+     */
+    void Flush();
+
+    /**
+     * @brief Flush the buffered rows, write the end marker and close the file.
+     */
+    void Close();
+
+    /**
+     * @return the number of rows committed so far
+     */
+    uint64_t GetNRows() const;
+
+  private:
+    /// A declared column
+    struct Column
+    {
+        std::string name;          //!< column name
+        ColumnType type;           //!< value type
+        uint32_t size;             //!< value size in bytes
+        std::vector<uint8_t> data; //!< values of the buffered rows
+    };
+
+    /**
+     * @brief Store a value of the current row.
+     * @tparam V the column value type
+     * @param column the column
+     * @param value the value
+     */
+    template <typename V>
+    void Store(Column& column, V value);
+
+    std::vector<Column> m_columns; //!< The table schema and buffers
+    std::ofstream m_file;          //!< The output file
+    uint32_t m_rowsPerBlock;       //!< Rows per block
+    uint32_t m_bufferedRows;       //!< Rows committed but not yet written
+    uint64_t m_nRows;              //!< Rows committed
+};
+
+template <typename V>
+void
+ColumnarWriter::Store(Column& column, V value)
+{
+    std::memcpy(column.data.data() + m_bufferedRows * sizeof(V), &value, sizeof(V));
+}
+
+template <typename T>
+void
+ColumnarWriter::Set(uint32_t column, T value)
+{
+    NS_ASSERT_MSG(column < m_columns.size(), "Unknown column " << column);
+    NS_ASSERT_MSG(IsOpen(), "ColumnarWriter is not open");
+    Column& c = m_columns[column];
+    switch (c.type)
+    {
+    case UINT32:
+        Store(c, static_cast<uint32_t>(value));
+        break;
+    case UINT64:
+        Store(c, static_cast<uint64_t>(value));
+        break;
+    case INT64:
+        Store(c, static_cast<int64_t>(value));
+        break;
+    case DOUBLE:
+        Store(c, static_cast<double>(value));
+        break;
+    }
+}
+
+} // namespace ns3
+
+#endif /* NS3_COLUMNAR_WRITER_H */
@@ -0,0 +1,337 @@
+//
+// SPDX-License-Identifier: GPL-2.0-only
+//
+
+#include "quantile-sketch.h"
+
+#include "ns3/abort.h"
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <cmath>
+
+#define DEFAULT_RELATIVE_ACCURACY 0.01
+#define DEFAULT_MAX_BINS 2048
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("QuantileSketch");
+
+QuantileSketch::QuantileSketch(double relativeAccuracy, uint32_t maxBins)
+    : m_offset(0),
+      m_zeroCount(0),
+      m_count(0),
+      m_min(0),
+      m_max(0)
+{
+    SetAccuracy(relativeAccuracy, maxBins);
+}
+
+QuantileSketch::QuantileSketch()
+    : QuantileSketch(DEFAULT_RELATIVE_ACCURACY, DEFAULT_MAX_BINS)
+{
+}
+
+void
+QuantileSketch::SetAccuracy(double relativeAccuracy, uint32_t maxBins)
+{
+    NS_ASSERT(m_count == 0); // we can only change the accuracy if no values were added
+    NS_ABORT_MSG_UNLESS(relativeAccuracy > 0 && relativeAccuracy < 1,
+                        "Relative accuracy must be in (0, 1)");
+    m_relativeAccuracy = relativeAccuracy;
+    m_gamma = (1 + relativeAccuracy) / (1 - relativeAccuracy);
+    m_logGamma = std::log(m_gamma);
+    m_maxBins = std::max<uint32_t>(maxBins, 1);
+}
+
+double
+QuantileSketch::GetRelativeAccuracy() const
+{
+    return m_relativeAccuracy;
+}
+
+int32_t
+QuantileSketch::GetIndex(double value) const
+{
+    return static_cast<int32_t>(std::ceil(std::log(value) / m_logGamma));
+}
+
+double
+QuantileSketch::GetValue(int32_t index) const
+{
+    // the point of (gamma^(i-1), gamma^i] with the same relative error to both ends
+    return 2 * std::exp(index * m_logGamma) / (1 + m_gamma);
+}
+
+void
+QuantileSketch::AddToBin(int32_t index, uint64_t count)
+{
+    if (m_bins.empty())
+    {
+        m_offset = index;
+        m_bins.assign(1, count);
+        return;
+    }
+
+    int32_t top = m_offset + static_cast<int32_t>(m_bins.size()) - 1;
+    if (index < m_offset)
+    {
+        // values below the stored range fall in the lowest bin when full
+        index = std::max(index, top - static_cast<int32_t>(m_maxBins) + 1);
+        if (index < m_offset)
+        {
+            m_bins.insert(m_bins.begin(), m_offset - index, 0);
+            m_offset = index;
+        }
+    }
+    else if (index > top)
+    {
+        int32_t offset = std::max(m_offset, index - static_cast<int32_t>(m_maxBins) + 1);
+        if (offset > m_offset)
+        {
+            // collapse the lowest bins into the new lowest bin
+            auto shift = static_cast<uint32_t>(offset - m_offset);
+            if (shift >= m_bins.size())
+            {
+                uint64_t total = 0;
+                for (auto c : m_bins)
+                {
+                    total += c;
+                }
+                m_bins.assign(1, total);
+            }
+            else
+            {
+                for (uint32_t i = 0; i < shift; i++)
+                {
+                    m_bins[shift] += m_bins[i];
+                }
+                m_bins.erase(m_bins.begin(), m_bins.begin() + shift);
+            }
+            m_offset = offset;
+        }
+        m_bins.resize(index - m_offset + 1, 0);
+    }
+    m_bins[index - m_offset] += count;
+}
+
+void
+QuantileSketch::AddValue(double value)
+{
+    NS_ASSERT_MSG(value >= 0, "QuantileSketch does not support negative values");
+    if (m_count == 0)
+    {
+        m_min = value;
+        m_max = value;
+    }
+    else
+    {
+        m_min = std::min(m_min, value);
+        m_max = std::max(m_max, value);
+    }
+    m_count++;
+
+    if (value < MIN_VALUE)
+    {
+        m_zeroCount++;
+    }
+    else
+    {
+        AddToBin(GetIndex(value), 1);
+    }
+}
+
+void
+QuantileSketch::Merge(const QuantileSketch& other)
+{
+    NS_ABORT_MSG_UNLESS(m_gamma == other.m_gamma,
+                        "Cannot merge sketches with a different relative accuracy");
+    if (other.m_count == 0)
+    {
+        return;
+    }
+    if (m_count == 0)
+    {
+        m_min = other.m_min;
+        m_max = other.m_max;
+    }
+    else
+    {
+        m_min = std::min(m_min, other.m_min);
+        m_max = std::max(m_max, other.m_max);
+    }
+    m_count += other.m_count;
+    m_zeroCount += other.m_zeroCount;
+
+    // add from the top, so that the stored range is only extended downwards
+    for (std::size_t i = other.m_bins.size(); i > 0; i--)
+    {
+        if (other.m_bins[i - 1])
+        {
+            AddToBin(other.m_offset + static_cast<int32_t>(i - 1), other.m_bins[i - 1]);
+        }
+    }
+}
+
+double
+QuantileSketch::GetQuantile(double q) const
+{
+    if (m_count == 0)
+    {
+        return 0;
+    }
+    if (q <= 0)
+    {
+        return m_min;
+    }
+    if (q >= 1)
+    {
+        return m_max;
+    }
+    auto rank = static_cast<uint64_t>(q * (m_count - 1));
+
+    uint64_t seen = m_zeroCount;
+    if (rank < seen)
+    {
+        return m_min;
+    }
+    for (std::size_t i = 0; i < m_bins.size(); i++)
+    {
+        seen += m_bins[i];
+        if (rank < seen)
+        {
+            return std::clamp(GetValue(m_offset + static_cast<int32_t>(i)), m_min, m_max);
+        }
+    }
+    return m_max;
+}
+
+uint64_t
+QuantileSketch::GetCount() const
+{
+    return m_count;
+}
+
+double
+QuantileSketch::GetMin() const
+{
+    return m_min;
+}
+
+double
+QuantileSketch::GetMax() const
+{
+    return m_max;
+}
+
+uint32_t
+QuantileSketch::GetNBins() const
+{
+    return m_bins.size();
+}
+
+void
+QuantileSketch::Clear()
+{
+    m_bins.clear();
+    m_offset = 0;
+    m_zeroCount = 0;
+    m_count = 0;
+    m_min = 0;
+    m_max = 0;
+}
+
+void
+QuantileSketch::SerializeToXmlStream(std::ostream& os,
+                                     uint16_t indent,
+                                     std::string elementName) const
+{
+    os << std::string(indent, ' ') << "<" << elementName << " count=\"" << m_count << "\""
+       << " min=\"" << m_min << "\""
+       << " max=\"" << m_max << "\""
+       << " p50=\"" << GetQuantile(0.5) << "\""
+       << " p90=\"" << GetQuantile(0.9) << "\""
+       << " p99=\"" << GetQuantile(0.99) << "\""
+       << " p999=\"" << GetQuantile(0.999) << "\""
+       << " relativeAccuracy=\"" << m_relativeAccuracy << "\""
+       << " >\n";
+    indent += 2;
+
+    if (m_zeroCount)
+    {
+        os << std::string(indent, ' ');
+        os << "<bin value=\"0\" count=\"" << m_zeroCount << "\" />\n";
+    }
+    for (std::size_t i = 0; i < m_bins.size(); i++)
+    {
+        if (m_bins[i])
+        {
+            int32_t index = m_offset + static_cast<int32_t>(i);
+            os << std::string(indent, ' ');
+            os << "<bin"
+               << " index=\"" << index << "\""
+               << " value=\"" << GetValue(index) << "\""
+               << " count=\"" << m_bins[i] << "\""
+               << " />\n";
+        }
+    }
+
+    indent -= 2;
+    os << std::string(indent, ' ') << "</" << elementName << ">\n";
+}
+
+void
+QuantileSketch::Serialize(std::ostream& os) const
+{
+    auto write = [&os](const auto& v) { os.write(reinterpret_cast<const char*>(&v), sizeof(v)); };
+    uint32_t nBins = m_bins.size();
+    write(m_relativeAccuracy);
+    write(m_maxBins);
+    write(m_count);
+    write(m_zeroCount);
+    write(m_min);
+    write(m_max);
+    write(m_offset);
+    write(nBins);
+    os.write(reinterpret_cast<const char*>(m_bins.data()), nBins * sizeof(uint64_t));
+}
+
+bool
+QuantileSketch::Deserialize(std::istream& is)
+{
+    auto read = [&is](auto& v) { is.read(reinterpret_cast<char*>(&v), sizeof(v)); };
+    double relativeAccuracy;
+    uint32_t maxBins;
+    uint32_t nBins;
+    read(relativeAccuracy);
+    read(maxBins);
+    if (!is || !(relativeAccuracy > 0 && relativeAccuracy < 1))
+    {
+        return false;
+    }
+    Clear();
+    SetAccuracy(relativeAccuracy, maxBins);
+    read(m_count);
+    read(m_zeroCount);
+    read(m_min);
+    read(m_max);
+    read(m_offset);
+    read(nBins);
+    if (!is || nBins > m_maxBins)
+    {
+        Clear();
+        return false;
+    }
+    m_bins.resize(nBins);
+    is.read(reinterpret_cast<char*>(m_bins.data()), nBins * sizeof(uint64_t));
+    if (!is)
+    {
+        Clear();
+        return false;
+    }
+    return true;
+}
+
+} // namespace ns3
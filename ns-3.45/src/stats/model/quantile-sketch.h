@@ -0,0 +1,184 @@
+//
+// SPDX-License-Identifier: GPL-2.0-only
+//
+
+#ifndef NS3_QUANTILE_SKETCH_H
+#define NS3_QUANTILE_SKETCH_H
+
+#include <istream>
+#include <ostream>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * @brief Mergeable streaming quantile estimator with bounded memory.
+ *
+ * This is a DDSketch: positive values are counted in logarithmically sized
+ * bins, so that any quantile is estimated within a fixed \a relative error
+ * of the exact value, independently of the number of values added. With a
+ * relative accuracy \f$\alpha\f$, bin \a i holds the values in
+ * \f$(\gamma^{i-1}, \gamma^i]\f$ with \f$\gamma = (1+\alpha)/(1-\alpha)\f$.
+ *
+ * Only the range of bins between the smallest and the largest value seen
+ * is stored. When that range exceeds the configured maximum number of
+ * bins, the lowest bins are collapsed together: the memory used is then
+ * constant, and only the accuracy of the lowest quantiles degrades, which
+ * is the right trade-off for latency tails.
+ *
+ * Two sketches with the same relative accuracy can be merged exactly, e.g.,
+ * to combine flows or the results of several simulation runs.
+ *
+ * Negative values are not supported. Values smaller than
+ * QuantileSketch::MIN_VALUE are counted as zero.
+ */
+class QuantileSketch
+{
+  public:
+    /// Values below this threshold are counted as zero
+    static constexpr double MIN_VALUE = 1e-12;
+
+    /**
+     * @brief Constructor
+     * @param relativeAccuracy the relative accuracy of the quantile estimates, in (0, 1)
+     * @param maxBins the maximum number of bins stored
+     */
+    QuantileSketch(double relativeAccuracy, uint32_t maxBins = 2048);
+    QuantileSketch();
+
+    /**
+     * @brief Set the accuracy parameters.
+     *
+     * Note that the parameters can be changed only if the sketch is empty.
+     *
+     * @param relativeAccuracy the relative accuracy of the quantile estimates, in (0, 1)
+     * @param maxBins the maximum number of bins stored
+     */
+    void SetAccuracy(double relativeAccuracy, uint32_t maxBins);
+
+    /**
+     * @brief Returns the relative accuracy of the sketch.
+     * @return the relative accuracy
+     */
+    double GetRelativeAccuracy() const;
+
+    /**
+     * @brief Add a value to the sketch
+     * @param value the value to add, must be non-negative
+     */
+    void AddValue(double value);
+
+    /**
+     * @brief Add the values of another sketch to this one.
+     *
+     * Both sketches must have the same relative accuracy.
+     *
+     * @param other the sketch to merge
+     */
+    void Merge(const QuantileSketch& other);
+
+    /**
+     * @brief Estimate a quantile.
+     * @param q the quantile, in [0, 1] (e.g., 0.99 for the 99th percentile)
+     * @return the estimated value (exact for 0 and 1), or 0 if the sketch is empty
+     */
+    double GetQuantile(double q) const;
+
+    /**
+     * @brief Returns the number of values added.
+     * @return the number of values
+     */
+    uint64_t GetCount() const;
+
+    /**
+     * @brief Returns the exact smallest value added.
+     * @return the smallest value, or 0 if the sketch is empty
+     */
+    double GetMin() const;
+
+    /**
+     * @brief Returns the exact largest value added.
+     * @return the largest value, or 0 if the sketch is empty
+     */
+    double GetMax() const;
+
+    /**
+     * @brief Returns the number of bins currently stored.
+     * @return the number of bins
+     */
+    uint32_t GetNBins() const;
+
+    /**
+     * Clear the sketch content.
+     */
+    void Clear();
+
+    /**
+     * @brief Serializes a summary to an std::ostream in XML format.
+     *
+     * The element holds the count, the extrema and the estimated 50th,
+     * 90th, 99th and 99.9th percentiles, plus the non-empty bins.
+     *
+     * @param os the output stream
+     * @param indent number of spaces to use as base indentation level
+     * @param elementName name of the element to serialize.
+     */
+    void SerializeToXmlStream(std::ostream& os, uint16_t indent, std::string elementName) const;
+
+    /**
+     * @brief Write the sketch to a binary stream.
+     *
+     * The format is host-endian and intended to save sketches of a run
+     * so that they can be merged with those of other runs.
+     *
+     * @param os the output stream
+     */
+    void Serialize(std::ostream& os) const;
+
+    /**
+     * @brief Read a sketch written by Serialize().
+     * @param is the input stream
+     * @return true on success
+     */
+    bool Deserialize(std::istream& is);
+
+  private:
+    /**
+     * @brief Returns the bin index of a positive value.
+     * @param value the value
+     * @return the bin index
+     */
+    int32_t GetIndex(double value) const;
+
+    /**
+     * @brief Returns the representative value of a bin.
+     * @param index the bin index
+     * @return the value
+     */
+    double GetValue(int32_t index) const;
+
+    /**
+     * @brief Add a count to a bin, growing or collapsing the stored range.
+     * @param index the bin index
+     * @param count the count to add
+     */
+    void AddToBin(int32_t index, uint64_t count);
+
+    double m_relativeAccuracy;    //!< Relative accuracy
+    double m_gamma;               //!< Bin growth factor
+    double m_logGamma;            //!< Logarithm of m_gamma
+    uint32_t m_maxBins;           //!< Maximum number of stored bins
+    std::vector<uint64_t> m_bins; //!< Counts of bins m_offset to m_offset + size - 1
+    int32_t m_offset;             //!< Index of the first stored bin
+    uint64_t m_zeroCount;         //!< Number of zero values
+    uint64_t m_count;             //!< Number of values
+    double m_min;                 //!< Smallest value
+    double m_max;                 //!< Largest value
+};
+
+} // namespace ns3
+
+#endif /* NS3_QUANTILE_SKETCH_H */
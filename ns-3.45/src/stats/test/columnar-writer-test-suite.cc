@@ -0,0 +1,164 @@
+//
+// SPDX-License-Identifier: GPL-2.0-only
+//
+
+#include "ns3/columnar-reader.h"
+#include "ns3/columnar-writer.h"
+#include "ns3/test.h"
+
+#include <fstream>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * @ingroup stats-tests
+ *
+ * @brief ColumnarWriter round trip Test: rows written in several blocks are read back.
+ */
+class ColumnarWriterRoundTripTestCase : public TestCase
+{
+  public:
+    ColumnarWriterRoundTripTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+ColumnarWriterRoundTripTestCase::ColumnarWriterRoundTripTestCase()
+    : TestCase("ColumnarWriter round trip")
+{
+}
+
+void
+ColumnarWriterRoundTripTestCase::DoRun()
+{
+    std::string fileName = CreateTempDirFilename("columnar-round-trip.ncol");
+    const uint32_t nRows = 1000;
+    {
+        ColumnarWriter writer;
+        uint32_t link = writer.AddColumn("link", ColumnarWriter::UINT32);
+        uint32_t bytes = writer.AddColumn("bytes", ColumnarWriter::UINT64);
+        uint32_t offset = writer.AddColumn("offset", ColumnarWriter::INT64);
+        uint32_t queue = writer.AddColumn("queue", ColumnarWriter::DOUBLE);
+        writer.Open(fileName, 64);
+        for (uint32_t i = 0; i < nRows; i++)
+        {
+            writer.Set(link, i % 7);
+            writer.Set(bytes, (uint64_t(1) << 40) + i);
+            if (i % 2)
+            {
+                // even rows leave the column unset
+                writer.Set(offset, -static_cast<int64_t>(i));
+            }
+            writer.Set(queue, i * 0.25);
+            writer.EndRow();
+        }
+        NS_TEST_EXPECT_MSG_EQ(writer.GetNRows(), nRows, "rows written");
+        // closed by the destructor
+    }
+
+    ColumnarReader reader;
+    NS_TEST_ASSERT_MSG_EQ(reader.Open(fileName), true, "open");
+    NS_TEST_EXPECT_MSG_EQ(reader.IsComplete(), true, "end marker");
+    NS_TEST_ASSERT_MSG_EQ(reader.GetNColumns(), 4, "number of columns");
+    NS_TEST_EXPECT_MSG_EQ(reader.GetNRows(), nRows, "number of rows");
+    NS_TEST_EXPECT_MSG_EQ(reader.GetColumnName(2), "offset", "column name");
+    NS_TEST_EXPECT_MSG_EQ(reader.GetColumnType(1), ColumnarWriter::UINT64, "column type");
+    NS_TEST_EXPECT_MSG_EQ(reader.GetColumnIndex("queue"), 3, "column index");
+    NS_TEST_EXPECT_MSG_EQ(reader.GetColumnIndex("none"), -1, "missing column");
+
+    std::vector<uint64_t> links;
+    std::vector<uint64_t> bytes;
+    std::vector<int64_t> offsets;
+    std::vector<double> queues;
+    NS_TEST_ASSERT_MSG_EQ(reader.ReadColumn(3, queues), true, "read queue");
+    NS_TEST_ASSERT_MSG_EQ(reader.ReadColumn(0, links), true, "read link");
+    NS_TEST_ASSERT_MSG_EQ(reader.ReadColumn(1, bytes), true, "read bytes");
+    NS_TEST_ASSERT_MSG_EQ(reader.ReadColumn(2, offsets), true, "read offset");
+    NS_TEST_ASSERT_MSG_EQ(queues.size(), nRows, "rows read");
+    for (uint32_t i = 0; i < nRows; i++)
+    {
+        NS_TEST_ASSERT_MSG_EQ(links[i], i % 7, "link of row " << i);
+        NS_TEST_ASSERT_MSG_EQ(bytes[i], (uint64_t(1) << 40) + i, "bytes of row " << i);
+        NS_TEST_ASSERT_MSG_EQ(offsets[i], (i % 2) ? -static_cast<int64_t>(i) : 0, "row " << i);
+        NS_TEST_ASSERT_MSG_EQ(queues[i], i * 0.25, "queue of row " << i);
+    }
+}
+
+/**
+ * @ingroup stats-tests
+ *
+ * @brief ColumnarReader Test: a file without end marker is read up to its last complete block.
+ */
+class ColumnarReaderTruncatedTestCase : public TestCase
+{
+  public:
+    ColumnarReaderTruncatedTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+ColumnarReaderTruncatedTestCase::ColumnarReaderTruncatedTestCase()
+    : TestCase("ColumnarReader truncated file")
+{
+}
+
+void
+ColumnarReaderTruncatedTestCase::DoRun()
+{
+    std::string fileName = CreateTempDirFilename("columnar-truncated.ncol");
+    {
+        ColumnarWriter writer;
+        writer.AddColumn("value", ColumnarWriter::DOUBLE);
+        writer.Open(fileName, 10);
+        for (uint32_t i = 0; i < 25; i++)
+        {
+            writer.Set(0, i);
+            writer.EndRow();
+        }
+        writer.Close();
+    }
+
+    // drop the end marker and half of the last block (5 rows)
+    std::ifstream in(fileName, std::ios::binary);
+    std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    in.close();
+    std::ofstream out(fileName, std::ios::binary | std::ios::trunc);
+    out.write(content.data(), content.size() - sizeof(uint32_t) - 3 * sizeof(double));
+    out.close();
+
+    ColumnarReader reader;
+    NS_TEST_ASSERT_MSG_EQ(reader.Open(fileName), true, "open");
+    NS_TEST_EXPECT_MSG_EQ(reader.IsComplete(), false, "no end marker");
+    NS_TEST_EXPECT_MSG_EQ(reader.GetNRows(), 20, "rows of the complete blocks");
+    std::vector<double> values;
+    NS_TEST_ASSERT_MSG_EQ(reader.ReadColumn(0, values), true, "read");
+    NS_TEST_EXPECT_MSG_EQ(values.back(), 19, "last value");
+
+    std::ofstream garbage(fileName, std::ios::binary | std::ios::trunc);
+    garbage << "<?xml version=\"1.0\" ?>";
+    garbage.close();
+    NS_TEST_EXPECT_MSG_EQ(reader.Open(fileName), false, "not a columnar file");
+}
+
+/**
+ * @ingroup stats-tests
+ *
+ * @brief ColumnarWriter TestSuite
+ */
+class ColumnarWriterTestSuite : public TestSuite
+{
+  public:
+    ColumnarWriterTestSuite();
+};
+
+ColumnarWriterTestSuite::ColumnarWriterTestSuite()
+    : TestSuite("columnar-writer", Type::UNIT)
+{
+    AddTestCase(new ColumnarWriterRoundTripTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new ColumnarReaderTruncatedTestCase, TestCase::Duration::QUICK);
+}
+
+static ColumnarWriterTestSuite g_columnarWriterTestSuite; //!< Static variable for test initialization
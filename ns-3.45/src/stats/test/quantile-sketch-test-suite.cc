@@ -0,0 +1,184 @@
+//
+// SPDX-License-Identifier: GPL-2.0-only
+//
+
+#include "ns3/quantile-sketch.h"
+#include "ns3/test.h"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * @ingroup stats-tests
+ *
+ * @brief QuantileSketch accuracy Test: compares the estimates with the exact quantiles.
+ */
+class QuantileSketchAccuracyTestCase : public TestCase
+{
+  public:
+    QuantileSketchAccuracyTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+QuantileSketchAccuracyTestCase::QuantileSketchAccuracyTestCase()
+    : TestCase("QuantileSketch accuracy")
+{
+}
+
+void
+QuantileSketchAccuracyTestCase::DoRun()
+{
+    QuantileSketch sketch(0.01);
+    std::vector<double> values;
+
+    // a heavy-tailed, deterministic sample spanning several decades
+    uint64_t state = 42;
+    for (uint32_t i = 0; i < 100000; i++)
+    {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        double u = ((state >> 11) + 1) * (1.0 / 9007199254740993.0);
+        double value = 1e-6 / std::pow(u, 0.7);
+        values.push_back(value);
+        sketch.AddValue(value);
+    }
+    std::sort(values.begin(), values.end());
+
+    NS_TEST_EXPECT_MSG_EQ(sketch.GetCount(), values.size(), "count");
+    NS_TEST_EXPECT_MSG_EQ(sketch.GetMin(), values.front(), "exact minimum");
+    NS_TEST_EXPECT_MSG_EQ(sketch.GetMax(), values.back(), "exact maximum");
+    for (double q : {0.0, 0.1, 0.5, 0.9, 0.99, 0.999, 1.0})
+    {
+        double exact = values[static_cast<std::size_t>(q * (values.size() - 1))];
+        NS_TEST_EXPECT_MSG_EQ_TOL(sketch.GetQuantile(q),
+                                  exact,
+                                  exact * 0.01,
+                                  "quantile " << q << " within the relative accuracy");
+    }
+
+    // zeros are counted apart
+    QuantileSketch zeros(0.01);
+    zeros.AddValue(0);
+    zeros.AddValue(0);
+    zeros.AddValue(1);
+    NS_TEST_EXPECT_MSG_EQ(zeros.GetQuantile(0.5), 0, "median of zeros");
+    NS_TEST_EXPECT_MSG_EQ(zeros.GetQuantile(1), 1, "maximum");
+}
+
+/**
+ * @ingroup stats-tests
+ *
+ * @brief QuantileSketch memory bound Test: the lowest bins are collapsed, the tail is kept.
+ */
+class QuantileSketchCollapseTestCase : public TestCase
+{
+  public:
+    QuantileSketchCollapseTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+QuantileSketchCollapseTestCase::QuantileSketchCollapseTestCase()
+    : TestCase("QuantileSketch bounded memory")
+{
+}
+
+void
+QuantileSketchCollapseTestCase::DoRun()
+{
+    QuantileSketch sketch(0.01, 64);
+    for (uint32_t i = 1; i <= 10000; i++)
+    {
+        sketch.AddValue(i * 1e-6);
+    }
+    // the values arrive in both orders
+    for (uint32_t i = 10000; i >= 1; i--)
+    {
+        sketch.AddValue(i * 1e-6);
+    }
+
+    NS_TEST_EXPECT_MSG_EQ((sketch.GetNBins() <= 64), true, "number of bins is bounded");
+    NS_TEST_EXPECT_MSG_EQ(sketch.GetCount(), 20000, "count");
+    NS_TEST_EXPECT_MSG_EQ_TOL(sketch.GetQuantile(0.99), 9900e-6, 9900e-6 * 0.01, "tail quantile");
+    NS_TEST_EXPECT_MSG_EQ_TOL(sketch.GetQuantile(0.9), 9000e-6, 9000e-6 * 0.01, "tail quantile");
+}
+
+/**
+ * @ingroup stats-tests
+ *
+ * @brief QuantileSketch merge and serialization Test.
+ */
+class QuantileSketchMergeTestCase : public TestCase
+{
+  public:
+    QuantileSketchMergeTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+QuantileSketchMergeTestCase::QuantileSketchMergeTestCase()
+    : TestCase("QuantileSketch merge and serialization")
+{
+}
+
+void
+QuantileSketchMergeTestCase::DoRun()
+{
+    QuantileSketch all(0.02);
+    QuantileSketch low(0.02);
+    QuantileSketch high(0.02);
+    for (uint32_t i = 1; i <= 1000; i++)
+    {
+        all.AddValue(i);
+        (i % 3 ? low : high).AddValue(i);
+    }
+
+    std::stringstream buffer;
+    high.Serialize(buffer);
+    QuantileSketch restored;
+    NS_TEST_ASSERT_MSG_EQ(restored.Deserialize(buffer), true, "deserialization");
+    NS_TEST_EXPECT_MSG_EQ(restored.GetCount(), high.GetCount(), "restored count");
+    NS_TEST_EXPECT_MSG_EQ(restored.GetRelativeAccuracy(), 0.02, "restored accuracy");
+
+    low.Merge(restored);
+    NS_TEST_EXPECT_MSG_EQ(low.GetCount(), all.GetCount(), "merged count");
+    NS_TEST_EXPECT_MSG_EQ(low.GetMin(), all.GetMin(), "merged minimum");
+    NS_TEST_EXPECT_MSG_EQ(low.GetMax(), all.GetMax(), "merged maximum");
+    for (double q : {0.01, 0.25, 0.5, 0.75, 0.99})
+    {
+        NS_TEST_EXPECT_MSG_EQ(low.GetQuantile(q),
+                              all.GetQuantile(q),
+                              "merging is exact for quantile " << q);
+    }
+
+    std::stringstream truncated(buffer.str().substr(0, 10));
+    NS_TEST_EXPECT_MSG_EQ(restored.Deserialize(truncated), false, "truncated input");
+}
+
+/**
+ * @ingroup stats-tests
+ *
+ * @brief QuantileSketch TestSuite
+ */
+class QuantileSketchTestSuite : public TestSuite
+{
+  public:
+    QuantileSketchTestSuite();
+};
+
+QuantileSketchTestSuite::QuantileSketchTestSuite()
+    : TestSuite("quantile-sketch", Type::UNIT)
+{
+    AddTestCase(new QuantileSketchAccuracyTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new QuantileSketchCollapseTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new QuantileSketchMergeTestCase, TestCase::Duration::QUICK);
+}
+
+static QuantileSketchTestSuite g_quantileSketchTestSuite; //!< Static variable for test initialization
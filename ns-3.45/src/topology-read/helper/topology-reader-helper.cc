@@ -9,6 +9,7 @@
 
 #include "topology-reader-helper.h"
 
+#include "ns3/auto-topology-reader.h"
 #include "ns3/inet-topology-reader.h"
 #include "ns3/log.h"
 #include "ns3/object.h"
@@ -66,6 +67,11 @@ TopologyReaderHelper::GetTopologyReader()
             NS_LOG_INFO("Creating Rocketfuel formatted data input.");
             m_inputModel = CreateObject<RocketfuelTopologyReader>();
         }
+        else if (m_fileType == "Auto")
+        {
+            NS_LOG_INFO("Creating Auto formatted data input.");
+            m_inputModel = CreateObject<AutoTopologyReader>();
+        }
         else
         {
             NS_ASSERT_MSG(false, "Wrong (unknown) File Type");
@@ -40,7 +40,8 @@ class TopologyReaderHelper
     void SetFileName(const std::string fileName);
 
     /**
-     * @brief Sets the input file type. Supported file types are "Orbis", "Inet", "Rocketfuel".
+     * @brief Sets the input file type. Supported file types are "Orbis", "Inet", "Rocketfuel",
+     * "Auto".
      * @param [in] fileType The input file type.
      */
     void SetFileType(const std::string fileType);
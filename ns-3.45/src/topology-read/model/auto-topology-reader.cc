@@ -0,0 +1,264 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "auto-topology-reader.h"
+
+#include "ns3/log.h"
+
+#include <charconv>
+#include <cstring>
+#include <fstream>
+
+/**
+ * @file
+ * @ingroup topology
+ * ns3::AutoTopologyReader implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("AutoTopologyReader");
+
+NS_OBJECT_ENSURE_REGISTERED(AutoTopologyReader);
+
+namespace
+{
+
+/**
+ * Skip blanks (spaces, tabs and carriage returns) within a line.
+ * @param [in] p Current position.
+ * @param [in] end End of the line.
+ * @return The first non-blank position.
+ */
+const char*
+SkipBlanks(const char* p, const char* end)
+{
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r'))
+    {
+        ++p;
+    }
+    return p;
+}
+
+/**
+ * Parse an unsigned integer, skipping leading blanks.
+ * @param [in,out] p Current position, advanced past the number on success.
+ * @param [in] end End of the line.
+ * @param [out] value The parsed value.
+ * @return True if a number was found.
+ */
+bool
+ParseUint(const char*& p, const char* end, uint32_t& value)
+{
+    p = SkipBlanks(p, end);
+    auto [ptr, ec] = std::from_chars(p, end, value);
+    if (ec != std::errc() || ptr == p)
+    {
+        return false;
+    }
+    p = ptr;
+    return true;
+}
+
+/**
+ * Check whether a line starts with a given keyword.
+ * @param [in] p Start of the line.
+ * @param [in] end End of the line.
+ * @param [in] key The keyword.
+ * @param [in] len The keyword length.
+ * @return True if the line starts with the keyword.
+ */
+bool
+StartsWith(const char* p, const char* end, const char* key, std::size_t len)
+{
+    return static_cast<std::size_t>(end - p) >= len && std::memcmp(p, key, len) == 0;
+}
+
+} // namespace
+
+TypeId
+AutoTopologyReader::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::AutoTopologyReader")
+                            .SetParent<TopologyReader>()
+                            .SetGroupName("TopologyReader")
+                            .AddConstructor<AutoTopologyReader>();
+    return tid;
+}
+
+AutoTopologyReader::AutoTopologyReader()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+AutoTopologyReader::~AutoTopologyReader()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+uint32_t
+AutoTopologyReader::Parse()
+{
+    NS_LOG_FUNCTION(this);
+
+    m_topoType.clear();
+    m_edgeNodes.clear();
+    m_linkInfos.clear();
+
+    std::ifstream topgen(GetFileName(), std::ios::in | std::ios::binary);
+    if (!topgen.is_open())
+    {
+        NS_LOG_WARN("Auto topology file object is not open, check file name and permissions");
+        return 0;
+    }
+
+    topgen.seekg(0, std::ios::end);
+    std::streamoff size = topgen.tellg();
+    topgen.seekg(0, std::ios::beg);
+    std::string buffer(size > 0 ? static_cast<std::size_t>(size) : 0, '\0');
+    topgen.read(buffer.data(), size);
+    topgen.close();
+
+    static const char topoKey[] = "TOPO_TYPE:";
+    static const char edgeKey[] = "EDGE_NODES:";
+
+    uint32_t nodesNumber = 0;
+    uint32_t linksNumber = 0;
+    int state = 0;
+
+    const char* p = buffer.data();
+    const char* bufEnd = p + buffer.size();
+    while (p < bufEnd)
+    {
+        const char* eol = static_cast<const char*>(std::memchr(p, '\n', bufEnd - p));
+        const char* end = eol ? eol : bufEnd;
+        const char* line = SkipBlanks(p, end);
+        p = eol ? eol + 1 : bufEnd;
+
+        if (line == end || *line == '#')
+        {
+            continue;
+        }
+        if (StartsWith(line, end, topoKey, sizeof(topoKey) - 1))
+        {
+            const char* first = SkipBlanks(line + sizeof(topoKey) - 1, end);
+            const char* last = end;
+            while (last > first && (last[-1] == ' ' || last[-1] == '\t' || last[-1] == '\r'))
+            {
+                --last;
+            }
+            m_topoType.assign(first, last);
+            continue;
+        }
+        if (StartsWith(line, end, edgeKey, sizeof(edgeKey) - 1))
+        {
+            const char* q = line + sizeof(edgeKey) - 1;
+            uint32_t id;
+            while (ParseUint(q, end, id))
+            {
+                m_edgeNodes.push_back(id);
+            }
+            continue;
+        }
+
+        if (state == 0)
+        {
+            if (ParseUint(line, end, nodesNumber))
+            {
+                state = 1;
+            }
+        }
+        else if (state == 1)
+        {
+            if (ParseUint(line, end, linksNumber))
+            {
+                m_linkInfos.reserve(linksNumber);
+                state = 2;
+            }
+        }
+        else
+        {
+            LinkInfo info;
+            if (!ParseUint(line, end, info.from) || !ParseUint(line, end, info.to))
+            {
+                continue;
+            }
+            if (!ParseUint(line, end, info.weight))
+            {
+                info.weight = 100;
+            }
+            if (info.from >= nodesNumber || info.to >= nodesNumber)
+            {
+                NS_LOG_WARN("Skipping link " << info.from << " - " << info.to
+                                             << ": node id out of range");
+                continue;
+            }
+            m_linkInfos.push_back(info);
+        }
+    }
+
+    if (m_linkInfos.size() != linksNumber)
+    {
+        NS_LOG_WARN("Auto topology file declares " << linksNumber << " links, "
+                                                   << m_linkInfos.size() << " found");
+    }
+    return nodesNumber;
+}
+
+NodeContainer
+AutoTopologyReader::Read()
+{
+    NS_LOG_FUNCTION(this);
+
+    NodeContainer nodes;
+    uint32_t nodesNumber = Parse();
+    if (nodesNumber == 0)
+    {
+        NS_LOG_WARN("Auto topology file has no nodes");
+        return nodes;
+    }
+
+    nodes.Create(nodesNumber);
+    for (const auto& info : m_linkInfos)
+    {
+        Link link(nodes.Get(info.from),
+                  std::to_string(info.from),
+                  nodes.Get(info.to),
+                  std::to_string(info.to));
+        link.SetAttribute("Weight", std::to_string(info.weight));
+        AddLink(link);
+    }
+    m_nodes = nodes;
+
+    NS_LOG_INFO("Auto topology created with " << nodesNumber << " nodes and "
+                                              << m_linkInfos.size() << " links");
+    return nodes;
+}
+
+NodeContainer
+AutoTopologyReader::GetNodes() const
+{
+    return m_nodes;
+}
+
+std::string
+AutoTopologyReader::GetTopologyType() const
+{
+    return m_topoType;
+}
+
+const std::vector<uint32_t>&
+AutoTopologyReader::GetEdgeNodes() const
+{
+    return m_edgeNodes;
+}
+
+const std::vector<AutoTopologyReader::LinkInfo>&
+AutoTopologyReader::GetLinkInfos() const
+{
+    return m_linkInfos;
+}
+
+} /* namespace ns3 */
@@ -0,0 +1,137 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef AUTO_TOPOLOGY_READER_H
+#define AUTO_TOPOLOGY_READER_H
+
+#include "topology-reader.h"
+
+#include "ns3/node-container.h"
+
+#include <string>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup topology
+ * ns3::AutoTopologyReader declaration.
+ */
+
+namespace ns3
+{
+
+// ------------------------------------------------------------
+// --------------------------------------------
+/**
+ * @ingroup topology
+ *
+ * @brief Topology file reader (auto.txt-format type).
+ *
+ * This class takes an input file in the "auto" format produced by our
+ * fabric generators and extracts all the information needed to build
+ * the topology. The format is line based:
+ *
+ * @verbatim
+   <number of nodes>
+   <number of links>
+   TOPO_TYPE: <free-form name>
+   EDGE_NODES:<id> <id> ...
+   <from> <to> [<weight>]
+   ...
+   @endverbatim
+ *
+ * The two numeric header lines, the TOPO_TYPE and the EDGE_NODES lines may
+ * appear in any order before the links. Empty lines and lines starting with
+ * '#' are ignored. Node ids are zero-based and must be lower than the number
+ * of nodes. A link without weight gets a weight of 100.
+ *
+ * The whole file is loaded with a single read and parsed in place in one
+ * pass, without per-line string or stream objects, so that topologies with
+ * tens of thousands of nodes can be read quickly.
+ */
+class AutoTopologyReader : public TopologyReader
+{
+  public:
+    /**
+     * @brief Details of a link as found in the input file.
+     */
+    struct LinkInfo
+    {
+        uint32_t from;   //!< Id of the node the link is originating from.
+        uint32_t to;     //!< Id of the node the link is directed to.
+        uint32_t weight; //!< Link weight.
+    };
+
+    /**
+     * @brief Get the type ID.
+     * @return the object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    AutoTopologyReader();
+    ~AutoTopologyReader() override;
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    AutoTopologyReader(const AutoTopologyReader&) = delete;
+    AutoTopologyReader& operator=(const AutoTopologyReader&) = delete;
+
+    /**
+     * @brief Main topology reading function.
+     *
+     * This method loads the auto-format file, creates the declared number
+     * of nodes and records every link together with its weight. The weight
+     * is also stored as the "Weight" attribute of the corresponding
+     * TopologyReader::Link.
+     *
+     * @return The container of the nodes created (or empty container if there was an error)
+     */
+    NodeContainer Read() override;
+
+    /**
+     * @brief Parse the input file without creating any node or link.
+     *
+     * Fills the topology type, the edge nodes and the link list only, for
+     * users that need the file contents but not the ns-3 objects.
+     *
+     * @return The number of nodes declared in the file (0 if there was an error).
+     */
+    uint32_t Parse();
+
+    /**
+     * @brief Returns the nodes created by the last call to Read().
+     * @return The nodes, indexed by their id in the input file.
+     */
+    NodeContainer GetNodes() const;
+
+    /**
+     * @brief Returns the TOPO_TYPE string of the input file.
+     * @return The topology type, or an empty string if none was given.
+     */
+    std::string GetTopologyType() const;
+
+    /**
+     * @brief Returns the ids of the edge nodes listed in the input file.
+     * @return The edge node ids, in file order.
+     */
+    const std::vector<uint32_t>& GetEdgeNodes() const;
+
+    /**
+     * @brief Returns the links found in the input file.
+     * @return The links, in file order.
+     */
+    const std::vector<LinkInfo>& GetLinkInfos() const;
+
+  private:
+    NodeContainer m_nodes;             //!< Nodes created by Read().
+    std::string m_topoType;            //!< TOPO_TYPE of the input file.
+    std::vector<uint32_t> m_edgeNodes; //!< Edge node ids.
+    std::vector<LinkInfo> m_linkInfos; //!< Links, in file order.
+
+    // end class AutoTopologyReader
+};
+
+// end namespace ns3
+}; // namespace ns3
+
+#endif /* AUTO_TOPOLOGY_READER_H */
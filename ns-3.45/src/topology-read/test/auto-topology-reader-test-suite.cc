@@ -0,0 +1,90 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/auto-topology-reader.h"
+#include "ns3/node-container.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+using namespace ns3;
+
+/**
+ * @file
+ * @ingroup topology-test
+ * ns3::AutoTopologyReader test suite.
+ */
+
+/**
+ * @ingroup topology-test
+ *
+ * @brief Auto Topology Reader Parse Test
+ */
+class AutoTopologyReaderParseTest : public TestCase
+{
+  public:
+    AutoTopologyReaderParseTest();
+
+  private:
+    void DoRun() override;
+};
+
+AutoTopologyReaderParseTest::AutoTopologyReaderParseTest()
+    : TestCase("AutoTopologyReaderParseTest")
+{
+}
+
+void
+AutoTopologyReaderParseTest::DoRun()
+{
+    Ptr<AutoTopologyReader> inFile = CreateObject<AutoTopologyReader>();
+    inFile->SetFileName("./src/topology-read/examples/Auto_toposample.txt");
+
+    NodeContainer nodes = inFile->Read();
+
+    NS_TEST_ASSERT_MSG_EQ(nodes.GetN(), 6, "nodes");
+    NS_TEST_ASSERT_MSG_EQ(inFile->LinksSize(), 7, "links");
+    NS_TEST_EXPECT_MSG_EQ(inFile->GetTopologyType(), "auto.txt", "topology type");
+
+    const auto& edges = inFile->GetEdgeNodes();
+    NS_TEST_ASSERT_MSG_EQ(edges.size(), 4, "edge nodes");
+    NS_TEST_EXPECT_MSG_EQ(edges.front(), 2, "first edge node");
+    NS_TEST_EXPECT_MSG_EQ(edges.back(), 5, "last edge node");
+
+    const auto& links = inFile->GetLinkInfos();
+    NS_TEST_EXPECT_MSG_EQ(links[4].from, 0, "link 4 from");
+    NS_TEST_EXPECT_MSG_EQ(links[4].to, 1, "link 4 to");
+    NS_TEST_EXPECT_MSG_EQ(links[4].weight, 200, "link 4 weight");
+    NS_TEST_EXPECT_MSG_EQ(links[5].weight, 100, "default weight");
+    NS_TEST_EXPECT_MSG_EQ(links[6].weight, 50, "link 6 weight");
+
+    TopologyReader::ConstLinksIterator it = inFile->LinksBegin();
+    NS_TEST_EXPECT_MSG_EQ(it->GetFromNode(), nodes.Get(0), "link from node");
+    NS_TEST_EXPECT_MSG_EQ(it->GetToNode(), nodes.Get(2), "link to node");
+    NS_TEST_EXPECT_MSG_EQ(it->GetAttribute("Weight"), "100", "link weight attribute");
+
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup topology-test
+ *
+ * @brief Auto Topology Reader TestSuite
+ */
+class AutoTopologyReaderTestSuite : public TestSuite
+{
+  public:
+    AutoTopologyReaderTestSuite();
+};
+
+AutoTopologyReaderTestSuite::AutoTopologyReaderTestSuite()
+    : TestSuite("auto-topology-reader", Type::UNIT)
+{
+    AddTestCase(new AutoTopologyReaderParseTest(), TestCase::Duration::QUICK);
+}
+
+/**
+ * @ingroup topology-test
+ * Static variable for test initialization
+ */
+static AutoTopologyReaderTestSuite g_autoTopologyReaderTestSuite;
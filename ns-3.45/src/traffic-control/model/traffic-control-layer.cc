@@ -9,6 +9,8 @@
 
 #include "queue-disc.h"
 
+#include "ns3/boolean.h"
+#include "ns3/header.h"
 #include "ns3/log.h"
 #include "ns3/net-device-queue-interface.h"
 #include "ns3/object-map.h"
@@ -39,6 +41,13 @@ TrafficControlLayer::GetTypeId()
                 MakeObjectMapAccessor(&TrafficControlLayer::GetNDevices,
                                       &TrafficControlLayer::GetRootQueueDiscOnDeviceByIndex),
                 MakeObjectMapChecker<QueueDisc>())
+            .AddAttribute("QueueDiscBypass",
+                          "Whether the packets sent to a single-queue device without a root "
+                          "queue disc go straight to the device, without a queue disc item. "
+                          "The address helpers then install no default queue disc.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&TrafficControlLayer::m_queueDiscBypass),
+                          MakeBooleanChecker())
             .AddTraceSource("TcDrop",
                             "Trace source indicating a packet has been dropped by the Traffic "
                             "Control layer because no queue disc is installed on the device, the "
@@ -49,7 +58,8 @@ TrafficControlLayer::GetTypeId()
 }
 
 TrafficControlLayer::TrafficControlLayer()
-    : Object()
+    : Object(),
+      m_queueDiscBypass(false)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -403,4 +413,53 @@ TrafficControlLayer::Send(Ptr<NetDevice> device, Ptr<QueueDiscItem> item)
     }
 }
 
+bool
+TrafficControlLayer::SendWithoutQueueDisc(Ptr<NetDevice> device,
+                                          Ptr<Packet> packet,
+                                          const Header& header,
+                                          const Address& address,
+                                          uint16_t protocol)
+{
+    NS_LOG_FUNCTION(this << device << packet << address << protocol);
+
+    if (!m_queueDiscBypass)
+    {
+        return false;
+    }
+
+    Ptr<NetDeviceQueueInterface> devQueueIface;
+    auto ndi = m_netDevices.find(device);
+    if (ndi != m_netDevices.end())
+    {
+        if (ndi->second.m_rootQueueDisc)
+        {
+            return false;
+        }
+        devQueueIface = ndi->second.m_ndqi;
+    }
+    if (devQueueIface && devQueueIface->GetNTxQueues() > 1)
+    {
+        // the select queue callback of a multi-queue device needs an item
+        return false;
+    }
+
+    packet->AddHeader(header);
+    if (devQueueIface && devQueueIface->GetTxQueue(0)->IsStopped())
+    {
+        m_dropped(packet);
+        return true;
+    }
+    // a single queue device makes no use of the priority tag
+    SocketPriorityTag priorityTag;
+    packet->RemovePacketTag(priorityTag);
+    device->Send(packet, address, protocol);
+    return true;
+}
+
+bool
+TrafficControlLayer::GetQueueDiscBypass() const
+{
+    return m_queueDiscBypass;
+}
+
 } // namespace ns3
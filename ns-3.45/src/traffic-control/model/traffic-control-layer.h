@@ -20,6 +20,7 @@
 namespace ns3
 {
 
+class Header;
 class Packet;
 class QueueDisc;
 class NetDeviceQueueInterface;
@@ -194,6 +195,39 @@ class TrafficControlLayer : public Object
      */
     virtual void Send(Ptr<NetDevice> device, Ptr<QueueDiscItem> item);
 
+    /**
+     * @brief Called from upper layer to send a packet straight to a device
+     * without a queue disc, if the QueueDiscBypass attribute is true.
+     *
+     * Unlike Send, it needs no QueueDiscItem. As Send does for a device
+     * without a queue disc, it adds the header to the packet and drops the
+     * packet, hitting the TcDrop trace, if the device queue is stopped.
+     *
+     * @param device the device the packet must be sent to
+     * @param packet the packet, without the header
+     * @param header the header of the network protocol
+     * @param address the destination address
+     * @param protocol the protocol number
+     * @return false, leaving the packet untouched, if the bypass is disabled,
+     *         or the device has a root queue disc or several transmission
+     *         queues: the caller must then use Send.
+     */
+    bool SendWithoutQueueDisc(Ptr<NetDevice> device,
+                              Ptr<Packet> packet,
+                              const Header& header,
+                              const Address& address,
+                              uint16_t protocol);
+
+    /**
+     * @brief Whether the devices without a queue disc are bypassed.
+     *
+     * The address helpers install no default queue disc then, so that the
+     * device queues are the only ones.
+     *
+     * @return the value of the QueueDiscBypass attribute
+     */
+    bool GetQueueDiscBypass() const;
+
   protected:
     void DoDispose() override;
     void DoInitialize() override;
@@ -242,6 +276,7 @@ class TrafficControlLayer : public Object
     /// Map storing the required information for each device with a queue disc installed
     std::map<Ptr<NetDevice>, NetDeviceInfo> m_netDevices;
     ProtocolHandlerList m_handlers; //!< List of upper-layer handlers
+    bool m_queueDiscBypass;         //!< Whether the devices without a queue disc are bypassed
 
     /**
      * The trace source fired when the Traffic Control layer drops a packet because
@@ -7,9 +7,11 @@
  *
  */
 
+#include "ns3/boolean.h"
 #include "ns3/config.h"
 #include "ns3/data-rate.h"
 #include "ns3/double.h"
+#include "ns3/llc-snap-header.h"
 #include "ns3/log.h"
 #include "ns3/net-device-queue-interface.h"
 #include "ns3/node-container.h"
@@ -481,6 +483,109 @@ TcFlowControlTestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup traffic-control-test
+ *
+ * @brief Traffic Control Queue Disc Bypass Test Case
+ *
+ * The packets sent to a device without a queue disc go straight to the
+ * device queue, and are dropped when the device queue is stopped.
+ */
+class TcQueueDiscBypassTestCase : public TestCase
+{
+  public:
+    TcQueueDiscBypassTestCase();
+
+  private:
+    void DoRun() override;
+    /**
+     * Count a packet dropped by the traffic control layer
+     * @param p the packet
+     */
+    void Dropped(Ptr<const Packet> p);
+
+    uint32_t m_dropped{0}; //!< the packets dropped by the traffic control layer
+};
+
+TcQueueDiscBypassTestCase::TcQueueDiscBypassTestCase()
+    : TestCase("Test the bypass of the devices without a queue disc")
+{
+}
+
+void
+TcQueueDiscBypassTestCase::Dropped(Ptr<const Packet> p)
+{
+    m_dropped++;
+}
+
+void
+TcQueueDiscBypassTestCase::DoRun()
+{
+    NodeContainer n;
+    n.Create(2);
+
+    Ptr<TrafficControlLayer> tc = CreateObject<TrafficControlLayer>();
+    n.Get(0)->AggregateObject(tc);
+    n.Get(1)->AggregateObject(CreateObject<TrafficControlLayer>());
+    tc->TraceConnectWithoutContext("TcDrop",
+                                   MakeCallback(&TcQueueDiscBypassTestCase::Dropped, this));
+
+    SimpleNetDeviceHelper simple;
+    NetDeviceContainer rxDevC = simple.Install(n.Get(1));
+    simple.SetDeviceAttribute("DataRate", DataRateValue(DataRate("1Mb/s")));
+    simple.SetQueue("ns3::DropTailQueue", "MaxSize", StringValue("3p"));
+    Ptr<NetDevice> txDev =
+        simple.Install(n.Get(0), DynamicCast<SimpleChannel>(rxDevC.Get(0)->GetChannel())).Get(0);
+    tc->Initialize();
+
+    LlcSnapHeader header;
+    NS_TEST_EXPECT_MSG_EQ(tc->SendWithoutQueueDisc(txDev,
+                                                   Create<Packet>(1000),
+                                                   header,
+                                                   txDev->GetBroadcast(),
+                                                   0),
+                          false,
+                          "The bypass is disabled by default");
+
+    tc->SetAttribute("QueueDiscBypass", BooleanValue(true));
+    // the first packet is transmitted at once, the next three fill the
+    // device queue, which is stopped, and the last one is dropped
+    for (uint32_t i = 0; i < 5; i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(tc->SendWithoutQueueDisc(txDev,
+                                                       Create<Packet>(1000),
+                                                       header,
+                                                       txDev->GetBroadcast(),
+                                                       0),
+                              true,
+                              "The device has no queue disc");
+    }
+    PointerValue ptr;
+    txDev->GetAttribute("TxQueue", ptr);
+    Ptr<Queue<Packet>> queue = ptr.Get<Queue<Packet>>();
+    NS_TEST_EXPECT_MSG_EQ(queue->GetNPackets(), 3, "There must be 3 packets in the device queue");
+    NS_TEST_EXPECT_MSG_EQ(queue->Peek()->GetSize(),
+                          1000 + header.GetSerializedSize(),
+                          "The header must be added");
+    NS_TEST_EXPECT_MSG_EQ(txDev->GetObject<NetDeviceQueueInterface>()->GetTxQueue(0)->IsStopped(),
+                          true,
+                          "The device queue must be stopped");
+    NS_TEST_EXPECT_MSG_EQ(m_dropped, 1, "One packet must be dropped");
+
+    TrafficControlHelper tch = TrafficControlHelper::Default();
+    tch.Install(txDev);
+    NS_TEST_EXPECT_MSG_EQ(tc->SendWithoutQueueDisc(txDev,
+                                                   Create<Packet>(1000),
+                                                   header,
+                                                   txDev->GetBroadcast(),
+                                                   0),
+                          false,
+                          "The device has a queue disc");
+
+    Simulator::Run();
+    Simulator::Destroy();
+}
+
 /**
  * @ingroup traffic-control-test
  *
@@ -515,5 +620,6 @@ static class TcFlowControlTestSuite : public TestSuite
         // also be made parametric.
         AddTestCase(new TcFlowControlTestCase(QueueSizeUnit::BYTES, 5000, 10),
                     TestCase::Duration::QUICK);
+        AddTestCase(new TcQueueDiscBypassTestCase, TestCase::Duration::QUICK);
     }
 } g_tcFlowControlTestSuite; ///< the test suite
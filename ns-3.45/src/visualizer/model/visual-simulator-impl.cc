@@ -210,6 +210,18 @@ VisualSimulatorImpl::GetEventCount() const
     return m_simulator->GetEventCount();
 }
 
+uint64_t
+VisualSimulatorImpl::GetCancelledEventCount() const
+{
+    return m_simulator->GetCancelledEventCount();
+}
+
+uint64_t
+VisualSimulatorImpl::GetPendingEventCount() const
+{
+    return m_simulator->GetPendingEventCount();
+}
+
 void
 VisualSimulatorImpl::RunRealSimulator()
 {
@@ -0,0 +1,186 @@
+//
+// SPDX-License-Identifier: GPL-2.0-only
+//
+
+// This program can be used to benchmark the construction of an auto.txt
+// fabric: the parsing of the file, the creation of the nodes, the Internet
+// stacks, and the point-to-point links with their addresses. The links are
+// installed either by PointToPointAutoTopologyHelper, which configures the
+// PointToPointHelper once per distinct weight, or by a loop which
+// configures it for every link, as the hand-written scenarios did.
+// Without --file, a leaf-spine fabric of 'nodes' nodes is generated.
+// Sample usage:  ./ns3 run 'bench-auto-topology --nodes=10000'
+
+#include "ns3/abort.h"
+#include "ns3/auto-topology-reader.h"
+#include "ns3/command-line.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/point-to-point-auto-topology.h"
+#include "ns3/point-to-point-helper.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/system-wall-clock-ms.h"
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdlib.h> // for exit ()
+
+using namespace ns3;
+
+/**
+ * Write a leaf-spine fabric in the auto.txt format: one spine for 50
+ * nodes, one leaf for 10 nodes, each leaf connected to 4 spines, and the
+ * other nodes hosts connected to one leaf. The host links have a weight
+ * of 100 and the fabric links a weight of 50, listed leaf by leaf.
+ * @param filename The file to write.
+ * @param nodes The number of nodes.
+ */
+static void
+WriteFabric(const std::string& filename, uint32_t nodes)
+{
+    uint32_t spines = std::max<uint32_t>(nodes / 50, 1);
+    uint32_t leaves = std::max<uint32_t>(nodes / 10, 1);
+    NS_ABORT_MSG_IF(spines + leaves >= nodes, "Not enough nodes for a fabric");
+    uint32_t hosts = nodes - spines - leaves;
+
+    std::ostringstream links;
+    uint32_t nLinks = 0;
+    uint32_t host = spines + leaves;
+    for (uint32_t leaf = 0; leaf < leaves; leaf++)
+    {
+        uint32_t id = spines + leaf;
+        for (uint32_t j = 0; j < 4 && j < spines; j++)
+        {
+            links << id << " " << (leaf + j * (spines / 4 + 1)) % spines << " 50\n";
+            nLinks++;
+        }
+        for (uint32_t end = spines + leaves + hosts * (leaf + 1) / leaves; host < end; host++)
+        {
+            links << host << " " << id << " 100\n";
+            nLinks++;
+        }
+    }
+
+    std::ofstream out(filename);
+    out << nodes << "\n" << nLinks << "\nTOPO_TYPE: leaf-spine\nEDGE_NODES:";
+    for (uint32_t i = spines + leaves; i < nodes; i++)
+    {
+        out << " " << i;
+    }
+    out << "\n" << links.str();
+}
+
+/**
+ * Configure the links of a weight, as the scenarios do.
+ * @param helper The helper.
+ * @param weight The link weight.
+ */
+static void
+ConfigureLink(PointToPointHelper& helper, uint32_t weight)
+{
+    std::ostringstream delay;
+    std::ostringstream rate;
+    delay << weight * 2.0 / 100.0 << "ms";
+    rate << 5000.0 / weight << "Mbps";
+    helper.SetChannelAttribute("Delay", StringValue(delay.str()));
+    helper.SetDeviceAttribute("DataRate", StringValue(rate.str()));
+}
+
+/**
+ * Build the fabric and print the time of each step.
+ * @param filename The auto.txt file.
+ * @param batched Whether the links are installed by PointToPointAutoTopologyHelper.
+ */
+static void
+BuildFabric(const std::string& filename, bool batched)
+{
+    SystemWallClockMs time;
+    uint64_t total = 0;
+    auto step = [&time, &total](const char* name) {
+        uint64_t ms = time.End();
+        total += ms;
+        std::cout << "  " << name << ": " << ms << " ms" << std::endl;
+        time.Start();
+    };
+
+    std::cout << (batched ? "PointToPointAutoTopologyHelper (one configuration per weight)"
+                          : "Loop (one configuration per link)")
+              << std::endl;
+    time.Start();
+    Ptr<AutoTopologyReader> reader = CreateObject<AutoTopologyReader>();
+    reader->SetFileName(filename);
+    NodeContainer nodes = reader->Read();
+    step("parse and create the nodes");
+
+    InternetStackHelper stack;
+    stack.Install(nodes);
+    step("install the Internet stacks");
+
+    Ipv4AddressHelper address("10.0.0.0", "255.255.255.252");
+    if (batched)
+    {
+        PointToPointHelper p2p;
+        PointToPointAutoTopologyHelper fabric(
+            p2p,
+            PointToPointAutoTopologyHelper::LinkConfigCallback(&ConfigureLink));
+        fabric.Install(reader, address);
+    }
+    else
+    {
+        PointToPointHelper p2p;
+        std::vector<NetDeviceContainer> devices;
+        for (const auto& info : reader->GetLinkInfos())
+        {
+            ConfigureLink(p2p, info.weight);
+            devices.push_back(p2p.Install(nodes.Get(info.from), nodes.Get(info.to)));
+        }
+        for (const auto& ndc : devices)
+        {
+            address.Assign(ndc);
+            address.NewNetwork();
+        }
+    }
+    step("install the links and the addresses");
+    std::cout << "  total: " << total << " ms (" << nodes.GetN() << " nodes, "
+              << reader->GetLinkInfos().size() << " links)" << std::endl;
+
+    Simulator::Destroy();
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t nodes = 10000;
+    std::string filename;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the construction of an auto.txt fabric");
+    cmd.AddValue("nodes", "number of nodes of the generated fabric", nodes);
+    cmd.AddValue("file", "auto.txt file to build instead of a generated fabric", filename);
+    cmd.Parse(argc, argv);
+
+    bool generated = filename.empty();
+    if (generated)
+    {
+        if (nodes < 20)
+        {
+            std::cerr << "Error-- the generated fabric needs at least 20 nodes" << std::endl;
+            exit(1);
+        }
+        filename = "bench-auto-topology.txt";
+        WriteFabric(filename, nodes);
+    }
+    std::cout << "Running bench-auto-topology with " << filename << std::endl;
+
+    BuildFabric(filename, false);
+    BuildFabric(filename, true);
+
+    if (generated)
+    {
+        std::remove(filename.c_str());
+    }
+    return 0;
+}
@@ -9,21 +9,73 @@
 // This program can be used to benchmark packet serialization/deserialization
 // operations using Headers and Tags, for various numbers of packets 'n'
 // Sample usage:  ./ns3 run 'bench-packets --n=10000'
+//
+// The forwarding benchmark also reports the time and the allocations per
+// packet, for a path of 'hops' hops:  ./ns3 run 'bench-packets --n=100000 --hops=8'
+// The fabric benchmark then reports the time per hop saved by Packet::DisableByteTags.
 
 #include "ns3/command-line.h"
+#include "ns3/packet-allocator.h"
 #include "ns3/packet-metadata.h"
 #include "ns3/packet.h"
 #include "ns3/system-wall-clock-ms.h"
 
 #include <algorithm>
+#include <cstdlib>
 #include <iostream>
 #include <limits>
+#include <new>
 #include <sstream>
 #include <stdlib.h> // for exit ()
 #include <string>
 
 using namespace ns3;
 
+/// Number of header deserializations
+static uint64_t g_deserializations = 0;
+
+/// Number of allocations with operator new, by this program and by ns-3
+static uint64_t g_allocations = 0;
+
+/// Number of hops of the forwarding benchmark
+static uint32_t g_hops = 4;
+
+/**
+ * Count the allocations.
+ * @param size The size of the allocation.
+ * @returns The memory.
+ */
+void*
+operator new(std::size_t size)
+{
+    g_allocations++;
+    if (void* p = std::malloc(size > 0 ? size : 1))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+/**
+ * Release the memory of operator new.
+ * @param p The memory.
+ */
+void
+operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+/**
+ * Release the memory of operator new.
+ * @param p The memory.
+ */
+void
+operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
 /// BenchHeader class used for benchmarking packet serialization/deserialization
 template <int N>
 class BenchHeader : public Header
@@ -125,6 +177,7 @@ template <int N>
 uint32_t
 BenchHeader<N>::Deserialize(Buffer::Iterator start)
 {
+    g_deserializations++;
     m_ok = true;
     for (int i = 0; i < N; i++)
     {
@@ -203,6 +256,40 @@ class BenchTag : public Tag
     }
 };
 
+/// A tag stored in a slot of the PacketTagList
+using BenchSlotTag = BenchTag<8>;
+NS_PACKET_TAG_SLOT_REGISTER(BenchSlotTag);
+
+/// A tag of the size of the IPv4 flow probe tag, which also has a slot
+using BenchProbeTag = BenchTag<20>;
+NS_PACKET_TAG_SLOT_REGISTER(BenchProbeTag);
+
+/**
+ * Forward the packets through 4 hops, each of which reads and updates a tag.
+ * @tparam T The type of the tag.
+ * @param n The number of packets.
+ */
+template <typename T>
+static void
+benchHopTags(uint32_t n)
+{
+    T tag;
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        Ptr<Packet> p = Create<Packet>(1000);
+        p->AddPacketTag(tag);
+        for (uint32_t hop = 0; hop < 4; hop++)
+        {
+            Ptr<Packet> cp = p->Copy();
+            cp->PeekPacketTag(tag);
+            cp->ReplacePacketTag(tag);
+            p = cp;
+        }
+        p->RemovePacketTag(tag);
+    }
+}
+
 static void
 benchD(uint32_t n)
 {
@@ -339,6 +426,127 @@ benchByteTags(uint32_t n)
     }
 }
 
+static void
+benchForwardPeeks(uint32_t n)
+{
+    BenchHeader<2> ppp;
+    BenchHeader<20> ipv4;
+    BenchHeader<8> udp;
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        Ptr<Packet> p = Create<Packet>(1000);
+        p->AddHeader(udp);
+        p->AddHeader(ipv4);
+        p->AddHeader(ppp);
+        for (uint32_t hop = 0; hop < 4; hop++)
+        {
+            // the device classifies the frame for its queue, PFC and telemetry
+            for (uint32_t j = 0; j < 3; j++)
+            {
+                Ptr<Packet> cp = p->Copy();
+                cp->PeekHeader(ppp);
+                cp->RemoveHeader(ppp);
+                cp->PeekHeader(ipv4);
+            }
+            // the IP layer receives the packet and hashes its flow to route it
+            p->RemoveHeader(ppp);
+            p->RemoveHeader(ipv4);
+            p->PeekHeader(udp);
+            p->AddHeader(ipv4);
+            p->AddHeader(ppp);
+        }
+    }
+}
+
+/**
+ * Forward the packets through g_hops hops. Each hop copies the packet, as
+ * the IP layer does, removes and adds its headers, and reads its tag.
+ * @param n The number of packets.
+ */
+static void
+benchForwardHops(uint32_t n)
+{
+    BenchHeader<2> ppp;
+    BenchHeader<20> ipv4;
+    BenchHeader<8> udp;
+    BenchTag<9> flowTag;
+    BenchTag<4> byteTag;
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        Ptr<Packet> p = Create<Packet>(1000);
+        p->AddHeader(udp);
+        if (Packet::ByteTagsEnabled())
+        {
+            p->AddByteTag(byteTag);
+        }
+        p->AddPacketTag(flowTag);
+        p->AddHeader(ipv4);
+        p->AddHeader(ppp);
+        for (uint32_t hop = 0; hop < g_hops; hop++)
+        {
+            Ptr<Packet> cp = p->Copy();
+            cp->RemoveHeader(ppp);
+            cp->RemoveHeader(ipv4);
+            cp->PeekPacketTag(flowTag);
+            cp->AddHeader(ipv4);
+            cp->AddHeader(ppp);
+            p = cp;
+        }
+        p->RemoveHeader(ppp);
+        p->RemoveHeader(ipv4);
+        p->RemovePacketTag(flowTag);
+        p->RemoveHeader(udp);
+    }
+}
+
+/**
+ * Forward the packets through g_hops hops of a fabric with a flow monitor.
+ * The flow probe tags each packet at its source, then each hop copies the
+ * packet, removes and adds its headers, and finds the tag of the probe. The
+ * tag is a byte tag, or a packet tag once the byte tags are disabled.
+ * @param n The number of packets.
+ */
+static void
+benchFabricHops(uint32_t n)
+{
+    BenchHeader<2> ppp;
+    BenchHeader<20> ipv4;
+    BenchHeader<8> udp;
+    BenchProbeTag probeTag;
+    bool byteTags = Packet::ByteTagsEnabled();
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        Ptr<Packet> p = Create<Packet>(1000);
+        p->AddHeader(udp);
+        if (byteTags)
+        {
+            p->AddByteTag(probeTag);
+        }
+        else
+        {
+            p->AddPacketTag(probeTag);
+        }
+        p->AddHeader(ipv4);
+        p->AddHeader(ppp);
+        for (uint32_t hop = 0; hop < g_hops; hop++)
+        {
+            Ptr<Packet> cp = p->Copy();
+            cp->RemoveHeader(ppp);
+            cp->RemoveHeader(ipv4);
+            byteTags ? cp->FindFirstMatchingByteTag(probeTag) : cp->PeekPacketTag(probeTag);
+            cp->AddHeader(ipv4);
+            cp->AddHeader(ppp);
+            p = cp;
+        }
+        p->RemoveHeader(ppp);
+        p->RemoveHeader(ipv4);
+        p->RemoveHeader(udp);
+    }
+}
+
 static uint64_t
 runBenchOneIteration(void (*bench)(uint32_t), uint32_t n)
 {
@@ -365,12 +573,83 @@ runBench(void (*bench)(uint32_t), uint32_t n, uint32_t minIterations, const char
               << " (" << minDelay << " ms elapsed)\t" << name << std::endl;
 }
 
+/**
+ * Run a benchmark, then report its header deserializations per packet.
+ * @param bench The benchmark.
+ * @param n The number of packets.
+ * @param minIterations The number of iterations.
+ * @param name The name of the benchmark.
+ */
+static void
+runBenchDeserializations(void (*bench)(uint32_t),
+                         uint32_t n,
+                         uint32_t minIterations,
+                         const char* name)
+{
+    g_deserializations = 0;
+    runBench(bench, n, minIterations, name);
+    std::cout << static_cast<double>(g_deserializations) / n / minIterations
+              << " header deserializations/packet\t" << name << std::endl;
+}
+
+/**
+ * Run a benchmark, then report its time and allocations per packet.
+ * @param bench The benchmark.
+ * @param n The number of packets.
+ * @param minIterations The number of iterations.
+ * @param name The name of the benchmark.
+ */
+static void
+runBenchAllocations(void (*bench)(uint32_t),
+                    uint32_t n,
+                    uint32_t minIterations,
+                    const std::string& name)
+{
+    uint64_t minDelay = std::numeric_limits<uint64_t>::max();
+    uint64_t allocations = 0;
+    for (uint32_t i = 0; i < minIterations; i++)
+    {
+        g_allocations = 0;
+        uint64_t delay = runBenchOneIteration(bench, n);
+        allocations = std::max(allocations, g_allocations);
+        minDelay = std::min(minDelay, delay);
+    }
+    std::cout << minDelay * 1e6 / n << " ns/packet, " << static_cast<double>(allocations) / n
+              << " allocations/packet\t" << name << std::endl;
+}
+
+/**
+ * Run a benchmark, then report its time per hop.
+ * @param bench The benchmark.
+ * @param n The number of packets.
+ * @param minIterations The number of iterations.
+ * @param name The name of the benchmark.
+ * @returns The time per hop, in ns.
+ */
+static double
+runBenchPerHop(void (*bench)(uint32_t),
+               uint32_t n,
+               uint32_t minIterations,
+               const std::string& name)
+{
+    uint64_t minDelay = std::numeric_limits<uint64_t>::max();
+    for (uint32_t i = 0; i < minIterations; i++)
+    {
+        minDelay = std::min(minDelay, runBenchOneIteration(bench, n));
+    }
+    double perHop = minDelay * 1e6 / n / std::max(g_hops, 1U);
+    std::cout << perHop << " ns/hop\t" << name << std::endl;
+    return perHop;
+}
+
 int
 main(int argc, char* argv[])
 {
     uint32_t n = 0;
     uint32_t minIterations = 1;
     bool enablePrinting = false;
+    bool enableHeaderCache = false;
+    uint32_t poolCache = PacketAllocator::GetCacheSize();
 
     CommandLine cmd(__FILE__);
     cmd.Usage("Benchmark Packet class");
@@ -379,6 +658,11 @@ main(int argc, char* argv[])
                  "number of subiterations to minimize iteration time over",
                  minIterations);
     cmd.AddValue("enable-printing", "enable packet printing", enablePrinting);
+    cmd.AddValue("header-cache", "enable the parsed-header cache", enableHeaderCache);
+    cmd.AddValue("hops", "number of hops of the forwarding benchmark", g_hops);
+    cmd.AddValue("pool-cache",
+                 "blocks kept per size class by the packet allocator, 0 to disable it",
+                 poolCache);
     cmd.Parse(argc, argv);
 
     if (n == 0)
@@ -387,6 +671,11 @@ main(int argc, char* argv[])
                   << "by command-line argument --n=(number of packets)" << std::endl;
         exit(1);
     }
+    if (enableHeaderCache)
+    {
+        Packet::EnableHeaderCache();
+    }
+    PacketAllocator::SetCacheSize(poolCache);
     std::cout << "Running bench-packets with n=" << n << std::endl;
     std::cout << "All tests begin by adding UDP and IPv4 headers." << std::endl;
 
@@ -395,7 +684,36 @@ main(int argc, char* argv[])
     runBench(&benchC, n, minIterations, "Remove by func call");
     runBench(&benchD, n, minIterations, "Intermixed add/remove headers and tags");
     runBench(&benchFragment, n, minIterations, "Fragmentation and concatenation");
-    runBench(&benchByteTags, n, minIterations, "Benchmark byte tags");
+    if (Packet::ByteTagsEnabled())
+    {
+        runBench(&benchByteTags, n, minIterations, "Benchmark byte tags");
+    }
+    runBench(&benchHopTags<BenchTag<9>>, n, minIterations, "Update a tag at 4 hops, tag list");
+    runBench(&benchHopTags<BenchSlotTag>, n, minIterations, "Update a tag at 4 hops, tag slot");
+    runBenchDeserializations(&benchForwardPeeks,
+                             n,
+                             minIterations,
+                             "Forward through 4 hops, peeking at headers");
+    runBenchAllocations(&benchForwardHops,
+                        n,
+                        minIterations,
+                        "Forward through " + std::to_string(g_hops) + " hops");
+
+    std::string fabric = "Forward through " + std::to_string(g_hops) + " fabric hops";
+    if (Packet::ByteTagsEnabled())
+    {
+        double withByteTags = runBenchPerHop(&benchFabricHops, n, minIterations, fabric);
+        // the byte tags cannot be enabled again, so this comes last
+        Packet::DisableByteTags();
+        double withoutByteTags =
+            runBenchPerHop(&benchFabricHops, n, minIterations, fabric + ", no byte tags");
+        std::cout << withByteTags - withoutByteTags << " ns/hop saved without byte tags"
+                  << std::endl;
+    }
+    else
+    {
+        runBenchPerHop(&benchFabricHops, n, minIterations, fabric + ", no byte tags");
+    }
 
     return 0;
 }
@@ -0,0 +1,149 @@
+//
+// SPDX-License-Identifier: GPL-2.0-only
+//
+
+// This program can be used to benchmark the enqueue and dequeue operations
+// of a DropTailQueue<Packet>, with the packets stored in a list or in a
+// ring buffer (DropTailQueue<Packet, PacketRingBuffer>), for various numbers
+// of packets 'n' and queue occupancies 'depth'
+// Sample usage:  ./ns3 run 'bench-queue --n=1000000 --depth=20'
+
+#include "ns3/command-line.h"
+#include "ns3/drop-tail-queue.h"
+#include "ns3/packet.h"
+#include "ns3/queue-size.h"
+#include "ns3/system-wall-clock-ms.h"
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <list>
+#include <stdlib.h> // for exit ()
+#include <vector>
+
+using namespace ns3;
+
+/// The number of packets in the queue in the steady state.
+static uint32_t g_depth = 20;
+
+/**
+ * Create a queue which holds g_depth packets.
+ * @tparam Container The container of the packets.
+ * @returns The queue.
+ */
+template <typename Container>
+static Ptr<DropTailQueue<Packet, Container>>
+CreateQueue()
+{
+    auto queue = CreateObject<DropTailQueue<Packet, Container>>();
+    queue->SetAttribute("MaxSize", QueueSizeValue(QueueSize(QueueSizeUnit::PACKETS, g_depth)));
+    return queue;
+}
+
+/**
+ * Enqueue and dequeue n packets, the queue holding g_depth packets.
+ * @tparam Container The container of the packets.
+ * @param n The number of packets.
+ */
+template <typename Container>
+static void
+benchSteady(uint32_t n)
+{
+    auto queue = CreateQueue<Container>();
+    Ptr<Packet> p = Create<Packet>(1000);
+    for (uint32_t i = 1; i < g_depth; i++)
+    {
+        queue->Enqueue(p);
+    }
+    for (uint32_t i = 0; i < n; i++)
+    {
+        queue->Enqueue(p);
+        queue->Dequeue();
+    }
+}
+
+/**
+ * Fill the queue up to g_depth packets, overflow it, then drain it, until
+ * n packets have been enqueued.
+ * @tparam Container The container of the packets.
+ * @param n The number of packets.
+ */
+template <typename Container>
+static void
+benchBurst(uint32_t n)
+{
+    auto queue = CreateQueue<Container>();
+    Ptr<Packet> p = Create<Packet>(1000);
+    for (uint32_t i = 0; i < n; i += g_depth + 1)
+    {
+        for (uint32_t j = 0; j <= g_depth; j++)
+        {
+            queue->Enqueue(p); // the last one is dropped
+        }
+        while (queue->Dequeue())
+        {
+        }
+    }
+}
+
+static uint64_t
+runBenchOneIteration(void (*bench)(uint32_t), uint32_t n)
+{
+    SystemWallClockMs time;
+    time.Start();
+    (*bench)(n);
+    uint64_t deltaMs = time.End();
+    return deltaMs;
+}
+
+static void
+runBench(void (*bench)(uint32_t), uint32_t n, uint32_t minIterations, const char* name)
+{
+    uint64_t minDelay = std::numeric_limits<uint64_t>::max();
+    for (uint32_t i = 0; i < minIterations; i++)
+    {
+        uint64_t delay = runBenchOneIteration(bench, n);
+        minDelay = std::min(minDelay, delay);
+    }
+    double ps = n;
+    ps *= 1000;
+    ps /= std::max<uint64_t>(minDelay, 1);
+    std::cout << ps << " packets/s"
+              << " (" << minDelay << " ms elapsed)\t" << name << std::endl;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t n = 0;
+    uint32_t minIterations = 1;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the storage of the packets in a Queue");
+    cmd.AddValue("n", "number of packets", n);
+    cmd.AddValue("depth", "number of packets in the queue", g_depth);
+    cmd.AddValue("min-iterations",
+                 "number of subiterations to minimize iteration time over",
+                 minIterations);
+    cmd.Parse(argc, argv);
+
+    if (n == 0 || g_depth == 0)
+    {
+        std::cerr << "Error-- number of packets and depth must be specified "
+                  << "by command-line arguments --n=(number of packets) --depth=(packets)"
+                  << std::endl;
+        exit(1);
+    }
+    std::cout << "Running bench-queue with n=" << n << " depth=" << g_depth << std::endl;
+
+    using List = std::list<Ptr<Packet>>;
+    runBench(&benchSteady<List>, n, minIterations, "Enqueue and dequeue, list");
+    runBench(&benchSteady<PacketRingBuffer>, n, minIterations, "Enqueue and dequeue, ring buffer");
+    runBench(&benchBurst<List>, n, minIterations, "Fill, overflow and drain, list");
+    runBench(&benchBurst<PacketRingBuffer>,
+             n,
+             minIterations,
+             "Fill, overflow and drain, ring buffer");
+
+    return 0;
+}
@@ -36,13 +36,20 @@ std::string g_me;
 /** Output field width for numeric data. */
 int g_fwidth = 6;
 
+/** Flag to report the event allocations. */
+bool g_allocs = false;
+
+/** Scheduler operations to replay, instead of the random events. */
+std::vector<RecordingScheduler::Operation> g_operations;
+
 /**
  *  Benchmark instance which can do a single run.
  *
  *  The run is controlled by the event population size and
  *  total number of events, which are set at construction.
  *
- *  The event distribution in time is set by SetRandomStream()
+ *  The event distribution in time is set by SetRandomStream(),
+ *  unless operations recorded by the RecordingScheduler are replayed.
  */
 class Bench
 {
@@ -89,6 +96,19 @@ class Bench
         m_total = total;
     }
 
+    /**
+     * Set the scheduler to benchmark.
+     *
+     * Simulator::Destroy() at the end of each run resets the scheduler, so
+     * it is set again at the start of each run.
+     *
+     * @param [in] factory Factory pre-configured to create the desired Scheduler.
+     */
+    void SetScheduler(const ObjectFactory& factory)
+    {
+        m_factory = factory;
+    }
+
     /** The output. */
     struct Result
     {
@@ -96,6 +116,8 @@ class Bench
         double simu;     /**< Time (s) for simulation. */
         uint64_t pop;    /**< Event population. */
         uint64_t events; /**< Number of events executed. */
+        uint64_t allocs; /**< Number of events allocated. */
+        uint64_t heap;   /**< Number of event allocations served by the heap. */
     };
 
     /**
@@ -106,12 +128,24 @@ class Bench
     Result Run();
 
   private:
+    /**
+     *  Replay the operations of g_operations against a new scheduler,
+     *  without the simulator.
+     *
+     *  The initialization is made of the operations before the first event
+     *  is run.
+     *
+     * @returns The Result.
+     */
+    Result Replay();
+
     /**
      *  Event function. This checks for completion (total number of events
      *  executed) and schedules a new event if not complete.
      */
     void Cb();
 
+    ObjectFactory m_factory;          /**< Factory of the Scheduler. */
     Ptr<RandomVariableStream> m_rand; /**< Stream for event delays. */
     uint64_t m_population;            /**< Event population size. */
     uint64_t m_total;                 /**< Total number of events to execute. */
@@ -121,12 +155,19 @@ class Bench
 Bench::Result
 Bench::Run()
 {
+    if (!g_operations.empty())
+    {
+        return Replay();
+    }
+
     SystemWallClockMs timer;
     double init;
     double simu;
 
     DEB("initializing");
+    Simulator::SetScheduler(m_factory);
     m_count = 0;
+    EventImpl::PoolStats start = EventImpl::GetPoolStats();
 
     timer.Start();
     for (uint64_t i = 0; i < m_population; ++i)
@@ -145,7 +186,63 @@ Bench::Run()
 
     Simulator::Destroy();
 
-    return Result{init, simu, m_population, m_count};
+    EventImpl::PoolStats end = EventImpl::GetPoolStats();
+    return Result{init,
+                  simu,
+                  m_population,
+                  m_count,
+                  end.allocations - start.allocations,
+                  end.heapAllocations - start.heapAllocations};
+}
+
+Bench::Result
+Bench::Replay()
+{
+    typedef RecordingScheduler::Operation Operation;
+    SystemWallClockMs timer;
+    double init;
+    double simu;
+    uint64_t pop = 0;
+    uint64_t events = 0;
+
+    DEB("initializing");
+    Ptr<Scheduler> scheduler = m_factory.Create<Scheduler>();
+    auto op = g_operations.begin();
+
+    timer.Start();
+    for (; op != g_operations.end() && op->type == Operation::INSERT; ++op)
+    {
+        scheduler->Insert(Scheduler::Event{nullptr, op->key});
+        ++pop;
+    }
+    init = timer.End() / 1000.0;
+    DEB("initialization took " << init << "s");
+
+    DEB("running");
+    timer.Start();
+    for (; op != g_operations.end(); ++op)
+    {
+        if (op->type == Operation::INSERT)
+        {
+            scheduler->Insert(Scheduler::Event{nullptr, op->key});
+        }
+        else if (op->type == Operation::REMOVE)
+        {
+            scheduler->Remove(Scheduler::Event{nullptr, op->key});
+        }
+        else
+        {
+            Scheduler::Event next = scheduler->RemoveNext();
+            NS_ABORT_MSG_IF(next.key.m_ts != op->key.m_ts,
+                            "Event " << events << " at " << next.key.m_ts << " instead of "
+                                     << op->key.m_ts);
+            ++events;
+        }
+    }
+    simu = timer.End() / 1000.0;
+    DEB("run took " << simu << "s");
+
+    return Result{init, simu, pop, events, 0, 0};
 }
 
 void
@@ -209,6 +306,8 @@ class BenchSuite
     {
         PhaseResult init; /**< Initialization phase results. */
         PhaseResult run;  /**< Run (simulation) phase results. */
+        double allocs{0}; /**< Events allocated per event executed. */
+        double heap{0};   /**< Heap allocations per event executed. */
         /**
          * Construct from the individual run result.
          *
@@ -236,8 +335,11 @@ class BenchSuite
 BenchSuite::Result
 BenchSuite::Result::Bench(Bench::Result r)
 {
-    return Result{{r.init, r.pop / r.init, r.init / r.pop},
+    Result result{{r.init, r.pop / r.init, r.init / r.pop},
                   {r.simu, r.events / r.simu, r.simu / r.events}};
+    result.allocs = static_cast<double>(r.allocs) / r.events;
+    result.heap = static_cast<double>(r.heap) / r.events;
+    return result;
 }
 
 template <typename T>
@@ -246,10 +348,15 @@ BenchSuite::Result::Log(T label) const
 {
     // Need std::left for string labels
 
-    LOG(std::left << std::setw(g_fwidth) << label << std::setw(g_fwidth) << init.time
-                  << std::setw(g_fwidth) << init.rate << std::setw(g_fwidth) << init.period
-                  << std::setw(g_fwidth) << run.time << std::setw(g_fwidth) << run.rate
-                  << std::setw(g_fwidth) << run.period);
+    std::cout << std::left << std::setw(g_fwidth) << label << std::setw(g_fwidth) << init.time
+              << std::setw(g_fwidth) << init.rate << std::setw(g_fwidth) << init.period
+              << std::setw(g_fwidth) << run.time << std::setw(g_fwidth) << run.rate
+              << std::setw(g_fwidth) << run.period;
+    if (g_allocs)
+    {
+        std::cout << std::setw(g_fwidth) << allocs << std::setw(g_fwidth) << heap;
+    }
+    std::cout << std::endl;
 }
 
 BenchSuite::BenchSuite(ObjectFactory& factory,
@@ -272,6 +379,7 @@ BenchSuite::BenchSuite(ObjectFactory& factory,
     }
 
     Bench bench(pop, total);
+    bench.SetScheduler(factory);
     bench.SetRandomStream(eventStream);
     bench.SetPopulation(pop);
     bench.SetTotal(total);
@@ -307,7 +415,8 @@ BenchSuite::Header() const
                   << std::left << std::setw(g_fwidth) << "Rate (ev/s)" << std::left
                   << std::setw(g_fwidth) << "Per (s/ev)" << std::left << std::setw(g_fwidth)
                   << "Time (s)" << std::left << std::setw(g_fwidth) << "Rate (ev/s)" << std::left
-                  << "Per (s/ev)");
+                  << std::setw(g_fwidth) << "Per (s/ev)" << std::left << std::setw(g_fwidth)
+                  << (g_allocs ? "Allocs/ev" : "") << (g_allocs ? "Heap/ev" : ""));
     LOG(std::setfill('-') << std::right << std::setw(g_fwidth) << " " << std::right
                           << std::setw(g_fwidth) << " " << std::right << std::setw(g_fwidth) << " "
                           << std::right << std::setw(g_fwidth) << " " << std::right
@@ -356,6 +465,13 @@ BenchSuite::Log() const
         ACCUMULATE(run, period);
 
 #undef ACCUMULATE
+
+        deltaPre = run.allocs - average.allocs;
+        average.allocs += deltaPre / count;
+        moment2.allocs += deltaPre * (run.allocs - average.allocs);
+        deltaPre = run.heap - average.heap;
+        average.heap += deltaPre / count;
+        moment2.heap += deltaPre * (run.heap - average.heap);
     }
 
     auto stdev = Result{
@@ -365,6 +481,8 @@ BenchSuite::Log() const
         {std::sqrt(moment2.run.time / n),
          std::sqrt(moment2.run.rate / n),
          std::sqrt(moment2.run.period / n)},
+        std::sqrt(moment2.allocs / n),
+        std::sqrt(moment2.heap / n),
     };
 
     average.Log("average");
@@ -443,6 +561,7 @@ main(int argc, char* argv[])
     bool allSched = false;
     bool schedCal = false;
     bool schedHeap = false;
+    bool schedLadder = false;
     bool schedList = false;
     bool schedMap = false; // default scheduler
     bool schedPQ = false;
@@ -451,6 +570,7 @@ main(int argc, char* argv[])
     uint64_t total = 1000000;
     uint64_t runs = 1;
     std::string filename = "";
+    std::string replay = "";
     bool calRev = false;
 
     CommandLine cmd(__FILE__);
@@ -463,11 +583,16 @@ main(int argc, char* argv[])
               "In the case of either --file form, the input is expected\n"
               "to be ascii, giving the relative event times in ns.\n"
               "\n"
+              "Alternatively, the operations of a simulation recorded by the\n"
+              "ns3::RecordingScheduler are replayed against each scheduler with\n"
+              "--replay=\"<filename>\"; --pop, --total and --file are then ignored.\n"
+              "\n"
               "If no scheduler is specified the MapScheduler will be run.");
     cmd.AddValue("all", "use all schedulers", allSched);
     cmd.AddValue("cal", "use CalendarScheduler", schedCal);
     cmd.AddValue("calrev", "reverse ordering in the CalendarScheduler", calRev);
     cmd.AddValue("heap", "use HeapScheduler", schedHeap);
+    cmd.AddValue("ladder", "use LadderScheduler", schedLadder);
     cmd.AddValue("list", "use ListScheduler", schedList);
     cmd.AddValue("map", "use MapScheduler (default)", schedMap);
     cmd.AddValue("pri", "use PriorityQueue", schedPQ);
@@ -476,7 +601,12 @@ main(int argc, char* argv[])
     cmd.AddValue("total", "total number of events to run", total);
     cmd.AddValue("runs", "number of runs", runs);
     cmd.AddValue("file", "file of relative event times", filename);
+    cmd.AddValue("replay", "file of operations recorded by the RecordingScheduler", replay);
     cmd.AddValue("prec", "printed output precision", g_fwidth);
+    cmd.AddValue("allocs",
+                 "report the events allocated, and those served by the heap "
+                 "instead of the event pool, per event executed",
+                 g_allocs);
     cmd.Parse(argc, argv);
 
     g_me = cmd.GetName() + ": ";
@@ -491,15 +621,25 @@ main(int argc, char* argv[])
 
     if (allSched)
     {
-        schedCal = schedHeap = schedList = schedMap = schedPQ = true;
+        schedCal = schedHeap = schedLadder = schedList = schedMap = schedPQ = true;
     }
     // Set the default case if nothing else is set
-    if (!(schedCal || schedHeap || schedList || schedMap || schedPQ))
+    if (!(schedCal || schedHeap || schedLadder || schedList || schedMap || schedPQ))
     {
         schedMap = true;
     }
 
-    auto eventStream = GetRandomStream(filename);
+    Ptr<RandomVariableStream> eventStream;
+    if (replay.empty())
+    {
+        eventStream = GetRandomStream(filename);
+    }
+    else
+    {
+        LOG("  Event time distribution:      replay of " << replay);
+        g_operations = RecordingScheduler::ReadFile(replay);
+        LOG("    Found " << g_operations.size() << " operations");
+    }
 
     ObjectFactory factory("ns3::MapScheduler");
     if (schedCal)
@@ -518,16 +658,28 @@ main(int argc, char* argv[])
         factory.SetTypeId("ns3::HeapScheduler");
         BenchSuite(factory, pop, total, runs, eventStream, calRev).Log();
     }
+    if (schedLadder)
+    {
+        factory.SetTypeId("ns3::LadderScheduler");
+        BenchSuite(factory, pop, total, runs, eventStream, calRev).Log();
+    }
     if (schedList)
     {
         factory.SetTypeId("ns3::ListScheduler");
         auto listTotal = total;
-        if (allSched)
+        if (allSched && !replay.empty())
+        {
+            LOG("Skipping List scheduler for the replay");
+        }
+        else
         {
-            LOG("Running List scheduler with 1/10 total events");
-            listTotal /= 10;
+            if (allSched)
+            {
+                LOG("Running List scheduler with 1/10 total events");
+                listTotal /= 10;
+            }
+            BenchSuite(factory, pop, listTotal, runs, eventStream, calRev).Log();
         }
-        BenchSuite(factory, pop, listTotal, runs, eventStream, calRev).Log();
     }
     if (schedMap)
     {
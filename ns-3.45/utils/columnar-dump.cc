@@ -0,0 +1,150 @@
+//
+// SPDX-License-Identifier: GPL-2.0-only
+//
+
+// This program prints the schema of a file written by ns3::ColumnarWriter
+// and, optionally, its content as CSV, e.g., to check a result file or to
+// feed tools that do not read the binary format.
+// Sample usage:  ./ns3 run 'columnar-dump --file=flows.ncol --csv --columns=flowId,rxBytes'
+
+#include "ns3/columnar-reader.h"
+#include "ns3/command-line.h"
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * Get the name of a column type
+ * @param type the column type
+ * @returns the name
+ */
+static const char*
+GetTypeName(ColumnarWriter::ColumnType type)
+{
+    switch (type)
+    {
+    case ColumnarWriter::UINT32:
+        return "uint32";
+    case ColumnarWriter::UINT64:
+        return "uint64";
+    case ColumnarWriter::INT64:
+        return "int64";
+    case ColumnarWriter::DOUBLE:
+        return "double";
+    }
+    return "unknown";
+}
+
+int
+main(int argc, char* argv[])
+{
+    std::string fileName;
+    std::string columnList;
+    bool csv = false;
+    uint64_t maxRows = std::numeric_limits<uint64_t>::max();
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Print the schema and content of a columnar statistics file");
+    cmd.AddValue("file", "the columnar file", fileName);
+    cmd.AddValue("csv", "print the rows as CSV", csv);
+    cmd.AddValue("columns",
+                 "comma-separated list of the columns to print (default: all)",
+                 columnList);
+    cmd.AddValue("max-rows", "maximum number of rows to print", maxRows);
+    cmd.Parse(argc, argv);
+
+    ColumnarReader reader;
+    if (fileName.empty() || !reader.Open(fileName))
+    {
+        std::cerr << "Error-- a columnar file must be specified by --file=(file name)" << std::endl;
+        return 1;
+    }
+
+    std::vector<uint32_t> columns;
+    if (columnList.empty())
+    {
+        for (uint32_t i = 0; i < reader.GetNColumns(); i++)
+        {
+            columns.push_back(i);
+        }
+    }
+    else
+    {
+        std::istringstream is(columnList);
+        std::string name;
+        while (std::getline(is, name, ','))
+        {
+            int32_t index = reader.GetColumnIndex(name);
+            if (index < 0)
+            {
+                std::cerr << "Error-- no column " << name << " in " << fileName << std::endl;
+                return 1;
+            }
+            columns.push_back(index);
+        }
+    }
+
+    if (!csv)
+    {
+        std::cout << fileName << ": " << reader.GetNRows() << " rows"
+                  << (reader.IsComplete() ? "" : " (truncated)") << std::endl;
+        for (auto column : columns)
+        {
+            std::cout << "  " << reader.GetColumnName(column) << " "
+                      << GetTypeName(reader.GetColumnType(column)) << std::endl;
+        }
+        return 0;
+    }
+
+    // integer columns are read as such, so that 64-bit values are exact
+    std::vector<std::vector<double>> doubles(columns.size());
+    std::vector<std::vector<int64_t>> integers(columns.size());
+    for (std::size_t i = 0; i < columns.size(); i++)
+    {
+        bool ok = reader.GetColumnType(columns[i]) == ColumnarWriter::DOUBLE
+                      ? reader.ReadColumn(columns[i], doubles[i])
+                      : reader.ReadColumn(columns[i], integers[i]);
+        if (!ok)
+        {
+            std::cerr << "Error-- unable to read column " << reader.GetColumnName(columns[i])
+                      << std::endl;
+            return 1;
+        }
+    }
+
+    std::cout.precision(std::numeric_limits<double>::max_digits10);
+    for (std::size_t i = 0; i < columns.size(); i++)
+    {
+        std::cout << (i ? "," : "") << reader.GetColumnName(columns[i]);
+    }
+    std::cout << "\n";
+    uint64_t nRows = std::min(reader.GetNRows(), maxRows);
+    for (uint64_t row = 0; row < nRows; row++)
+    {
+        for (std::size_t i = 0; i < columns.size(); i++)
+        {
+            std::cout << (i ? "," : "");
+            if (reader.GetColumnType(columns[i]) == ColumnarWriter::DOUBLE)
+            {
+                std::cout << doubles[i][row];
+            }
+            else if (reader.GetColumnType(columns[i]) == ColumnarWriter::UINT64)
+            {
+                std::cout << static_cast<uint64_t>(integers[i][row]);
+            }
+            else
+            {
+                std::cout << integers[i][row];
+            }
+        }
+        std::cout << "\n";
+    }
+
+    return 0;
+}
@@ -8,6 +8,7 @@
 #include <ns3/boolean.h>
 #include <ns3/uinteger.h>
 #include <ns3/assert.h>
+#include <ns3/abort.h>
 #include <ns3/data-rate.h>
 #include <ns3/node-list.h>
 #include <ns3/queue.h>
@@ -29,24 +30,36 @@ namespace ns3 {
 
 // ==================== TokenBucket ====================
 
-TokenBucket::TokenBucket(double pps, uint32_t burst)
-  : m_pps(pps), m_capacity(burst), m_tokens(burst), m_lastRefill(Simulator::Now())
-{}
+TokenBucket::TokenBucket(DataRate rate, uint32_t pktSize, uint32_t burst)
+  : m_rate(rate), m_pktSize(pktSize),
+    m_capacity(uint64_t(burst) * pktSize), m_tokens(m_capacity),
+    m_refillBase(Simulator::Now()), m_refilled(0)
+{
+  // 包长为 0 时每包不消耗令牌, 桶将失去限速作用
+  NS_ABORT_MSG_IF(pktSize == 0, "TokenBucket: packet size must be positive");
+}
 
 void TokenBucket::Refill()
 {
-  if (m_pps <= 0.0) return;
+  if (m_rate.GetBitRate() == 0) return;
+  // 自基准时刻起的总补充量减去已补充量: 整数换算, 无累积舍入误差
   Time now = Simulator::Now();
-  double elapsed = (now - m_lastRefill).GetSeconds();
-  m_tokens = std::min(m_tokens + elapsed * m_pps, static_cast<double>(m_capacity));
-  m_lastRefill = now;
+  uint64_t total = m_rate.CalculateBytesInTime(now - m_refillBase);
+  m_tokens += total - m_refilled;
+  m_refilled = total;
+  if (m_tokens >= m_capacity) {
+    m_tokens = m_capacity;
+    m_refillBase = now;
+    m_refilled = 0;
+  }
 }
 
 bool TokenBucket::TryConsume(uint32_t pkts)
 {
   Refill();
-  if (m_tokens >= pkts) {
-    m_tokens -= pkts;
+  uint64_t bytes = uint64_t(pkts) * m_pktSize;
+  if (m_tokens >= bytes) {
+    m_tokens -= bytes;
     return true;
   }
   return false;
@@ -54,7 +67,7 @@ bool TokenBucket::TryConsume(uint32_t pkts)
 
 void TokenBucket::Refund(uint32_t pkts)
 {
-  m_tokens = std::min(m_tokens + pkts, static_cast<double>(m_capacity));
+  m_tokens = std::min(m_tokens + uint64_t(pkts) * m_pktSize, m_capacity);
 }
 
 // ==================== EgressTokenManager ====================
@@ -76,10 +89,11 @@ EgressTokenManager::~EgressTokenManager() = default;
 void EgressTokenManager::RegisterEgressPort(uint32_t portId, DataRate rate, uint32_t avgPktSize)
 {
   if (m_buckets.find(portId) != m_buckets.end()) return;
+  NS_ABORT_MSG_IF(avgPktSize == 0, "EgressTokenManager: average packet size must be positive");
 
-  double pps = (avgPktSize > 0) ? (static_cast<double>(rate.GetBitRate()) / (avgPktSize * 8.0)) : 0.0;
-  uint32_t burst = std::max(8u, static_cast<uint32_t>(pps * 0.001));
-  m_buckets[portId] = std::make_unique<TokenBucket>(pps, burst);
+  uint64_t pktsPerMs = rate.CalculateBytesInTime(MilliSeconds(1)) / avgPktSize;
+  uint32_t burst = std::max<uint64_t>(8, pktsPerMs);
+  m_buckets[portId] = std::make_unique<TokenBucket>(rate, avgPktSize, burst);
 }
 
 bool EgressTokenManager::TryConsumeToken(uint32_t portId, uint32_t pkts)
@@ -172,7 +186,7 @@ TypeId QbbNetDevice::GetTypeId()
     .AddAttribute("AvgPktSize", "Avg packet size for token calc (bytes on wire)",
                   UintegerValue(1500),
                   MakeUintegerAccessor(&QbbNetDevice::m_avgPktSize),
-                  MakeUintegerChecker<uint32_t>());
+                  MakeUintegerChecker<uint32_t>(1));
   return tid;
 }
 
@@ -182,6 +196,10 @@ QbbNetDevice::QbbNetDevice()
   m_pauseUntil.fill(Seconds(0));
   m_rxOccPkts.fill(0);
   m_localCongested.fill(false);
+  for (uint8_t pr = 0; pr < 8; ++pr) {
+    m_refillTimer[pr].SetFunction(&QbbNetDevice::RefillMacQueueFromHold, this);
+    m_refillTimer[pr].SetArguments(pr);
+  }
 }
 
 QbbNetDevice::~QbbNetDevice() = default;
@@ -292,8 +310,7 @@ void QbbNetDevice::EnsureTokenManager()
   for (uint32_t i = 0; i < nd->GetNDevices(); ++i) {
     Ptr<QbbNetDevice> qbb = DynamicCast<QbbNetDevice>(nd->GetDevice(i));
     if (!qbb) continue;
-    DataRateValue dv; qbb->GetAttribute("DataRate", dv);
-    m_tokenMgr->RegisterEgressPort(i, dv.Get(), m_avgPktSize);
+    m_tokenMgr->RegisterEgressPort(i, qbb->GetDataRate(), m_avgPktSize);
   }
 }
 
@@ -345,19 +362,17 @@ void QbbNetDevice::HandleMacRx(Ptr<const Packet> p)
           m_pfcRxXon[pr]++;
           m_paused[pr] = false;
           m_pauseUntil[pr] = Simulator::Now();
-          if (m_refillEvent[pr].IsRunning()) m_refillEvent[pr].Cancel();
+          m_refillTimer[pr].Cancel();
           RefillMacQueueFromHold(pr);
         } else {
           m_pfcRxXoff[pr]++;
-          double bt = GetBitTime();
           m_paused[pr] = true;
-          m_pauseUntil[pr] = Simulator::Now() + Seconds(q * 512.0 * bt);
+          m_pauseUntil[pr] = Simulator::Now() + GetPauseDuration(q);
 
           PurgeMacQueueForPrio(pr);
 
-          if (m_refillEvent[pr].IsRunning()) m_refillEvent[pr].Cancel();
-          m_refillEvent[pr] = Simulator::Schedule(m_pauseUntil[pr] - Simulator::Now(),
-                                                  &QbbNetDevice::ResumeFromPause, this, pr);
+          // 暂停结束时回填; XOFF 续期时定时器原地后移
+          m_refillTimer[pr].Schedule(m_pauseUntil[pr] - Simulator::Now());
         }
       }
       if (m_txEvent.IsExpired()) {
@@ -561,8 +576,7 @@ void QbbNetDevice::RefillMacQueueFromHold(uint8_t prio)
   }
 
   if (!m_macHold[prio].empty()) {
-    m_refillEvent[prio] = Simulator::Schedule(MicroSeconds(5),
-                                              &QbbNetDevice::RefillMacQueueFromHold, this, prio);
+    m_refillTimer[prio].Schedule(MicroSeconds(5));
   } else {
     if (m_txEvent.IsExpired()) {
       m_txEvent = Simulator::ScheduleNow(&QbbNetDevice::TryDequeue, this);
@@ -570,13 +584,6 @@ void QbbNetDevice::RefillMacQueueFromHold(uint8_t prio)
   }
 }
 
-void QbbNetDevice::ResumeFromPause(uint8_t prio)
-{
-  if (Simulator::Now() < m_pauseUntil[prio]) return;
-  m_paused[prio] = false;
-  RefillMacQueueFromHold(prio);
-}
-
 void QbbNetDevice::SendPfcXoff(uint8_t prio, uint16_t quanta)
 {
   if (prio < 8) m_pfcTxXoff[prio]++;
@@ -608,11 +615,11 @@ void QbbNetDevice::SendPfcXon(uint8_t prio)
 void QbbNetDevice::BroadcastPfcXoff(uint8_t prio, uint16_t quanta) { SendPfcXoff(prio, quanta); }
 void QbbNetDevice::BroadcastPfcXon(uint8_t prio) { SendPfcXon(prio); }
 
-double QbbNetDevice::GetBitTime() const
+Time QbbNetDevice::GetPauseDuration(uint16_t quanta) const
 {
-  DataRateValue dv; GetAttribute("DataRate", dv);
-  double br = dv.Get().GetBitRate();
-  return (br > 0) ? (1.0 / br) : 1e-9;
+  DataRate rate = GetDataRate();
+  uint32_t bits = quanta * 512u;
+  return (rate.GetBitRate() > 0) ? rate.CalculateBitsTxTime(bits) : NanoSeconds(bits);
 }
 
 void QbbNetDevice::PrintAllPfcCounters()
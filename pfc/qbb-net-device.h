@@ -3,6 +3,7 @@
 
 #include <ns3/point-to-point-net-device.h>
 #include <ns3/event-id.h>
+#include <ns3/reschedulable-timer.h>
 #include <ns3/data-rate.h>
 
 #include <array>
@@ -14,20 +15,22 @@
 
 namespace ns3 {
 
-// 简单按包粒度的令牌桶
+// 简单按包粒度的令牌桶; 令牌按字节整数计, 不经 double 换算
 class TokenBucket
 {
 public:
-  TokenBucket(double pps, uint32_t burst);
+  TokenBucket(DataRate rate, uint32_t pktSize, uint32_t burst);
   void Refill();
   bool TryConsume(uint32_t pkts = 1);
   void Refund(uint32_t pkts = 1);  // 新增：令牌退回
 
 private:
-  double m_pps;
-  uint32_t m_capacity;
-  double m_tokens;
-  Time m_lastRefill;
+  DataRate m_rate;
+  uint32_t m_pktSize;    // 每包消耗的字节数, 必须为正
+  uint64_t m_capacity;   // 字节
+  uint64_t m_tokens;     // 字节
+  Time m_refillBase;     // 上次桶满(或创建)的时刻
+  uint64_t m_refilled;   // 自 m_refillBase 起已补充的字节
 };
 
 // 每个出端口一个令牌桶 + 公平轮询仲裁器
@@ -120,7 +123,6 @@ private:
   // PFC 控制帧处理相关：MAC 队列清理/回填、到时恢复
   void PurgeMacQueueForPrio(uint8_t prio);
   void RefillMacQueueFromHold(uint8_t prio);
-  void ResumeFromPause(uint8_t prio);
 
   // 发送 PFC 控制帧
   void SendPfcXoff(uint8_t prio, uint16_t quanta);
@@ -128,7 +130,7 @@ private:
   void BroadcastPfcXoff(uint8_t prio, uint16_t quanta);
   void BroadcastPfcXon(uint8_t prio);
 
-  double GetBitTime() const;
+  Time GetPauseDuration(uint16_t quanta) const;  // quanta 个 512 比特时间
 
   // 配置
   bool m_pfcEnable{true};
@@ -163,7 +165,7 @@ private:
   // 事件
   EventId m_txEvent;
   EventId m_ingressDrainEv;
-  std::array<EventId, 8> m_refillEvent; // 复用：回填/到时恢复
+  std::array<ReschedulableTimer, 8> m_refillTimer; // 复用：回填/到时恢复, 不留下已取消的事件
 
   Ptr<EgressTokenManager> m_tokenMgr;
 
@@ -0,0 +1,77 @@
+// PFC 令牌桶测试
+// 由 ns-3.45/scratch/pfc-test/CMakeLists.txt 与 pfc/*.cc 一起编译, 运行:
+//   ./ns3 run pfc-test
+#include "qbb-net-device.h"
+
+#include <ns3/config.h>
+#include <ns3/simulator.h>
+#include <ns3/test.h>
+#include <ns3/uinteger.h>
+
+using namespace ns3;
+
+// 令牌桶在初始突发后耗尽, 之后按速率补充
+class TokenBucketTestCase : public TestCase
+{
+public:
+  TokenBucketTestCase();
+
+private:
+  void DoRun() override;
+};
+
+TokenBucketTestCase::TokenBucketTestCase()
+  : TestCase("TokenBucket limits the packets to its rate")
+{}
+
+void
+TokenBucketTestCase::DoRun()
+{
+  // 1Gbps, 每包 1500 字节: 每 12us 补充一个包
+  TokenBucket bucket(DataRate("1Gbps"), 1500, 8);
+  for (uint32_t i = 0; i < 8; i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ(bucket.TryConsume(), true, "burst packet " << i);
+    }
+  NS_TEST_EXPECT_MSG_EQ(bucket.TryConsume(), false, "bucket empty after the burst");
+
+  Simulator::Schedule(MicroSeconds(11), [&]() {
+    NS_TEST_EXPECT_MSG_EQ(bucket.TryConsume(), false, "less than one packet refilled");
+  });
+  Simulator::Schedule(MicroSeconds(12), [&]() {
+    NS_TEST_EXPECT_MSG_EQ(bucket.TryConsume(), true, "one packet refilled");
+    NS_TEST_EXPECT_MSG_EQ(bucket.TryConsume(), false, "only one packet refilled");
+  });
+  Simulator::Run();
+  Simulator::Destroy();
+
+  // 包长为 0 时桶不再限速, 属性检查拒绝该值
+  NS_TEST_EXPECT_MSG_EQ(Config::SetDefaultFailSafe("ns3::QbbNetDevice::AvgPktSize",
+                                                   UintegerValue(0)),
+                        false,
+                        "zero packet size rejected");
+  NS_TEST_EXPECT_MSG_EQ(Config::SetDefaultFailSafe("ns3::QbbNetDevice::AvgPktSize",
+                                                   UintegerValue(1500)),
+                        true,
+                        "positive packet size accepted");
+}
+
+class PfcTestSuite : public TestSuite
+{
+public:
+  PfcTestSuite();
+};
+
+PfcTestSuite::PfcTestSuite()
+  : TestSuite("pfc", Type::UNIT)
+{
+  AddTestCase(new TokenBucketTestCase, TestCase::Duration::QUICK);
+}
+
+static PfcTestSuite g_pfcTestSuite;
+
+int
+main(int argc, char* argv[])
+{
+  return TestRunner::Run(argc, argv);
+}